@@ -0,0 +1,37 @@
+#include <benchmark/benchmark.h>
+#include "call_profiler.hpp"
+
+#include <mutex>
+
+static std::mutex mutex;
+
+static void BM_UninstrumentedCall(benchmark::State& state){
+    for(auto _: state){
+        std::lock_guard<std::mutex> lock(mutex);
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_UninstrumentedCall)->ThreadRange(1, 4);
+
+static void BM_InstrumentedCall(benchmark::State& state){ //what HEL_PROFILE_CALL and HEL_PROFILE_LOCK_WAIT add to an entry point that takes one lock
+    static const std::size_t SITE = hel::CallProfiler::registerSite(__PRETTY_FUNCTION__);
+    for(auto _: state){
+        hel::CallProfiler::ScopedCall call(SITE);
+        hel::CallProfiler::LockWait wait;
+        std::lock_guard<std::mutex> lock(mutex);
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_InstrumentedCall)->ThreadRange(1, 4);
+
+static void BM_Snapshot(benchmark::State& state){
+    for(auto _: state){
+        benchmark::DoNotOptimize(hel::CallProfiler::snapshot());
+    }
+}
+
+BENCHMARK(BM_Snapshot);
+
+BENCHMARK_MAIN();
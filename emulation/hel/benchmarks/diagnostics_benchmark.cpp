@@ -0,0 +1,24 @@
+#include <benchmark/benchmark.h>
+#include "diagnostics.hpp"
+
+#include <fstream>
+
+static void BM_WriteWarning(benchmark::State& state){ //what each warning used to cost, with a file standing in for the terminal
+    std::ofstream out("/dev/null");
+    for(auto _: state){
+        out<<"Synthesis warning: Unsupported feature: Function call tSPI::readDebugState\n";
+        out.flush();
+    }
+}
+
+BENCHMARK(BM_WriteWarning);
+
+static void BM_ReportWarning(benchmark::State& state){
+    for(auto _: state){
+        HEL_WARN("Unsupported feature: Function call tSPI::readDebugState");
+    }
+}
+
+BENCHMARK(BM_ReportWarning)->ThreadRange(1, 4);
+
+BENCHMARK_MAIN();
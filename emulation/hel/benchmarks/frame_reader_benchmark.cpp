@@ -0,0 +1,126 @@
+#include <benchmark/benchmark.h>
+#include "digital_system.hpp"
+#include "frame_reader.hpp"
+#include "joystick.hpp"
+#include "json_util.hpp"
+#include "send_data.hpp"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+constexpr std::size_t MTU = 1516; //ETHERNET_MTU, the most received by one read
+constexpr unsigned PACKETS_PER_STREAM = 16;
+
+static std::string makeDeepJSONPacket(){ //about the size of a deep packet with every input populated
+    std::string packet = "{\"roborio\":{\"digital_hdrs\":[0,0,0,0,0,0,0,0,0,0],\"joysticks\":[";
+    for(unsigned i = 0; i < hel::Joystick::MAX_JOYSTICK_COUNT; i++){
+        if(i != 0){
+            packet += ",";
+        }
+        packet += "{\"is_xbox\":0,\"type\":0,\"name\":\"\",\"buttons\":0,\"button_count\":0,\"axes\":[0,0,0,0,0,0,0,0,0,0,0,0],\"axis_count\":0,\"axis_types\":[0,0,0,0,0,0,0,0,0,0,0,0],\"povs\":[0,0,0,0,0,0,0,0,0,0,0,0],\"pov_count\":0,\"outputs\":0,\"left_rumble\":0,\"right_rumble\":0}";
+    }
+    packet += "],\"digital_mxp\":[";
+    for(int32_t i = 0; i < hel::DigitalSystem::NUM_DIGITAL_MXP_CHANNELS; i++){
+        if(i != 0){
+            packet += ",";
+        }
+        packet += "{\"config\":\"DI\",\"value\":0.0}";
+    }
+    packet += "],\"encoders\":[null,null,null,null,null,null,null,null]}}";
+    return packet;
+}
+
+static std::vector<std::string> fragment(const std::string& stream, std::size_t chunk_size){ //split a stream the way a socket might deliver it
+    std::vector<std::string> chunks;
+    for(std::size_t i = 0; i < stream.size(); i += chunk_size){
+        chunks.push_back(stream.substr(i, chunk_size));
+    }
+    return chunks;
+}
+
+static std::string makeStream(const std::string& packet, const std::string& suffix){
+    std::string stream;
+    for(unsigned i = 0; i < PACKETS_PER_STREAM; i++){
+        stream += packet + suffix;
+    }
+    return stream;
+}
+
+namespace legacy{ //the recursive string splicing reader replaced by FrameReader
+    std::string readJSONPacket(const std::vector<std::string>& chunks, std::size_t& next_chunk, std::string& rest){
+        std::array<char, MTU + 1> data;
+        std::fill(data.begin(), data.end(), '\0');
+        const std::string& chunk = chunks[next_chunk++];
+        std::copy(chunk.begin(), chunk.end(), data.begin());
+        std::string received_data = rest;
+        received_data += std::string(data.begin(), data.begin() + chunk.size());
+        rest = "";
+        const std::string PREAMBLE = "{\"roborio";
+        if(received_data.substr(0, PREAMBLE.length()) != PREAMBLE){
+            if(received_data.find(hel::JSON_PACKET_SUFFIX) == std::string::npos){
+                rest = received_data;
+            } else {
+                rest = received_data.substr(received_data.find(hel::JSON_PACKET_SUFFIX) + 1);
+            }
+            return readJSONPacket(chunks, next_chunk, rest);
+        }
+        std::size_t i = received_data.find(hel::JSON_PACKET_SUFFIX);
+        if(i == std::string::npos){
+            rest = received_data;
+            return readJSONPacket(chunks, next_chunk, rest);
+        }
+        rest = received_data.substr(i + 1);
+        return received_data.substr(0, i);
+    }
+}
+
+static void BM_LegacyJSONReader(benchmark::State& state) {
+    const std::string PACKET = makeDeepJSONPacket();
+    const std::vector<std::string> CHUNKS = fragment(makeStream(PACKET, std::string(1, hel::JSON_PACKET_SUFFIX)), state.range(0));
+    std::size_t bytes = 0;
+    for(auto _ : state){
+        std::size_t next_chunk = 0;
+        std::string rest = "";
+        for(unsigned i = 0; i < PACKETS_PER_STREAM; i++){
+            std::string packet = legacy::readJSONPacket(CHUNKS, next_chunk, rest);
+            benchmark::DoNotOptimize(packet.data());
+            bytes += packet.size();
+        }
+    }
+    state.SetBytesProcessed(bytes);
+    state.counters["packet_bytes"] = PACKET.size();
+}
+
+static void readFrames(benchmark::State& state, hel::WireFormat format, const std::string& packet, const std::string& suffix){
+    const std::vector<std::string> CHUNKS = fragment(makeStream(packet, suffix), state.range(0));
+    hel::FrameReader reader(format);
+    std::size_t bytes = 0;
+    for(auto _ : state){
+        for(const std::string& chunk: CHUNKS){
+            std::pair<char*, std::size_t> space = reader.prepare(MTU);
+            std::copy(chunk.begin(), chunk.end(), space.first); //stands in for the socket read
+            reader.commit(chunk.size());
+            hel::StringView frame;
+            while(reader.next(frame)){
+                benchmark::DoNotOptimize(frame.data());
+                bytes += frame.size();
+            }
+        }
+    }
+    state.SetBytesProcessed(bytes);
+    state.counters["packet_bytes"] = packet.size();
+}
+
+static void BM_FrameReaderJSON(benchmark::State& state) {
+    readFrames(state, hel::WireFormat::JSON, makeDeepJSONPacket(), std::string(1, hel::JSON_PACKET_SUFFIX));
+}
+
+static void BM_FrameReaderBinary(benchmark::State& state) {
+    hel::SendData sender;
+    readFrames(state, hel::WireFormat::BINARY, sender.serializeDeepBinary(), "");
+}
+
+BENCHMARK(BM_LegacyJSONReader)->Arg(64)->Arg(536)->Arg(MTU);
+BENCHMARK(BM_FrameReaderJSON)->Arg(64)->Arg(536)->Arg(MTU);
+BENCHMARK(BM_FrameReaderBinary)->Arg(7)->Arg(64)->Arg(MTU);
+BENCHMARK_MAIN();
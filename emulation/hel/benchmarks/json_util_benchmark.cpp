@@ -28,6 +28,28 @@ static void BM_PullObjectByLabel(benchmark::State& state) {
     std::cout<<"Pulled object: "<<value<<"\n\n";
 }
 
+static void BM_ReadObjectByLabel(benchmark::State& state) {
+    std::cout<<"Input: "<<PULL_VALUE_INPUT<<"\n";
+    hel::StringView value;
+    for(auto _ : state){
+        hel::JSONReader reader(PULL_VALUE_INPUT);
+        hel::StringView label;
+        reader.beginObject();
+        reader.nextField(label); //roborio
+        reader.beginObject();
+        while(reader.nextField(label)){
+            if(label == hel::StringView("joysticks", 9)){
+                value = reader.skipValue();
+                break;
+            }
+            reader.skipValue();
+        }
+        benchmark::DoNotOptimize(value);
+    }
+    std::cout<<"Read object: "<<value.toString()<<"\n\n";
+}
+
 BENCHMARK(BM_PullFirstObject);
 BENCHMARK(BM_PullObjectByLabel);
+BENCHMARK(BM_ReadObjectByLabel);
 BENCHMARK_MAIN();
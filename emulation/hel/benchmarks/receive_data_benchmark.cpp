@@ -1,4 +1,5 @@
 #include <benchmark/benchmark.h>
+#include "binary_util.hpp"
 #include "receive_data.hpp"
 #include <iostream>
 
@@ -19,5 +20,59 @@ static void BM_ReceiveData(benchmark::State& state) {
     instance.second.unlock();
 }
 
+static std::string makeBinaryInput(){ //the same inputs as INPUT1 and INPUT2
+    std::string packet;
+    hel::BinaryWriter writer(packet);
+    std::size_t header_position = writer.beginPacket(hel::BinaryPacketType::SHALLOW);
+    writer.write(static_cast<uint16_t>(0b0010010010)); //the digital headers of INPUT1
+    for(unsigned i = 0; i < hel::Joystick::MAX_JOYSTICK_COUNT; i++){
+        hel::Joystick joystick;
+        joystick.setButtonCount(10);
+        joystick.setAxisCount(12);
+        joystick.setPOVCount(12);
+        joystick.setPOVs(hel::BoundsCheckedArray<int16_t, hel::Joystick::MAX_POV_COUNT>(0));
+        if(i == 0){
+            joystick.setName("Test Gamepad");
+        } else {
+            joystick.setAxes(std::array<int8_t, hel::Joystick::MAX_AXIS_COUNT>{{27,16,4,92,26,57,-25,-97,85,-92,45,-118}});
+        }
+        joystick.serializeBinary(writer);
+    }
+    hel::MatchInfo match_info;
+    match_info.setGameSpecificMessage("LLL");
+    match_info.serializeBinary(writer);
+    hel::RobotMode robot_mode;
+    robot_mode.setFMSAttached(true);
+    robot_mode.serializeBinary(writer);
+    for(unsigned i = 0; i < hel::FPGAEncoder::NUM_ENCODERS; i++){
+        writer.write(false); //no encoder
+    }
+    writer.write(false); //no simulation time
+    writer.endPacket(header_position);
+    return packet;
+}
+
+static void BM_ReceiveDataBinary(benchmark::State& state) {
+    const std::string INPUT = makeBinaryInput();
+    const std::size_t BUTTONS_OFFSET = hel::BINARY_HEADER_SIZE + 3 + std::string("Test Gamepad").size(); //after is_xbox, type, and the length-prefixed name of the first joystick
+    std::cout<<"Input size: "<<INPUT.size()<<" bytes (JSON: "<<(INPUT1.size() + 1 + INPUT2.size())<<" bytes)\n\n";
+    std::string in;
+    auto instance = hel::ReceiveDataManager::getInstance();
+    uint32_t i = 0;
+    for(auto _ : state){
+        in = INPUT;
+        for(unsigned b = 0; b < sizeof(i); b++){ //vary the button states, as the JSON benchmark does
+            in[BUTTONS_OFFSET + b] = static_cast<char>((i >> (8 * b)) & 0xFF);
+        }
+        instance.first->deserializeBinary(in);
+        instance.first->updateShallow();
+        i++;
+    }
+    state.counters["packet_bytes"] = INPUT.size();
+    std::cout<<"Receiver value: "<<instance.first->toString()<<"\n";
+    instance.second.unlock();
+}
+
 BENCHMARK(BM_ReceiveData);
+BENCHMARK(BM_ReceiveDataBinary);
 BENCHMARK_MAIN();
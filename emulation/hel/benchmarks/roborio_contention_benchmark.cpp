@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+#include "roborio_manager.hpp"
+#include <iostream>
+
+using namespace nFPGA;
+using namespace nRoboRIO_FPGANamespace;
+
+/*
+  Each thread plays one of the roles found in a typical robot program (see tests/test_projects/robot_timing.cpp) or in HEL's own background threads:
+  0 - user code writing PWM outputs
+  1 - the Driver Station thread reading joysticks
+  2 - user code reading encoders
+  3 - user code writing digital outputs
+*/
+
+static tPWM* pwm = tPWM::create(nullptr);
+static tDIO* dio = tDIO::create(nullptr);
+static tEncoder* encoder = tEncoder::create(0, nullptr);
+
+static void runRole(int role, unsigned i){
+    switch(role % 4){
+    case 0:
+        pwm->writeHdr(i % hel::PWMSystem::NUM_HDRS, i % 2000, nullptr);
+        break;
+    case 1:
+    {
+        auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::JOYSTICKS);
+        benchmark::DoNotOptimize(instance.first->joysticks[0].getAxes());
+        instance.second.unlock();
+        break;
+    }
+    case 2:
+        benchmark::DoNotOptimize(encoder->readOutput_Value(nullptr));
+        break;
+    case 3:
+        dio->writeDO_Headers(i % 2, nullptr);
+        break;
+    default:
+        break;
+    }
+}
+
+static void BM_PerSubsystemLocking(benchmark::State& state) {
+    hel::hal_is_initialized.store(true);
+    unsigned i = 0;
+    for(auto _ : state){
+        runRole(state.thread_index(), i++);
+    }
+}
+
+static void BM_GlobalLocking(benchmark::State& state) { //emulates the single RoboRIO lock by locking every sub-system around each call
+    hel::hal_is_initialized.store(true);
+    unsigned i = 0;
+    for(auto _ : state){
+        auto instance = hel::RoboRIOManager::getInstance();
+        runRole(state.thread_index(), i++);
+        instance.second.unlock();
+    }
+}
+
+BENCHMARK(BM_PerSubsystemLocking)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_GlobalLocking)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_MAIN();
@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+#include "roborio_manager.hpp"
+#include <iostream>
+
+static void populateRoboRIO(){
+    auto instance = hel::RoboRIOManager::getInstance();
+    for(uint8_t i = 0; i < 12; i++){ //typical number of CAN motor controllers in a drivetrain and mechanisms
+        instance.first->can_motor_controllers.emplace(hel::CANDevice::Type::TALON_SRX, i);
+    }
+    for(unsigned i = 0; i < hel::AnalogInputs::NUM_ANALOG_INPUTS; i++){
+        instance.first->analog_inputs.setValues(i, std::vector<int32_t>(100, 1));
+    }
+    instance.second.unlock();
+}
+
+static void BM_GetCopy(benchmark::State& state) {
+    populateRoboRIO();
+    double sum = 0;
+    for(auto _ : state){
+        hel::RoboRIO roborio = hel::RoboRIOManager::getCopy();
+        sum += roborio.can_motor_controllers.find(hel::CANDevice::Type::TALON_SRX, 0)->getPercentOutput();
+    }
+    std::cout<<"Sum: "<<sum<<"\n";
+}
+
+static void BM_PublishSnapshot(benchmark::State& state) {
+    populateRoboRIO();
+    for(auto _ : state){
+        hel::RoboRIOManager::publishSnapshot();
+    }
+    std::cout<<"Snapshot version: "<<hel::RoboRIOManager::getSnapshotVersion()<<"\n";
+}
+
+static void BM_PublishSubsystemSnapshot(benchmark::State& state) { //what an output setter pays
+    populateRoboRIO();
+    auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::PWM_SYSTEM);
+    for(auto _ : state){
+        hel::RoboRIOManager::publishSnapshot(hel::RoboRIO::Subsystem::PWM_SYSTEM);
+    }
+    instance.second.unlock();
+    std::cout<<"Snapshot version: "<<hel::RoboRIOManager::getSnapshotVersion()<<"\n";
+}
+
+static void BM_PublishAndReadSnapshot(benchmark::State& state) {
+    populateRoboRIO();
+    double sum = 0;
+    for(auto _ : state){
+        hel::RoboRIOManager::publishSnapshot();
+        const hel::RoboRIOSnapshot& snapshot = hel::RoboRIOManager::getSnapshot();
+        sum += snapshot.can_motor_controllers.find(hel::CANDevice::Type::TALON_SRX, 0)->getPercentOutput();
+    }
+    std::cout<<"Sum: "<<sum<<"\n";
+}
+
+static void BM_SendDataUpdateShallow(benchmark::State& state) {
+    populateRoboRIO();
+    hel::hal_is_initialized.store(true);
+    auto instance = hel::SendDataManager::getInstance();
+    for(auto _ : state){
+        hel::RoboRIOManager::publishSnapshot();
+        instance.first->updateShallow();
+    }
+    std::cout<<"Sender value: "<<instance.first->toString()<<"\n";
+    instance.second.unlock();
+}
+
+BENCHMARK(BM_GetCopy);
+BENCHMARK(BM_PublishSnapshot);
+BENCHMARK(BM_PublishSubsystemSnapshot);
+BENCHMARK(BM_PublishAndReadSnapshot);
+BENCHMARK(BM_SendDataUpdateShallow);
+BENCHMARK_MAIN();
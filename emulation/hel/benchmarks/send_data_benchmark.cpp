@@ -1,6 +1,29 @@
 #include <benchmark/benchmark.h>
+#include "roborio_manager.hpp"
 #include "send_data.hpp"
+#include <atomic>
+#include <cstdlib>
 #include <iostream>
+#include <new>
+#include <thread>
+
+static std::atomic<std::size_t> allocation_count{0};
+
+void* operator new(std::size_t size){ //count every heap allocation so benchmarks can report allocations per packet
+    allocation_count++;
+    if(void* p = std::malloc(size == 0 ? 1 : size)){
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p)noexcept{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t)noexcept{
+    std::free(p);
+}
 
 static void BM_SendData(benchmark::State& state) {
     for(auto _ : state){
@@ -12,5 +35,96 @@ static void BM_SendData(benchmark::State& state) {
     }
 }
 
+static void serializeOutputs(benchmark::State& state, const std::string& (hel::SendData::*serialize)()) {
+    {
+        auto instance = hel::RoboRIOManager::getInstance();
+        for(uint8_t i = 0; i < 12; i++){ //typical number of CAN motor controllers in a drivetrain and mechanisms
+            instance.first->can_motor_controllers.emplace(hel::CANDevice::Type::TALON_SRX, i);
+        }
+        for(unsigned i = 0; i < hel::PWMSystem::NUM_HDRS; i++){
+            instance.first->pwm_system.setHdrPulseWidth(i, 1000 + i);
+        }
+        instance.second.unlock();
+        hel::RoboRIOManager::publishSnapshot();
+    }
+    hel::hal_is_initialized.store(true);
+    auto instance = hel::SendDataManager::getInstance();
+    instance.first->enable(true);
+    std::size_t packet_size = 0;
+    std::size_t allocations = 0;
+    unsigned i = 0;
+    ((*instance.first).*serialize)(); //grow the serialization buffer before measuring steady state
+    for(auto _ : state){
+        { //a typical frame changes one drivetrain output and leaves the rest constant
+            auto roborio = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::PWM_SYSTEM);
+            roborio.first->pwm_system.setHdrPulseWidth(0, 1000 + (i++ % 1000));
+        }
+        instance.first->updateShallow();
+        const std::size_t ALLOCATIONS_BEFORE = allocation_count;
+        packet_size = ((*instance.first).*serialize)().size();
+        allocations += allocation_count - ALLOCATIONS_BEFORE;
+    }
+    state.counters["packet_bytes"] = packet_size;
+    state.counters["allocations_per_packet"] = benchmark::Counter(allocations, benchmark::Counter::kAvgIterations);
+    instance.second.unlock();
+}
+
+static void BM_SerializeShallowJSON(benchmark::State& state) {
+    serializeOutputs(state, &hel::SendData::serializeShallow);
+}
+
+static void BM_SerializeShallowBinary(benchmark::State& state) {
+    serializeOutputs(state, &hel::SendData::serializeShallowBinary);
+}
+
+static void BM_SerializeDeepJSON(benchmark::State& state) {
+    serializeOutputs(state, &hel::SendData::serializeDeep);
+}
+
+static void BM_SerializeDeepBinary(benchmark::State& state) {
+    serializeOutputs(state, &hel::SendData::serializeDeepBinary);
+}
+
+static void BM_SerializeShallowDelta(benchmark::State& state) {
+    serializeOutputs(state, &hel::SendData::serializeShallowDelta);
+}
+
+static void BM_SerializeDeepDelta(benchmark::State& state) {
+    serializeOutputs(state, &hel::SendData::serializeDeepDelta);
+}
+
+static void BM_NewDataWakeupLatency(benchmark::State& state) { //time from an output changing to the transmitter thread serializing it
+    hel::hal_is_initialized.store(true);
+    std::atomic<bool> running{true};
+    std::atomic<unsigned> packets{0};
+    std::thread transmitter([&](){
+        while(running){
+            auto instance = hel::SendDataManager::getInstance();
+            if(hel::SendDataManager::waitForNewData(instance.second, std::chrono::milliseconds(10))){
+                instance.first->serializeShallow();
+                packets++;
+            }
+        }
+    });
+    unsigned i = 0;
+    for(auto _ : state){
+        const unsigned TARGET = packets + 1;
+        {
+            auto roborio = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::PWM_SYSTEM);
+            roborio.first->pwm_system.setHdrPulseWidth(0, 1000 + (i++ % 1000));
+        }
+        while(packets < TARGET){}
+    }
+    running = false;
+    transmitter.join();
+}
+
 BENCHMARK(BM_SendData);
+BENCHMARK(BM_SerializeShallowJSON);
+BENCHMARK(BM_SerializeShallowBinary);
+BENCHMARK(BM_SerializeDeepJSON);
+BENCHMARK(BM_SerializeDeepBinary);
+BENCHMARK(BM_SerializeShallowDelta);
+BENCHMARK(BM_SerializeDeepDelta);
+BENCHMARK(BM_NewDataWakeupLatency)->UseRealTime();
 BENCHMARK_MAIN();
@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+#include <asio.hpp>
+#include "shm_transport.hpp"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+constexpr std::size_t PACKET_SIZE = 600; //about the size of a shallow binary input packet
+
+static void BM_ShmRoundTrip(benchmark::State& state) { //engine writes inputs, HEL echoes them back as outputs
+    const std::string SUFFIX = std::to_string(getpid());
+    hel::ShmRing inputs = hel::ShmRing::create("/hel_bench_inputs_" + SUFFIX);
+    hel::ShmRing outputs = hel::ShmRing::create("/hel_bench_outputs_" + SUFFIX);
+    std::atomic<bool> running{true};
+    std::thread hel_side([&](){
+        hel::ShmRing received = hel::ShmRing::open(inputs.getName());
+        hel::ShmRing sent = hel::ShmRing::open(outputs.getName());
+        std::string packet;
+        while(running){
+            if(received.waitForData(std::chrono::milliseconds(10)) && received.readLatest(packet)){
+                while(!sent.tryWrite(packet)){}
+            }
+        }
+    });
+    const std::string PACKET(PACKET_SIZE, 'x');
+    std::string reply;
+    for(auto _ : state){
+        inputs.tryWrite(PACKET);
+        while(!outputs.waitForData(std::chrono::seconds(1))){}
+        outputs.readLatest(reply);
+    }
+    running = false;
+    hel_side.join();
+}
+
+static void BM_LoopbackTCPRoundTrip(benchmark::State& state) { //the same exchange over the loopback sockets the engine uses by default
+    asio::io_context io;
+    asio::ip::tcp::acceptor acceptor(io, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+    const unsigned short PORT = acceptor.local_endpoint().port();
+    std::thread hel_side([&](){
+        asio::ip::tcp::socket socket(io);
+        acceptor.accept(socket);
+        socket.set_option(asio::ip::tcp::no_delay(true));
+        std::string packet(PACKET_SIZE, '\0');
+        asio::error_code ec;
+        while(asio::read(socket, asio::buffer(&packet[0], packet.size()), ec) && !ec){
+            asio::write(socket, asio::buffer(packet), ec);
+        }
+    });
+    asio::ip::tcp::socket socket(io);
+    socket.connect(asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), PORT));
+    socket.set_option(asio::ip::tcp::no_delay(true));
+    const std::string PACKET(PACKET_SIZE, 'x');
+    std::string reply(PACKET_SIZE, '\0');
+    for(auto _ : state){
+        asio::write(socket, asio::buffer(PACKET));
+        asio::read(socket, asio::buffer(&reply[0], reply.size()));
+    }
+    socket.close();
+    hel_side.join();
+}
+
+BENCHMARK(BM_ShmRoundTrip)->UseRealTime();
+BENCHMARK(BM_LoopbackTCPRoundTrip)->UseRealTime();
+BENCHMARK_MAIN();
@@ -0,0 +1,281 @@
+#include <benchmark/benchmark.h>
+#include "FRC_NetworkCommunication/CANSessionMux.h"
+#include "FRC_NetworkCommunication/FRCComm.h"
+#include "json_util.hpp"
+#include "roborio_manager.hpp"
+#include "sync_client.hpp"
+#include "sync_server.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <sys/socket.h>
+#include <thread>
+
+using namespace nFPGA;
+using namespace nRoboRIO_FPGANamespace;
+
+/*
+  One benchmark per emulated FPGA subsystem, each making the calls HAL makes for it. Every benchmark runs with 1, 2, 4 and 8 threads calling concurrently, then again as .../engine while a stand-in engine streams JSON inputs to the SyncClient and reads outputs from the SyncServer.
+  Threads use different channels where the subsystem has them, so they contend only on the subsystem's lock as separate robot code threads would.
+  scripts/run_benchmarks.sh records the results as JSON for comparison between commits. Record both runs on the same multi-core host; on a single core the threaded rows measure time slicing rather than contention.
+*/
+
+constexpr int MAX_THREADS = 8;
+constexpr std::chrono::milliseconds ENGINE_PERIOD{1}; //well above the engine's real rate, to load the sync threads
+
+static tAccumulator* accumulator = tAccumulator::create(0, nullptr);
+static tAI* analog_input = tAI::create(nullptr);
+static tAO* analog_output = tAO::create(nullptr);
+static tAlarm* alarm_manager = tAlarm::create(nullptr);
+static tCounter* counter = tCounter::create(0, nullptr);
+static tDIO* dio = tDIO::create(nullptr);
+static tEncoder* encoder = tEncoder::create(0, nullptr);
+static tPWM* pwm = tPWM::create(nullptr);
+static tRelay* relay = tRelay::create(nullptr);
+static tSPI* spi = tSPI::create(nullptr);
+
+constexpr uint32_t TALON_MESSAGE_ID = 0x02040001; //a Talon SRX with ID 1
+
+/**
+ * \brief Stands in for the engine, streaming inputs to HEL and discarding its outputs
+ */
+
+class EngineLoad{
+    asio::io_context hel_io;
+    std::thread hel_thread;
+
+    asio::io_context engine_io;
+    asio::ip::tcp::socket input_socket;
+    asio::ip::tcp::socket output_socket;
+    std::atomic<bool> running;
+    std::thread writer;
+    std::thread reader;
+
+public:
+    void start(){
+        if(!hel_thread.joinable()){ //HEL's sync threads outlive each run, as they do in a robot program
+            hel_thread = std::thread([this](){
+                hel::SyncServer server(hel_io);
+                hel::SyncClient client(hel_io);
+                hel_io.run();
+            });
+        }
+        const asio::ip::address LOCALHOST = asio::ip::make_address("127.0.0.1");
+        for(unsigned attempt = 0;; attempt++){ //the sync threads may still be starting to listen
+            try{
+                input_socket.connect(asio::ip::tcp::endpoint(LOCALHOST, RECEIVE_PORT));
+                output_socket.connect(asio::ip::tcp::endpoint(LOCALHOST, SEND_PORT));
+                break;
+            } catch(const std::exception&){
+                input_socket.close();
+                output_socket.close();
+                if(attempt == 100){
+                    throw;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+        running = true;
+        writer = std::thread([this](){
+            const std::string PACKET = hel::ReceiveData::defaultPacket() + hel::JSON_PACKET_SUFFIX;
+            asio::error_code ec;
+            while(running && !ec){
+                asio::write(input_socket, asio::buffer(PACKET), ec);
+                std::this_thread::sleep_for(ENGINE_PERIOD);
+            }
+        });
+        reader = std::thread([this](){
+            std::array<char, 4096> buffer;
+            asio::error_code ec;
+            while(running && !ec){
+                output_socket.read_some(asio::buffer(buffer), ec);
+            }
+        });
+    }
+
+    void stop(){
+        running = false;
+        ::shutdown(output_socket.native_handle(), SHUT_RDWR); //wake the blocked reader
+        writer.join();
+        reader.join();
+        input_socket.close();
+        output_socket.close();
+    }
+
+    EngineLoad():input_socket(engine_io), output_socket(engine_io), running(false){}
+
+    ~EngineLoad(){
+        hel_io.stop();
+        if(hel_thread.joinable()){
+            hel_thread.join();
+        }
+    }
+};
+
+static EngineLoad engine_load;
+
+static void startEngine(const benchmark::State&){
+    hel::hal_is_initialized.store(true);
+    engine_load.start();
+}
+
+static void stopEngine(const benchmark::State&){
+    engine_load.stop();
+}
+
+static std::streambuf* cerr_buffer = nullptr;
+
+static void silenceWarnings(const benchmark::State&){ //drop warnings without the cost of a terminal
+    cerr_buffer = std::cerr.rdbuf(nullptr);
+}
+
+static void restoreWarnings(const benchmark::State&){
+    std::cerr.rdbuf(cerr_buffer);
+    std::cerr.clear();
+}
+
+static void startEngineSilenced(const benchmark::State& state){
+    startEngine(state);
+    silenceWarnings(state);
+}
+
+static void stopEngineSilenced(const benchmark::State& state){
+    restoreWarnings(state);
+    stopEngine(state);
+}
+
+static void BM_PWM(benchmark::State& state){
+    hel::hal_is_initialized.store(true);
+    const uint8_t CHANNEL = state.thread_index() % hel::PWMSystem::NUM_HDRS;
+    uint16_t i = 0;
+    for(auto _: state){
+        pwm->writeHdr(CHANNEL, i++ % 2000, nullptr);
+        benchmark::DoNotOptimize(pwm->readHdr(CHANNEL, nullptr));
+    }
+}
+
+static void BM_DIO(benchmark::State& state){
+    hel::hal_is_initialized.store(true);
+    dio->writeOutputEnable_Headers((1u << hel::DigitalSystem::NUM_DIGITAL_HEADERS) - 1, nullptr); //HAL enables a header for output before writing it
+    const uint16_t MASK = 1u << (state.thread_index() % hel::DigitalSystem::NUM_DIGITAL_HEADERS);
+    uint16_t i = 0;
+    for(auto _: state){
+        dio->writeDO_Headers((i++ % 2) ? MASK : 0, nullptr);
+        benchmark::DoNotOptimize(dio->readDI_Headers(nullptr));
+    }
+}
+
+static void BM_Relay(benchmark::State& state){
+    hel::hal_is_initialized.store(true);
+    uint8_t i = 0;
+    for(auto _: state){
+        relay->writeValue_Forward(i++, nullptr);
+        benchmark::DoNotOptimize(relay->readValue_Forward(nullptr));
+    }
+}
+
+static void BM_AnalogInput(benchmark::State& state){
+    for(auto _: state){
+        benchmark::DoNotOptimize(analog_input->readOutput(nullptr));
+    }
+}
+
+static void BM_AnalogOutput(benchmark::State& state){
+    hel::hal_is_initialized.store(true);
+    const uint8_t CHANNEL = state.thread_index() % hel::AnalogOutputs::NUM_ANALOG_OUTPUTS;
+    uint16_t i = 0;
+    for(auto _: state){
+        analog_output->writeMXP(CHANNEL, i++ % 4096, nullptr);
+        benchmark::DoNotOptimize(analog_output->readMXP(CHANNEL, nullptr));
+    }
+}
+
+static void BM_Accumulator(benchmark::State& state){
+    for(auto _: state){
+        benchmark::DoNotOptimize(accumulator->readOutput_Value(nullptr));
+        benchmark::DoNotOptimize(accumulator->readOutput_Count(nullptr));
+    }
+}
+
+static void BM_Counter(benchmark::State& state){
+    for(auto _: state){
+        benchmark::DoNotOptimize(counter->readOutput_Value(nullptr));
+    }
+}
+
+static void BM_FPGAEncoder(benchmark::State& state){
+    for(auto _: state){
+        benchmark::DoNotOptimize(encoder->readOutput_Value(nullptr));
+    }
+}
+
+static void BM_Alarm(benchmark::State& state){
+    uint32_t i = 0;
+    for(auto _: state){
+        alarm_manager->writeTriggerTime(i++, nullptr);
+        benchmark::DoNotOptimize(alarm_manager->readEnable(nullptr));
+    }
+}
+
+static void BM_SPI(benchmark::State& state){
+    uint32_t i = 0;
+    for(auto _: state){
+        spi->writeAutoRate(i++, nullptr);
+        benchmark::DoNotOptimize(spi->readAutoRate(nullptr));
+    }
+}
+
+static void BM_CANSend(benchmark::State& state){
+    hel::hal_is_initialized.store(true);
+    std::array<uint8_t, hel::CANMotorController::MessageData::SIZE> data{};
+    data[hel::CANMotorController::MessageData::COMMAND_BYTE] = 1u << hel::CANMotorController::SendCommandByteMask::SET_POWER_PERCENT;
+    const uint32_t MESSAGE_ID = TALON_MESSAGE_ID + state.thread_index();
+    for(auto _: state){
+        FRC_NetworkCommunication_CANSessionMux_sendMessage(MESSAGE_ID, data.data(), data.size(), 0, nullptr);
+    }
+}
+
+static void BM_CANReceive(benchmark::State& state){ //reads are unsupported, so this measures reporting the deduplicated warning
+    std::array<uint8_t, hel::CANMotorController::MessageData::SIZE> data{};
+    uint8_t size = 0;
+    uint32_t timestamp = 0;
+    for(auto _: state){
+        uint32_t message_id = TALON_MESSAGE_ID;
+        FRC_NetworkCommunication_CANSessionMux_receiveMessage(&message_id, 0, data.data(), &size, &timestamp, nullptr);
+    }
+}
+
+static void BM_JoystickRead(benchmark::State& state){
+    const uint8_t JOYSTICK = state.thread_index() % hel::Joystick::MAX_JOYSTICK_COUNT;
+    struct{ //JoystickAxes_t declares one axis, so size it for every axis as HAL does
+        uint16_t count;
+        int16_t axes[hel::Joystick::MAX_AXIS_COUNT];
+    } axes;
+    uint32_t buttons;
+    uint8_t count;
+    for(auto _: state){
+        benchmark::DoNotOptimize(FRC_NetworkCommunication_getJoystickAxes(JOYSTICK, reinterpret_cast<JoystickAxes_t*>(&axes), hel::Joystick::MAX_AXIS_COUNT));
+        benchmark::DoNotOptimize(FRC_NetworkCommunication_getJoystickButtons(JOYSTICK, &buttons, &count));
+    }
+}
+
+#define SUBSYSTEM_BENCHMARK(FUNCTION) \
+    BENCHMARK(FUNCTION)->ThreadRange(1, MAX_THREADS)->UseRealTime(); \
+    BENCHMARK(FUNCTION)->Name(#FUNCTION "/engine")->ThreadRange(1, MAX_THREADS)->UseRealTime()->Setup(startEngine)->Teardown(stopEngine)
+
+SUBSYSTEM_BENCHMARK(BM_PWM);
+SUBSYSTEM_BENCHMARK(BM_DIO);
+SUBSYSTEM_BENCHMARK(BM_Relay);
+SUBSYSTEM_BENCHMARK(BM_AnalogInput);
+SUBSYSTEM_BENCHMARK(BM_AnalogOutput);
+SUBSYSTEM_BENCHMARK(BM_Accumulator);
+SUBSYSTEM_BENCHMARK(BM_Counter);
+SUBSYSTEM_BENCHMARK(BM_FPGAEncoder);
+SUBSYSTEM_BENCHMARK(BM_Alarm);
+SUBSYSTEM_BENCHMARK(BM_SPI);
+SUBSYSTEM_BENCHMARK(BM_CANSend);
+BENCHMARK(BM_CANReceive)->ThreadRange(1, MAX_THREADS)->UseRealTime()->Setup(silenceWarnings)->Teardown(restoreWarnings);
+BENCHMARK(BM_CANReceive)->Name("BM_CANReceive/engine")->ThreadRange(1, MAX_THREADS)->UseRealTime()->Setup(startEngineSilenced)->Teardown(stopEngineSilenced);
+SUBSYSTEM_BENCHMARK(BM_JoystickRead);
+
+BENCHMARK_MAIN();
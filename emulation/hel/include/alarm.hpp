@@ -8,6 +8,7 @@ namespace hel{
 
     /**
      * \brief Data model for a time-based trigger/alarm
+     * When enabled, the alarm asserts its interrupt once FPGA time passes the trigger time, then disables itself. AlarmScheduler does the waiting.
      */
 
     struct Alarm{
@@ -55,6 +56,16 @@ namespace hel{
 
         void setTriggerTime(uint32_t)noexcept;
 
+        /**
+         * \brief Get when the alarm triggers
+         * The FPGA compares the trigger time to the low 32 bits of its time, so the alarm triggers once that time passes it. A trigger time up to half the 32-bit range in the past is treated as already passed rather than waiting for the time to wrap.
+         * \param fpga_start_time The clock time when the FPGA started, in microseconds
+         * \param now The current clock time, in microseconds
+         * \return The clock time the alarm triggers at, in microseconds
+         */
+
+        uint64_t getDeadline(uint64_t, uint64_t)const noexcept;
+
         /**
          * Constructor for an Alarm
          */
@@ -0,0 +1,127 @@
+#ifndef _ALARM_SCHEDULER_HPP_
+#define _ALARM_SCHEDULER_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace hel{
+    class RobotInstance;
+
+    /**
+     * \brief Triggers a robot instance's FPGA alarm at its deadline
+     * A single timer thread sleeps on its instance's SimClock until the armed deadline, so it follows the engine's time in lockstep mode and the host clock otherwise. At the deadline it disables the alarm and asserts the alarm interrupt, which wakes HAL's notifiers. The thread starts when the alarm is first armed.
+     */
+
+    class AlarmScheduler{
+    public:
+        /**
+         * \brief Arm the alarm, replacing any deadline armed before
+         * \param deadline The clock time to trigger at, in microseconds
+         */
+
+        void arm(uint64_t);
+
+        /**
+         * \brief Disarm the alarm so it does not trigger
+         */
+
+        void disarm();
+
+        /**
+         * \brief Check if the alarm is armed
+         * \return True if the alarm will trigger
+         */
+
+        bool isArmed();
+
+        /**
+         * Constructor for AlarmScheduler
+         * \param robot The instance whose alarm this triggers
+         */
+
+        explicit AlarmScheduler(RobotInstance&)noexcept;
+
+        AlarmScheduler(const AlarmScheduler&) = delete;
+
+        AlarmScheduler& operator=(const AlarmScheduler&) = delete;
+
+        /**
+         * Deconstructor for AlarmScheduler
+         */
+
+        ~AlarmScheduler();
+
+    private:
+        /**
+         * \brief The instance whose alarm this triggers
+         */
+
+        RobotInstance& robot;
+
+        /**
+         * \brief The mutex guarding the scheduler's state
+         */
+
+        std::mutex mutex;
+
+        /**
+         * \brief Notified when the alarm is armed or the scheduler stops
+         */
+
+        std::condition_variable changed;
+
+        /**
+         * \brief Whether the alarm will trigger
+         */
+
+        bool armed;
+
+        /**
+         * \brief The clock time the alarm triggers at, in microseconds
+         */
+
+        uint64_t deadline;
+
+        /**
+         * \brief Incremented by every change, so the timer thread can tell its wait is stale
+         */
+
+        std::atomic<uint64_t> generation;
+
+        /**
+         * \brief Whether the timer thread should exit
+         */
+
+        bool stopping;
+
+        /**
+         * \brief The timer thread
+         */
+
+        std::thread timer_thread;
+
+        /**
+         * \brief Wait for deadlines and trigger the alarm at each, until stopped
+         */
+
+        void run();
+
+        /**
+         * \brief Trigger the alarm, unless it was changed since the deadline was waited for
+         * \param generation The generation the deadline was armed in
+         */
+
+        void trigger(uint64_t);
+
+        /**
+         * \brief Wake the timer thread's wait on its instance's clock so it sees a change
+         */
+
+        void wakeTimer();
+    };
+}
+
+#endif
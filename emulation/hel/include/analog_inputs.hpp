@@ -4,6 +4,7 @@
 #include "FRC_FPGA_ChipObject/RoboRIO_FRC_ChipObject_Aliases.h"
 #include "FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tAI.h"
 
+#include <array>
 #include <vector>
 #include "bounds_checked_array.hpp"
 
@@ -50,6 +51,13 @@ namespace hel{
 
         static constexpr int32_t OFFSET = 0;
 
+        /**
+         * \brief The most samples an averaged read covers, as a power of two
+         * Larger average and oversample bit settings are clamped to it
+         */
+
+        static constexpr uint8_t MAX_SAMPLE_BITS = 7;
+
         /**
          * \brief Data model for individual analog input
          * Holds all internal data for a single analog input.
@@ -74,10 +82,38 @@ namespace hel{
             uint8_t scan_list;
 
             /**
-             * \brief The history of analog input values
+             * \brief The number of running sums kept, enough to cover the largest averaged read
+             */
+
+            static constexpr unsigned SAMPLE_CAPACITY = 1u << (MAX_SAMPLE_BITS + 1);
+
+            /**
+             * \brief A ring of running sums, where the entry for sample n is the sum of every sample up to and including it
+             * The sum of any recent window of samples is the difference of two entries, so averaged reads take constant time whatever their size
+             */
+
+            std::array<int64_t, SAMPLE_CAPACITY> sums;
+
+            /**
+             * \brief The number of samples added since the history was last cleared
              */
 
-            std::vector<int32_t> values;
+            uint64_t sample_count;
+
+            /**
+             * \brief Add a sample to the history
+             * \param value The sample
+             */
+
+            void push(int32_t)noexcept;
+
+            /**
+             * \brief Get the sum of the most recent samples
+             * \param count The number of samples, at most SAMPLE_CAPACITY - 1 and at most the samples added
+             * \return The sum
+             */
+
+            int64_t sumRecent(unsigned)const noexcept;
 
             /**
              * Constructor for AnalogInput
@@ -157,7 +193,32 @@ namespace hel{
          * \param value A vector history of 32-bit integers representing the value of the input.
          */
 
-        void setValues(uint8_t, std::vector<int32_t>);
+        void setValues(uint8_t, const std::vector<int32_t>&);
+
+        /**
+         * \brief Add a sample to the history of analog input values.
+         * \param channel A byte representing the hardware channel of the desired analog input.
+         * \param value The newest value of the input.
+         */
+
+        void pushValue(uint8_t, int32_t);
+
+        /**
+         * \brief Get the newest analog input value.
+         * \param channel A byte representing the hardware channel of the desired analog input.
+         * \return The newest value, or zero if there is no history.
+         */
+
+        int32_t getLatestValue(uint8_t);
+
+        /**
+         * \brief Get the average of the 2**(average_bits + oversample_bits) newest analog input values.
+         * Fewer values are averaged if the history is shorter.
+         * \param channel A byte representing the hardware channel of the desired analog input.
+         * \return The average, or zero if there is no history.
+         */
+
+        int32_t getAveragedValue(uint8_t);
 
         /**
          * \brief Get current analog input configuration.
@@ -189,7 +250,7 @@ namespace hel{
         /**
          * \brief Get the recent history of analog input values.
          * \param channel A byte representing the hardware channel of the desired analog input.
-         * \return A vector of 32-bit integer representing the recent history of the analog input value for analog input \b channel.
+         * \return A vector of 32-bit integer representing the recent history of the analog input value for analog input \b channel, holding at most AnalogInput::SAMPLE_CAPACITY - 1 values.
          */
 
         std::vector<int32_t> getValues(uint8_t);
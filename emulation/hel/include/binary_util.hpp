@@ -0,0 +1,317 @@
+#ifndef _BINARY_UTIL_HPP_
+#define _BINARY_UTIL_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace hel{
+    /**
+     * \brief Marker at the start of every binary packet
+     * This is "HELB" as little-endian bytes, which can never begin a JSON packet
+     */
+
+    constexpr uint32_t BINARY_PACKET_MAGIC = 0x424C4548;
+
+    /**
+     * \brief The binary schema version implemented by HEL
+     * Increment this whenever the layout of any binary record changes
+     */
+
+    constexpr uint16_t BINARY_SCHEMA_VERSION = 4;
+
+    /**
+     * \brief The size in bytes of a binary packet header
+     * Each header holds the magic (4 bytes), schema version (2 bytes), packet type (1 byte), and payload length (4 bytes)
+     */
+
+    constexpr std::size_t BINARY_HEADER_SIZE = 11;
+
+    /**
+     * \brief The types of binary packets
+     */
+
+    enum class BinaryPacketType: uint8_t{
+        SHALLOW,
+        DEEP,
+        HANDSHAKE,
+        DELTA,
+        BATCH
+    };
+
+    /**
+     * \brief The formats HEL can use to communicate with Synthesis's engine
+     */
+
+    enum class WireFormat{
+        JSON,
+        BINARY
+    };
+
+    /**
+     * \brief Format a wire format as a string
+     * \param format The wire format to convert
+     * \return The wire format as a string
+     */
+
+    std::string asString(WireFormat);
+
+    /**
+     * \brief An exception representing when parsing failed due to a truncated or malformed binary packet
+     */
+
+    struct BinaryParsingException: std::exception{
+    private:
+        /**
+         * \brief The exception message
+         */
+
+        std::string message;
+
+    public:
+        /**
+         * \brief Returns the exception message
+         */
+
+        const char* what()const throw();
+
+        /**
+         * Constructor for BinaryParsingException
+         * \param det The details of the parsing exception
+         */
+
+        BinaryParsingException(std::string);
+    };
+
+    namespace detail{
+        /**
+         * \brief The unsigned integer type with the same size as an integral or enum type
+         * \tparam T The integral or enum type
+         */
+
+        template<typename T, bool = std::is_enum<T>::value>
+        struct BinaryBits{
+            using type = typename std::make_unsigned<T>::type;
+        };
+
+        template<typename T>
+        struct BinaryBits<T, true>{
+            using type = typename std::make_unsigned<typename std::underlying_type<T>::type>::type;
+        };
+    }
+
+    /**
+     * \brief Appends fixed-layout little-endian records to a string
+     */
+
+    struct BinaryWriter{
+    private:
+        /**
+         * \brief The string being written to
+         */
+
+        std::string& output;
+
+    public:
+        /**
+         * \brief Append an integral value
+         * \tparam T The integral type to write
+         * \param value The value to write
+         */
+
+        template<typename T>
+        void write(T value){
+            static_assert(std::is_integral<T>::value || std::is_enum<T>::value, "BinaryWriter::write only accepts integral and enum types");
+            using U = typename detail::BinaryBits<T>::type;
+            U bits = static_cast<U>(value);
+            for(unsigned i = 0; i < sizeof(U); i++){
+                output.push_back(static_cast<char>((bits >> (8 * i)) & 0xFF));
+            }
+        }
+
+        /**
+         * \brief Append a boolean as a single byte
+         * \param value The value to write
+         */
+
+        void write(bool);
+
+        /**
+         * \brief Append a 32-bit IEEE 754 floating point number
+         * \param value The value to write
+         */
+
+        void write(float);
+
+        /**
+         * \brief Append a 64-bit IEEE 754 floating point number
+         * \param value The value to write
+         */
+
+        void write(double);
+
+        /**
+         * \brief Append a string prefixed by its length as one byte
+         * Strings longer than 255 bytes are truncated
+         * \param value The value to write
+         */
+
+        void write(const std::string&);
+
+        /**
+         * \brief Start a packet by appending its header with a placeholder payload length
+         * \param type The type of packet to write
+         * \return The position of the header in the output
+         */
+
+        std::size_t beginPacket(BinaryPacketType);
+
+        /**
+         * \brief Finish a packet by filling in its payload length
+         * \param header_position The position returned by beginPacket
+         */
+
+        void endPacket(std::size_t);
+
+        /**
+         * Constructor for BinaryWriter
+         * \param out The string to append to
+         */
+
+        explicit BinaryWriter(std::string&)noexcept;
+    };
+
+    /**
+     * \brief Reads fixed-layout little-endian records from a buffer
+     * Reading past the end of the buffer throws a BinaryParsingException
+     */
+
+    struct BinaryReader{
+    private:
+        /**
+         * \brief The next byte to read
+         */
+
+        const char* position;
+
+        /**
+         * \brief One past the last readable byte
+         */
+
+        const char* end;
+
+        /**
+         * \brief Throw if fewer than the given number of bytes remain
+         * \param size The number of bytes about to be read
+         */
+
+        void require(std::size_t)const;
+
+    public:
+        /**
+         * \brief Read an integral value
+         * \tparam T The integral type to read
+         * \return The value read
+         */
+
+        template<typename T>
+        T read(){
+            static_assert(std::is_integral<T>::value || std::is_enum<T>::value, "BinaryReader::read only accepts integral and enum types");
+            using U = typename detail::BinaryBits<T>::type;
+            require(sizeof(U));
+            U bits = 0;
+            for(unsigned i = 0; i < sizeof(U); i++){
+                bits |= static_cast<U>(static_cast<U>(static_cast<uint8_t>(position[i])) << (8 * i));
+            }
+            position += sizeof(U);
+            return static_cast<T>(bits);
+        }
+
+        /**
+         * \brief Read a single byte boolean
+         * \return The value read
+         */
+
+        bool readBool();
+
+        /**
+         * \brief Read a 32-bit IEEE 754 floating point number
+         * \return The value read
+         */
+
+        float readFloat();
+
+        /**
+         * \brief Read a 64-bit IEEE 754 floating point number
+         * \return The value read
+         */
+
+        double readDouble();
+
+        /**
+         * \brief Read a string prefixed by its length as one byte
+         * \return The value read
+         */
+
+        std::string readString();
+
+        /**
+         * \brief Get the number of unread bytes
+         * \return The number of bytes remaining
+         */
+
+        std::size_t remaining()const noexcept;
+
+        /**
+         * Constructor for BinaryReader
+         * \param data The start of the buffer to read
+         * \param size The length of the buffer
+         */
+
+        BinaryReader(const char*, std::size_t)noexcept;
+    };
+
+    /**
+     * \brief The fields of a binary packet header
+     */
+
+    struct BinaryHeader{
+        /**
+         * \brief The schema version the packet was written with
+         */
+
+        uint16_t version;
+
+        /**
+         * \brief The type of the packet
+         */
+
+        BinaryPacketType type;
+
+        /**
+         * \brief The length of the payload following the header
+         */
+
+        uint32_t payload_length;
+    };
+
+    /**
+     * \brief Check if a buffer begins with the binary packet magic
+     * \param data The buffer to check
+     * \param size The length of the buffer
+     * \return True if the buffer begins a binary packet
+     */
+
+    bool isBinaryPacket(const char*, std::size_t)noexcept;
+
+    /**
+     * \brief Parse a binary packet header
+     * \param reader The reader positioned at the start of the header
+     * \return The parsed header
+     */
+
+    BinaryHeader readBinaryHeader(BinaryReader&);
+}
+
+#endif
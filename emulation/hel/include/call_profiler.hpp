@@ -0,0 +1,275 @@
+#ifndef _CALL_PROFILER_HPP_
+#define _CALL_PROFILER_HPP_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace hel{
+
+    /**
+     * \brief Latency statistics for the entry points HAL calls into HEL
+     * Each call records its total duration and the part of it spent waiting for RoboRIO, SendData, or ReceiveData locks. Threads record into their own counters so recording never contends; reports merge every thread's counters on demand.
+     * Entry points are only instrumented when HEL is built with HEL_PROFILING defined; see HEL_PROFILE_CALL.
+     */
+
+    class CallProfiler{
+    public:
+        /**
+         * \brief A log-linear histogram of durations in nanoseconds
+         * Each power of two is split into SUB_BUCKETS linear buckets, so a reported percentile is never more than 1/SUB_BUCKETS above the true value
+         */
+
+        class Histogram{
+        public:
+            static constexpr unsigned SUB_BUCKET_BITS = 3;
+
+            static constexpr unsigned SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+
+            static constexpr unsigned NUM_BUCKETS = (65 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+            /**
+             * \brief Get the bucket a duration falls in
+             * \param nanoseconds The duration
+             * \return The bucket index
+             */
+
+            static unsigned bucketOf(uint64_t)noexcept;
+
+            /**
+             * \brief Get the largest duration that falls in a bucket
+             * \param bucket The bucket index
+             * \return The duration in nanoseconds
+             */
+
+            static uint64_t bucketUpperBound(unsigned)noexcept;
+
+            /**
+             * \brief Record a duration
+             * \param nanoseconds The duration
+             */
+
+            void record(uint64_t)noexcept;
+
+            /**
+             * \brief Add another histogram's samples to this one
+             * \param other The histogram to merge in
+             */
+
+            void merge(const Histogram&)noexcept;
+
+            /**
+             * \brief Estimate a percentile
+             * \param fraction The percentile as a fraction between 0 and 1
+             * \return The duration in nanoseconds at or below which the fraction of samples fall, or 0 if there are no samples
+             */
+
+            uint64_t percentile(double)const noexcept;
+
+            /**
+             * \brief Get the mean duration
+             * \return The mean in nanoseconds, or 0 if there are no samples
+             */
+
+            double mean()const noexcept;
+
+            std::array<uint64_t, NUM_BUCKETS> buckets;
+
+            uint64_t count;
+
+            uint64_t sum;
+
+            uint64_t max;
+
+            Histogram()noexcept;
+        };
+
+        /**
+         * \brief The statistics of one entry point, merged across threads
+         */
+
+        struct CallStats{
+            /**
+             * \brief The entry point's qualified name
+             */
+
+            std::string name;
+
+            /**
+             * \brief The number of threads that called it
+             */
+
+            unsigned threads;
+
+            /**
+             * \brief The total duration of each call
+             */
+
+            Histogram latency;
+
+            /**
+             * \brief The time each call spent waiting for locks
+             */
+
+            Histogram lock_wait;
+        };
+
+        class LockWait;
+
+        /**
+         * \brief Times one call to an entry point on the current thread
+         */
+
+        class ScopedCall{
+        public:
+            /**
+             * Constructor for ScopedCall
+             * \param site The entry point's ID from registerSite
+             */
+
+            explicit ScopedCall(std::size_t)noexcept;
+
+            ScopedCall(const ScopedCall&) = delete;
+
+            ScopedCall& operator=(const ScopedCall&) = delete;
+
+            ~ScopedCall();
+
+        private:
+            friend class CallProfiler::LockWait;
+
+            std::size_t site;
+
+            std::chrono::steady_clock::time_point start;
+
+            /**
+             * \brief The time spent waiting for locks during this call so far, in nanoseconds
+             */
+
+            uint64_t lock_wait;
+
+            /**
+             * \brief The call this one was made from, if any
+             */
+
+            ScopedCall* outer;
+        };
+
+        /**
+         * \brief Times a lock acquisition, charging it to the current thread's innermost call
+         * Waits outside of any instrumented call, such as by the sync threads, are charged to UNATTRIBUTED_SITE_NAME
+         */
+
+        class LockWait{
+        public:
+            LockWait()noexcept;
+
+            LockWait(const LockWait&) = delete;
+
+            LockWait& operator=(const LockWait&) = delete;
+
+            ~LockWait();
+
+        private:
+            std::chrono::steady_clock::time_point start;
+        };
+
+        /**
+         * \brief The most entry points that can be registered; calls to any more are not recorded
+         */
+
+        static constexpr std::size_t MAX_SITES = 1024;
+
+        /**
+         * \brief The name lock waits outside of instrumented calls are reported under
+         */
+
+        static const std::string UNATTRIBUTED_SITE_NAME;
+
+        /**
+         * \brief The environment variable naming the file reports are written to
+         */
+
+        static const std::string REPORT_PATH_VARIABLE;
+
+        /**
+         * \brief The environment variable setting how often the report file is rewritten, in milliseconds
+         */
+
+        static const std::string REPORT_PERIOD_VARIABLE;
+
+        /**
+         * \brief How often the report file is rewritten by default
+         */
+
+        static constexpr std::chrono::milliseconds DEFAULT_REPORT_PERIOD{1000};
+
+        /**
+         * \brief Shorten a function signature to its qualified name, without the return type, parameters, or hel namespace
+         * \param signature A signature as given by __PRETTY_FUNCTION__
+         * \return The name
+         */
+
+        static std::string siteName(const char*);
+
+        /**
+         * \brief Register an entry point
+         * The first registration also starts rewriting the report file periodically and at exit if REPORT_PATH_VARIABLE is set
+         * \param signature The entry point's signature as given by __PRETTY_FUNCTION__
+         * \return The entry point's ID
+         */
+
+        static std::size_t registerSite(const char*);
+
+        /**
+         * \brief Merge the statistics of every thread
+         * \return The statistics of each entry point called so far, sorted by total time spent, longest first
+         */
+
+        static std::vector<CallStats> snapshot();
+
+        /**
+         * \brief Write a table of the statistics of every entry point called so far
+         * \param out The stream to write to
+         */
+
+        static void writeReport(std::ostream&);
+
+        /**
+         * \brief Write the report to the file named by REPORT_PATH_VARIABLE, replacing it
+         * \return True if the variable is set and the file was written
+         */
+
+        static bool writeReportToEnvironment();
+    };
+}
+
+/**
+ * \brief Time the enclosing function as an entry point; place it at the top of the function body
+ * Expands to nothing unless HEL_PROFILING is defined
+ */
+
+#ifdef HEL_PROFILING
+#define HEL_PROFILE_CALL() \
+    static const std::size_t HEL_PROFILE_SITE = hel::CallProfiler::registerSite(__PRETTY_FUNCTION__); \
+    hel::CallProfiler::ScopedCall hel_profile_call(HEL_PROFILE_SITE)
+#else
+#define HEL_PROFILE_CALL()
+#endif
+
+/**
+ * \brief Time the rest of the enclosing scope as waiting for a lock
+ * Expands to nothing unless HEL_PROFILING is defined
+ */
+
+#ifdef HEL_PROFILING
+#define HEL_PROFILE_LOCK_WAIT() hel::CallProfiler::LockWait hel_profile_lock_wait
+#else
+#define HEL_PROFILE_LOCK_WAIT()
+#endif
+
+#endif
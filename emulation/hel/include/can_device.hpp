@@ -38,7 +38,8 @@ namespace hel{
             TALON_SRX_TYPE = 0x02040000,
             VICTOR_SPX_TYPE = 0x01040000,
             PCM_TYPE = 0x09041000,
-            PDP_TYPE = 0x08041000
+            PDP_TYPE = 0x08041000,
+            API = 0xFFC0
         };
 
     public:
@@ -57,6 +58,15 @@ namespace hel{
          */
 
         static Type pullDeviceType(uint32_t)noexcept;
+
+        /**
+         * \brief Address a different API of the same CAN device
+         * \param message_id A CAN message ID for the device
+         * \param api The API bits of the new message ID, such as a frame the device sends
+         * \return The CAN message ID with its API bits replaced
+         */
+
+        static uint32_t replaceAPI(uint32_t, uint32_t)noexcept;
     };
 
     /**
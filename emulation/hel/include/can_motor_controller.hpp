@@ -5,6 +5,11 @@
 #include "can_device.hpp"
 
 namespace hel{
+    struct BinaryReader;
+    struct BinaryWriter;
+    struct JSONReader;
+    struct JSONWriter;
+
 
     /**
      * \brief Models a CAN motor controller
@@ -125,6 +130,13 @@ namespace hel{
 
         void setInverted(bool)noexcept;
 
+        /**
+         * \brief Get the inverted flag of the motor controller
+         * \return True if the motor controller output is inverted
+         */
+
+        bool getInverted()const noexcept;
+
         /**
          * \fn std::string serialize()const
          * \brief Convert the CANMotorController to a JSON object
@@ -133,6 +145,13 @@ namespace hel{
 
         std::string serialize()const;
 
+        /**
+         * \brief Append the CANMotorController to a JSON packet
+         * \param writer The JSONWriter to append to
+         */
+
+        void serialize(JSONWriter&)const;
+
         /**
          * \fn static CANMotorController deserialize(std::string input)
          * \brief Convert a JSON object string to a CANMotorController object
@@ -142,6 +161,29 @@ namespace hel{
 
         static CANMotorController deserialize(std::string);
 
+        /**
+         * \brief Read a CANMotorController object written by serialize
+         * \param reader The JSONReader positioned at the start of the object
+         * \return The parsed CANMotorController object
+         */
+
+        static CANMotorController deserialize(JSONReader&);
+
+        /**
+         * \brief Append the motor controller data to a binary packet
+         * \param writer The BinaryWriter to append to
+         */
+
+        void serializeBinary(BinaryWriter&)const;
+
+        /**
+         * \brief Read a CANMotorController object from a binary packet
+         * \param reader The BinaryReader to read from
+         * \return The parsed CANMotorController object
+         */
+
+        static CANMotorController deserializeBinary(BinaryReader&);
+
         /**
          * Constructor for CANMotorController
          */
@@ -153,7 +195,9 @@ namespace hel{
          * \param source A CANMotorController object to copy
          */
 
-        CANMotorController(const CANMotorController&)noexcept;
+        CANMotorController(const CANMotorController&)noexcept = default;
+
+        CANMotorController& operator=(const CANMotorController&)noexcept = default;
 
         /**
          * Constructor for CANMotorController
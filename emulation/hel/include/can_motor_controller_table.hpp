@@ -0,0 +1,371 @@
+#ifndef _CAN_MOTOR_CONTROLLER_TABLE_HPP_
+#define _CAN_MOTOR_CONTROLLER_TABLE_HPP_
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "can_motor_controller.hpp"
+
+namespace hel{
+
+    /**
+     * \brief The CAN motor controllers on the bus, held in a fixed slot per device type and ID
+     * Lookups are a single index, copies are a flat memory copy, and iteration visits only occupied slots, in order of type and then ID.
+     */
+
+    class CANMotorControllerTable{
+    public:
+        /**
+         * \brief The number of motor controller device types, VICTOR_SPX and TALON_SRX
+         */
+
+        static constexpr unsigned NUM_TYPES = 2;
+
+        /**
+         * \brief The number of IDs a CAN message can address for each type, including the one past MAX_CAN_BUS_ADDRESS
+         */
+
+        static constexpr unsigned IDS_PER_TYPE = 64;
+
+        /**
+         * \brief The number of slots in the table
+         */
+
+        static constexpr unsigned CAPACITY = NUM_TYPES * IDS_PER_TYPE;
+
+        /**
+         * \brief A set of slots, one bit per slot
+         */
+
+        class SlotMask{
+        private:
+            /**
+             * \brief The bits of the slots of each type, indexed by ID
+             */
+
+            std::array<uint64_t, NUM_TYPES> words;
+
+        public:
+            /**
+             * \brief Check if a slot is in the set
+             * \param slot The slot to check
+             * \return True if the slot is in the set
+             */
+
+            bool test(unsigned slot)const noexcept{
+                return (words[slot / IDS_PER_TYPE] >> (slot % IDS_PER_TYPE)) & 1u;
+            }
+
+            /**
+             * \brief Add a slot to the set
+             * \param slot The slot to add
+             */
+
+            void set(unsigned slot)noexcept{
+                words[slot / IDS_PER_TYPE] |= uint64_t(1) << (slot % IDS_PER_TYPE);
+            }
+
+            /**
+             * \brief Remove every slot from the set
+             */
+
+            void clear()noexcept{
+                words.fill(0);
+            }
+
+            /**
+             * \brief Check if the set is empty
+             * \return True if no slot is in the set
+             */
+
+            bool empty()const noexcept{
+                for(uint64_t word: words){
+                    if(word != 0){
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            /**
+             * \brief Count the slots in the set
+             * \return The number of slots in the set
+             */
+
+            unsigned count()const noexcept{
+                unsigned count = 0;
+                for(uint64_t word: words){
+                    count += __builtin_popcountll(word);
+                }
+                return count;
+            }
+
+            /**
+             * \brief Find the first slot in the set at or after a given slot
+             * \param slot The slot to start searching from
+             * \return The slot found, or CAPACITY if there is none
+             */
+
+            unsigned next(unsigned slot)const noexcept{
+                for(unsigned type = slot / IDS_PER_TYPE; type < NUM_TYPES; type++){
+                    const unsigned SHIFT = type == slot / IDS_PER_TYPE ? slot % IDS_PER_TYPE : 0;
+                    const uint64_t REMAINING = words[type] >> SHIFT << SHIFT;
+                    if(REMAINING != 0){
+                        return type * IDS_PER_TYPE + __builtin_ctzll(REMAINING);
+                    }
+                }
+                return CAPACITY;
+            }
+
+            bool operator==(const SlotMask& other)const noexcept{
+                return words == other.words;
+            }
+
+            bool operator!=(const SlotMask& other)const noexcept{
+                return !(*this == other);
+            }
+
+            /**
+             * Constructor for SlotMask
+             */
+
+            SlotMask()noexcept:words(){}
+        };
+
+        /**
+         * \brief Iterates over the occupied slots of a table
+         */
+
+        class const_iterator{
+        private:
+            const CANMotorControllerTable* table;
+
+            unsigned slot;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = CANMotorController;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const CANMotorController*;
+            using reference = const CANMotorController&;
+
+            reference operator*()const noexcept{
+                return table->slots[slot];
+            }
+
+            pointer operator->()const noexcept{
+                return &table->slots[slot];
+            }
+
+            const_iterator& operator++()noexcept{
+                slot = table->occupied.next(slot + 1);
+                return *this;
+            }
+
+            const_iterator operator++(int)noexcept{
+                const_iterator previous = *this;
+                ++*this;
+                return previous;
+            }
+
+            bool operator==(const const_iterator& other)const noexcept{
+                return slot == other.slot;
+            }
+
+            bool operator!=(const const_iterator& other)const noexcept{
+                return slot != other.slot;
+            }
+
+            /**
+             * Constructor for const_iterator
+             * \param table The table to iterate over
+             * \param slot The occupied slot to start at, or CAPACITY for the end
+             */
+
+            const_iterator(const CANMotorControllerTable* table, unsigned slot)noexcept:table(table), slot(slot){}
+        };
+
+        using value_type = CANMotorController;
+
+    private:
+        /**
+         * \brief The motor controllers, valid only in occupied slots
+         */
+
+        std::array<CANMotorController, CAPACITY> slots;
+
+        /**
+         * \brief The slots which hold a motor controller
+         */
+
+        SlotMask occupied;
+
+    public:
+        /**
+         * \brief Check if a device has a slot in the table
+         * \param type The type of the device
+         * \param id The ID of the device
+         * \return True if the device is a motor controller with an ID a CAN message can address
+         */
+
+        static bool hasSlot(CANDevice::Type type, uint8_t id)noexcept{
+            return (type == CANDevice::Type::VICTOR_SPX || type == CANDevice::Type::TALON_SRX) && id < IDS_PER_TYPE;
+        }
+
+        /**
+         * \brief Get the slot of a device
+         * \param type The type of the device, which must have a slot
+         * \param id The ID of the device
+         * \return The slot
+         */
+
+        static unsigned slotOf(CANDevice::Type type, uint8_t id)noexcept{
+            return static_cast<unsigned>(type) * IDS_PER_TYPE + id;
+        }
+
+        /**
+         * \brief Find a motor controller
+         * \param type The type of the motor controller
+         * \param id The ID of the motor controller
+         * \return The motor controller, or nullptr if the table does not hold it
+         */
+
+        CANMotorController* find(CANDevice::Type type, uint8_t id)noexcept{
+            if(!hasSlot(type, id) || !occupied.test(slotOf(type, id))){
+                return nullptr;
+            }
+            return &slots[slotOf(type, id)];
+        }
+
+        /**
+         * \brief Find a motor controller
+         * \param type The type of the motor controller
+         * \param id The ID of the motor controller
+         * \return The motor controller, or nullptr if the table does not hold it
+         */
+
+        const CANMotorController* find(CANDevice::Type type, uint8_t id)const noexcept{
+            return const_cast<CANMotorControllerTable*>(this)->find(type, id);
+        }
+
+        /**
+         * \brief Get a motor controller, adding it with default outputs if the table does not hold it
+         * \param type The type of the motor controller
+         * \param id The ID of the motor controller
+         * \return The motor controller
+         */
+
+        CANMotorController& emplace(CANDevice::Type, uint8_t);
+
+        /**
+         * \brief Get the motor controller in an occupied slot
+         * \param slot The slot
+         * \return The motor controller
+         */
+
+        const CANMotorController& at(unsigned slot)const noexcept{
+            return slots[slot];
+        }
+
+        /**
+         * \brief Get the slots which hold a motor controller
+         * \return The occupied slots
+         */
+
+        const SlotMask& occupancy()const noexcept{
+            return occupied;
+        }
+
+        /**
+         * \brief Get the number of motor controllers held
+         * \return The number of occupied slots
+         */
+
+        unsigned size()const noexcept{
+            return occupied.count();
+        }
+
+        /**
+         * \brief Check if the table holds no motor controllers
+         * \return True if no slot is occupied
+         */
+
+        bool empty()const noexcept{
+            return occupied.empty();
+        }
+
+        /**
+         * \brief Remove every motor controller
+         */
+
+        void clear()noexcept{
+            occupied.clear();
+        }
+
+        const_iterator begin()const noexcept{
+            return const_iterator(this, occupied.next(0));
+        }
+
+        const_iterator end()const noexcept{
+            return const_iterator(this, CAPACITY);
+        }
+
+        /**
+         * \brief Format the table as a string
+         * \return A string containing every motor controller held
+         */
+
+        std::string toString()const;
+
+        /**
+         * \brief Append the motor controllers to a JSON packet as a list
+         * \param writer The JSONWriter to append to
+         */
+
+        void serialize(JSONWriter&)const;
+
+        /**
+         * \brief Read a JSON list of motor controllers written by serialize
+         * \param reader The JSONReader positioned at the start of the list
+         * \return A table holding only the motor controllers read
+         */
+
+        static CANMotorControllerTable deserialize(JSONReader&);
+
+        /**
+         * \brief Append the motor controllers to a binary packet, prefixed by their count as one byte
+         * \param writer The BinaryWriter to append to
+         */
+
+        void serializeBinary(BinaryWriter&)const;
+
+        /**
+         * \brief Append some of the motor controllers to a binary packet, prefixed by their count as one byte
+         * \param writer The BinaryWriter to append to
+         * \param selected The occupied slots to append
+         */
+
+        void serializeBinary(BinaryWriter&, const SlotMask&)const;
+
+        /**
+         * \brief Read motor controllers written by serializeBinary into the table, replacing any in the same slots
+         * \param reader The BinaryReader to read from
+         */
+
+        void deserializeBinary(BinaryReader&);
+
+        /**
+         * Constructor for CANMotorControllerTable
+         */
+
+        CANMotorControllerTable()noexcept;
+    };
+
+    static_assert(std::is_trivially_copyable<CANMotorControllerTable>::value, "CAN motor controller tables are copied into each RoboRIO snapshot, so they must copy as flat memory");
+}
+
+#endif
@@ -0,0 +1,242 @@
+#ifndef _CAN_STREAM_MANAGER_HPP_
+#define _CAN_STREAM_MANAGER_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "mpmc_ring.hpp"
+
+namespace hel{
+
+    /**
+     * \brief Holds the CAN stream sessions opened by robot programs and delivers status frames to them
+     * Each session buffers the frames which match its message ID filter in its own lock-free ring, so publishing and reading never take a lock. Publishers and readers pin the session slot they use, and close frees a stream only once every pin taken before it was unpublished is released. Only opening and closing sessions are serialized by a mutex.
+     */
+
+    class CANStreamManager{
+    public:
+        /**
+         * \brief A CAN frame as delivered to a stream session
+         */
+
+        struct Message{
+            /**
+             * \brief The CAN message ID of the frame
+             */
+
+            uint32_t message_id;
+
+            /**
+             * \brief The time the frame was produced, in milliseconds
+             */
+
+            uint32_t time_stamp;
+
+            /**
+             * \brief The payload of the frame
+             */
+
+            std::array<uint8_t, 8> data;
+
+            /**
+             * \brief The number of bytes of data used
+             */
+
+            uint8_t data_size;
+        };
+
+        /**
+         * \brief The most stream sessions open at once across all robot instances
+         */
+
+        static constexpr unsigned MAX_SESSIONS = 64;
+
+        /**
+         * \brief The most frames one session buffers, whatever the robot program asks for
+         */
+
+        static constexpr uint32_t MAX_MESSAGES_PER_SESSION = 4096;
+
+    private:
+        /**
+         * \brief The state of one open stream session
+         */
+
+        struct Stream{
+            /**
+             * \brief The frames waiting to be read
+             */
+
+            MPMCRing<Message> ring;
+
+            /**
+             * \brief The ID of the robot instance the session was opened by
+             */
+
+            const unsigned robot_id;
+
+            /**
+             * \brief The message ID frames must match in the bits of message_id_mask
+             */
+
+            const uint32_t message_id;
+
+            /**
+             * \brief The bits of the message ID to filter frames by
+             */
+
+            const uint32_t message_id_mask;
+
+            /**
+             * \brief Whether a frame has been dropped because the ring was full since the last read
+             */
+
+            std::atomic<bool> overrun;
+
+            /**
+             * Constructor for Stream
+             * \param robot_id The ID of the robot instance opening the session
+             * \param message_id The message ID to receive frames for
+             * \param message_id_mask The bits of message_id a frame must match
+             * \param max_messages The most frames to buffer between reads
+             */
+
+            Stream(unsigned, uint32_t, uint32_t, uint32_t);
+        };
+
+        /**
+         * \brief One stream session slot
+         */
+
+        struct Session{
+            /**
+             * \brief The open session, or nullptr if the slot is free
+             */
+
+            std::atomic<Stream*> stream;
+
+            /**
+             * \brief The number of publishers and readers currently using the stream
+             */
+
+            std::atomic<unsigned> pins;
+
+            /**
+             * Constructor for Session
+             */
+
+            constexpr Session()noexcept:stream(nullptr), pins(0){}
+        };
+
+        /**
+         * \brief A pin on a session slot, which keeps its stream from being freed while held
+         */
+
+        class Pin{
+        private:
+            /**
+             * \brief The pinned session slot
+             */
+
+            Session& session;
+
+        public:
+            /**
+             * \brief Get the stream of the pinned slot
+             * \return The stream, or nullptr if the slot is free
+             */
+
+            Stream* get()const noexcept;
+
+            /**
+             * Constructor for Pin
+             * \param session The session slot to pin
+             */
+
+            explicit Pin(Session&)noexcept;
+
+            /**
+             * Deconstructor for Pin
+             */
+
+            ~Pin();
+
+            Pin(const Pin&) = delete;
+            Pin& operator=(const Pin&) = delete;
+        };
+
+        /**
+         * \brief The mutex serializing opening and closing sessions
+         */
+
+        static std::mutex sessions_mutex;
+
+        /**
+         * \brief Every session slot, indexed by session handle minus one
+         */
+
+        static std::array<Session, MAX_SESSIONS> sessions;
+
+        /**
+         * \brief The number of open sessions, so publishing can skip the sessions when there are none
+         */
+
+        static std::atomic<unsigned> open_count;
+
+    public:
+        /**
+         * \brief Open a stream session
+         * \param robot_id The ID of the robot instance whose frames to receive
+         * \param message_id The message ID to receive frames for
+         * \param message_id_mask The bits of message_id a frame must match
+         * \param max_messages The most frames to buffer between reads
+         * \return The handle of the session, which is never zero
+         */
+
+        static uint32_t open(unsigned, uint32_t, uint32_t, uint32_t);
+
+        /**
+         * \brief Close a stream session and discard its buffered frames
+         * Waits for any read of or publish to the session already in progress to finish. Closing a handle which is not open, or which another robot instance opened, does nothing.
+         * \param robot_id The ID of the robot instance closing the session
+         * \param handle The handle of the session
+         */
+
+        static void close(unsigned, uint32_t)noexcept;
+
+        /**
+         * \brief Drain buffered frames from a stream session, oldest first
+         * Concurrent reads of one session each receive different frames
+         * \param robot_id The ID of the robot instance reading the session
+         * \param handle The handle of the session
+         * \param messages Where to copy the frames
+         * \param max_count The most frames to read
+         * \param overrun Set to whether frames were dropped since the last read because the session's buffer was full
+         * \return The number of frames read
+         * \throw std::out_of_range if the session is not open or was opened by another robot instance
+         */
+
+        static std::size_t read(unsigned, uint32_t, Message*, std::size_t, bool&);
+
+        /**
+         * \brief Deliver a frame to each open session of a robot instance whose filter it matches
+         * \param robot_id The ID of the robot instance which produced the frame
+         * \param message The frame
+         */
+
+        static void publish(unsigned, const Message&)noexcept;
+
+        /**
+         * \brief Check if any stream session is open
+         * Producers can use this to skip building frames nobody would receive
+         * \return True if a session is open
+         */
+
+        static bool hasSessions()noexcept;
+    };
+}
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef _DIAGNOSTICS_HPP_
+#define _DIAGNOSTICS_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace hel{
+
+    /**
+     * \brief Collects Synthesis warnings and prints them from a background thread
+     * Each distinct warning is registered once and given an ID; reporting it again only increments a counter. Once per flush period, every warning reported since the last flush is printed as one line with the number of times it happened, so a warning raised on every loop of the user program costs no terminal I/O on that loop.
+     */
+
+    class Diagnostics{
+    public:
+        /**
+         * \brief Where a warning is raised in HEL, which remembers the ID of the warning it registered
+         * Sites are constant-initialized, so they can be declared static in any function at no cost
+         */
+
+        class Site{
+        private:
+            friend class Diagnostics;
+
+            /**
+             * \brief The ID of the warning plus one, or zero if it has not been registered yet
+             */
+
+            std::atomic<std::size_t> id;
+
+        public:
+            /**
+             * Constructor for Site
+             */
+
+            constexpr Site()noexcept:id(0){}
+
+            Site(const Site&) = delete;
+            Site& operator=(const Site&) = delete;
+        };
+
+        /**
+         * \brief The most distinct warnings that can be registered; any more are counted together under one overflow warning
+         */
+
+        static constexpr std::size_t MAX_WARNINGS = 1024;
+
+        /**
+         * \brief The environment variable setting how often warnings are printed, in milliseconds
+         */
+
+        static const std::string FLUSH_PERIOD_VARIABLE;
+
+        /**
+         * \brief How often warnings are printed by default
+         */
+
+        static constexpr std::chrono::milliseconds DEFAULT_FLUSH_PERIOD{1000};
+
+        /**
+         * \brief Register a warning
+         * Registering the same message again returns the same ID. The first registration starts printing warnings periodically and at exit.
+         * \param message The warning, without the "Synthesis warning: " prefix
+         * \return The warning's ID
+         */
+
+        static std::size_t registerWarning(const std::string&);
+
+        /**
+         * \brief Count one occurrence of a warning
+         * \param id The ID of the warning
+         */
+
+        static void report(std::size_t)noexcept;
+
+        /**
+         * \brief Count one occurrence of the warning raised at a site, registering it on the site's first report
+         * \param site The site raising the warning
+         * \param make_message A callable returning the warning, only called on the site's first report
+         */
+
+        template<typename MakeMessage>
+        static void report(Site& site, MakeMessage make_message){
+            std::size_t id = site.id.load(std::memory_order_relaxed);
+            if(id == 0){ //racing first reports register the same message, so they agree on the ID
+                id = registerWarning(make_message()) + 1;
+                site.id.store(id, std::memory_order_relaxed);
+            }
+            report(id - 1);
+        }
+
+        /**
+         * \brief Print every warning reported since the last flush, one line each
+         * \param out The stream to print to
+         */
+
+        static void flush(std::ostream&);
+    };
+}
+
+/**
+ * \brief Report a warning, registering it the first time this line runs
+ * The message expression is only evaluated on the first report
+ */
+
+#define HEL_WARN(MESSAGE) \
+    do{ \
+        static hel::Diagnostics::Site hel_warning_site; \
+        hel::Diagnostics::report(hel_warning_site, [&](){ return std::string(MESSAGE); }); \
+    } while(0)
+
+#endif
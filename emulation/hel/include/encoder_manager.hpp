@@ -1,11 +1,17 @@
 #ifndef _ENCODER_MANAGER_HPP_
 #define _ENCODER_MANAGER_HPP_
 
+#include <array>
 #include <cstdint>
 #include <string>
 #include "util.hpp"
 
 namespace hel{
+    struct BinaryReader;
+    struct BinaryWriter;
+    struct JSONReader;
+    struct JSONWriter;
+
 
     /**
      * \brief Manager for HEL encoder data
@@ -81,26 +87,6 @@ namespace hel{
 
         int32_t ticks;
 
-        /**
-         * \brief Check the EncoderManager configuration against tEncoder or tCounter configurations
-         * This is used to determine what device to map the EncoderManager to
-         * \param a The configuration's a channel value
-         * \param a_module The configuration's a module value
-         * \param a_analog The configuration's b analog value
-         * \param b The configuration's b channel value
-         * \param b_module The configuration's b module value
-         * \param b_analog The configuration's b analog value
-         * \return True if the devices match
-         */
-
-        bool checkDevice(uint8_t, bool, bool, uint8_t, bool, bool)const noexcept;
-
-        /**
-         * \brief Update the EncoderManager's type and index given the FPGAEncoders and Counters
-         */
-
-        void updateDevice();
-
     public:
         /**
          * \brief Get the type of encoder the manager is mapped to
@@ -188,6 +174,7 @@ namespace hel{
 
         /**
          * \brief Updates the EncoderManager's type and index and the ticks of its corresponding FPGAEncoder or Counter
+         * The device is looked up in the RoboRIO's encoder source indexes, so this takes constant time however many devices there are
          */
 
         void update();
@@ -199,6 +186,13 @@ namespace hel{
 
         std::string serialize()const;
 
+        /**
+         * \brief Append the encoder data to a JSON packet
+         * \param writer The JSONWriter to append to
+         */
+
+        void serialize(JSONWriter&)const;
+
         /**
          * \brief Deserialize a JSON string as an EncoderManager
          * \param input The JSON string to parse
@@ -206,6 +200,29 @@ namespace hel{
 
         static EncoderManager deserialize(std::string);
 
+        /**
+         * \brief Read a JSON object as an EncoderManager
+         * \param reader The JSONReader positioned at the start of the object
+         * \return The parsed EncoderManager object
+         */
+
+        static EncoderManager deserialize(JSONReader&);
+
+        /**
+         * \brief Append the encoder data to a binary packet
+         * \param writer The BinaryWriter to append to
+         */
+
+        void serializeBinary(BinaryWriter&)const;
+
+        /**
+         * \brief Read a EncoderManager object from a binary packet
+         * \param reader The BinaryReader to read from
+         * \return The parsed EncoderManager object
+         */
+
+        static EncoderManager deserializeBinary(BinaryReader&);
+
         /**
          * \brief Format the EncoderManager data as a string
          * \return The EncoderManager data in string format
@@ -237,6 +254,88 @@ namespace hel{
         EncoderManager(uint8_t,PortType,uint8_t,PortType)noexcept;
     };
 
+    /**
+     * \brief Maps the ports an EncoderManager is attached to onto the FPGA encoders or counters whose sources are configured on them
+     * Each device's entry is updated when HAL writes its configuration, so finding the device for an EncoderManager is a lookup rather than a scan of every configuration
+     */
+
+    struct EncoderSourceIndex{
+        /**
+         * \brief The most devices an index can hold
+         */
+
+        static constexpr unsigned MAX_DEVICES = 8;
+
+        /**
+         * \brief The number of distinct ports per port type, covering every channel a configuration can select
+         */
+
+        static constexpr unsigned CHANNELS_PER_TYPE = 32;
+
+    private:
+        /**
+         * \brief For each port, a mask of the devices whose a source can be on it, indexed by keyOf
+         */
+
+        std::array<uint8_t, 2 * CHANNELS_PER_TYPE> a_sources;
+
+        /**
+         * \brief For each port, a mask of the devices whose b source can be on it, indexed by keyOf
+         */
+
+        std::array<uint8_t, 2 * CHANNELS_PER_TYPE> b_sources;
+
+        /**
+         * \brief Get the position of a port in the source masks
+         * \param channel The port index
+         * \param type The type of port
+         * \return The key, or 2 * CHANNELS_PER_TYPE if the channel is out of range
+         */
+
+        static unsigned keyOf(uint8_t, EncoderManager::PortType)noexcept;
+
+        /**
+         * \brief Record the ports one source of a device can be on
+         * \param sources The source masks to update
+         * \param device The index of the device
+         * \param channel The configuration's channel value
+         * \param module The configuration's module value
+         * \param analog The configuration's analog trigger value
+         */
+
+        static void setSource(std::array<uint8_t, 2 * CHANNELS_PER_TYPE>&, uint8_t, uint8_t, bool, bool)noexcept;
+
+    public:
+        /**
+         * \brief Update a device's entry from its configuration
+         * \param device The index of the FPGA encoder or counter
+         * \param a The configuration's a (or up) channel value
+         * \param a_module The configuration's a module value
+         * \param a_analog The configuration's a analog trigger value
+         * \param b The configuration's b (or down) channel value
+         * \param b_module The configuration's b module value
+         * \param b_analog The configuration's b analog trigger value
+         */
+
+        void set(uint8_t, uint8_t, bool, bool, uint8_t, bool, bool)noexcept;
+
+        /**
+         * \brief Find the first device whose sources are on an EncoderManager's ports
+         * \param manager The EncoderManager to find the device of
+         * \param index Set to the index of the device if one is found
+         * \return True if a device was found
+         */
+
+        bool find(const EncoderManager&, uint8_t&)const noexcept;
+
+        /**
+         * Constructor for EncoderSourceIndex
+         * Every device starts with the default configuration, all sources on channel 0 of the RoboRIO headers
+         */
+
+        EncoderSourceIndex()noexcept;
+    };
+
     /**
      * \fn std::string asString(EncoderManager::Type type)
      * \brief Convert an EncoderManager::Type to a string
@@ -0,0 +1,152 @@
+#ifndef _FRAME_READER_HPP_
+#define _FRAME_READER_HPP_
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "binary_util.hpp"
+#include "util.hpp"
+
+namespace hel{
+
+    /**
+     * \brief Splits a stream of received bytes into complete packets without copying them
+     * Bytes are received directly into a reusable buffer, and each new byte is scanned for a packet boundary only once. Complete packets are handed out as views into the buffer. Unconsumed bytes are moved to the front of the buffer only when more space is needed, and the buffer only grows when a single packet does not fit.
+     * JSON packets start with the roborio preamble and end with JSON_PACKET_SUFFIX; binary packets start with BINARY_PACKET_MAGIC and are delimited by the payload length in their header. Bytes before a packet start are discarded.
+     */
+
+    class FrameReader{
+    public:
+        /**
+         * \brief The initial size of the buffer in bytes
+         */
+
+        static constexpr std::size_t INITIAL_CAPACITY = 8192;
+
+        /**
+         * \brief The largest binary payload accepted; larger lengths can only come from a corrupt header
+         */
+
+        static constexpr uint32_t MAX_BINARY_PAYLOAD_SIZE = 0x10000;
+
+    private:
+        /**
+         * \brief The storage for received bytes
+         */
+
+        std::vector<char> buffer;
+
+        /**
+         * \brief The position of the first unconsumed byte
+         */
+
+        std::size_t read_position;
+
+        /**
+         * \brief The position one past the last received byte
+         */
+
+        std::size_t write_position;
+
+        /**
+         * \brief The position of the first byte not yet scanned for a packet boundary
+         */
+
+        std::size_t scan_position;
+
+        /**
+         * \brief Whether read_position is at the start of a packet
+         */
+
+        bool in_frame;
+
+        /**
+         * \brief The framing of the stream
+         */
+
+        WireFormat format;
+
+        /**
+         * \brief Find the next packet start at or after the scan position, discarding bytes before it
+         * \param marker The bytes each packet starts with
+         * \param marker_size The number of bytes in marker
+         * \return True if a packet start was found
+         */
+
+        bool findFrameStart(const char*, std::size_t);
+
+        /**
+         * \brief Extract the next JSON packet
+         * \param frame Set to the packet, excluding its suffix, if one is complete
+         * \return True if a complete packet was extracted
+         */
+
+        bool nextJSON(StringView&);
+
+        /**
+         * \brief Extract the next binary packet
+         * \param frame Set to the packet, including its header, if one is complete
+         * \return True if a complete packet was extracted
+         */
+
+        bool nextBinary(StringView&);
+
+    public:
+        /**
+         * \brief Get space to receive bytes into
+         * This may move unconsumed bytes, invalidating previously returned frames
+         * \param min_size The minimum number of bytes of space needed
+         * \return The start of the space and its size, which is at least min_size
+         */
+
+        std::pair<char*, std::size_t> prepare(std::size_t);
+
+        /**
+         * \brief Mark bytes received into the space returned by prepare as readable
+         * \param size The number of bytes received
+         */
+
+        void commit(std::size_t);
+
+        /**
+         * \brief Extract the next complete packet
+         * The frame stays valid until the next call to prepare or reset
+         * \param frame Set to the packet if one is complete
+         * \return True if a complete packet was extracted
+         */
+
+        bool next(StringView&);
+
+        /**
+         * \brief Discard all buffered bytes and change the framing
+         * \param format The framing of the new stream
+         */
+
+        void reset(WireFormat);
+
+        /**
+         * \brief Get the number of received bytes not yet extracted as part of a packet
+         * \return The number of buffered bytes
+         */
+
+        std::size_t buffered()const noexcept;
+
+        /**
+         * \brief Get the current size of the buffer
+         * \return The capacity in bytes
+         */
+
+        std::size_t capacity()const noexcept;
+
+        /**
+         * Constructor for FrameReader
+         * \param format The framing of the stream
+         * \param capacity The initial size of the buffer
+         */
+
+        explicit FrameReader(WireFormat = WireFormat::JSON, std::size_t = INITIAL_CAPACITY);
+    };
+}
+
+#endif
@@ -26,16 +26,18 @@ namespace hel{
         uint64_t getFPGAStartTime()const noexcept;
 
         /**
-         * \brief Get the time in microseconds for which the emulated FPGA has been running
+         * \brief Get the current time in microseconds
+         * This follows the engine's simulation time in lockstep mode; see SimClock
          */
 
         static uint64_t getCurrentTime()noexcept;
 
         /**
          * Constructor for Global
+         * \param fpga_start_time The time in microseconds at which the emulated FPGA started
          */
 
-        Global()noexcept;
+        explicit Global(uint64_t)noexcept;
 
         /**
          * Constructor for Global
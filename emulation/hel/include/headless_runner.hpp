@@ -0,0 +1,194 @@
+#ifndef _HEADLESS_RUNNER_HPP_
+#define _HEADLESS_RUNNER_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace hel{
+    /**
+     * \brief If set before HAL initializes, this runs in place of the connection to Synthesis's engine
+     */
+
+    extern void (*engine_stand_in)();
+
+    /**
+     * \brief Runs a robot program without the engine, as fast as the host can compute
+     * Scripted inputs are fed directly into ReceiveData, and the FPGA clock is stepped in lockstep with the user program's loop, so each run is deterministic and independent of host speed. The same script can be run many times in one process, like a robot playing consecutive matches.
+     */
+
+    class HeadlessRunner{
+    public:
+        /**
+         * \brief Inputs applied from a point in a run onwards
+         */
+
+        struct Keyframe{
+            /**
+             * \brief The time since the start of the run in microseconds
+             */
+
+            uint64_t time;
+
+            /**
+             * \brief A JSON input packet in the same format the engine sends; fields it leaves out keep their values
+             */
+
+            std::string packet;
+        };
+
+        /**
+         * \brief The outcome of one run
+         */
+
+        struct RunReport{
+            /**
+             * \brief The simulated duration of the run in microseconds
+             */
+
+            uint64_t simulated_time;
+
+            /**
+             * \brief The host time the run took
+             */
+
+            std::chrono::microseconds wall_time;
+
+            /**
+             * \brief The number of user program loop iterations
+             */
+
+            uint64_t loops;
+
+            /**
+             * \brief The mean host time of one loop iteration
+             */
+
+            std::chrono::microseconds mean_loop_time;
+
+            /**
+             * \brief The longest host time of one loop iteration
+             */
+
+            std::chrono::microseconds max_loop_time;
+
+            /**
+             * \brief The outputs at the end of the last scripted segment, as a deep JSON packet
+             */
+
+            std::string outputs;
+
+            /**
+             * \brief Format the report as a single line
+             * \return The formatted report
+             */
+
+            std::string toString()const;
+        };
+
+        /**
+         * \brief The default simulated time between loop iterations, matching the driver station's packet rate
+         */
+
+        static constexpr std::chrono::microseconds DEFAULT_STEP_PERIOD{20000};
+
+        /**
+         * \brief The longest host time one loop iteration may take before the user program is considered hung
+         */
+
+        static constexpr std::chrono::seconds LOOP_TIMEOUT{10};
+
+    private:
+        /**
+         * \brief The script for every run, sorted by time
+         */
+
+        std::vector<Keyframe> script;
+
+        /**
+         * \brief The number of runs
+         */
+
+        unsigned runs;
+
+        /**
+         * \brief The simulated time between loop iterations in microseconds
+         */
+
+        uint64_t step_period;
+
+        /**
+         * \brief The simulation time fed to the clock, which continues across runs
+         */
+
+        uint64_t sim_time;
+
+        /**
+         * \brief Apply a scripted input packet
+         * \param packet The packet to apply
+         */
+
+        void applyInputs(const std::string&);
+
+        /**
+         * \brief Capture the current outputs
+         * \return The outputs as a deep JSON packet
+         */
+
+        static std::string captureOutputs();
+
+    public:
+        /**
+         * \brief Parse a script
+         * Each line holds the time in seconds followed by a JSON input packet. Blank lines and lines starting with # are ignored.
+         * \param input The script to parse
+         * \return The keyframes, sorted by time
+         */
+
+        static std::vector<Keyframe> parseScript(std::istream&);
+
+        /**
+         * \brief Get the script used when none is given: 15 seconds of autonomous
+         * \return The keyframes
+         */
+
+        static std::vector<Keyframe> defaultScript();
+
+        /**
+         * \brief Simulate one run of the script
+         * The user program must be running and held at the loop barrier by SimClock
+         * \return The report for the run
+         */
+
+        RunReport run();
+
+        /**
+         * \brief Simulate every run and report each
+         * \param out The stream to write the reports to
+         */
+
+        void runAll(std::ostream&);
+
+        /**
+         * \brief Wait for HAL to initialize, simulate every run configured by the environment, and exit the process
+         * HEL_RUNNER_SCRIPT names the script file, HEL_RUNNER_RUNS sets the number of runs, and HEL_RUNNER_STEP_US sets the step period
+         * Suitable for engine_stand_in
+         */
+
+        static void runFromEnvironment();
+
+        /**
+         * Constructor for HeadlessRunner
+         * \param script The script for every run
+         * \param runs The number of runs
+         * \param step_period The simulated time between loop iterations
+         */
+
+        HeadlessRunner(std::vector<Keyframe>, unsigned, std::chrono::microseconds = DEFAULT_STEP_PERIOD);
+    };
+}
+
+#endif
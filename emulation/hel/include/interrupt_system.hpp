@@ -0,0 +1,231 @@
+#ifndef _INTERRUPT_SYSTEM_HPP_
+#define _INTERRUPT_SYSTEM_HPP_
+
+#include "FRC_FPGA_ChipObject/RoboRIO_FRC_ChipObject_Aliases.h"
+#include "FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tInterrupt.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace hel{
+
+    /**
+     * \brief Models the RoboRIO's interrupts, which latch edges of digital inputs and wake the threads waiting on them
+     * Each interrupt has its own mutex and condition variable, so a waiting thread uses no CPU until an edge it watches arrives or its wait is released.
+     * Digital header inputs (source module 0) and digital MXP inputs (source module 1) can be interrupt sources. Edges are detected between the inputs of consecutive packets, so a pulse shorter than one packet is never seen. The FPGA alarm asserts its own interrupt, which HAL's notifiers wait on.
+     */
+
+    class InterruptSystem{
+    public:
+        /**
+         * \brief The number of interrupts supported by the Ni FPGA
+         */
+
+        static constexpr uint8_t MAX_INTERRUPT_COUNT = nFPGA::nRoboRIO_FPGANamespace::tInterrupt::kNumSystems;
+
+        /**
+         * \brief How far the asserted bit of a falling edge is shifted from the interrupt's rising edge bit
+         * An interrupt at index i asserts bit i for rising edges and bit i + FALLING_EDGE_SHIFT for falling edges, as with the Ni FPGA's IRQ numbers
+         */
+
+        static constexpr unsigned FALLING_EDGE_SHIFT = 8;
+
+        /**
+         * \brief The bit the FPGA alarm asserts, which HAL's notifiers wait on
+         */
+
+        static constexpr unsigned ALARM_IRQ = 28;
+
+    private:
+        /**
+         * \brief The state of one interrupt
+         */
+
+        struct Slot{
+            /**
+             * \brief The mutex guarding the rest of the slot
+             */
+
+            std::mutex mutex;
+
+            /**
+             * \brief Notified when the interrupt asserts or its waiters are released
+             */
+
+            std::condition_variable changed;
+
+            /**
+             * \brief The interrupt's source and the edges it triggers on
+             */
+
+            nFPGA::nRoboRIO_FPGANamespace::tInterrupt::tConfig config;
+
+            /**
+             * \brief The FPGA time of the last rising edge, in microseconds
+             */
+
+            uint32_t rising_time_stamp;
+
+            /**
+             * \brief The FPGA time of the last falling edge, in microseconds
+             */
+
+            uint32_t falling_time_stamp;
+
+            /**
+             * \brief The edges which have asserted since they were last acknowledged by a wait
+             */
+
+            uint32_t asserted;
+
+            /**
+             * \brief The number of times waiters have been released without an edge
+             */
+
+            uint64_t releases;
+
+            /**
+             * Constructor for Slot
+             */
+
+            Slot()noexcept;
+        };
+
+        /**
+         * \brief The slot of the alarm interrupt, after every configurable interrupt
+         */
+
+        static constexpr uint8_t ALARM_SLOT = MAX_INTERRUPT_COUNT;
+
+        /**
+         * \brief Every interrupt, indexed by its system index, followed by the alarm interrupt
+         */
+
+        std::array<Slot, MAX_INTERRUPT_COUNT + 1> slots;
+
+        /**
+         * \brief Get the interrupt an asserted mask refers to
+         * \param mask A mask of asserted bits for one interrupt
+         * \return The slot of the interrupt
+         */
+
+        static uint8_t indexOf(uint32_t);
+
+        /**
+         * \brief Get the bits a slot asserts
+         * \param slot The slot of the interrupt
+         * \return The mask of the slot's asserted bits
+         */
+
+        static uint32_t edgesOf(uint8_t)noexcept;
+
+        /**
+         * \brief Detect the edges a change in one module's digital inputs triggers, and wake the threads waiting on them
+         * \param module The source module of the inputs
+         * \param channels The number of channels in the module
+         * \param previous The inputs before the change
+         * \param current The inputs after the change
+         * \param time_stamp The FPGA time of the change in microseconds
+         */
+
+        void updateDigitalSource(uint8_t, uint8_t, uint16_t, uint16_t, uint32_t);
+
+    public:
+        /**
+         * \brief Get the bits an interrupt asserts
+         * \param index The index of the interrupt
+         * \return The mask of the interrupt's rising and falling edge bits
+         */
+
+        static uint32_t maskOf(uint8_t)noexcept;
+
+        /**
+         * \brief Get the configuration of an interrupt
+         * \param index The index of the interrupt
+         * \return The interrupt's configuration
+         */
+
+        nFPGA::nRoboRIO_FPGANamespace::tInterrupt::tConfig getConfig(uint8_t);
+
+        /**
+         * \brief Set the configuration of an interrupt
+         * \param index The index of the interrupt
+         * \param config The configuration to use
+         */
+
+        void setConfig(uint8_t, nFPGA::nRoboRIO_FPGANamespace::tInterrupt::tConfig);
+
+        /**
+         * \brief Get the time of an interrupt's last rising edge
+         * \param index The index of the interrupt
+         * \return The FPGA time in microseconds
+         */
+
+        uint32_t getRisingTimeStamp(uint8_t);
+
+        /**
+         * \brief Get the time of an interrupt's last falling edge
+         * \param index The index of the interrupt
+         * \return The FPGA time in microseconds
+         */
+
+        uint32_t getFallingTimeStamp(uint8_t);
+
+        /**
+         * \brief Detect the edges a change in digital header inputs triggers, and wake the threads waiting on them
+         * \param previous The digital header inputs before the change
+         * \param current The digital header inputs after the change
+         * \param time_stamp The FPGA time of the change in microseconds
+         */
+
+        void updateHeaders(uint16_t, uint16_t, uint32_t);
+
+        /**
+         * \brief Detect the edges a change in digital MXP inputs triggers, and wake the threads waiting on them
+         * \param previous The digital MXP inputs before the change
+         * \param current The digital MXP inputs after the change
+         * \param time_stamp The FPGA time of the change in microseconds
+         */
+
+        void updateMXP(uint16_t, uint16_t, uint32_t);
+
+        /**
+         * \brief Assert the alarm interrupt and wake the threads waiting on it
+         */
+
+        void assertAlarm();
+
+        /**
+         * \brief Wait for an interrupt to assert, then acknowledge the edges waited for
+         * \param mask The edges to wait for, all of one interrupt, or the alarm bit
+         * \param timeout How long to wait, or a negative duration to wait until an edge arrives or the wait is released
+         * \param ignore_previous Whether to discard edges which asserted before the call
+         * \param active If not nullptr, the wait also ends once this is false; it must be cleared before calling release so the wake is not missed
+         * \return The edges which asserted, or zero if the wait timed out or was released
+         */
+
+        uint32_t wait(uint32_t, std::chrono::microseconds, bool, const std::atomic<bool>* = nullptr);
+
+        /**
+         * \brief Wake every thread waiting on an interrupt without an edge
+         * \param mask Edges of the interrupt whose waiters to release
+         */
+
+        void release(uint32_t);
+
+        /**
+         * Constructor for InterruptSystem
+         */
+
+        InterruptSystem()noexcept;
+
+        InterruptSystem(const InterruptSystem&) = delete;
+        InterruptSystem& operator=(const InterruptSystem&) = delete;
+    };
+}
+
+#endif
@@ -0,0 +1,216 @@
+#ifndef _IO_RECORDER_HPP_
+#define _IO_RECORDER_HPP_
+
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "binary_util.hpp"
+#include "util.hpp"
+
+namespace hel{
+
+    /**
+     * \brief Records every packet exchanged with the engine to a log, so a run can be replayed without the engine by the IOReplayer
+     * The log starts with LOG_MAGIC and LOG_VERSION. Each record follows as its direction (1 byte), wire format (1 byte), robot instance ID (2 bytes), FPGA time in microseconds (8 bytes), packet length (4 bytes), and the packet itself, all little-endian.
+     * Packets are appended to a buffer by the threads exchanging them and written to the file by a background thread, so recording never waits on the disk.
+     */
+
+    class IORecorder{
+    public:
+        /**
+         * \brief Which way a recorded packet travelled
+         */
+
+        enum class Direction: uint8_t{
+            INPUT,
+            OUTPUT
+        };
+
+        /**
+         * \brief One packet in a log
+         */
+
+        struct Record{
+            /**
+             * \brief Whether the packet was received from or sent to the engine
+             */
+
+            Direction direction;
+
+            /**
+             * \brief The wire format of the packet
+             */
+
+            WireFormat format;
+
+            /**
+             * \brief The ID of the robot instance the packet belongs to
+             */
+
+            uint16_t robot_id;
+
+            /**
+             * \brief The FPGA time the packet was applied or sent at, in microseconds
+             */
+
+            uint64_t time;
+
+            /**
+             * \brief The packet, exactly as it was applied or sent
+             */
+
+            std::string packet;
+        };
+
+        /**
+         * \brief The bytes every log starts with
+         */
+
+        static const std::string LOG_MAGIC;
+
+        /**
+         * \brief The version of the log format, which follows LOG_MAGIC
+         */
+
+        static constexpr uint8_t LOG_VERSION = 1;
+
+        /**
+         * \brief The environment variable naming the log to record to; recording is disabled if it is unset
+         */
+
+        static const std::string LOG_PATH_VARIABLE;
+
+        /**
+         * \brief Append a packet to the log named by LOG_PATH_VARIABLE, or do nothing if recording is disabled
+         * \param direction Whether the packet was received from or sent to the engine
+         * \param format The wire format of the packet
+         * \param robot_id The ID of the robot instance the packet belongs to
+         * \param packet The packet
+         */
+
+        static void record(Direction, WireFormat, unsigned, StringView);
+
+        /**
+         * \brief Append a record to a log being built in memory
+         * \param log The log to append to
+         * \param direction Whether the packet was received from or sent to the engine
+         * \param format The wire format of the packet
+         * \param robot_id The ID of the robot instance the packet belongs to
+         * \param time The FPGA time the packet was applied or sent at, in microseconds
+         * \param packet The packet
+         */
+
+        static void appendRecord(std::string&, Direction, WireFormat, unsigned, uint64_t, StringView);
+
+        /**
+         * \brief Read every record in a log
+         * A record cut off at the end of the log, such as by the robot program being killed, is dropped with a warning
+         * \param input The log to read
+         * \return The records, in the order they were recorded
+         */
+
+        static std::vector<Record> readLog(std::istream&);
+
+        /**
+         * \brief Append a packet to the log
+         * \param direction Whether the packet was received from or sent to the engine
+         * \param format The wire format of the packet
+         * \param robot_id The ID of the robot instance the packet belongs to
+         * \param packet The packet
+         */
+
+        void append(Direction, WireFormat, unsigned, StringView);
+
+        /**
+         * \brief Block until every packet appended so far is written to the file
+         */
+
+        void flush();
+
+        /**
+         * Constructor for IORecorder
+         * \param path The log file to create, replacing any existing file
+         */
+
+        explicit IORecorder(const std::string&);
+
+        IORecorder(const IORecorder&) = delete;
+
+        IORecorder& operator=(const IORecorder&) = delete;
+
+        /**
+         * Deconstructor for IORecorder
+         * Writes every packet appended so far before returning
+         */
+
+        ~IORecorder();
+
+    private:
+        /**
+         * \brief The size of the fixed fields at the start of each record
+         */
+
+        static constexpr std::size_t RECORD_HEADER_SIZE = 16;
+
+        /**
+         * \brief Get the recorder for LOG_PATH_VARIABLE, creating it on first use
+         * \return The recorder, or nullptr if recording is disabled or the log could not be created
+         */
+
+        static IORecorder* active();
+
+        std::ofstream file;
+
+        std::mutex buffer_mutex;
+
+        /**
+         * \brief Signalled when records are appended, when a write finishes, and when stopping
+         */
+
+        std::condition_variable buffer_changed;
+
+        /**
+         * \brief Records appended but not yet taken by the writer thread
+         */
+
+        std::string pending;
+
+        /**
+         * \brief The number of bytes appended since the recorder started
+         */
+
+        uint64_t appended;
+
+        /**
+         * \brief The number of bytes written to the file since the recorder started
+         */
+
+        uint64_t written;
+
+        /**
+         * \brief Whether the writer thread should write what remains and exit
+         */
+
+        bool stopping;
+
+        /**
+         * \brief Writes pending records to the file
+         */
+
+        std::thread writer;
+
+        /**
+         * \brief The body of the writer thread
+         */
+
+        void writeLoop();
+    };
+}
+
+#endif
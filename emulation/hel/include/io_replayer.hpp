@@ -0,0 +1,176 @@
+#ifndef _IO_REPLAYER_HPP_
+#define _IO_REPLAYER_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "io_recorder.hpp"
+#include "send_data.hpp"
+
+namespace hel{
+
+    /**
+     * \brief Reruns a robot program against the inputs in an I/O log, without the engine, and checks its outputs against those recorded
+     * Inputs are applied as fast as the user program can run its loop, which is held at SimClock's loop barrier between inputs. Before each new input, the outputs the program has produced are compared with the last ones recorded before that input.
+     * Outputs are compared by value rather than byte for byte, since delta packets depend on when each was sent. Every recorded output stream begins with a deep packet, and later packets replace only the outputs they hold, so the replay's deep outputs are compared with every output recorded. Replays of runs recorded in lockstep mode should match exactly; free-running recordings may report mismatches wherever the original program lagged behind its inputs.
+     */
+
+    class IOReplayer{
+    public:
+        /**
+         * \brief A point in the replay where the outputs differ from those recorded
+         */
+
+        struct Mismatch{
+            /**
+             * \brief The recorded time of the input the outputs were checked before, in microseconds since the first input
+             */
+
+            uint64_t time;
+
+            /**
+             * \brief The recorded outputs
+             */
+
+            std::string expected;
+
+            /**
+             * \brief The outputs produced by the replay
+             */
+
+            std::string actual;
+        };
+
+        /**
+         * \brief The outcome of a replay
+         */
+
+        struct ReplayReport{
+            /**
+             * \brief The number of input packets applied
+             */
+
+            uint64_t inputs;
+
+            /**
+             * \brief The number of user program loop iterations run
+             */
+
+            uint64_t loops;
+
+            /**
+             * \brief The number of times the outputs were compared
+             */
+
+            uint64_t checks;
+
+            /**
+             * \brief The host time the replay took
+             */
+
+            std::chrono::microseconds wall_time;
+
+            /**
+             * \brief The comparisons which failed, in order
+             */
+
+            std::vector<Mismatch> mismatches;
+
+            /**
+             * \brief Format the report, with up to MAX_REPORTED_MISMATCHES mismatches on their own lines
+             * \return The formatted report
+             */
+
+            std::string toString()const;
+        };
+
+        /**
+         * \brief The number of mismatches described by ReplayReport::toString; the rest are only counted
+         */
+
+        static constexpr std::size_t MAX_REPORTED_MISMATCHES = 10;
+
+        /**
+         * \brief The environment variable naming the log to replay
+         * It is a constant expression so the headless runner's entry point can check it during static initialization
+         */
+
+        static constexpr const char* LOG_PATH_VARIABLE = "HEL_REPLAY_LOG";
+
+        /**
+         * \brief The environment variable selecting the robot instance to replay, for logs recorded from several; defaults to the robot of the first record
+         */
+
+        static constexpr const char* ROBOT_VARIABLE = "HEL_REPLAY_ROBOT";
+
+    private:
+        /**
+         * \brief The records of the replayed robot
+         */
+
+        std::vector<IORecorder::Record> records;
+
+        /**
+         * \brief The recorded outputs as of the record being replayed
+         */
+
+        SendData expected;
+
+        /**
+         * \brief The wire format of the last recorded output, or nothing if none has been seen yet
+         */
+
+        Maybe<WireFormat> expected_format;
+
+        /**
+         * \brief Apply a recorded output to the expected outputs
+         * \param record The output record
+         */
+
+        void applyOutputs(const IORecorder::Record&);
+
+        /**
+         * \brief Apply a recorded input packet to the current robot instance
+         * \param record The input record
+         */
+
+        static void applyInputs(const IORecorder::Record&);
+
+        /**
+         * \brief Compare the current outputs with the expected outputs
+         * \param time The time to report a mismatch at, in microseconds since the first input
+         * \param report The report to add any mismatch to
+         */
+
+        void check(uint64_t, ReplayReport&);
+
+    public:
+        /**
+         * \brief Replay the log
+         * The user program must be running, and nothing else may be exchanging its packets
+         * \return The report for the replay
+         */
+
+        ReplayReport run();
+
+        /**
+         * \brief Wait for HAL to initialize, replay the log configured by the environment, and exit the process
+         * The process exits with failure if any outputs differ from those recorded
+         * Suitable for engine_stand_in
+         */
+
+        static void runFromEnvironment();
+
+        /**
+         * Constructor for IOReplayer
+         * \param records The records of a log
+         * \param robot_id The ID of the robot instance whose records to replay
+         */
+
+        IOReplayer(const std::vector<IORecorder::Record>&, unsigned);
+    };
+}
+
+#endif
@@ -6,6 +6,11 @@
 #include "bounds_checked_array.hpp"
 
 namespace hel{
+    struct BinaryReader;
+    struct BinaryWriter;
+    struct JSONReader;
+    struct JSONWriter;
+
 
     /**
      * \brief A data container for joystick data
@@ -309,6 +314,13 @@ namespace hel{
 
         std::string serialize()const;
 
+        /**
+         * \brief Append the joystick data to a JSON packet
+         * \param writer The JSONWriter to append to
+         */
+
+        void serialize(JSONWriter&)const;
+
         /**
          * \brief Convert a JSON joystick object to a Joystick object
          * \param input The JSON string to parse
@@ -317,6 +329,29 @@ namespace hel{
 
         static Joystick deserialize(std::string);
 
+        /**
+         * \brief Read a JSON joystick object into a Joystick object
+         * \param reader The JSONReader positioned at the start of the object
+         * \return The parsed Joystick object
+         */
+
+        static Joystick deserialize(JSONReader&);
+
+        /**
+         * \brief Append the joystick data to a binary packet
+         * \param writer The BinaryWriter to append to
+         */
+
+        void serializeBinary(BinaryWriter&)const;
+
+        /**
+         * \brief Read a Joystick object from a binary packet
+         * \param reader The BinaryReader to read from
+         * \return The parsed Joystick object
+         */
+
+        static Joystick deserializeBinary(BinaryReader&);
+
         /**
          * \brief Format the Joystick data as a string
          * \return The Joystick data in string format
@@ -0,0 +1,329 @@
+#ifndef _JSON_SCHEMA_HPP_
+#define _JSON_SCHEMA_HPP_
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "bounds_checked_array.hpp"
+#include "json_util.hpp"
+#include "util.hpp"
+
+namespace hel{
+    /**
+     * \brief Which packets a schema field appears in
+     * Shallow fields are supported by Synthesis's engine and appear in every packet, while deep fields only appear in deep packets
+     */
+
+    enum class SchemaDepth{
+        SHALLOW,
+        DEEP
+    };
+
+    /**
+     * \brief Append a boolean as a JSON value
+     * \param writer The JSONWriter to append to
+     * \param value The value to append
+     */
+
+    inline void writeJSONValue(JSONWriter& writer, bool value){
+        writer.write(value);
+    }
+
+    /**
+     * \brief Append an integer as a JSON value
+     * \param writer The JSONWriter to append to
+     * \param value The value to append
+     */
+
+    template<typename T>
+    std::enable_if_t<std::is_integral<T>::value> writeJSONValue(JSONWriter& writer, T value){
+        writer.write(value);
+    }
+
+    /**
+     * \brief Append a floating point number as a JSON value
+     * \param writer The JSONWriter to append to
+     * \param value The value to append
+     */
+
+    inline void writeJSONValue(JSONWriter& writer, double value){
+        writer.write(value);
+    }
+
+    /**
+     * \brief Append an enum as a quoted JSON string, using its asString function
+     * \param writer The JSONWriter to append to
+     * \param value The value to append
+     */
+
+    template<typename T>
+    std::enable_if_t<std::is_enum<T>::value> writeJSONValue(JSONWriter& writer, T value){
+        writer.writeString(asString(value));
+    }
+
+    /**
+     * \brief Append an object as a JSON value, using its serialize function
+     * \param writer The JSONWriter to append to
+     * \param value The value to append
+     */
+
+    template<typename T>
+    auto writeJSONValue(JSONWriter& writer, const T& value) -> decltype(value.serialize(writer), void()){
+        value.serialize(writer);
+    }
+
+    /**
+     * \brief Append an optional value as a JSON value, or null if it is not set
+     * \param writer The JSONWriter to append to
+     * \param value The value to append
+     */
+
+    template<typename T>
+    void writeJSONValue(JSONWriter& writer, const Maybe<T>& value){
+        if(value){
+            writeJSONValue(writer, value.get());
+        } else {
+            writer.writeRaw("null");
+        }
+    }
+
+    /**
+     * \brief Append a fixed-size array as a JSON list
+     * \param writer The JSONWriter to append to
+     * \param value The array to append
+     */
+
+    template<typename T, std::size_t LEN>
+    void writeJSONValue(JSONWriter& writer, const BoundsCheckedArray<T, LEN>& value){
+        writer.writeRaw('[');
+        for(std::size_t i = 0; i < LEN; i++){
+            if(i != 0){
+                writer.writeRaw(',');
+            }
+            writeJSONValue(writer, value[i]);
+        }
+        writer.writeRaw(']');
+    }
+
+    /**
+     * \brief Append the values of a map as a JSON list
+     * The keys are not written, so each value should hold its own key
+     * \param writer The JSONWriter to append to
+     * \param value The map to append
+     */
+
+    template<typename K, typename V>
+    void writeJSONValue(JSONWriter& writer, const std::map<K, V>& value){
+        writer.writeRaw('[');
+        for(auto i = value.begin(); i != value.end(); ++i){
+            if(i != value.begin()){
+                writer.writeRaw(',');
+            }
+            writeJSONValue(writer, i->second);
+        }
+        writer.writeRaw(']');
+    }
+
+    /**
+     * \brief Read a boolean JSON value
+     * \param reader The JSONReader positioned at the start of the value
+     * \param value Set to the value read
+     */
+
+    inline void readJSONValue(JSONReader& reader, bool& value){
+        value = reader.readBool();
+    }
+
+    /**
+     * \brief Read an integer JSON value
+     * \param reader The JSONReader positioned at the start of the value
+     * \param value Set to the value read
+     */
+
+    template<typename T>
+    std::enable_if_t<std::is_integral<T>::value> readJSONValue(JSONReader& reader, T& value){
+        value = reader.readInteger<T>();
+    }
+
+    /**
+     * \brief Read a floating point JSON value
+     * \param reader The JSONReader positioned at the start of the value
+     * \param value Set to the value read
+     */
+
+    inline void readJSONValue(JSONReader& reader, double& value){
+        value = reader.readDouble();
+    }
+
+    /**
+     * \brief Read a JSON object, using the type's static deserialize function
+     * \param reader The JSONReader positioned at the start of the object
+     * \param value Set to the object read
+     */
+
+    template<typename T>
+    auto readJSONValue(JSONReader& reader, T& value) -> decltype(value = T::deserialize(reader), void()){
+        value = T::deserialize(reader);
+    }
+
+    /**
+     * \brief Read an optional JSON value, which is unset if the value is null
+     * \param reader The JSONReader positioned at the start of the value
+     * \param value Set to the value read
+     */
+
+    template<typename T>
+    void readJSONValue(JSONReader& reader, Maybe<T>& value){
+        if(reader.readNull()){
+            value = Maybe<T>();
+            return;
+        }
+        T data;
+        readJSONValue(reader, data);
+        value = Maybe<T>(data);
+    }
+
+    /**
+     * \brief Read a JSON list which must exactly fill a fixed-size array
+     * \param reader The JSONReader positioned at the start of the list
+     * \param value The array to fill
+     */
+
+    template<typename T, std::size_t LEN>
+    void readJSONValue(JSONReader& reader, BoundsCheckedArray<T, LEN>& value){
+        reader.beginList();
+        std::size_t i = 0;
+        while(reader.nextElement()){
+            readJSONValue(reader, value[i]); //throws if the list is too long
+            i++;
+        }
+        if(i != LEN){
+            throw std::out_of_range("Exception: deserialization resulted in list of " + std::to_string(i) + " elements, expected " + std::to_string(LEN));
+        }
+    }
+
+    /**
+     * \brief Describes one member of a struct in its JSON format
+     * Use HEL_SCHEMA_FIELD to declare fields, which gives each a label
+     * \tparam Owner The struct holding the member
+     * \tparam T The type of the member
+     * \tparam MEMBER The member
+     * \tparam DEPTH Which packets the member appears in
+     */
+
+    template<typename Owner, typename T, T Owner::*MEMBER, SchemaDepth DEPTH>
+    struct SchemaField{
+        /**
+         * \brief Check if the field appears in packets of the given depth
+         * \param depth The depth of the packet
+         * \return True if the field appears in the packet
+         */
+
+        static constexpr bool includedIn(SchemaDepth depth)noexcept{
+            return DEPTH == SchemaDepth::SHALLOW || depth == SchemaDepth::DEEP;
+        }
+
+        static constexpr T& get(Owner& owner)noexcept{
+            return owner.*MEMBER;
+        }
+
+        static constexpr const T& get(const Owner& owner)noexcept{
+            return owner.*MEMBER;
+        }
+    };
+
+/**
+ * \brief Declare a schema field named NAME for OWNER::MEMBER with the JSON label LABEL
+ * Declare fields inside OWNER after the member so the schema can access private members
+ */
+
+#define HEL_SCHEMA_FIELD(NAME, OWNER, MEMBER, LABEL, DEPTH)                                     \
+    struct NAME: hel::SchemaField<OWNER, decltype(OWNER::MEMBER), &OWNER::MEMBER, DEPTH>{     \
+        static constexpr const char* label()noexcept{                                           \
+            return LABEL;                                                                       \
+        }                                                                                       \
+        static constexpr std::size_t length()noexcept{                                          \
+            return sizeof(LABEL) - 1;                                                           \
+        }                                                                                       \
+        static constexpr std::size_t hash()noexcept{                                            \
+            return hel::hasher(LABEL);                                                          \
+        }                                                                                       \
+    }
+
+    /**
+     * \brief An ordered list of schema fields describing the JSON format of a struct
+     * The serializer, parser, and shallow and deep subsets are all generated from this list, so they cannot disagree
+     * \tparam Fields The fields in the order they are written
+     */
+
+    template<typename... Fields>
+    struct Schema{
+    private:
+        /**
+         * \brief Used to expand a parameter pack into a sequence of expressions
+         */
+
+        using Expand = int[];
+
+        template<SchemaDepth DEPTH, typename Field, typename Owner>
+        static void serializeField(JSONWriter& writer, const Owner& owner, bool& first){
+            if(!Field::includedIn(DEPTH)){ //constant, so excluded fields generate no code
+                return;
+            }
+            if(!first){
+                writer.writeRaw(',');
+            }
+            first = false;
+            writer.writeLabel(Field::label());
+            writeJSONValue(writer, Field::get(owner));
+        }
+
+        template<SchemaDepth DEPTH, typename Field, typename Owner>
+        static bool deserializeField(JSONReader& reader, StringView label, std::size_t hash, Owner& owner){
+            if(!Field::includedIn(DEPTH) || hash != Field::hash() || !(label == StringView(Field::label(), Field::length()))){
+                return false;
+            }
+            try{
+                readJSONValue(reader, Field::get(owner));
+            } catch(const std::exception& ex){
+                throw JSONParsingException(Field::label());
+            }
+            return true;
+        }
+
+    public:
+        /**
+         * \brief Append the fields of the given depth as the labelled values of a JSON object, without the enclosing brackets
+         * \tparam DEPTH The depth of the packet
+         * \param writer The JSONWriter to append to
+         * \param owner The struct to serialize
+         */
+
+        template<SchemaDepth DEPTH, typename Owner>
+        static void serialize(JSONWriter& writer, const Owner& owner){
+            bool first = true;
+            (void)Expand{0, (serializeField<DEPTH, Fields>(writer, owner, first), 0)...};
+        }
+
+        /**
+         * \brief Read the value of the field with the given label
+         * \tparam DEPTH The depth of the packet
+         * \param reader The JSONReader positioned at the start of the value
+         * \param label The label of the value
+         * \param owner The struct to update
+         * \return False if no field of the given depth has the label, in which case nothing is read
+         */
+
+        template<SchemaDepth DEPTH, typename Owner>
+        static bool deserialize(JSONReader& reader, StringView label, Owner& owner){
+            const std::size_t HASH = hasher(label);
+            bool found = false;
+            (void)Expand{0, (found = found || deserializeField<DEPTH, Fields>(reader, label, HASH, owner), 0)...};
+            return found;
+        }
+    };
+}
+
+#endif
@@ -1,10 +1,14 @@
 #ifndef _JSON_UTIL_HPP_
 #define _JSON_UTIL_HPP_
 
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <functional>
+#include <stdexcept>
+#include <type_traits>
 #include "bounds_checked_array.hpp"
+#include "util.hpp"
 
 namespace hel{
     /**
@@ -21,10 +25,10 @@ namespace hel{
     struct JSONParsingException: std::exception{
     private:
         /**
-         * \brief Details about the JSON parsing exception
+         * \brief The exception message
          */
 
-        std::string details;
+        std::string message;
 
     public:
         /**
@@ -41,6 +45,274 @@ namespace hel{
         JSONParsingException(std::string);
     };
 
+    /**
+     * \brief Reads JSON values from a buffer in a single forward pass
+     * Values are parsed in place as the reader advances, so no intermediate substrings are created. Reading malformed data throws a JSONParsingException
+     */
+
+    struct JSONReader{
+    private:
+        /**
+         * \brief The next character to read
+         */
+
+        const char* position;
+
+        /**
+         * \brief One past the last readable character
+         */
+
+        const char* end;
+
+        /**
+         * \brief Advance past any whitespace
+         */
+
+        void skipWhitespace()noexcept;
+
+        /**
+         * \brief Consume the given character, throwing if it is not next
+         * \param c The expected character
+         */
+
+        void expect(char);
+
+        /**
+         * \brief Read a signed integer token
+         * \return The value read
+         */
+
+        int64_t readSigned();
+
+    public:
+        /**
+         * \brief Consume the opening bracket of a JSON object
+         * Follow with calls to nextField until it returns false
+         */
+
+        void beginObject();
+
+        /**
+         * \brief Advance to the next field of the current object
+         * \param label Set to the label of the next field, without its quotation marks
+         * \return False if the object has ended, in which case its closing bracket is consumed
+         */
+
+        bool nextField(StringView&);
+
+        /**
+         * \brief Consume the opening bracket of a JSON list
+         * Follow with calls to nextElement until it returns false
+         */
+
+        void beginList();
+
+        /**
+         * \brief Advance to the next element of the current list
+         * \return False if the list has ended, in which case its closing bracket is consumed
+         */
+
+        bool nextElement();
+
+        /**
+         * \brief Consume a null value if one is next
+         * \return True if a null was consumed
+         */
+
+        bool readNull();
+
+        /**
+         * \brief Read a string value
+         * Escape sequences are skipped over but not decoded
+         * \return A view of the string's characters, without its quotation marks
+         */
+
+        StringView readString();
+
+        /**
+         * \brief Read an integer value
+         * \tparam T The integral type to read
+         * \return The value read
+         */
+
+        template<typename T>
+        T readInteger(){
+            static_assert(std::is_integral<T>::value, "JSONReader::readInteger only accepts integral types");
+            return static_cast<T>(readSigned());
+        }
+
+        /**
+         * \brief Read a floating point value
+         * \return The value read
+         */
+
+        double readDouble();
+
+        /**
+         * \brief Read a boolean value written as either a number or a literal
+         * \return The value read
+         */
+
+        bool readBool();
+
+        /**
+         * \brief Advance past the next value, including any nested objects and lists
+         * \return A view of the skipped value's characters
+         */
+
+        StringView skipValue();
+
+        /**
+         * Constructor for JSONReader
+         * \param input The buffer to read, which must outlive the reader
+         */
+
+        explicit JSONReader(StringView)noexcept;
+    };
+
+    /**
+     * \brief Read a JSON list into a fixed-size array
+     * \param reader The reader positioned at the start of the list
+     * \param array The array to fill, which the list must exactly fill
+     * \param from_json The function used to read each element from the reader
+     */
+
+    template<typename T, std::size_t LEN, typename Function>
+    void deserializeList(JSONReader& reader, BoundsCheckedArray<T, LEN>& array, Function from_json){
+        reader.beginList();
+        std::size_t i = 0;
+        while(reader.nextElement()){
+            array[i] = from_json(reader); //throws if the list is too long
+            i++;
+        }
+        if(i != LEN){
+            throw std::out_of_range("Exception: deserialization resulted in list of " + std::to_string(i) + " elements, expected " + std::to_string(LEN));
+        }
+    }
+
+    /**
+     * \brief Appends JSON values to a buffer
+     * Values are formatted directly into the buffer, so a buffer with enough reserved capacity is never reallocated
+     */
+
+    struct JSONWriter{
+    private:
+        /**
+         * \brief The buffer to append to
+         */
+
+        std::string& output;
+
+        /**
+         * \brief Append the decimal digits of an unsigned integer
+         * \param value The integer to append
+         */
+
+        void writeDigits(uint64_t);
+
+    public:
+        /**
+         * \brief The number of digits written after the decimal point of floating point values
+         * This matches std::to_string's formatting
+         */
+
+        static constexpr unsigned DECIMAL_PLACES = 6;
+
+        /**
+         * \brief Append characters without any formatting
+         * \param value The characters to append
+         */
+
+        void writeRaw(StringView);
+
+        /**
+         * \brief Append characters without any formatting
+         * \param value The null-terminated characters to append
+         */
+
+        void writeRaw(const char*);
+
+        /**
+         * \brief Append a character without any formatting
+         * \param value The character to append
+         */
+
+        void writeRaw(char);
+
+        /**
+         * \brief Append a field label and its following colon
+         * \param label The label, without quotation marks
+         */
+
+        void writeLabel(const char*);
+
+        /**
+         * \brief Append a quoted string value
+         * The characters are not escaped
+         * \param value The string to append
+         */
+
+        void writeString(StringView);
+
+        /**
+         * \brief Append a boolean value as 0 or 1
+         * \param value The value to append
+         */
+
+        void write(bool);
+
+        /**
+         * \brief Append a floating point value with DECIMAL_PLACES fixed decimal places
+         * \param value The value to append
+         */
+
+        void write(double);
+
+        /**
+         * \brief Append an integer value
+         * \tparam T The integral type to write
+         * \param value The value to append
+         */
+
+        template<typename T, typename = std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value>>
+        void write(T value){
+            if(value < 0){
+                output.push_back('-');
+                writeDigits(0 - static_cast<uint64_t>(value)); //negate after widening so the minimum value does not overflow
+            } else {
+                writeDigits(static_cast<uint64_t>(value));
+            }
+        }
+
+        /**
+         * Constructor for JSONWriter
+         * \param out The buffer to append to
+         */
+
+        explicit JSONWriter(std::string&)noexcept;
+    };
+
+    /**
+     * \brief Append a labelled JSON list
+     * \param writer The writer to append to
+     * \param label The JSON label to use, without quotation marks
+     * \param iterable The data to serialize
+     * \param to_json The function used to write each element to the writer
+     */
+
+    template<typename T, typename Function>
+    void serializeList(JSONWriter& writer, const char* label, const T& iterable, Function to_json){
+        writer.writeLabel(label);
+        writer.writeRaw('[');
+        for(auto i = iterable.begin(); i != iterable.end(); ++i){
+            if(i != iterable.begin()){
+                writer.writeRaw(',');
+            }
+            to_json(writer, *i);
+        }
+        writer.writeRaw(']');
+    }
+
     /**
      * \brief Serialize an iterable container as a JSON string
      * \param label The JSON label to use
@@ -6,6 +6,11 @@
 #include <string>
 
 namespace hel{
+    struct BinaryReader;
+    struct BinaryWriter;
+    struct JSONReader;
+    struct JSONWriter;
+
 
     /**
      * \brief A data container for match/driver station information
@@ -177,6 +182,29 @@ namespace hel{
 
         static MatchInfo deserialize(std::string);
 
+        /**
+         * \brief Read a JSON object into a MatchInfo object
+         * \param reader The JSONReader positioned at the start of the object
+         * \return The parsed MatchInfo object
+         */
+
+        static MatchInfo deserialize(JSONReader&);
+
+        /**
+         * \brief Append the match information to a binary packet
+         * \param writer The BinaryWriter to append to
+         */
+
+        void serializeBinary(BinaryWriter&)const;
+
+        /**
+         * \brief Read a MatchInfo object from a binary packet
+         * \param reader The BinaryReader to read from
+         * \return The parsed MatchInfo object
+         */
+
+        static MatchInfo deserializeBinary(BinaryReader&);
+
         /**
          * \brief Format the match information as JSON
          * \return The match information in JSON format
@@ -184,6 +212,13 @@ namespace hel{
 
         std::string serialize()const;
 
+        /**
+         * \brief Append the match information to a JSON packet
+         * \param writer The JSONWriter to append to
+         */
+
+        void serialize(JSONWriter&)const;
+
         /**
          * \brief Convert the match information to string format
          * \return A string containing the match info
@@ -0,0 +1,196 @@
+#ifndef _MPMC_RING_HPP_
+#define _MPMC_RING_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace hel{
+
+    /**
+     * \brief Bounded lock-free multi-producer multi-consumer queue
+     * Each slot carries a sequence number saying whether it is free for the producer claiming its position or filled for the consumer claiming it, so producers and consumers claim positions with a compare-and-swap and never take a lock. Values pushed by one producer are popped in the order they were pushed.
+     * \tparam T The type of value held by the ring
+     */
+
+    template<typename T>
+    class MPMCRing{
+    private:
+        /**
+         * \brief The assumed size of a cache line, used to keep head and tail from sharing one
+         */
+
+        static constexpr std::size_t CACHE_LINE = 64;
+
+        /**
+         * \brief One slot of the ring
+         */
+
+        struct Slot{
+            /**
+             * \brief The position which may next use the slot: equal to it when free for a producer, one past it when filled for a consumer
+             */
+
+            std::atomic<uint32_t> sequence;
+
+            /**
+             * \brief The value held by the slot
+             */
+
+            T value;
+        };
+
+        /**
+         * \brief The slots of the ring, whose count is a power of two so indices wrap with a mask
+         */
+
+        std::unique_ptr<Slot[]> slots;
+
+        /**
+         * \brief The mask to turn a position into a slot index
+         */
+
+        uint32_t index_mask;
+
+        /**
+         * \brief The most values the ring holds at once
+         */
+
+        uint32_t capacity;
+
+        /**
+         * \brief The position the next value is pushed to
+         */
+
+        std::atomic<uint32_t> head;
+
+        char head_padding[CACHE_LINE - sizeof(std::atomic<uint32_t>)];
+
+        /**
+         * \brief The position the next value is popped from
+         */
+
+        std::atomic<uint32_t> tail;
+
+        char tail_padding[CACHE_LINE - sizeof(std::atomic<uint32_t>)];
+
+        /**
+         * \brief Round a count up to a power of two
+         * \param count The count to round, at least one
+         * \return The smallest power of two no less than count
+         */
+
+        static uint32_t roundUpToPowerOfTwo(uint32_t count)noexcept{
+            uint32_t size = 1;
+            while(size < count){
+                size <<= 1;
+            }
+            return size;
+        }
+
+    public:
+        /**
+         * \brief Add a value to the ring
+         * \param value The value to add
+         * \return False if the ring is full, in which case the value is dropped
+         */
+
+        bool push(const T& value)noexcept{
+            uint32_t position = head.load(std::memory_order_relaxed);
+            while(true){
+                if(static_cast<int32_t>(position - tail.load(std::memory_order_acquire)) >= static_cast<int32_t>(capacity)){ //signed, since a stale position may be behind tail
+                    return false;
+                }
+                Slot& slot = slots[position & index_mask];
+                const int32_t LAG = static_cast<int32_t>(slot.sequence.load(std::memory_order_acquire) - position);
+                if(LAG == 0){
+                    if(head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)){
+                        slot.value = value;
+                        slot.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if(LAG < 0){ //a consumer has claimed the slot but not finished copying it out
+                    return false;
+                } else { //another producer claimed the position
+                    position = head.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * \brief Remove a value from the ring
+         * \param out Where to copy the removed value
+         * \return False if the ring is empty
+         */
+
+        bool pop(T& out)noexcept{
+            uint32_t position = tail.load(std::memory_order_relaxed);
+            while(true){
+                Slot& slot = slots[position & index_mask];
+                const int32_t LAG = static_cast<int32_t>(slot.sequence.load(std::memory_order_acquire) - (position + 1));
+                if(LAG == 0){
+                    if(tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)){
+                        out = slot.value;
+                        slot.sequence.store(position + index_mask + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if(LAG < 0){ //empty, or the producer which claimed the position has not finished writing it
+                    return false;
+                } else { //another consumer claimed the position
+                    position = tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * \brief Remove values from the ring, oldest first
+         * \param out Where to copy the removed values
+         * \param max_count The most values to remove
+         * \return The number of values removed
+         */
+
+        std::size_t pop(T* out, std::size_t max_count)noexcept{
+            std::size_t count = 0;
+            while(count < max_count && pop(out[count])){
+                count++;
+            }
+            return count;
+        }
+
+        /**
+         * \brief Get the number of values in the ring
+         * The result may be stale by the time it is used if the ring is in use
+         * \return The number of values pushed but not yet popped
+         */
+
+        std::size_t size()const noexcept{
+            return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+        }
+
+        /**
+         * \brief Get the most values the ring holds at once
+         * \return The capacity of the ring
+         */
+
+        std::size_t getCapacity()const noexcept{
+            return capacity;
+        }
+
+        /**
+         * Constructor for MPMCRing
+         * \param capacity The most values the ring holds at once, at least one
+         */
+
+        explicit MPMCRing(uint32_t capacity):slots(new Slot[roundUpToPowerOfTwo(capacity)]()), index_mask(roundUpToPowerOfTwo(capacity) - 1), capacity(capacity), head(0), head_padding(), tail(0), tail_padding(){
+            for(uint32_t i = 0; i <= index_mask; i++){
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MPMCRing(const MPMCRing&) = delete;
+        MPMCRing& operator=(const MPMCRing&) = delete;
+    };
+}
+
+#endif
@@ -0,0 +1,195 @@
+#ifndef _MULTIPLEXED_SYNC_HPP_
+#define _MULTIPLEXED_SYNC_HPP_
+
+#include "robot_instance.hpp"
+#include <asio.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include "binary_util.hpp"
+#include "frame_reader.hpp"
+
+namespace hel{
+    /**
+     * \brief Exchanges the inputs and outputs of several robot instances with the engine over one connection
+     * The engine connects once and must negotiate the binary wire format. Every packet in either direction is a BATCH packet whose payload is a sequence of entries, each a robot instance ID (2 bytes) followed by a complete binary packet for that robot. The engine sends one batch with every robot's inputs per tick; HEL coalesces output changes from all robots and writes one batch carrying the latest outputs of each robot which changed.
+     * Robots served here must not also have their own SyncServer and SyncClient, since each robot's SendData holds a single new data listener.
+     */
+
+    class MultiplexedSync{
+    public:
+        /**
+         * \brief One robot's packet within a batch
+         */
+
+        struct BatchEntry{
+            /**
+             * \brief The ID of the robot instance the packet belongs to
+             */
+
+            uint16_t robot_id;
+
+            /**
+             * \brief The packet, including its header
+             */
+
+            StringView packet;
+        };
+
+        /**
+         * \brief The longest time the session waits for new data before resending every robot's outputs
+         */
+
+        static constexpr std::chrono::milliseconds SEND_IDLE_TIMEOUT{1000};
+
+        /**
+         * \brief Split a batch packet into its entries
+         * \param batch The batch packet, including its header
+         * \return The entries, which view into batch
+         */
+
+        static std::vector<BatchEntry> parseBatch(StringView);
+
+        /**
+         * \brief Append one robot's packet to a batch started with BinaryWriter::beginPacket
+         * \param batch The batch being written
+         * \param robot_id The ID of the robot instance the packet belongs to
+         * \param packet The complete binary packet
+         */
+
+        static void appendBatchEntry(std::string&, uint16_t, const std::string&);
+
+        /**
+         * Constructor for MultiplexedSync
+         * \param io The io_context to run the session on
+         * \param port The port to accept the engine's connection on
+         * \param robots The robot instances to serve
+         */
+
+        MultiplexedSync(asio::io_context&, uint16_t, std::vector<std::shared_ptr<RobotInstance>>);
+
+        /**
+         * Destructor for MultiplexedSync
+         */
+
+        ~MultiplexedSync();
+
+        MultiplexedSync(const MultiplexedSync&) = delete;
+
+        MultiplexedSync& operator=(const MultiplexedSync&) = delete;
+
+    private:
+        asio::io_context& io;
+
+        /**
+         * \brief The robot instances served by this session
+         */
+
+        std::vector<std::shared_ptr<RobotInstance>> robots;
+
+        /**
+         * \brief Whether each robot, by its index in robots, has outputs not yet sent
+         */
+
+        std::unique_ptr<std::atomic<bool>[]> dirty;
+
+        asio::ip::tcp::acceptor acceptor;
+
+        asio::ip::tcp::socket socket;
+
+        /**
+         * \brief Times out the wire format negotiation with a new connection
+         */
+
+        asio::steady_timer negotiation_timer;
+
+        /**
+         * \brief Resends every robot's outputs when no new data is sent for SEND_IDLE_TIMEOUT
+         */
+
+        asio::steady_timer idle_timer;
+
+        /**
+         * \brief Receives data from the engine and splits it into batches
+         */
+
+        FrameReader frames;
+
+        /**
+         * \brief Whether an engine is connected and has finished negotiating
+         */
+
+        bool connected;
+
+        /**
+         * \brief Whether outgoing is being written to the socket
+         */
+
+        bool write_in_progress;
+
+        /**
+         * \brief Whether new data arrived while a batch was being written
+         */
+
+        bool send_pending;
+
+        /**
+         * \brief Whether a notification of new data has been posted to the io_context but not handled
+         */
+
+        std::atomic<bool> notify_posted;
+
+        /**
+         * \brief The batch being written
+         */
+
+        std::string outgoing;
+
+        /**
+         * \brief Accept the next connection
+         */
+
+        void startAccept();
+
+        /**
+         * \brief Read the next chunk of data from the engine
+         */
+
+        void startRead();
+
+        /**
+         * \brief Apply every entry of a batch to its robot's ReceiveData
+         * \param batch The batch packet
+         */
+
+        void applyBatch(StringView);
+
+        /**
+         * \brief Serialize the latest outputs of every robot with new data into one batch and send it, or mark it pending if a batch is being written
+         */
+
+        void sendLatest();
+
+        /**
+         * \brief Mark every robot as having new data
+         */
+
+        void markAllDirty()noexcept;
+
+        /**
+         * \brief Restart the timer which resends every robot's outputs when idle
+         */
+
+        void restartIdleTimer();
+
+        /**
+         * \brief Reset every robot's inputs to their defaults, close the connection, and wait for the engine to reconnect
+         */
+
+        void disconnect();
+    };
+}
+
+#endif
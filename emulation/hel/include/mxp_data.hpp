@@ -2,8 +2,14 @@
 #define _MXP_DATA_HPP_
 
 #include <string>
+#include "util.hpp"
 
 namespace hel{
+    struct BinaryReader;
+    struct BinaryWriter;
+    struct JSONReader;
+    struct JSONWriter;
+
     /**
      * \brief Represents a RoboRIO MXP configurations and values
      */
@@ -45,6 +51,13 @@ namespace hel{
 
         std::string serialize()const;
 
+        /**
+         * \brief Append the port to a JSON packet
+         * \param writer The JSONWriter to append to
+         */
+
+        void serialize(JSONWriter&)const;
+
         /**
          * \brief Convert a JSON object string to an MXPData object
          * \param input The data to parse
@@ -53,6 +66,29 @@ namespace hel{
 
         static MXPData deserialize(std::string);
 
+        /**
+         * \brief Read a JSON object as an MXPData object
+         * \param reader The JSONReader positioned at the start of the object
+         * \return The parsed MXPData object
+         */
+
+        static MXPData deserialize(JSONReader&);
+
+        /**
+         * \brief Append the MXP data to a binary packet
+         * \param writer The BinaryWriter to append to
+         */
+
+        void serializeBinary(BinaryWriter&)const;
+
+        /**
+         * \brief Read a MXPData object from a binary packet
+         * \param reader The BinaryReader to read from
+         * \return The parsed MXPData object
+         */
+
+        static MXPData deserializeBinary(BinaryReader&);
+
         /**
          * Constructor for MXPData
          */
@@ -65,6 +101,8 @@ namespace hel{
          */
 
         MXPData(const MXPData&)noexcept;
+
+        MXPData& operator=(const MXPData&)noexcept = default;
     };
 
     /**
@@ -73,7 +111,7 @@ namespace hel{
      * \return The parsed MXPData::Config
      */
 
-    MXPData::Config s_to_mxp_config(std::string);
+    MXPData::Config s_to_mxp_config(StringView);
 
     /**
      * std::string asString(MXPData::Config config)
@@ -5,13 +5,16 @@
 #include <mutex>
 
 #include "bounds_checked_array.hpp"
+#include "call_profiler.hpp"
 #include "digital_system.hpp"
 #include "encoder_manager.hpp"
 #include "fpga_encoder.hpp"
 #include "joystick.hpp"
+#include "json_schema.hpp"
 #include "match_info.hpp"
 #include "mxp_data.hpp"
 #include "robot_mode.hpp"
+#include "util.hpp"
 
 namespace hel{
     /**
@@ -65,64 +68,76 @@ namespace hel{
         BoundsCheckedArray<Maybe<EncoderManager>, FPGAEncoder::NUM_ENCODERS> encoder_managers;
 
         /**
-         * \brief Deserialize the digital header states from the received JSON string
-         * Consumes the digital headers portion of the JSON string
-         * \param input The JSON string to deserialize
+         * \brief The engine's simulation time in microseconds, if it drives the FPGA clock
          */
 
-        void deserializeDigitalHdrs(std::string&);
+        Maybe<uint64_t> sim_time;
+
+        HEL_SCHEMA_FIELD(DigitalHdrsField, ReceiveData, digital_hdrs, "digital_hdrs", SchemaDepth::SHALLOW);
+        HEL_SCHEMA_FIELD(JoysticksField, ReceiveData, joysticks, "joysticks", SchemaDepth::SHALLOW);
+        HEL_SCHEMA_FIELD(DigitalMXPField, ReceiveData, digital_mxp, "digital_mxp", SchemaDepth::DEEP);
+        HEL_SCHEMA_FIELD(MatchInfoField, ReceiveData, match_info, "match_info", SchemaDepth::SHALLOW);
+        HEL_SCHEMA_FIELD(RobotModeField, ReceiveData, robot_mode, "robot_mode", SchemaDepth::SHALLOW);
+        HEL_SCHEMA_FIELD(EncodersField, ReceiveData, encoder_managers, "encoders", SchemaDepth::SHALLOW);
+        HEL_SCHEMA_FIELD(SimTimeField, ReceiveData, sim_time, "sim_time", SchemaDepth::SHALLOW);
 
         /**
-         * \brief Deserialize the joystick states from the received JSON string
-         * Consumes the joysticks' portion of the JSON string
-         * \param input The JSON string to deserialize
+         * \brief The JSON format of the inputs, in the order they are written
          */
 
-        void deserializeJoysticks(std::string&);
+        using JSONSchema = Schema<DigitalHdrsField, JoysticksField, DigitalMXPField, MatchInfoField, RobotModeField, EncodersField, SimTimeField>;
 
         /**
-         * \brief Deserialize the digital MXP states from the received JSON string
-         * Consumes the digital MXP portion of the JSON string
-         * \param input The JSON string to deserialize
+         * \brief Deserialize each field of a received JSON object in a single pass
+         * Fields are dispatched by label, and unrecognized fields are skipped
+         * \tparam DEPTH Whether to read all inputs supported by HEL or only those supported by Synthesis's engine
+         * \param reader The JSONReader positioned at the start of the object
          */
 
-        void deserializeDigitalMXP(std::string&);
+        template<SchemaDepth DEPTH>
+        void deserializeFields(JSONReader&);
 
         /**
-         * \brief Deserialize the match info from the received JSON string
-         * Consumes the match info portion of the JSON string
-         * \param input The JSON string to deserialize
+         * \brief Parse a given input JSON string and update ReceiveData's internal data
+         * \tparam DEPTH Whether to read all inputs supported by HEL or only those supported by Synthesis's engine
+         * \param input The JSON packet to parse
          */
 
-        void deserializeMatchInfo(std::string&);
+        template<SchemaDepth DEPTH>
+        void deserializeJSON(StringView);
 
         /**
-         * \brief Deserialize the robot mode from the received JSON string
-         * Consumes the robot mode portion of the JSON string
-         * \param input The JSON string to deserialize
+         * \brief Copy the inputs supported by Synthesis's engine into the RoboRIO instance in RoboRIOManager
          */
 
-        void deserializeRobotMode(std::string&);
+        void updateInputs()const;
 
         /**
-         * \brief Deserialize the encoder states from the received JSON string
-         * Consumes the encoders' portion of the JSON string
-         * \param input The JSON string to deserialize
+         * \brief Copy the digital inputs into the RoboRIO instance in RoboRIOManager and trigger the interrupts their edges assert
+         * \param deep Whether to copy the digital MXP inputs as well as the digital header inputs
+         */
+
+        void updateDigitalInputs(bool)const;
+
+        /**
+         * \brief Update the data held by the RoboRIO instance in RoboRIOManager given received data
+         * \param deep Whether to touch all RoboRIO inputs supported by HEL or only those supported by Synthesis's engine
          */
 
-        void deserializeEncoders(std::string&);
+        void update(bool)const;
 
     public:
         /**
          * \brief Update the data held by the RoboRIO instance in RoboRIOManager given received data
          * For efficiency, this only touches the inputs supported by Synthesis's engine.
+         * If the engine sent a simulation time, the FPGA clock is advanced to it.
          */
 
         void updateShallow()const;
 
         /**
          * \brief Update the data held by the RoboRIO instance in RoboRIOManager given received data
-         * This touches all RoboRIO inputs supported by HEL, not just those supported by Synthesis's engine
+         * This touches all RoboRIO inputs supported by HEL, not just those supported by Synthesis's engine. Digital MXP inputs keep the values of the last deep packet received, so this is safe to call after shallow packets too.
          */
 
         void updateDeep()const;
@@ -137,16 +152,34 @@ namespace hel{
         /**
          * \brief Parse a given input JSON string and update ReceiveData's internal data
          * For efficiency, this only touches the inputs supported by Synthesis's engine.
+         * \param input The JSON packet to parse
          */
 
-        void deserializeShallow(std::string);
+        void deserializeShallow(StringView);
 
-/**
+        /**
          * \brief Parse a given input JSON string and update ReceiveData's internal data
          * This touches all RoboRIO inputs supported by HEL, not just those supported by Synthesis's engine
+         * \param input The JSON packet to parse
          */
 
-        void deserializeDeep(std::string);
+        void deserializeDeep(StringView);
+
+        /**
+         * \brief Parse a given binary packet and update ReceiveData's internal data
+         * Shallow packets only touch the inputs supported by Synthesis's engine, while deep packets touch all RoboRIO inputs supported by HEL
+         * \param packet The binary packet to parse, including its header
+         */
+
+        void deserializeBinary(StringView);
+
+        /**
+         * \brief Get a JSON packet holding the default value of every input
+         * Deserializing this resets all the inputs, such as when the engine disconnects
+         * \return The default packet
+         */
+
+        static const std::string& defaultPacket();
 
         /**
          * Constructor for ReceiveData
@@ -157,17 +190,28 @@ namespace hel{
 
     class ReceiveDataManager{ //TODO move to separate file
     public:
-        static std::pair<std::shared_ptr<ReceiveData>, std::unique_lock<std::recursive_mutex>> getInstance() {
-            std::unique_lock<std::recursive_mutex> lock(receive_data_mutex);
-            if(instance == nullptr){
-                instance = std::make_shared<ReceiveData>();
-            }
-            return std::make_pair(instance, std::move(lock));
-        }
+        /**
+         * \brief The ReceiveData of one RobotInstance and the mutex guarding it
+         */
 
-    private:
-        static std::shared_ptr<ReceiveData> instance;
-        static std::recursive_mutex receive_data_mutex;
+        struct State{
+            std::shared_ptr<ReceiveData> instance;
+
+            std::recursive_mutex receive_data_mutex;
+
+            /**
+             * Constructor for State
+             */
+
+            State();
+        };
+
+        /**
+         * \brief Get the ReceiveData instance of the current RobotInstance for use
+         * \return A pair with the ReceiveData instance and its lock
+         */
+
+        static std::pair<std::shared_ptr<ReceiveData>, std::unique_lock<std::recursive_mutex>> getInstance();
     };
 }
 
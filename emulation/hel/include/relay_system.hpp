@@ -5,6 +5,7 @@
 #include "FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tRelay.h"
 
 #include <string>
+#include "util.hpp"
 
 namespace hel{
     /**
@@ -60,7 +61,7 @@ namespace hel{
          * \return The state of the header
          */
 
-        State getState(uint8_t)noexcept;
+        State getState(uint8_t)const noexcept;
 
         /**
          * Constructor for RelaySystem
@@ -84,6 +85,14 @@ namespace hel{
      */
 
     std::string asString(RelaySystem::State);
+
+    /**
+     * \brief Convert a string to a RelaySystem::State
+     * \param input The string to parse
+     * \return The parsed RelaySystem::State
+     */
+
+    RelaySystem::State s_to_relay_state(StringView);
 }
 
 #endif
@@ -9,7 +9,6 @@
 #define ASIO_HAS_STD_TYPE_TRAITS
 
 #include <array>
-#include <map>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -23,7 +22,7 @@
 #include "alarm.hpp"
 #include "analog_inputs.hpp"
 #include "analog_outputs.hpp"
-#include "can_motor_controller.hpp"
+#include "can_motor_controller_table.hpp"
 #include "counter.hpp"
 #include "digital_system.hpp"
 #include "encoder_manager.hpp"
@@ -86,6 +85,44 @@ namespace hel{
      * This class represents the internals of the RoboRIO hardware, broken up into several sub-systems.
      */
     struct RoboRIO{
+        /**
+         * \brief Identifiers for each of the RoboRIO's sub-systems
+         * Each sub-system is guarded by its own lock in RoboRIOManager. When multiple sub-systems are locked at once, they are locked in the order listed here.
+         */
+
+        enum class Subsystem{
+            USER_BUTTON,
+            ACCELEROMETER,
+            ACCUMULATORS,
+            ALARM,
+            ANALOG_INPUTS,
+            ANALOG_OUTPUTS,
+            CAN_MOTOR_CONTROLLERS,
+            COUNTERS,
+            DIGITAL_SYSTEM,
+            DS_ERRORS,
+            MATCH_INFO,
+            ENCODER_MANAGERS,
+            FPGA_ENCODERS,
+            GLOBAL,
+            JOYSTICKS,
+            NET_COMM,
+            POWER,
+            PWM_SYSTEM,
+            RELAY_SYSTEM,
+            ROBOT_MODE,
+            PCM,
+            PDP,
+            SPI_SYSTEM,
+            WATCHDOG
+        };
+
+        /**
+         * \brief The number of RoboRIO sub-systems
+         */
+
+        static constexpr unsigned NUM_SUBSYSTEMS = static_cast<unsigned>(Subsystem::WATCHDOG) + 1;
+
         /**
          * \brief Represents the state of the user button on the roborio
          */
@@ -126,7 +163,7 @@ namespace hel{
          * \brief Represents the states of all the CAN motor controllers
          */
 
-        std::map<uint32_t,CANMotorController> can_motor_controllers;
+        CANMotorControllerTable can_motor_controllers;
 
         /**
          * \brief Represents the states of all the counters
@@ -134,6 +171,12 @@ namespace hel{
 
         BoundsCheckedArray<Counter, Counter::MAX_COUNTER_COUNT> counters;
 
+        /**
+         * \brief Maps encoder ports to the counters whose sources are on them, guarded with the counters
+         */
+
+        EncoderSourceIndex counter_sources;
+
         /**
          * \brief Represents the states of all the digital pins
          */
@@ -165,6 +208,12 @@ namespace hel{
 
         BoundsCheckedArray<FPGAEncoder, FPGAEncoder::NUM_ENCODERS> fpga_encoders;
 
+        /**
+         * \brief Maps encoder ports to the FPGA encoders whose sources are on them, guarded with the FPGA encoders
+         */
+
+        EncoderSourceIndex fpga_encoder_sources;
+
         /**
          * \brief Data manager associated with Ni FPGA's tGlobal class
          */
@@ -235,9 +284,10 @@ namespace hel{
          * Constructor for RoboRIO
          *
          * RoboRIOManager handles the RoboRIO instance used by all of HEL, so this should not be used by anything else
+         * \param fpga_start_time The time in microseconds at which the emulated FPGA started, read from the clock of the RobotInstance which owns this RoboRIO
          */
 
-        explicit RoboRIO()noexcept;
+        explicit RoboRIO(uint64_t)noexcept;
 
         /**
          * Deconstructor for RoboRIO
@@ -1,28 +1,230 @@
 #ifndef _ROBORIO_MANAGER_HPP_
 #define _ROBORIO_MANAGER_HPP_
 
+#include <array>
+#include <initializer_list>
 #include <memory>
 #include <mutex>
 #include <thread>
 
+#include "call_profiler.hpp"
 #include "roborio.hpp"
+#include "triple_buffer.hpp"
 
 namespace hel{
+    class RobotInstance;
 
     /**
-     * \brief Manager of a global RoboRIO instance using a Singleton pattern
+     * \brief A view of the subset of RoboRIO state transmitted to the Synthesis engine
+     * RoboRIOManager publishes each output sub-system separately, so that SendData can read outputs without copying the rest of the RoboRIO or taking its lock. Each sub-system is internally consistent, but sub-systems may have been published at different times.
+     */
+
+    struct RoboRIOSnapshot{
+        /**
+         * \brief The number of sub-system snapshots published before this view was read
+         */
+
+        uint64_t version;
+
+        /**
+         * \brief The PWM outputs
+         */
+
+        const PWMSystem& pwm_system;
+
+        /**
+         * \brief The digital outputs
+         */
+
+        const DigitalSystem& digital_system;
+
+        /**
+         * \brief The relay outputs
+         */
+
+        const RelaySystem& relay_system;
+
+        /**
+         * \brief The analog outputs
+         */
+
+        const AnalogOutputs& analog_outputs;
+
+        /**
+         * \brief The CAN motor controller outputs
+         */
+
+        const CANMotorControllerTable& can_motor_controllers;
+    };
+
+    /**
+     * \brief Manager of the RoboRIO of the current RobotInstance
      */
 
     class RoboRIOManager {
     public:
 
+        /**
+         * \brief The RoboRIO of one RobotInstance and the state guarding it
+         */
+
+        struct State{
+            /**
+             * \brief The RoboRIO instance
+             */
+
+            std::shared_ptr<RoboRIO> instance;
+
+            /**
+             * \brief The mutexes used to lock each sub-system of the RoboRIO instance, indexed by RoboRIO::Subsystem
+             */
+
+            std::array<std::recursive_mutex, RoboRIO::NUM_SUBSYSTEMS> subsystem_mutexes;
+
+            /**
+             * \brief The buffers cycling published PWM outputs between the RoboRIO and SendData
+             * The writer side of each buffer is guarded by the lock of its sub-system, which the writer already holds
+             */
+
+            TripleBuffer<PWMSystem> pwm_snapshots;
+
+            /**
+             * \brief The buffers cycling published digital outputs between the RoboRIO and SendData
+             */
+
+            TripleBuffer<DigitalSystem> digital_snapshots;
+
+            /**
+             * \brief The buffers cycling published relay outputs between the RoboRIO and SendData
+             */
+
+            TripleBuffer<RelaySystem> relay_snapshots;
+
+            /**
+             * \brief The buffers cycling published analog outputs between the RoboRIO and SendData
+             */
+
+            TripleBuffer<AnalogOutputs> analog_output_snapshots;
+
+            /**
+             * \brief The buffers cycling published CAN motor controller outputs between the RoboRIO and SendData
+             */
+
+            TripleBuffer<CANMotorControllerTable> can_motor_controller_snapshots;
+
+            /**
+             * \brief The number of sub-system snapshots published so far
+             */
+
+            std::atomic<uint64_t> snapshot_version;
+
+            /**
+             * Constructor for State
+             * \param fpga_start_time The time in microseconds at which the emulated FPGA of this RoboRIO started
+             */
+
+            explicit State(uint64_t);
+        };
+
+        /**
+         * \brief A held lock on one or more RoboRIO sub-systems
+         * Sub-systems are locked in the order they are declared in RoboRIO::Subsystem and are unlocked when unlock is called or the lock is destroyed. The locks are recursive, so a thread may re-lock sub-systems it already holds, but a thread holding a sub-system must not newly lock one declared before it.
+         */
+
+        class Lock{
+        private:
+
+            /**
+             * \brief The mutexes of the RoboRIO this lock guards
+             */
+
+            std::array<std::recursive_mutex, RoboRIO::NUM_SUBSYSTEMS>* mutexes;
+
+            /**
+             * \brief A bitmask of the sub-systems guarded by this lock
+             */
+
+            uint32_t subsystems;
+
+            /**
+             * \brief Whether the sub-systems are currently held by this lock
+             */
+
+            bool held;
+
+        public:
+
+            /**
+             * \brief Check if this lock currently holds its sub-systems
+             * \return True if the sub-systems are held
+             */
+
+            bool ownsLock()const noexcept;
+
+            /**
+             * \brief Re-acquire the sub-systems guarded by this lock
+             * Locking a lock which is already held does nothing
+             */
+
+            void lock();
+
+            /**
+             * \brief Release the sub-systems guarded by this lock
+             * Unlocking a lock which is not held does nothing
+             */
+
+            void unlock()noexcept;
+
+            /**
+             * Constructor for Lock
+             * \param mutexes The sub-system mutexes of the RoboRIO to lock
+             * \param mask A bitmask of the sub-systems to lock
+             */
+
+            Lock(std::array<std::recursive_mutex, RoboRIO::NUM_SUBSYSTEMS>&, uint32_t);
+
+            /**
+             * Constructor for Lock
+             * \param source The lock to take ownership from
+             */
+
+            Lock(Lock&&)noexcept;
+
+            /**
+             * Deconstructor for Lock
+             */
+
+            ~Lock();
+
+            Lock(Lock const&) = delete;
+            Lock& operator=(Lock const&) = delete;
+        };
+
+        /**
+         * \brief Get the RoboRIO instance for use
+         * Locks every sub-system and returns both the RoboRIO instance and the lock. This should only be used when a consistent view across sub-systems is required.
+         * \return A pair with the RoboRIO instance and thread lock
+         */
+
+        static std::pair<std::shared_ptr<RoboRIO>, Lock> getInstance();
+
+        /**
+         * \brief Get the RoboRIO instance for use
+         * Locks only the given sub-system and returns both the RoboRIO instance and the lock
+         * \param subsystem The sub-system to lock
+         * \return A pair with the RoboRIO instance and thread lock
+         */
+
+        static std::pair<std::shared_ptr<RoboRIO>, Lock> getInstance(RoboRIO::Subsystem);
+
         /**
          * \brief Get the RoboRIO instance for use
-         * Locks the current thread and returns both the RoboRIO instance and the lock
+         * Locks the given sub-systems in their declared order and returns both the RoboRIO instance and the lock
+         * \param subsystems The sub-systems to lock
          * \return A pair with the RoboRIO instance and thread lock
          */
 
-        static std::pair<std::shared_ptr<RoboRIO>, std::unique_lock<std::recursive_mutex>> getInstance();
+        static std::pair<std::shared_ptr<RoboRIO>, Lock> getInstance(std::initializer_list<RoboRIO::Subsystem>);
 
         /**
          * \brief Get a copy of the RoboRIO instance
@@ -31,24 +233,50 @@ namespace hel{
 
         static RoboRIO getCopy();
 
-    private:
         /**
-         * Constructor for RoboRIOManager
+         * \brief Capture the outputs of every sub-system of the RoboRIO instance and publish them
+         * Locks every output sub-system, so this must not be called by a thread which already holds a sub-system lock
          */
 
-        RoboRIOManager() {}
+        static void publishSnapshot();
+
+        /**
+         * \brief Capture the outputs of a single sub-system and publish them
+         * Output setters call this while holding the sub-system, so re-locking it never waits; only that sub-system is copied, and publishing never waits on the reader or on writers of other sub-systems
+         * \param subsystem The sub-system whose outputs have changed
+         */
+
+        static void publishSnapshot(RoboRIO::Subsystem);
 
         /**
-         * \brief The RoboRIO instance
+         * \brief Get the most recently published outputs without locking the RoboRIO instance
+         * The returned view remains valid until the next call to getSnapshot. Calls must be serialized among readers, as SendDataManager does.
+         * \return A view of the latest published outputs
          */
 
-        static std::shared_ptr<RoboRIO> instance;
+        static RoboRIOSnapshot getSnapshot();
 
         /**
-         * \brief The mutex used to lock the thread accessing the RoboRIO instance
+         * \brief Get the version of the most recently published snapshot
+         * \return The number of snapshots published so far
+         */
+
+        static uint64_t getSnapshotVersion()noexcept;
+
+    private:
+        /**
+         * Constructor for RoboRIOManager
+         */
+
+        RoboRIOManager() {}
+
+        /**
+         * \brief Get the RoboRIO instance and lock a set of sub-systems
+         * \param mask A bitmask of the sub-systems to lock
+         * \return A pair with the RoboRIO instance and thread lock
          */
 
-        static std::recursive_mutex roborio_mutex;
+        static std::pair<std::shared_ptr<RoboRIO>, Lock> getInstance(uint32_t);
 
     public:
         RoboRIOManager(RoboRIOManager const&) = delete;
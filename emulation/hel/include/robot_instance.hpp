@@ -0,0 +1,273 @@
+#ifndef _ROBOT_INSTANCE_HPP_
+#define _ROBOT_INSTANCE_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "alarm_scheduler.hpp"
+#include "interrupt_system.hpp"
+#include "roborio_manager.hpp"
+#include "receive_data.hpp"
+#include "send_data.hpp"
+#include "sim_clock.hpp"
+
+namespace hel{
+
+    /**
+     * \brief One emulated robot: a RoboRIO, its clock, interrupts, and alarm timer, the data sent to and received from the engine for it, and the ports the engine connects to
+     * RoboRIOManager, SendDataManager, ReceiveDataManager, and SimClock operate on the instance bound to the calling thread, or on the default instance if none is bound. This lets several robot programs share one host process, each on threads bound to its own instance.
+     * The FPGA managers HAL creates keep the instance that was current when they were created and bind it for each call, so threads HAL starts internally, such as for notifiers, reach the right RoboRIO. Threads which call the FRC_NetworkCommunication functions directly must be bound by the host, or they use the default instance.
+     * WPILib's HAL keeps its own process-wide state, so each robot program must be loaded with a separate copy of it, for example with dlmopen.
+     */
+
+    class RobotInstance: public std::enable_shared_from_this<RobotInstance>{
+    public:
+        /**
+         * \brief Binds an instance to the current thread for the lifetime of the binding
+         * Bindings nest; destroying one restores the instance bound before it
+         */
+
+        class Binding{
+        public:
+            /**
+             * Constructor for Binding
+             * \param robot The instance to bind
+             */
+
+            explicit Binding(RobotInstance&)noexcept;
+
+            Binding(const Binding&) = delete;
+
+            Binding& operator=(const Binding&) = delete;
+
+            /**
+             * Deconstructor for Binding
+             */
+
+            ~Binding();
+
+        private:
+            /**
+             * \brief The instance bound before this binding, or nullptr if none was
+             */
+
+            RobotInstance* previous;
+        };
+
+        /**
+         * \brief The ID of the default instance
+         */
+
+        static constexpr unsigned DEFAULT_ID = 0;
+
+        /**
+         * \brief The port the default instance receives inputs from the engine on
+         */
+
+        static constexpr uint16_t DEFAULT_RECEIVE_PORT = 11000;
+
+        /**
+         * \brief The port the default instance sends outputs to the engine on
+         */
+
+        static constexpr uint16_t DEFAULT_SEND_PORT = 11001;
+
+        /**
+         * \brief Create a new instance with its own RoboRIO and engine connection
+         * \param receive_port The port to receive inputs from the engine on
+         * \param send_port The port to send outputs to the engine on
+         * \return The instance, which lives as long as any handle to it or any FPGA manager bound to it
+         */
+
+        static std::shared_ptr<RobotInstance> create(uint16_t, uint16_t);
+
+        /**
+         * \brief Get the instance used by threads with no instance bound
+         * It is created on first use with the default ports
+         * \return The default instance
+         */
+
+        static std::shared_ptr<RobotInstance> getDefault();
+
+        /**
+         * \brief Get the instance bound to the calling thread
+         * \return The bound instance, or the default instance if none is bound
+         */
+
+        static std::shared_ptr<RobotInstance> getCurrent();
+
+        /**
+         * \brief Get the instance bound to the calling thread without taking a handle to it
+         * \return The bound instance, or the default instance if none is bound
+         */
+
+        static RobotInstance& current()noexcept;
+
+        /**
+         * \brief Get the number which identifies this instance in the process
+         * \return The ID, which is DEFAULT_ID for the default instance
+         */
+
+        unsigned getID()const noexcept;
+
+        /**
+         * \brief Get the port this instance receives inputs from the engine on
+         * \return The port number
+         */
+
+        uint16_t getReceivePort()const noexcept;
+
+        /**
+         * \brief Get the port this instance sends outputs to the engine on
+         * \return The port number
+         */
+
+        uint16_t getSendPort()const noexcept;
+
+        /**
+         * \brief Get the interrupts of this instance
+         * They are kept outside the RoboRIO since threads wait on them, so they cannot be locked or snapshotted with it
+         * \return The interrupts
+         */
+
+        InterruptSystem& getInterruptSystem()noexcept;
+
+        /**
+         * \brief Get the scheduler which triggers this instance's FPGA alarm
+         * \return The alarm scheduler
+         */
+
+        AlarmScheduler& getAlarmScheduler()noexcept;
+
+        RobotInstance(const RobotInstance&) = delete;
+
+        RobotInstance& operator=(const RobotInstance&) = delete;
+
+        /**
+         * Deconstructor for RobotInstance
+         */
+
+        ~RobotInstance();
+
+    private:
+        friend class RoboRIOManager;
+        friend class SendDataManager;
+        friend class ReceiveDataManager;
+        friend class SimClock;
+
+        /**
+         * Constructor for RobotInstance
+         * \param id The ID of the instance
+         * \param receive_port The port to receive inputs from the engine on
+         * \param send_port The port to send outputs to the engine on
+         */
+
+        RobotInstance(unsigned, uint16_t, uint16_t);
+
+        /**
+         * \brief Reserve an instance's ports and create it
+         * \param id The ID of the instance
+         * \param receive_port The port to receive inputs from the engine on
+         * \param send_port The port to send outputs to the engine on
+         * \return The instance
+         */
+
+        static std::shared_ptr<RobotInstance> create(unsigned, uint16_t, uint16_t);
+
+        /**
+         * \brief Check that no other live instance uses a port, then reserve it
+         * The registry mutex must be held by the caller
+         * \param port The port to reserve
+         */
+
+        static void reservePort(uint16_t);
+
+        /**
+         * \brief The mutex guarding the registry of used ports
+         */
+
+        static std::mutex registry_mutex;
+
+        /**
+         * \brief The ports used by live instances
+         */
+
+        static std::vector<uint16_t> used_ports;
+
+        /**
+         * \brief The ID given to the next instance created
+         */
+
+        static std::atomic<unsigned> next_id;
+
+        /**
+         * \brief The instance bound to each thread, or nullptr if none is bound
+         */
+
+        static thread_local RobotInstance* bound;
+
+        unsigned id;
+
+        uint16_t receive_port;
+
+        uint16_t send_port;
+
+        /**
+         * \brief The time of this instance, driven by its own engine connection
+         * Declared before the RoboRIO, whose FPGA start time is read from it
+         */
+
+        SimClock::State sim_clock;
+
+        /**
+         * \brief The RoboRIO of this instance, its locks, and its published snapshots
+         */
+
+        RoboRIOManager::State roborio;
+
+        /**
+         * \brief The outputs sent to the engine for this instance
+         */
+
+        SendDataManager::State send_data;
+
+        /**
+         * \brief The inputs received from the engine for this instance
+         */
+
+        ReceiveDataManager::State receive_data;
+
+        InterruptSystem interrupt_system;
+
+        /**
+         * \brief Declared after the RoboRIO and interrupts so its timer thread stops before they are destroyed
+         */
+
+        AlarmScheduler alarm_scheduler;
+    };
+
+    /**
+     * \brief Base for FPGA managers, which belong to the instance current when they are created
+     * Each manager call binds the instance before touching the RoboRIO
+     */
+
+    class InstanceBound{
+    protected:
+        /**
+         * \brief The instance this manager was created for
+         */
+
+        std::shared_ptr<RobotInstance> robot;
+
+        /**
+         * Constructor for InstanceBound
+         */
+
+        InstanceBound();
+    };
+}
+
+#endif
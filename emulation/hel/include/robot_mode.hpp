@@ -6,6 +6,11 @@
 #include <string>
 
 namespace hel{
+    struct BinaryReader;
+    struct BinaryWriter;
+    struct JSONReader;
+    struct JSONWriter;
+
 
     /**
      * \brief Represents match phase and robot enabled state
@@ -140,6 +145,29 @@ namespace hel{
 
         static RobotMode deserialize(std::string);
 
+        /**
+         * \brief Read a RobotMode object from JSON
+         * \param reader The JSONReader positioned at the start of the object
+         * \return The parsed RobotMode object
+         */
+
+        static RobotMode deserialize(JSONReader&);
+
+        /**
+         * \brief Append the robot mode to a binary packet
+         * \param writer The BinaryWriter to append to
+         */
+
+        void serializeBinary(BinaryWriter&)const;
+
+        /**
+         * \brief Read a RobotMode object from a binary packet
+         * \param reader The BinaryReader to read from
+         * \return The parsed RobotMode object
+         */
+
+        static RobotMode deserializeBinary(BinaryReader&);
+
         /**
          * \brief Serialize RobotMode as a JSON string
          * \return The serialized string
@@ -147,6 +175,13 @@ namespace hel{
 
         std::string serialize()const;
 
+        /**
+         * \brief Append the robot mode to a JSON packet
+         * \param writer The JSONWriter to append to
+         */
+
+        void serialize(JSONWriter&)const;
+
         /**
          * \brief Format RobotMode data as a string
          * \return A string containing the converted data
@@ -1,25 +1,61 @@
 #ifndef _SEND_DATA_HPP_
 #define _SEND_DATA_HPP_
 
-#include <map>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
 
 #include "analog_outputs.hpp"
-#include "can_motor_controller.hpp"
+#include "binary_util.hpp"
+#include "call_profiler.hpp"
+#include "can_motor_controller_table.hpp"
 #include "digital_system.hpp"
+#include "json_schema.hpp"
 #include "mxp_data.hpp"
 #include "pwm_system.hpp"
 #include "relay_system.hpp"
 
 namespace hel{
+    /**
+     * \brief Read a relay state from its quoted JSON string
+     * \param reader The JSONReader positioned at the start of the value
+     * \param value Set to the value read
+     */
+
+    inline void readJSONValue(JSONReader& reader, RelaySystem::State& value){
+        value = s_to_relay_state(reader.readString());
+    }
+
     /**
      * \brief Container for all the data to send to the Synthesis engine
      * Contains functions to interpret RoboRIO data and prepare it for transmission
      */
 
     struct SendData{
+        /**
+         * \brief The sections of a delta packet
+         * A delta packet begins with a bitmask of these flags, and only the flagged sections follow
+         */
+
+        enum DeltaSection: uint8_t{
+            KEYFRAME = 1u << 0,
+            PWM_HDRS = 1u << 1,
+            RELAYS = 1u << 2,
+            ANALOG_OUTPUTS = 1u << 3,
+            DIGITAL_MXP = 1u << 4,
+            DIGITAL_HDRS = 1u << 5,
+            CAN_MOTOR_CONTROLLERS = 1u << 6
+        };
+
+        /**
+         * \brief The number of delta packets to send between keyframes
+         */
+
+        static constexpr unsigned KEYFRAME_INTERVAL = 100;
+
     private:
         /**
          * \brief A copy of the most recently serialized data
@@ -28,6 +64,12 @@ namespace hel{
 
         std::string serialized_data;
 
+        /**
+         * \brief The wire format of serialized_data
+         */
+
+        WireFormat serialized_format;
+
         /**
          * \brief Whether SendData has been updated since last serialization
          */
@@ -74,43 +116,168 @@ namespace hel{
          * \brief All the CAN motor controller outputs
          */
 
-        std::map<uint32_t, CANMotorController> can_motor_controllers;
+        CANMotorControllerTable can_motor_controllers;
 
         /**
-         * \brief Update the serialized_data with the PWM headers
+         * \brief Bitmask of the PWM headers changed since they were last sent in a delta packet
          */
 
-        void serializePWMHdrs();
+        uint16_t dirty_pwm_hdrs;
 
         /**
-         * \brief Update the serialized_data with the relays
+         * \brief Bitmask of the relays changed since they were last sent in a delta packet
          */
 
-        void serializeRelays();
+        uint8_t dirty_relays;
 
         /**
-         * \brief Update the serialized_data with the analog outputs
+         * \brief Bitmask of the analog outputs changed since they were last sent in a delta packet
          */
 
-        void serializeAnalogOutputs();
+        uint8_t dirty_analog_outputs;
 
         /**
-         * \brief Update the serialized_data with the digital MXP
+         * \brief Bitmask of the digital MXP channels changed since they were last sent in a delta packet
          */
 
-        void serializeDigitalMXP();
+        uint16_t dirty_digital_mxp;
 
         /**
-         * \brief Update the serialized_data with the digital headers
+         * \brief Whether any digital header changed since the headers were last sent in a delta packet
          */
 
-        void serializeDigitalHdrs();
+        bool dirty_digital_hdrs;
 
         /**
-         * \brief Update the serialized_data with the CAN motor controllers
+         * \brief The slots of the CAN motor controllers changed since they were last sent in a delta packet
          */
 
-        void serializeCANMotorControllers();
+        CANMotorControllerTable::SlotMask dirty_can_motor_controllers;
+
+        /**
+         * \brief The sequence number of the next delta packet
+         */
+
+        uint32_t sequence;
+
+        /**
+         * \brief The number of delta packets sent since the last keyframe
+         */
+
+        unsigned deltas_since_keyframe;
+
+        /**
+         * \brief Whether the next delta packet must be a keyframe and the next packet from serializeNext must be deep
+         */
+
+        bool keyframe_requested;
+
+        /**
+         * \brief The version of the RoboRIO snapshot the outputs were last updated from
+         */
+
+        uint64_t snapshot_version;
+
+        /**
+         * \brief Update the CAN motor controllers and mark those that changed as dirty
+         * \param source The latest CAN motor controllers
+         */
+
+        void updateCANMotorControllers(const CANMotorControllerTable&);
+
+        /**
+         * \brief Check if the next delta packet must be a keyframe
+         * \return True if a keyframe was requested, KEYFRAME_INTERVAL packets have passed since the last one, or SendData is disabled
+         */
+
+        bool isKeyframeDue()const noexcept;
+
+        /**
+         * \brief Check if any output only carried by deep packets has changed since it was last sent
+         * \return True if a relay, analog output, or digital output is dirty
+         */
+
+        bool hasDeepChanges()const noexcept;
+
+        /**
+         * \brief Mark the outputs carried by a packet as sent
+         * \param deep Whether the packet held all the data supported by HEL or only that supported by Synthesis's engine
+         */
+
+        void clearDirty(bool)noexcept;
+
+        HEL_SCHEMA_FIELD(PWMHdrsField, SendData, pwm_hdrs, "pwm_hdrs", SchemaDepth::SHALLOW);
+        HEL_SCHEMA_FIELD(RelaysField, SendData, relays, "relays", SchemaDepth::DEEP);
+        HEL_SCHEMA_FIELD(AnalogOutputsField, SendData, analog_outputs, "analog_outputs", SchemaDepth::DEEP);
+        HEL_SCHEMA_FIELD(DigitalMXPField, SendData, digital_mxp, "digital_mxp", SchemaDepth::DEEP);
+        HEL_SCHEMA_FIELD(DigitalHdrsField, SendData, digital_hdrs, "digital_hdrs", SchemaDepth::DEEP);
+        HEL_SCHEMA_FIELD(CANMotorControllersField, SendData, can_motor_controllers, "can_motor_controllers", SchemaDepth::SHALLOW);
+
+        /**
+         * \brief The JSON format of the outputs, in the order they are written
+         */
+
+        using JSONSchema = Schema<PWMHdrsField, RelaysField, AnalogOutputsField, DigitalMXPField, DigitalHdrsField, CANMotorControllersField>;
+
+        /**
+         * \brief Write a JSON packet holding the outputs
+         * \tparam DEPTH Whether to include all the data supported by HEL or only that supported by Synthesis's engine
+         * \param writer The JSONWriter to write the packet to
+         */
+
+        template<SchemaDepth DEPTH>
+        void serializeJSON(JSONWriter&)const;
+
+        /**
+         * \brief Update and return the JSON serialized outputs
+         * \tparam DEPTH Whether to include all the data supported by HEL or only that supported by Synthesis's engine
+         * \return The JSON packet
+         */
+
+        template<SchemaDepth DEPTH>
+        const std::string& serializeJSON();
+
+        /**
+         * \brief Read the labelled outputs of a JSON object, descending into the object they are wrapped in
+         * \param reader The JSONReader positioned at the start of the object
+         */
+
+        void deserializeFields(JSONReader&);
+
+        /**
+         * \brief Write a binary packet holding the outputs
+         * Shallow packets only hold the data supported by Synthesis's engine, while deep packets hold all the data supported by HEL
+         * \param writer The BinaryWriter to write the packet to
+         * \param type The type of packet to write
+         */
+
+        void serializeBinary(BinaryWriter&, BinaryPacketType)const;
+
+        /**
+         * \brief Update and return the binary serialized outputs
+         * \param type The type of packet to generate
+         * \return The binary packet
+         */
+
+        const std::string& serializeBinary(BinaryPacketType);
+
+        /**
+         * \brief Write a delta packet holding the outputs
+         * \param writer The BinaryWriter to write the packet to
+         * \param seq The sequence number of the packet
+         * \param deep Whether to include all the data supported by HEL or only that supported by Synthesis's engine
+         * \param keyframe Whether to include every output or only those that changed
+         */
+
+        void serializeDelta(BinaryWriter&, uint32_t, bool, bool)const;
+
+        /**
+         * \brief Update and return a delta packet holding the outputs changed since the last delta packet
+         * \param deep Whether to include all the data supported by HEL or only that supported by Synthesis's engine
+         * \return The delta packet
+         */
+
+        const std::string& serializeDelta(bool);
 
     public:
         /**
@@ -120,15 +287,15 @@ namespace hel{
         SendData();
 
         /**
-         * \brief Update the data held by SendData from a copy of the RoboRIO instance
-         * This only updates the data supported by Synthesis's engine
+         * \brief Update the data held by SendData from the latest published RoboRIO snapshot
+         * This only updates the data supported by Synthesis's engine. It does not lock the RoboRIO instance and does nothing if no snapshot has been published since the last update.
          */
 
         void updateShallow();
 
         /**
-         * \brief Update the data held by SendData from a copy of the RoboRIO instance
-         * This updates all the data supported by HEL
+         * \brief Update the data held by SendData from the latest published RoboRIO snapshot
+         * This updates all the data supported by HEL. It does not lock the RoboRIO instance.
          */
 
         void updateDeep();
@@ -153,14 +320,78 @@ namespace hel{
          * Only updates the cached serialized string if there is new data and it is enabled. If it is disabled, it returns zeroed outputs. This also only generates a string using the data supported by Synthesis's engine.
          */
 
-        std::string serializeShallow();
+        const std::string& serializeShallow();
 
         /**
          * \brief Update and return the JSON serialized outputs
          * Only updates the cached serialized string if there is new data and it is enabled. If it is disabled, it returns zeroed outputs. This also  generates a string using all the data supported by HEL.
          */
 
-        std::string serializeDeep();
+        const std::string& serializeDeep();
+
+        /**
+         * \brief Update and return the binary serialized outputs
+         * Behaves like serializeShallow, but generates a binary packet instead of JSON
+         * \return The binary packet
+         */
+
+        const std::string& serializeShallowBinary();
+
+        /**
+         * \brief Update and return the binary serialized outputs
+         * Behaves like serializeDeep, but generates a binary packet instead of JSON
+         * \return The binary packet
+         */
+
+        const std::string& serializeDeepBinary();
+
+        /**
+         * \brief Update and return a binary delta packet
+         * The packet only holds the outputs supported by Synthesis's engine which changed since the last delta packet, unless it is a keyframe. Keyframes hold every output and are sent when requested, every KEYFRAME_INTERVAL packets, and while disabled.
+         * \return The delta packet
+         */
+
+        const std::string& serializeShallowDelta();
+
+        /**
+         * \brief Update and return a binary delta packet
+         * Behaves like serializeShallowDelta, but considers all the outputs supported by HEL
+         * \return The delta packet
+         */
+
+        const std::string& serializeDeepDelta();
+
+        /**
+         * \brief Update and return the next packet to send to a peer
+         * A deep packet is sent when a keyframe is due or an output only carried by deep packets has changed since it was last sent, and a shallow packet otherwise, so those outputs reach the peer without every packet carrying them
+         * \param format The wire format of the packet; binary packets are deltas
+         * \return The packet
+         */
+
+        const std::string& serializeNext(WireFormat);
+
+        /**
+         * \brief Parse a binary packet written by another SendData and update the held outputs to match
+         * Shallow and deep packets replace the outputs they hold, while delta packets only replace those they flag as changed, so applying every packet sent to a peer in order yields the outputs the peer has seen
+         * \param packet The binary packet to parse, including its header
+         */
+
+        void deserializeBinary(StringView);
+
+        /**
+         * \brief Parse a JSON packet written by another SendData and update the held outputs to match
+         * Shallow and deep packets each replace only the outputs they hold, so applying every packet sent to a peer in order yields the outputs the peer has seen
+         * \param packet The JSON packet to parse
+         */
+
+        void deserializeJSON(StringView);
+
+        /**
+         * \brief Make the next delta packet a keyframe and the next packet from serializeNext deep
+         * This should be called whenever a new peer connects, since it has not seen any previous packets
+         */
+
+        void requestKeyframe();
 
         /**
          * \brief Get if SendData has new data
@@ -172,18 +403,56 @@ namespace hel{
 
     class SendDataManager { //TODO move to separate file
     public:
-        static std::pair<std::shared_ptr<SendData>, std::unique_lock<std::recursive_mutex>> getInstance() {
-            std::unique_lock<std::recursive_mutex> lock(send_data_mutex);
-            if (instance == nullptr) {
-                instance = std::make_shared<SendData>();
-            }
-            return std::make_pair(instance, std::move(lock));
-        }
+        /**
+         * \brief The SendData of one RobotInstance and the state guarding it
+         */
 
-    private:
-        static std::shared_ptr<SendData> instance;
-        static std::recursive_mutex send_data_mutex;
+        struct State{
+            std::shared_ptr<SendData> instance;
+
+            std::recursive_mutex send_data_mutex;
+
+            std::condition_variable_any new_data_condition;
+
+            std::function<void()> new_data_listener;
+
+            /**
+             * Constructor for State
+             */
+
+            State();
+        };
+
+        /**
+         * \brief Get the SendData instance of the current RobotInstance for use
+         * \return A pair with the SendData instance and its lock
+         */
+
+        static std::pair<std::shared_ptr<SendData>, std::unique_lock<std::recursive_mutex>> getInstance();
+
+        /**
+         * \brief Wake any threads waiting for SendData to have new data
+         * Call this after setting new data while holding the SendData lock so that no wakeup is lost
+         */
+
+        static void notifyNewData();
+
+        /**
+         * \brief Set a function to call whenever SendData has new data
+         * The listener is called while the SendData lock is held, so it must not block
+         * \param listener The function to call, or nullptr to remove the listener
+         */
+
+        static void setNewDataListener(std::function<void()>);
+
+        /**
+         * \brief Block until SendData has new data or the timeout elapses
+         * \param lock The lock returned by getInstance, held exactly once by the calling thread
+         * \param timeout The longest time to wait
+         * \return True if SendData has new data
+         */
 
+        static bool waitForNewData(std::unique_lock<std::recursive_mutex>&, std::chrono::milliseconds);
     };
 }
 
@@ -0,0 +1,103 @@
+#ifndef _SHM_ENGINE_PEER_HPP_
+#define _SHM_ENGINE_PEER_HPP_
+
+#include <asio.hpp>
+
+#include <chrono>
+#include <string>
+
+#include "binary_util.hpp"
+#include "shm_transport.hpp"
+#include "util.hpp"
+
+namespace hel{
+    /**
+     * \brief Stands in for Synthesis's engine on the same host, talking to HEL over shared memory rings
+     * Creates one ring for inputs and one for outputs, connects to the SyncClient and SyncServer ports, and offers the rings in the binary handshake. Used to test the shared memory transport and to drive HEL without the engine.
+     * All calls block and must come from one thread.
+     */
+
+    class ShmEnginePeer{
+    private:
+        asio::io_context io;
+
+        /**
+         * \brief The ring the peer writes inputs into for the SyncClient
+         */
+
+        ShmRing inputs;
+
+        /**
+         * \brief The ring the SyncServer writes outputs into for the peer
+         */
+
+        ShmRing outputs;
+
+        /**
+         * \brief The connection to the SyncClient, kept open while the rings are in use
+         */
+
+        asio::ip::tcp::socket input_socket;
+
+        /**
+         * \brief The connection to the SyncServer, kept open while the rings are in use
+         */
+
+        asio::ip::tcp::socket output_socket;
+
+        /**
+         * \brief The wire format agreed with HEL
+         */
+
+        WireFormat format;
+
+        /**
+         * \brief Connect to HEL and offer it a ring
+         * Throws if HEL does not attach to the ring
+         * \param socket The socket to connect
+         * \param host The address HEL is listening on
+         * \param port The port to connect to
+         * \param ring The ring to offer
+         * \return The wire format agreed with HEL
+         */
+
+        WireFormat connect(asio::ip::tcp::socket&, const std::string&, unsigned short, const ShmRing&);
+
+    public:
+        /**
+         * \brief Get the wire format agreed with HEL
+         * Packets sent and received through the rings are in this format
+         * \return The wire format
+         */
+
+        WireFormat getWireFormat()const noexcept;
+
+        /**
+         * \brief Send an input packet to HEL
+         * \param packet The packet to send
+         * \return False if HEL has not caught up and the input ring is full
+         */
+
+        bool sendInputs(StringView);
+
+        /**
+         * \brief Wait for output packets from HEL and take the newest
+         * \param packet Replaced with the newest packet
+         * \param timeout The longest time to wait
+         * \return False if no packet arrived before the timeout
+         */
+
+        bool receiveOutputs(std::string&, std::chrono::microseconds);
+
+        /**
+         * Constructor for ShmEnginePeer
+         * Connects to HEL, which must already be listening
+         * \param host The address HEL is listening on
+         * \param capacity The number of bytes of packet storage in each ring
+         */
+
+        explicit ShmEnginePeer(const std::string& = "127.0.0.1", uint32_t = DEFAULT_SHM_RING_CAPACITY);
+    };
+}
+
+#endif
@@ -0,0 +1,250 @@
+#ifndef _SHM_TRANSPORT_HPP_
+#define _SHM_TRANSPORT_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "util.hpp"
+
+namespace hel{
+    /**
+     * \brief Marker at the start of every shared memory ring
+     * This is "HELR" as little-endian bytes
+     */
+
+    constexpr uint32_t SHM_RING_MAGIC = 0x524C4548;
+
+    /**
+     * \brief The default number of bytes of packet storage in a shared memory ring
+     */
+
+    constexpr uint32_t DEFAULT_SHM_RING_CAPACITY = 0x10000;
+
+    /**
+     * \brief How long a producer waits before retrying a write into a full ring
+     */
+
+    constexpr std::chrono::microseconds SHM_FULL_RETRY_INTERVAL{100};
+
+    /**
+     * \brief The layout of the start of a shared memory ring; packet storage follows it
+     * Head and tail are free-running byte counts kept on separate cache lines so the producer and consumer never write to the same line. Both double as futex words for wakeups.
+     */
+
+    struct ShmRingHeader{
+        /**
+         * \brief Set to SHM_RING_MAGIC once the ring is initialized
+         */
+
+        uint32_t magic;
+
+        /**
+         * \brief The number of bytes of packet storage, which is a power of two
+         */
+
+        uint32_t capacity;
+
+        /**
+         * \brief The number of bytes ever written, modulo 2^32; only written by the producer
+         */
+
+        alignas(64) std::atomic<uint32_t> head;
+
+        /**
+         * \brief Set by the consumer while it sleeps waiting for head to change
+         */
+
+        std::atomic<uint32_t> consumer_waiting;
+
+        /**
+         * \brief The number of bytes ever read, modulo 2^32; only written by the consumer
+         */
+
+        alignas(64) std::atomic<uint32_t> tail;
+    };
+
+    /**
+     * \brief Single-producer single-consumer ring of packets in POSIX shared memory
+     * Lets HEL exchange packets with an engine on the same host without going through the kernel's socket path. Each packet is stored as its length followed by its bytes. Writes never block; a write into a full ring fails so the caller can coalesce it with later data. The consumer can sleep on a futex until the producer writes.
+     * Exactly one thread, in any process, may write and exactly one may read.
+     */
+
+    class ShmRing{
+    private:
+        /**
+         * \brief The name of the shared memory object
+         */
+
+        std::string name;
+
+        /**
+         * \brief The mapped region, starting with the header
+         */
+
+        ShmRingHeader* header;
+
+        /**
+         * \brief The packet storage following the header
+         */
+
+        char* data;
+
+        /**
+         * \brief The size of the mapping in bytes
+         */
+
+        std::size_t mapped_size;
+
+        /**
+         * \brief Whether this mapping created the shared memory object and should unlink it
+         */
+
+        bool owner;
+
+        /**
+         * \brief Copy bytes into packet storage, wrapping around its end
+         * \param position The free-running position to start writing at
+         * \param source The bytes to write
+         * \param size The number of bytes to write
+         */
+
+        void copyIn(uint32_t, const char*, uint32_t)noexcept;
+
+        /**
+         * \brief Copy bytes out of packet storage, wrapping around its end
+         * \param position The free-running position to start reading at
+         * \param destination Where to write the bytes
+         * \param size The number of bytes to read
+         */
+
+        void copyOut(uint32_t, char*, uint32_t)const noexcept;
+
+        ShmRing(std::string, ShmRingHeader*, std::size_t, bool)noexcept;
+
+    public:
+        /**
+         * \brief The space in the ring taken by each packet's length prefix
+         */
+
+        static constexpr uint32_t LENGTH_PREFIX_SIZE = sizeof(uint32_t);
+
+        /**
+         * \brief Create a new shared memory ring
+         * The shared memory object is unlinked when the returned ring is destroyed
+         * \param name The name of the shared memory object, starting with a slash
+         * \param capacity The number of bytes of packet storage, rounded up to a power of two
+         * \return The created ring
+         */
+
+        static ShmRing create(const std::string&, uint32_t = DEFAULT_SHM_RING_CAPACITY);
+
+        /**
+         * \brief Map an existing shared memory ring created by another process
+         * Throws if the object does not exist or does not hold a ring
+         * \param name The name of the shared memory object
+         * \return The opened ring
+         */
+
+        static ShmRing open(const std::string&);
+
+        /**
+         * \brief Get the name of the shared memory object
+         * \return The name of the ring
+         */
+
+        const std::string& getName()const noexcept;
+
+        /**
+         * \brief Get the number of bytes of packet storage
+         * \return The capacity of the ring
+         */
+
+        uint32_t capacity()const noexcept;
+
+        /**
+         * \brief Append a packet and wake the consumer if it is sleeping
+         * Only the producer may call this
+         * \param packet The packet to append
+         * \return False if there is not enough free space, in which case nothing is written
+         */
+
+        bool tryWrite(StringView);
+
+        /**
+         * \brief Remove the oldest packet
+         * Only the consumer may call this
+         * \param packet Replaced with the removed packet
+         * \return False if the ring is empty
+         */
+
+        bool tryRead(std::string&);
+
+        /**
+         * \brief Remove every packet, keeping only the newest
+         * Older packets are skipped without being copied
+         * Only the consumer may call this
+         * \param packet Replaced with the newest packet
+         * \return False if the ring is empty
+         */
+
+        bool readLatest(std::string&);
+
+        /**
+         * \brief Check if the ring holds no packets
+         * \return True if the ring is empty
+         */
+
+        bool empty()const noexcept;
+
+        /**
+         * \brief Sleep until the ring holds a packet
+         * Only the consumer may call this
+         * \param timeout The longest time to wait
+         * \return True if the ring holds a packet
+         */
+
+        bool waitForData(std::chrono::microseconds);
+
+        ShmRing(ShmRing&&)noexcept;
+        ShmRing& operator=(ShmRing&&)noexcept;
+        ShmRing(const ShmRing&) = delete;
+        ShmRing& operator=(const ShmRing&) = delete;
+
+        /**
+         * Destructor for ShmRing
+         */
+
+        ~ShmRing();
+    };
+
+    /**
+     * \brief An exception representing when a shared memory ring could not be created or mapped
+     */
+
+    struct ShmException: std::exception{
+    private:
+        /**
+         * \brief The exception message
+         */
+
+        std::string message;
+
+    public:
+        /**
+         * \brief Returns the exception message
+         */
+
+        const char* what()const throw();
+
+        /**
+         * Constructor for ShmException
+         * \param det The details of the failure
+         */
+
+        ShmException(std::string);
+    };
+}
+
+#endif
@@ -0,0 +1,235 @@
+#ifndef _SIM_CLOCK_HPP_
+#define _SIM_CLOCK_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+namespace hel{
+
+    /**
+     * \brief The source of the emulated FPGA's time
+     * In real-time mode, time follows the host's clock. Once the engine sends a simulation timestamp with its inputs, the clock enters lockstep mode: time only advances when the engine's timestamp does, and each advance is one step of the user program's loop. The simulation can then run slower or faster than real time and stay deterministic.
+     * Switching modes never makes time jump; it continues from where it was at the rate of the new mode.
+     * Each RobotInstance has its own clock, and these functions use the clock of the instance bound to the calling thread, so one robot's engine connection never moves or releases another robot's time.
+     */
+
+    class SimClock{
+    public:
+        /**
+         * \brief How often the user program's loop is signalled in real-time mode
+         */
+
+        static constexpr std::chrono::microseconds REAL_TIME_STEP_PERIOD{10000};
+
+        /**
+         * \brief Get the current time
+         * \return The time in microseconds
+         */
+
+        static uint64_t now()noexcept;
+
+        /**
+         * \brief Check if time is driven by the engine
+         * \return True if the clock is in lockstep mode
+         */
+
+        static bool isLockstep()noexcept;
+
+        /**
+         * \brief Advance time to the engine's simulation timestamp, entering lockstep mode if needed
+         * A timestamp earlier than the last one means the engine restarted its simulation, so time continues from where it was rather than going backwards. Repeating the last timestamp does nothing.
+         * \param sim_time The engine's simulation time in microseconds
+         */
+
+        static void advanceTo(uint64_t);
+
+        /**
+         * \brief Return to real-time mode, such as when the engine disconnects
+         */
+
+        static void release();
+
+        /**
+         * \brief Get the number of steps taken so far
+         * \return The step count
+         */
+
+        static uint64_t getStep()noexcept;
+
+        /**
+         * \brief Wait for the next step of the user program's loop
+         * In lockstep mode this waits for the engine to advance time; in real-time mode it sleeps for REAL_TIME_STEP_PERIOD
+         * \param step The last step seen by the caller, updated to the current step
+         * \param timeout The longest time to wait for the engine in lockstep mode
+         * \return True if a step was taken
+         */
+
+        static bool waitForStep(uint64_t&, std::chrono::microseconds);
+
+        /**
+         * \brief Wait until the clock reaches a time
+         * In lockstep mode this waits for the engine to advance time to it; in real-time mode it sleeps until the host clock reaches it, without polling
+         * \param time The time to wait for in microseconds
+         * \param cancelled Checked with the clock locked whenever the waiter wakes; the wait ends early once it returns true
+         * \return True if the time was reached, false if the wait was cancelled
+         */
+
+        static bool waitUntil(uint64_t, const std::function<bool()>&);
+
+        /**
+         * \brief Wake every thread in waitUntil so it checks whether it was cancelled
+         * Call this after changing the state the cancellation checks read
+         */
+
+        static void wake();
+
+        /**
+         * \brief Set whether the user program is held at the start of each loop iteration until released
+         * This lets a driver such as the HeadlessRunner know when an iteration has finished, so it can change inputs and time between iterations without racing the user program
+         * \param enabled True to hold the user program at the barrier
+         */
+
+        static void setLoopBarrier(bool);
+
+        /**
+         * \brief Mark the start of a user program loop iteration, waiting at the barrier if it is enabled
+         * HEL calls this when the user program reports its mode, which WPILib does once per iteration
+         */
+
+        static void startUserLoop();
+
+        /**
+         * \brief Wait for the user program to arrive at the loop barrier
+         * \param timeout The longest time to wait
+         * \return True if the user program is being held
+         */
+
+        static bool waitForUserLoop(std::chrono::microseconds);
+
+        /**
+         * \brief Let the user program held at the loop barrier run its iteration
+         */
+
+        static void releaseUserLoop();
+
+        /**
+         * \brief Get the number of user program loop iterations started so far
+         * \return The iteration count
+         */
+
+        static uint64_t getUserLoopCount()noexcept;
+
+        /**
+         * \brief The clock of one RobotInstance
+         */
+
+        struct State{
+            std::mutex clock_mutex;
+
+            std::condition_variable step_taken;
+
+            /**
+             * \brief Whether time is driven by the engine
+             */
+
+            bool lockstep;
+
+            /**
+             * \brief The time when the current mode began, in microseconds
+             */
+
+            uint64_t base_time;
+
+            /**
+             * \brief The host time when real-time mode began, in microseconds
+             */
+
+            uint64_t base_host_time;
+
+            /**
+             * \brief The engine's timestamp when lockstep mode began, in microseconds
+             */
+
+            uint64_t base_sim_time;
+
+            /**
+             * \brief The engine's latest timestamp, in microseconds
+             */
+
+            uint64_t sim_time;
+
+            /**
+             * \brief The number of steps taken so far
+             */
+
+            uint64_t step;
+
+            /**
+             * \brief Signalled when the user program arrives at or is released from the loop barrier
+             */
+
+            std::condition_variable loop_changed;
+
+            /**
+             * \brief Whether the user program is held at the start of each loop iteration
+             */
+
+            bool loop_barrier;
+
+            /**
+             * \brief The number of user program loop iterations started
+             */
+
+            uint64_t loops_started;
+
+            /**
+             * \brief The number of user program loop iterations released from the barrier
+             */
+
+            uint64_t loops_released;
+
+            /**
+             * Constructor for State
+             */
+
+            State();
+        };
+
+        /**
+         * \brief Get the current time of a given clock
+         * Unlike now(), this does not look up the instance bound to the calling thread, so it is safe to use while a RobotInstance is being constructed
+         * \param state The clock to read
+         * \return The time in microseconds
+         */
+
+        static uint64_t now(State&)noexcept;
+
+    private:
+        /**
+         * \brief Get the clock of the RobotInstance bound to the calling thread
+         * \return The clock's state
+         */
+
+        static State& current()noexcept;
+
+        /**
+         * \brief Get the host's time, corrected for drift
+         * \return The host time in microseconds
+         */
+
+        static uint64_t hostTime()noexcept;
+
+        /**
+         * \brief Get the current time without locking
+         * \param state The clock to read, whose mutex the caller holds
+         * \return The time in microseconds
+         */
+
+        static uint64_t nowLocked(const State&)noexcept;
+    };
+}
+
+#endif
@@ -1,32 +1,164 @@
 #ifndef _SYNC_CLIENT_HPP_
 #define _SYNC_CLIENT_HPP_
 
-#include "roborio.hpp"
+#include "robot_instance.hpp"
 #include <asio.hpp>
 
-#define RECEIVE_PORT 11000
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include "binary_util.hpp"
+#include "frame_reader.hpp"
+#include "shm_transport.hpp"
+#include "sync_util.hpp"
+
+#define RECEIVE_PORT hel::RobotInstance::DEFAULT_RECEIVE_PORT
 
 namespace hel {
     /**
      * \brief TCP socket receiver used in communication with Synthesis's engine
+     * All networking runs asynchronously on the io_context given to the constructor. Only the latest complete packet in each read is applied, since older inputs would be immediately overwritten.
+     * If the engine offers a shared memory ring during negotiation, packets are instead taken from the ring by a dedicated thread which sleeps until the engine writes, and the socket is only watched for disconnection.
      */
 
     class SyncClient {
     public:
+        /**
+         * \brief The longest time the ring reader sleeps before checking whether it should stop
+         */
+
+        static constexpr std::chrono::milliseconds RING_WAIT_TIMEOUT{100};
+
+        /**
+         * Constructor for SyncClient
+         * Receives inputs for the instance bound to the calling thread
+         * \param io The io_context to run the receiver on
+         */
+
+        SyncClient(asio::io_context& io);
+
         /**
          * Constructor for SyncClient
+         * \param io The io_context to run the receiver on
+         * \param robot The instance to receive inputs for on its receive port
          */
 
-        SyncClient(asio::io_service& io);
+        SyncClient(asio::io_context& io, std::shared_ptr<RobotInstance> robot);
 
         /**
-         * \brief Begins and runs receiver in a background thread
+         * Destructor for SyncClient
          */
 
-        void startSync(asio::io_service& io);
+        ~SyncClient();
+
+        /**
+         * \brief Begin accepting connections from the engine
+         * The receiver runs as the io_context runs
+         */
+
+        void startSync();
 
     private:
-        asio::ip::tcp::endpoint endpoint;
+        std::shared_ptr<RobotInstance> robot;
+
+        asio::ip::tcp::acceptor acceptor;
+
+        asio::ip::tcp::socket socket;
+
+        /**
+         * \brief Times out the wire format negotiation with a new connection
+         */
+
+        asio::steady_timer negotiation_timer;
+
+        /**
+         * \brief The wire format agreed with the connected engine
+         */
+
+        WireFormat format;
+
+        /**
+         * \brief Receives data from the engine and splits it into packets
+         */
+
+        FrameReader frames;
+
+        /**
+         * \brief The shared memory ring the engine writes inputs into, if one was agreed
+         */
+
+        std::unique_ptr<ShmRing> ring;
+
+        /**
+         * \brief The thread applying packets from the ring
+         */
+
+        std::thread ring_reader;
+
+        /**
+         * \brief Whether the ring reader should keep running
+         */
+
+        std::atomic<bool> ring_reader_running;
+
+        /**
+         * \brief Receives and discards anything sent over the socket while the ring carries packets
+         */
+
+        std::array<char, 64> discarded;
+
+        /**
+         * \brief Accept the next connection
+         */
+
+        void startAccept();
+
+        /**
+         * \brief Map a shared memory ring offered by the engine
+         * \param name The name of the ring
+         * \return True if the ring was mapped
+         */
+
+        bool attachRing(const std::string&);
+
+        /**
+         * \brief Read the next chunk of data from the engine
+         */
+
+        void startRead();
+
+        /**
+         * \brief Start the thread which applies packets from the ring
+         */
+
+        void startRingReader();
+
+        /**
+         * \brief Stop the ring reader and unmap the ring
+         */
+
+        void stopRingReader();
+
+        /**
+         * \brief Wait for the engine to close the socket while the ring carries packets
+         */
+
+        void startWatch();
+
+        /**
+         * \brief Deserialize a complete packet into ReceiveData and apply it
+         * \param packet The packet to apply
+         */
+
+        void applyPacket(StringView);
+
+        /**
+         * \brief Reset inputs to their defaults, close the connection, and wait for the engine to reconnect
+         */
+
+        void disconnect();
     };
 }
 
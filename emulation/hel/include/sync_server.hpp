@@ -1,32 +1,207 @@
 #ifndef _SYNC_SERVER_HPP_
 #define _SYNC_SERVER_HPP_
 
-#include "roborio.hpp"
+#include "robot_instance.hpp"
 #include <asio.hpp>
 
-#define SEND_PORT 11001
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include "binary_util.hpp"
+#include "shm_transport.hpp"
+
+#define SEND_PORT hel::RobotInstance::DEFAULT_SEND_PORT
 
 namespace hel {
     /**
-     * \brief TCP socket transmitted used in communication with Synthesis's engine
+     * \brief TCP socket transmitter used in communication with Synthesis's engine
+     * All networking runs asynchronously on the io_context given to the constructor, so one thread can serve both the SyncServer and the SyncClient. Packets are never queued: while a write is in progress, changes are coalesced and the latest outputs are serialized once it completes.
+     * If the engine offers a shared memory ring during negotiation, packets are written into the ring instead, and the socket is only watched for disconnection. A packet which does not fit in a full ring is retried until the engine catches up.
      */
 
     class SyncServer {
     public:
+        /**
+         * \brief The longest time the transmitter waits for new data before resending the last packet
+         * Resending lets the transmitter notice when the engine disconnects from an idle robot
+         */
+
+        static constexpr std::chrono::milliseconds SEND_IDLE_TIMEOUT{1000};
+
+        /**
+         * Constructor for SyncServer
+         * Transmits the outputs of the instance bound to the calling thread
+         * \param io The io_context to run the transmitter on
+         * \param max_send_rate The maximum number of packets to send per second, or zero to send every change as soon as it happens
+         */
+
+        SyncServer(asio::io_context& io, unsigned max_send_rate = 0);
+
         /**
          * Constructor for SyncServer
+         * \param io The io_context to run the transmitter on
+         * \param robot The instance whose outputs to transmit on its send port
+         * \param max_send_rate The maximum number of packets to send per second, or zero to send every change as soon as it happens
+         */
+
+        SyncServer(asio::io_context& io, std::shared_ptr<RobotInstance> robot, unsigned max_send_rate = 0);
+
+        /**
+         * Destructor for SyncServer
          */
 
-        SyncServer(asio::io_service& io);
+        ~SyncServer();
 
         /**
-         * \brief Begins and runs transmitter in a background thread
+         * \brief Begin accepting connections from the engine
+         * The transmitter runs as the io_context runs
          */
 
-        void startSync(asio::io_service& io);
+        void startSync();
 
     private:
-        asio::ip::tcp::endpoint endpoint;
+        asio::io_context& io;
+
+        std::shared_ptr<RobotInstance> robot;
+
+        asio::ip::tcp::acceptor acceptor;
+
+        asio::ip::tcp::socket socket;
+
+        /**
+         * \brief Times out the wire format negotiation with a new connection
+         */
+
+        asio::steady_timer negotiation_timer;
+
+        /**
+         * \brief Resends the last packet when no new data is sent for SEND_IDLE_TIMEOUT
+         */
+
+        asio::steady_timer idle_timer;
+
+        /**
+         * \brief Delays the next packet to respect the maximum send rate
+         */
+
+        asio::steady_timer rate_timer;
+
+        /**
+         * \brief Delays retrying a write into a full ring
+         */
+
+        asio::steady_timer ring_retry_timer;
+
+        /**
+         * \brief The wire format agreed with the connected engine
+         */
+
+        WireFormat format;
+
+        /**
+         * \brief Whether an engine is connected and has finished negotiating
+         */
+
+        bool connected;
+
+        /**
+         * \brief Whether outgoing is being written to the socket
+         */
+
+        bool write_in_progress;
+
+        /**
+         * \brief Whether new data arrived while a packet could not be sent
+         */
+
+        bool send_pending;
+
+        /**
+         * \brief Whether the transmitter is waiting out the minimum send interval
+         */
+
+        bool rate_limited;
+
+        /**
+         * \brief Whether a notification of new data has been posted to the io_context but not handled
+         */
+
+        std::atomic<bool> notify_posted;
+
+        /**
+         * \brief The packet being written
+         */
+
+        std::string outgoing;
+
+        /**
+         * \brief The shortest time between packets, or zero for no limit
+         */
+
+        std::chrono::microseconds min_send_interval;
+
+        /**
+         * \brief The shared memory ring to write outputs into, if one was agreed
+         */
+
+        std::unique_ptr<ShmRing> ring;
+
+        /**
+         * \brief Receives and discards anything sent over the socket while the ring carries packets
+         */
+
+        std::array<char, 64> discarded;
+
+        /**
+         * \brief Accept the next connection
+         */
+
+        void startAccept();
+
+        /**
+         * \brief Map a shared memory ring offered by the engine
+         * \param name The name of the ring
+         * \return True if the ring was mapped
+         */
+
+        bool attachRing(const std::string&);
+
+        /**
+         * \brief Write outgoing into the ring, retrying until it fits
+         */
+
+        void writeToRing();
+
+        /**
+         * \brief Wait for the engine to close the socket while the ring carries packets
+         */
+
+        void startWatch();
+
+        /**
+         * \brief Send any pending data or wait out the send interval once a packet has been written
+         */
+
+        void finishWrite();
+
+        /**
+         * \brief Serialize and send the latest outputs, or mark them pending if a packet cannot be sent yet
+         */
+
+        void sendLatest();
+
+        /**
+         * \brief Restart the timer which resends the last packet when idle
+         */
+
+        void restartIdleTimer();
+
+        /**
+         * \brief Close the connection and wait for the engine to reconnect
+         */
+
+        void disconnect();
     };
 }
 
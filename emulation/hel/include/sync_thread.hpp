@@ -0,0 +1,72 @@
+#ifndef _SYNC_THREAD_HPP_
+#define _SYNC_THREAD_HPP_
+
+#include "robot_instance.hpp"
+#include <asio.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace hel{
+    class MultiplexedSync;
+    class SyncClient;
+    class SyncServer;
+
+    /**
+     * \brief Runs the engine connections of every robot instance on one thread
+     * An instance is served either by its own SyncServer and SyncClient or by a MultiplexedSync shared with other instances, never both; whichever is requested first for an instance is kept
+     */
+
+    class SyncThread{
+    public:
+        /**
+         * \brief Serve an instance on its own ports, starting the thread if needed
+         * \param robot The instance to serve
+         */
+
+        static void attach(std::shared_ptr<RobotInstance>);
+
+        /**
+         * \brief Serve several instances over one connection, starting the thread if needed
+         * Call this before the robot programs initialize HAL so that they are not given their own connections
+         * \param port The port to accept the engine's connection on
+         * \param robots The instances to serve
+         */
+
+        static void multiplex(uint16_t, std::vector<std::shared_ptr<RobotInstance>>);
+
+    private:
+        asio::io_context io;
+
+        asio::executor_work_guard<asio::io_context::executor_type> work;
+
+        std::vector<std::unique_ptr<SyncServer>> servers;
+
+        std::vector<std::unique_ptr<SyncClient>> clients;
+
+        std::vector<std::unique_ptr<MultiplexedSync>> sessions;
+
+        /**
+         * \brief The IDs of the instances already served
+         */
+
+        std::set<unsigned> attached;
+
+        std::thread thread;
+
+        /**
+         * \brief Get the sync thread, starting it on first use
+         * It is never destroyed, as robot programs never stop their sync thread
+         * \return The sync thread
+         */
+
+        static SyncThread& getInstance();
+
+        SyncThread();
+    };
+}
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef _SYNC_UTIL_HPP_
+#define _SYNC_UTIL_HPP_
+
+#include "roborio.hpp"
+#include <asio.hpp>
+
+#include <functional>
+#include "binary_util.hpp"
+
+#define ETHERNET_MTU 1516
+
+namespace hel{
+    /**
+     * \brief The longest time in milliseconds to wait for the engine to request the binary wire format after connecting
+     */
+
+    constexpr unsigned WIRE_FORMAT_NEGOTIATION_TIMEOUT_MS = 250;
+
+    /**
+     * \brief The largest handshake payload accepted: the schema version followed by a length-prefixed shared memory ring name
+     */
+
+    constexpr std::size_t MAX_HANDSHAKE_PAYLOAD_SIZE = sizeof(uint16_t) + 1 + 255;
+
+    /**
+     * \brief The ways packets can travel between HEL and Synthesis's engine once a connection is negotiated
+     */
+
+    enum class Transport{
+        SOCKET,
+        SHARED_MEMORY
+    };
+
+    /**
+     * \brief Format a transport as a string
+     * \param transport The transport to convert
+     * \return The transport as a string
+     */
+
+    std::string asString(Transport);
+
+    /**
+     * \brief Agree on a wire format with a newly connected engine without blocking
+     * The engine requests the binary format by sending a handshake packet carrying the newest schema version it supports. HEL replies with a handshake carrying the version both sides will use. If anything other than a handshake arrives first, or nothing arrives before the timeout, nothing is consumed from the socket and the JSON format is used.
+     * An engine on the same host may follow the version with the name of a shared memory ring it created. HEL then follows its reply version with whether it attached to the ring, and if it did, packets travel through the ring while the socket is only kept open to notice disconnection.
+     * \param socket The connected socket
+     * \param timer A timer to use for the timeout; it must outlive the negotiation
+     * \param attach Called with the name of an offered shared memory ring; returns whether HEL attached to it
+     * \param handler Called on the socket's io_context with the wire format and transport to use for the rest of the connection
+     */
+
+    void asyncNegotiateWireFormat(asio::ip::tcp::socket&, asio::steady_timer&, std::function<bool(const std::string&)>, std::function<void(WireFormat, Transport)>);
+}
+
+#endif
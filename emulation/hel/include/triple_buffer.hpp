@@ -0,0 +1,108 @@
+#ifndef _TRIPLE_BUFFER_HPP_
+#define _TRIPLE_BUFFER_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace hel{
+
+    /**
+     * \brief Wait-free single-producer single-consumer triple buffer
+     * The writer fills the back buffer and publishes it by swapping it with the middle buffer; the reader claims the middle buffer by swapping it with the front buffer. Neither side ever waits on the other, and the reader always sees a complete, consistent value. Publishing must be serialized among writers and reading must be serialized among readers.
+     * \tparam T The type of value held by the buffer
+     */
+
+    template<typename T>
+    class TripleBuffer{
+    private:
+
+        /**
+         * \brief Flag set in middle when it holds a value not yet claimed by the reader
+         */
+
+        static constexpr uint8_t FRESH = 0x4;
+
+        /**
+         * \brief Mask to pull the buffer index out of middle
+         */
+
+        static constexpr uint8_t INDEX_MASK = 0x3;
+
+        /**
+         * \brief The three buffers cycled between the writer and the reader
+         */
+
+        std::array<T, 3> buffers;
+
+        /**
+         * \brief The index of the most recently published buffer along with the FRESH flag
+         */
+
+        std::atomic<uint8_t> middle;
+
+        /**
+         * \brief The index of the buffer owned by the writer
+         */
+
+        uint8_t back;
+
+        /**
+         * \brief The index of the buffer owned by the reader
+         */
+
+        uint8_t front;
+
+    public:
+
+        /**
+         * \brief Get the buffer to write the next value into
+         * \return A reference to the back buffer
+         */
+
+        T& getBack()noexcept{
+            return buffers[back];
+        }
+
+        /**
+         * \brief Make the value in the back buffer visible to the reader
+         */
+
+        void publish()noexcept{
+            back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+        }
+
+        /**
+         * \brief Get the most recently published value
+         * The returned reference remains valid until the next call to read
+         * \return A reference to the front buffer
+         */
+
+        const T& read()noexcept{
+            if(middle.load(std::memory_order_relaxed) & FRESH){
+                front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+            }
+            return buffers[front];
+        }
+
+        /**
+         * \brief Check if a value has been published since the last read
+         * \return True if read will return a newly published value
+         */
+
+        bool hasFresh()const noexcept{
+            return middle.load(std::memory_order_acquire) & FRESH;
+        }
+
+        /**
+         * Constructor for TripleBuffer
+         */
+
+        TripleBuffer():buffers(), middle(1), back(0), front(2){}
+
+        TripleBuffer(const TripleBuffer&) = delete;
+        TripleBuffer& operator=(const TripleBuffer&) = delete;
+    };
+}
+
+#endif
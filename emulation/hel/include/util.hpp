@@ -1,7 +1,9 @@
 #ifndef _UTIL_HPP_
 #define _UTIL_HPP_
 
+#include <cstring>
 #include <functional>
+#include <string>
 #include <vector>
 #include <cassert>
 
@@ -120,6 +122,12 @@ namespace hel{
             assert(_is_valid);
             return _data;
         }
+
+        constexpr const T& get()const noexcept{
+            assert(_is_valid);
+            return _data;
+        }
+
         void set(T data){
             _data = data;
             _is_valid = true;
@@ -138,7 +146,78 @@ namespace hel{
         }
 
         Maybe(T data)noexcept:_data(data), _is_valid(true){}
-        Maybe()noexcept: _is_valid(false) {}
+        Maybe()noexcept: _data(), _is_valid(false) {}
+    };
+
+    /**
+     * \brief A non-owning view of a contiguous range of characters
+     * The viewed characters must outlive the view
+     */
+
+    struct StringView{
+    private:
+        /**
+         * \brief The first viewed character
+         */
+
+        const char* start;
+
+        /**
+         * \brief The number of viewed characters
+         */
+
+        std::size_t length;
+
+    public:
+        using value_type = char;
+        using const_iterator = const char*;
+
+        constexpr const char* data()const noexcept{
+            return start;
+        }
+
+        constexpr std::size_t size()const noexcept{
+            return length;
+        }
+
+        constexpr bool empty()const noexcept{
+            return length == 0;
+        }
+
+        constexpr const char* begin()const noexcept{
+            return start;
+        }
+
+        constexpr const char* end()const noexcept{
+            return start + length;
+        }
+
+        constexpr char operator[](std::size_t index)const noexcept{
+            return start[index];
+        }
+
+        /**
+         * \brief Copy the viewed characters into a string
+         * \return The copied string
+         */
+
+        std::string toString()const{
+            return std::string(start, length);
+        }
+
+        friend bool operator==(const StringView& a, const StringView& b)noexcept{
+            return a.length == b.length && (a.length == 0 || std::memcmp(a.start, b.start, a.length) == 0);
+        }
+
+        friend bool operator!=(const StringView& a, const StringView& b)noexcept{
+            return !(a == b);
+        }
+
+        constexpr StringView()noexcept:start(nullptr), length(0){}
+
+        constexpr StringView(const char* s, std::size_t l)noexcept:start(s), length(l){}
+
+        StringView(const std::string& s)noexcept:start(s.data()), length(s.size()){}
     };
 
     /**
@@ -217,6 +296,21 @@ namespace hel{
         return *input ? static_cast<unsigned>(*input) + 33 * hasher(input + 1) : 5381;
     }
 
+    /**
+     * \brief Hash function for a string view
+     * Produces the same hash as hasher(const char*) for the same characters, so views can be matched against hashed literals
+     * \param input The characters to hash
+     * \return The resulting hash
+     */
+
+    constexpr std::size_t hasher(StringView input){
+        std::size_t hash = 5381;
+        for(std::size_t i = input.size(); i > 0; i--){
+            hash = static_cast<unsigned>(input[i - 1]) + 33 * hash;
+        }
+        return hash;
+    }
+
     /**
      * \brief Compare the bits in two integers given a comparison mask
      * \param a The first integer to compare
@@ -0,0 +1,21 @@
+#include "headless_runner.hpp"
+#include "io_replayer.hpp"
+
+#include <cstdlib>
+
+namespace{
+    /**
+     * \brief Replaces the engine connection with the headless runner, or with a replay if one is configured, before the robot program initializes HAL
+     */
+
+    struct HeadlessEntry{
+        HeadlessEntry(){
+            const char* replay_log = std::getenv(hel::IOReplayer::LOG_PATH_VARIABLE);
+            if(replay_log != nullptr && *replay_log != '\0'){
+                hel::engine_stand_in = &hel::IOReplayer::runFromEnvironment;
+            } else {
+                hel::engine_stand_in = &hel::HeadlessRunner::runFromEnvironment;
+            }
+        }
+    } headless_entry;
+}
@@ -0,0 +1,54 @@
+#!/bin/bash
+
+# Runs the benchmarks and records their results as JSON, or compares two recordings
+# ./scripts/run_benchmarks.sh [benchmark_name ...]    Record every benchmark, or those given, to bin/benchmarks/results/<commit>
+# ./scripts/run_benchmarks.sh compare <old> <new>     Compare two recordings, given as commits or result directories
+
+benchmarks_dir=bin/benchmarks
+results_root=$benchmarks_dir/results
+compare_script=lib/GoogleBench/src/GoogleBench/tools/compare.py
+
+results_dir_for() {
+    if [ -d "$1" ]; then
+        echo "$1"
+    else
+        echo "$results_root/$1"
+    fi
+}
+
+if [ "$1" == "compare" ]; then
+    if [ $# -ne 3 ]; then
+        printf "Usage: $0 compare <old> <new>\n"
+        exit 1
+    fi
+    old_dir=$(results_dir_for "$2")
+    new_dir=$(results_dir_for "$3")
+    status=0
+    for old_result in "$old_dir"/*.json; do
+        name=$(basename "$old_result")
+        if [ -f "$new_dir/$name" ]; then
+            printf "\n${name%.json}\n"
+            python3 $compare_script benchmarks "$old_result" "$new_dir/$name" || status=1
+        fi
+    done
+    exit $status
+fi
+
+commit=$(git rev-parse --short HEAD)
+if [ -n "$(git status --porcelain -- src include benchmarks)" ]; then
+    commit=$commit-dirty
+fi
+results_dir=$results_root/$commit
+mkdir -p "$results_dir"
+
+if [ $# -eq 0 ]; then
+    names=$(find $benchmarks_dir -maxdepth 1 -type f -executable -printf "%f\n" | sort)
+else
+    names="$@"
+fi
+
+for name in $names; do
+    printf "Running $name\n"
+    ./$benchmarks_dir/$name --benchmark_out="$results_dir/$name.json" --benchmark_out_format=json || exit 1
+done
+printf "Results recorded to $results_dir\n"
@@ -1,4 +1,5 @@
 #include "roborio_manager.hpp"
+#include "robot_instance.hpp"
 
 #include "FRC_FPGA_ChipObject/RoboRIO_FRC_ChipObject_Aliases.h"
 #include "FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tAccel.h"
@@ -118,7 +119,7 @@ namespace hel{
 #undef COPY
     }
 
-    struct AccelerometerManager: public tAccel{
+    struct AccelerometerManager: public tAccel, private InstanceBound{
     private:
         static constexpr uint8_t ID = 0x2a;
 
@@ -134,11 +135,14 @@ namespace hel{
         }
 
         uint8_t readSTAT(tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
             return 0; //since functions are essentially completed instantly, status is always 0, or done
         }
 
         void writeDATO(uint8_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ACCELEROMETER);
             switch(instance.first->accelerometer.getControlMode()){
                 case Accelerometer::ControlMode::SET_COMM_TARGET:
                     instance.first->accelerometer.setCommTargetReg(value);
@@ -167,23 +171,28 @@ namespace hel{
         }
 
         uint8_t readDATO(tRioStatusCode* /*status*/){ //unnecessary for emulation
+            HEL_PROFILE_CALL();
             return 0;
         }
 
         void writeCNTR(uint8_t /*value*/, tRioStatusCode* /*status*/){} //unnecessary for emulation
 
         uint8_t readCNTR(tRioStatusCode* /*status*/){ //unnecessary for emulation
+            HEL_PROFILE_CALL();
             return 0;
         }
 
         void writeCNFG(uint8_t /*value*/, tRioStatusCode* /*status*/){} //unnecessary for emulation
 
         uint8_t readCNFG(tRioStatusCode* /*status*/){ //unnecessary for emulation
+            HEL_PROFILE_CALL();
             return 0;
         }
 
         void writeCNTL(uint8_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ACCELEROMETER);
             Accelerometer::ControlMode control_mode = [&]{
                 if(value == (CONTROL_START | CONTROL_TX_RX)){//HAL sets value to this when setting up write to comm target
                     return Accelerometer::ControlMode::SET_COMM_TARGET;
@@ -195,11 +204,14 @@ namespace hel{
         }
 
         uint8_t readCNTL(tRioStatusCode* /*status*/){ //unnecessary for emulation
+            HEL_PROFILE_CALL();
             return 0;
         }
 
         uint8_t readDATI(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ACCELEROMETER);
 
             switch(instance.first->accelerometer.getCommTargetReg()){
             case Accelerometer::Register::kReg_WhoAmI:
@@ -240,6 +252,7 @@ namespace hel{
         void writeADDR(uint8_t /*value*/, tRioStatusCode* /*status*/){} //unnecessary for emulation
 
         uint8_t readADDR(tRioStatusCode* /*status*/){ //unnecessary for emulation
+            HEL_PROFILE_CALL();
             return 0;
         }
     };
@@ -1,4 +1,5 @@
 #include "roborio_manager.hpp"
+#include "robot_instance.hpp"
 
 using namespace nFPGA;
 using namespace nRoboRIO_FPGANamespace;
@@ -38,7 +39,7 @@ namespace hel{
 #undef COPY
     }
 
-    struct AccumulatorManager: public tAccumulator{
+    struct AccumulatorManager: public tAccumulator, private InstanceBound{
     private:
         uint8_t index;
 
@@ -48,53 +49,70 @@ namespace hel{
         }
 
         uint8_t getSystemIndex(){
+            HEL_PROFILE_CALL();
             return index;
         }
 
         tOutput readOutput(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ACCUMULATORS);
             instance.second.unlock();
             return instance.first->accumulators[index].getOutput();
         }
 
         signed long long readOutput_Value(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ACCUMULATORS);
             instance.second.unlock();
             return instance.first->accumulators[index].getOutput().Value;
         }
 
         uint32_t readOutput_Count(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ACCUMULATORS);
             instance.second.unlock();
             return instance.first->accumulators[index].getOutput().Count;
         }
 
         void writeCenter(int32_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ACCUMULATORS);
             instance.second.unlock();
             return instance.first->accumulators[index].setCenter(value);
         }
 
         int32_t readCenter(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ACCUMULATORS);
             instance.second.unlock();
             return instance.first->accumulators[index].getCenter();
         }
 
         void writeDeadband(int32_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ACCUMULATORS);
             instance.second.unlock();
             return instance.first->accumulators[index].setDeadband(value);
         }
 
         int32_t readDeadband(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ACCUMULATORS);
             instance.second.unlock();
             return instance.first->accumulators[index].getDeadband();
         }
 
         void strobeReset(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ACCUMULATORS);
             tOutput output;
             instance.second.unlock();
             return instance.first->accumulators[index].setOutput(output);
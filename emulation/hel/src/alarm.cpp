@@ -1,4 +1,5 @@
 #include "roborio_manager.hpp"
+#include "robot_instance.hpp"
 
 using namespace nFPGA;
 using namespace nRoboRIO_FPGANamespace;
@@ -20,6 +21,14 @@ namespace hel{
         trigger_time = time;
     }
 
+    uint64_t Alarm::getDeadline(uint64_t fpga_start_time, uint64_t now)const noexcept{
+        const int32_t REMAINING = (int32_t)(trigger_time - (uint32_t)(now - fpga_start_time));
+        if(REMAINING < 0){
+            return now;
+        }
+        return now + REMAINING + 1; //HAL only counts a notifier as due once the time is past its trigger time
+    }
+
     Alarm::Alarm()noexcept:enabled(false),trigger_time(0){}
 
     Alarm::Alarm(const Alarm& source)noexcept{
@@ -29,31 +38,57 @@ namespace hel{
 #undef COPY
     }
 
-    struct AlarmManager: public tAlarm{ //TODO implement full logic
+    struct AlarmManager: public tAlarm, private InstanceBound{
+    private:
+        /**
+         * \brief Arm or disarm the alarm to match its model
+         * The caller must hold the alarm and global sub-systems
+         * \param roborio The RoboRIO holding the alarm
+         */
+
+        void schedule(const RoboRIO& roborio){
+            if(roborio.alarm.getEnabled()){
+                robot->getAlarmScheduler().arm(roborio.alarm.getDeadline(roborio.global.getFPGAStartTime(), Global::getCurrentTime()));
+            } else {
+                robot->getAlarmScheduler().disarm();
+            }
+        }
+
+    public:
         tSystemInterface* getSystemInterface(){
             return new SystemInterface();
         }
 
         void writeEnable(bool value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance({RoboRIO::Subsystem::ALARM, RoboRIO::Subsystem::GLOBAL});
             instance.first->alarm.setEnabled(value);
+            schedule(*instance.first);
             instance.second.unlock();
         }
 
         bool readEnable(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ALARM);
             instance.second.unlock();
             return instance.first->alarm.getEnabled();
         }
 
         void writeTriggerTime(uint32_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance({RoboRIO::Subsystem::ALARM, RoboRIO::Subsystem::GLOBAL});
             instance.first->alarm.setTriggerTime(value);
+            schedule(*instance.first);
             instance.second.unlock();
         }
 
         uint32_t readTriggerTime(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ALARM);
             instance.second.unlock();
             return instance.first->alarm.getTriggerTime();
         }
@@ -0,0 +1,91 @@
+#include "alarm_scheduler.hpp"
+
+#include "robot_instance.hpp"
+#include "sim_clock.hpp"
+
+namespace hel{
+    AlarmScheduler::AlarmScheduler(RobotInstance& robot)noexcept:robot(robot), mutex(), changed(), armed(false), deadline(0), generation(0), stopping(false), timer_thread(){}
+
+    AlarmScheduler::~AlarmScheduler(){
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            generation++;
+        }
+        changed.notify_all();
+        wakeTimer();
+        if(timer_thread.joinable()){
+            timer_thread.join();
+        }
+    }
+
+    void AlarmScheduler::arm(uint64_t time){
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            armed = true;
+            deadline = time;
+            generation++;
+            if(!timer_thread.joinable()){
+                timer_thread = std::thread(&AlarmScheduler::run, this);
+            }
+        }
+        changed.notify_all();
+        wakeTimer(); //end the wait for the old deadline
+    }
+
+    void AlarmScheduler::disarm(){
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(!armed){
+                return;
+            }
+            armed = false;
+            generation++;
+        }
+        wakeTimer();
+    }
+
+    bool AlarmScheduler::isArmed(){
+        std::lock_guard<std::mutex> lock(mutex);
+        return armed;
+    }
+
+    void AlarmScheduler::run(){
+        RobotInstance::Binding binding(robot);
+        std::unique_lock<std::mutex> lock(mutex);
+        while(!stopping){
+            if(!armed){
+                changed.wait(lock);
+                continue;
+            }
+            const uint64_t DEADLINE = deadline;
+            const uint64_t GENERATION = generation;
+            lock.unlock();
+            if(SimClock::waitUntil(DEADLINE, [&](){ return generation != GENERATION; })){
+                trigger(GENERATION);
+            }
+            lock.lock();
+        }
+    }
+
+    void AlarmScheduler::trigger(uint64_t armed_generation){
+        {
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ALARM); //taken before the scheduler's mutex, as the alarm manager does
+            std::lock_guard<std::mutex> lock(mutex);
+            if(generation != armed_generation){ //re-armed or disarmed while the deadline passed
+                instance.second.unlock();
+                return;
+            }
+            armed = false;
+            generation++;
+            instance.first->alarm.setEnabled(false); //the FPGA disables the alarm each time it triggers
+            instance.second.unlock();
+        }
+        robot.getInterruptSystem().assertAlarm();
+    }
+
+    void AlarmScheduler::wakeTimer(){
+        RobotInstance::Binding binding(robot); //the caller may be bound to another instance, or to none while this instance is destroyed
+        SimClock::wake();
+    }
+}
@@ -1,13 +1,27 @@
+#include <algorithm>
 #include <thread>
 #include <mutex>
-#include <cmath>
 
 #include "roborio_manager.hpp"
+#include "robot_instance.hpp"
 
 using namespace nFPGA;
 using namespace nRoboRIO_FPGANamespace;
 
 namespace hel {
+    constexpr uint8_t AnalogInputs::MAX_SAMPLE_BITS;
+    constexpr unsigned AnalogInputs::AnalogInput::SAMPLE_CAPACITY;
+
+    void AnalogInputs::AnalogInput::push(int32_t value)noexcept{
+        const int64_t SUM = sums[sample_count % SAMPLE_CAPACITY] + value;
+        sample_count++;
+        sums[sample_count % SAMPLE_CAPACITY] = SUM;
+    }
+
+    int64_t AnalogInputs::AnalogInput::sumRecent(unsigned count)const noexcept{
+        return sums[sample_count % SAMPLE_CAPACITY] - sums[(sample_count - count) % SAMPLE_CAPACITY];
+    }
+
     void AnalogInputs::setConfig(tAI::tConfig value)noexcept{
         config = value;
     }
@@ -49,20 +63,55 @@ namespace hel {
     }
 
     std::vector<int32_t> AnalogInputs::getValues(uint8_t channel){
-        return analog_inputs[channel].values;
+        const AnalogInput& input = analog_inputs[channel];
+        const unsigned COUNT = std::min<uint64_t>(input.sample_count, AnalogInput::SAMPLE_CAPACITY - 1);
+        std::vector<int32_t> values;
+        values.reserve(COUNT);
+        for(unsigned i = COUNT; i > 0; i--){
+            values.push_back(input.sumRecent(i) - input.sumRecent(i - 1));
+        }
+        return values;
     }
 
-    void AnalogInputs::setValues(uint8_t channel, std::vector<int32_t> values){
-        analog_inputs[channel].values = values;
+    void AnalogInputs::setValues(uint8_t channel, const std::vector<int32_t>& values){
+        AnalogInput& input = analog_inputs[channel];
+        input.sums.fill(0);
+        input.sample_count = 0;
+        for(int32_t value: values){
+            input.push(value);
+        }
+    }
+
+    void AnalogInputs::pushValue(uint8_t channel, int32_t value){
+        analog_inputs[channel].push(value);
     }
 
-    AnalogInputs::AnalogInput::AnalogInput()noexcept:oversample_bits(0),average_bits(0),scan_list(0),values({}){}
+    int32_t AnalogInputs::getLatestValue(uint8_t channel){
+        const AnalogInput& input = analog_inputs[channel];
+        if(input.sample_count == 0){
+            return 0;
+        }
+        return input.sumRecent(1);
+    }
+
+    int32_t AnalogInputs::getAveragedValue(uint8_t channel){
+        const AnalogInput& input = analog_inputs[channel];
+        if(input.sample_count == 0){
+            return 0;
+        }
+        const unsigned WINDOW_BITS = std::min<unsigned>(input.average_bits + input.oversample_bits, MAX_SAMPLE_BITS);
+        const unsigned COUNT = std::min<uint64_t>(1u << WINDOW_BITS, input.sample_count);
+        return input.sumRecent(COUNT) / COUNT;
+    }
+
+    AnalogInputs::AnalogInput::AnalogInput()noexcept:oversample_bits(0),average_bits(0),scan_list(0),sums(),sample_count(0){}
 
     AnalogInputs::AnalogInput::AnalogInput(const AnalogInput& source)noexcept:AnalogInput(){
 #define COPY(NAME) NAME = source.NAME
         COPY(oversample_bits);
         COPY(average_bits);
-        COPY(values);
+        COPY(sums);
+        COPY(sample_count);
 #undef COPY
     }
 
@@ -76,50 +125,34 @@ namespace hel {
 #undef COPY
     }
 
-    struct AnalogInputManager: public tAI{
+    struct AnalogInputManager: public tAI, private InstanceBound{
         tSystemInterface* getSystemInterface(){
             return nullptr;
         }
 
         int32_t readOutput(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
-            AnalogInputs analog_inputs = instance.first->analog_inputs;
-            uint8_t channel = analog_inputs.getReadSelect().Channel;
-
-            if(analog_inputs.getValues(channel).empty()){
-                return 0;
-            }
-
-            if(analog_inputs.getReadSelect().Averaged){
-                float average = 0;
-                int8_t start_index = std::max(
-                    std::min(
-                        (int)(analog_inputs.getValues(channel).size() - std::pow(2, analog_inputs.getAverageBits(channel) + analog_inputs.getOversampleBits(channel))),
-                        (int)analog_inputs.getValues(channel).size()
-                        ),
-                    0
-                    );
-
-                for(unsigned i = start_index; i < analog_inputs.getValues(channel).size(); i++){
-                    average += analog_inputs.getValues(channel)[i];
-                }
-
-                average /= (analog_inputs.getValues(channel).size() - start_index);
-
-                return (int32_t)average;
-            }
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ANALOG_INPUTS);
+            AnalogInputs& analog_inputs = instance.first->analog_inputs;
+            const tAI::tReadSelect READ_SELECT = analog_inputs.getReadSelect();
+            const int32_t VALUE = READ_SELECT.Averaged ? analog_inputs.getAveragedValue(READ_SELECT.Channel) : analog_inputs.getLatestValue(READ_SELECT.Channel);
             instance.second.unlock();
-            return analog_inputs.getValues(channel).back();
+            return VALUE;
         }
 
         void writeConfig(tAI::tConfig value, tRioStatusCode*) {
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ANALOG_INPUTS);
             instance.first->analog_inputs.setConfig(value);
             instance.second.unlock();
         }
 
         void writeConfig_ScanSize(uint8_t value, tRioStatusCode*) {
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ANALOG_INPUTS);
             auto current_config = instance.first->analog_inputs.getConfig();
             current_config.ScanSize = value;
             instance.first->analog_inputs.setConfig(current_config);
@@ -127,7 +160,9 @@ namespace hel {
         }
 
         void writeConfig_ConvertRate(uint32_t value, tRioStatusCode*) {
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ANALOG_INPUTS);
             auto current_config = instance.first->analog_inputs.getConfig();
             current_config.ConvertRate = value;
             instance.first->analog_inputs.setConfig(current_config);
@@ -135,65 +170,87 @@ namespace hel {
         }
 
         tAI::tConfig readConfig(tRioStatusCode*) {
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ANALOG_INPUTS);
             instance.second.unlock();
             return instance.first->analog_inputs.getConfig();
         }
 
         uint8_t readConfig_ScanSize(tRioStatusCode*) {
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ANALOG_INPUTS);
             instance.second.unlock();
             return instance.first->analog_inputs.getConfig().ScanSize;
         }
 
         uint32_t readConfig_ConvertRate(tRioStatusCode*) {
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ANALOG_INPUTS);
             instance.second.unlock();
             return instance.first->analog_inputs.getConfig().ConvertRate;
         }
 
         void writeOversampleBits(uint8_t channel, uint8_t value, tRioStatusCode*) {
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ANALOG_INPUTS);
             instance.first->analog_inputs.setOversampleBits(channel, value);
             instance.second.unlock();
         }
         void writeAverageBits(uint8_t channel, uint8_t value, tRioStatusCode*) {
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ANALOG_INPUTS);
             instance.first->analog_inputs.setAverageBits(channel, value);
             instance.second.unlock();
         }
         void writeScanList(uint8_t channel, uint8_t value, tRioStatusCode*) {
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ANALOG_INPUTS);
             instance.first->analog_inputs.setScanList(channel, value);
             instance.second.unlock();
         }
 
         uint8_t readOversampleBits(uint8_t channel, tRioStatusCode*) {
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ANALOG_INPUTS);
             instance.second.unlock();
             return instance.first->analog_inputs.getOversampleBits(channel);
         }
 
         uint8_t readAverageBits(uint8_t channel, tRioStatusCode*) {
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ANALOG_INPUTS);
             instance.second.unlock();
             return instance.first->analog_inputs.getAverageBits(channel);
         }
 
         uint8_t readScanList(uint8_t channel, tRioStatusCode*) {
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ANALOG_INPUTS);
             instance.second.unlock();
             return instance.first->analog_inputs.getScanList(channel);
         }
 
         void writeReadSelect(tAI::tReadSelect value, tRioStatusCode*) {
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ANALOG_INPUTS);
             instance.first->analog_inputs.setReadSelect(value);
             instance.second.unlock();
         }
 
         void writeReadSelect_Channel(uint8_t value, tRioStatusCode*) {
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ANALOG_INPUTS);
             auto current_read_select = instance.first->analog_inputs.getReadSelect();
             current_read_select.Channel = value;
             instance.first->analog_inputs.setReadSelect(current_read_select);
@@ -201,31 +258,40 @@ namespace hel {
         }
 
         void writeReadSelect_Averaged(bool value, tRioStatusCode*) {
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ANALOG_INPUTS);
             auto current_read_select = instance.first->analog_inputs.getReadSelect();
-            current_read_select.Channel = value;
+            current_read_select.Averaged = value;
             instance.first->analog_inputs.setReadSelect(current_read_select);
             instance.second.unlock();
         }
 
         tAI::tReadSelect readReadSelect(tRioStatusCode*) {
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ANALOG_INPUTS);
             instance.second.unlock();
             return instance.first->analog_inputs.getReadSelect();
         }
 
         uint8_t readReadSelect_Channel(tRioStatusCode*) {
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ANALOG_INPUTS);
             instance.second.unlock();
             return instance.first->analog_inputs.getReadSelect().Channel;
         }
         bool readReadSelect_Averaged(tRioStatusCode*) {
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ANALOG_INPUTS);
             instance.second.unlock();
             return instance.first->analog_inputs.getReadSelect().Averaged;
         }
 
         uint32_t readLoopTiming(tRioStatusCode*) {
+            HEL_PROFILE_CALL();
             return PWMSystem::EXPECTED_LOOP_TIMING; //this is probably fine
         }
 
@@ -1,4 +1,5 @@
 #include "roborio_manager.hpp"
+#include "robot_instance.hpp"
 
 using namespace nFPGA;
 using namespace nRoboRIO_FPGANamespace;
@@ -10,6 +11,10 @@ namespace hel{
 
     void AnalogOutputs::setMXPOutput(uint8_t index, uint16_t value){
         mxp_outputs[index] = value;
+        RoboRIOManager::publishSnapshot(RoboRIO::Subsystem::ANALOG_OUTPUTS);
+        auto instance = SendDataManager::getInstance();
+        instance.first->updateDeep();
+        instance.second.unlock();
     }
 
     AnalogOutputs::AnalogOutputs()noexcept:mxp_outputs(0){}
@@ -19,19 +24,23 @@ namespace hel{
 #undef COPY
     }
 
-    struct AnalogOutputManager: public tAO{
+    struct AnalogOutputManager: public tAO, private InstanceBound{
         tSystemInterface* getSystemInterface(){
             return new SystemInterface();
         }
 
         void writeMXP(uint8_t reg_index, uint16_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ANALOG_OUTPUTS);
             instance.first->analog_outputs.setMXPOutput(reg_index, value);
             instance.second.unlock();
         }
 
         uint16_t readMXP(uint8_t reg_index, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::ANALOG_OUTPUTS);
             instance.second.unlock();
             return instance.first->analog_outputs.getMXPOutput(reg_index);
         }
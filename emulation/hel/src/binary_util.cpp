@@ -0,0 +1,125 @@
+#include "binary_util.hpp"
+
+#include "error.hpp"
+
+namespace hel{
+    std::string asString(WireFormat format){
+        switch(format){
+        case WireFormat::JSON:
+            return "JSON";
+        case WireFormat::BINARY:
+            return "BINARY";
+        default:
+            throw UnhandledEnumConstantException("hel::WireFormat");
+        }
+    }
+
+    BinaryParsingException::BinaryParsingException(std::string det):message("Synthesis exception: binary parsing failed due to " + det){}
+
+    const char* BinaryParsingException::what()const throw(){
+        return message.c_str();
+    }
+
+    BinaryWriter::BinaryWriter(std::string& out)noexcept:output(out){}
+
+    void BinaryWriter::write(bool value){
+        output.push_back(value ? 1 : 0);
+    }
+
+    void BinaryWriter::write(float value){
+        static_assert(sizeof(float) == sizeof(uint32_t), "Binary format requires 32-bit floats");
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        write(bits);
+    }
+
+    void BinaryWriter::write(double value){
+        static_assert(sizeof(double) == sizeof(uint64_t), "Binary format requires 64-bit doubles");
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        write(bits);
+    }
+
+    void BinaryWriter::write(const std::string& value){
+        const uint8_t LENGTH = value.size() > UINT8_MAX ? UINT8_MAX : value.size();
+        write(LENGTH);
+        output.append(value, 0, LENGTH);
+    }
+
+    std::size_t BinaryWriter::beginPacket(BinaryPacketType type){
+        std::size_t header_position = output.size();
+        write(BINARY_PACKET_MAGIC);
+        write(BINARY_SCHEMA_VERSION);
+        write(type);
+        write(static_cast<uint32_t>(0)); //placeholder for the payload length
+        return header_position;
+    }
+
+    void BinaryWriter::endPacket(std::size_t header_position){
+        const uint32_t PAYLOAD_LENGTH = output.size() - header_position - BINARY_HEADER_SIZE;
+        const std::size_t LENGTH_POSITION = header_position + BINARY_HEADER_SIZE - sizeof(uint32_t);
+        for(unsigned i = 0; i < sizeof(uint32_t); i++){
+            output[LENGTH_POSITION + i] = static_cast<char>((PAYLOAD_LENGTH >> (8 * i)) & 0xFF);
+        }
+    }
+
+    BinaryReader::BinaryReader(const char* data, std::size_t size)noexcept:position(data), end(data + size){}
+
+    void BinaryReader::require(std::size_t size)const{
+        if(remaining() < size){
+            throw BinaryParsingException("truncated packet (needed " + std::to_string(size) + " bytes, " + std::to_string(remaining()) + " remaining)");
+        }
+    }
+
+    std::size_t BinaryReader::remaining()const noexcept{
+        return end - position;
+    }
+
+    bool BinaryReader::readBool(){
+        return read<uint8_t>() != 0;
+    }
+
+    float BinaryReader::readFloat(){
+        uint32_t bits = read<uint32_t>();
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    double BinaryReader::readDouble(){
+        uint64_t bits = read<uint64_t>();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    std::string BinaryReader::readString(){
+        const uint8_t LENGTH = read<uint8_t>();
+        require(LENGTH);
+        std::string value(position, LENGTH);
+        position += LENGTH;
+        return value;
+    }
+
+    bool isBinaryPacket(const char* data, std::size_t size)noexcept{
+        if(size < sizeof(BINARY_PACKET_MAGIC)){
+            return false;
+        }
+        BinaryReader reader(data, size);
+        return reader.read<uint32_t>() == BINARY_PACKET_MAGIC;
+    }
+
+    BinaryHeader readBinaryHeader(BinaryReader& reader){
+        if(reader.read<uint32_t>() != BINARY_PACKET_MAGIC){
+            throw BinaryParsingException("missing packet magic");
+        }
+        BinaryHeader header;
+        header.version = reader.read<uint16_t>();
+        header.type = reader.read<BinaryPacketType>();
+        header.payload_length = reader.read<uint32_t>();
+        if(header.type > BinaryPacketType::BATCH){
+            throw BinaryParsingException("unknown packet type " + std::to_string(static_cast<unsigned>(header.type)));
+        }
+        return header;
+    }
+}
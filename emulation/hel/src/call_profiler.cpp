@@ -0,0 +1,354 @@
+#include "call_profiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace hel{
+    constexpr unsigned CallProfiler::Histogram::SUB_BUCKET_BITS;
+    constexpr unsigned CallProfiler::Histogram::SUB_BUCKETS;
+    constexpr unsigned CallProfiler::Histogram::NUM_BUCKETS;
+    constexpr std::size_t CallProfiler::MAX_SITES;
+    constexpr std::chrono::milliseconds CallProfiler::DEFAULT_REPORT_PERIOD;
+
+    const std::string CallProfiler::UNATTRIBUTED_SITE_NAME = "(lock waits outside HAL calls)";
+    const std::string CallProfiler::REPORT_PATH_VARIABLE = "HEL_PROFILE_REPORT";
+    const std::string CallProfiler::REPORT_PERIOD_VARIABLE = "HEL_PROFILE_REPORT_PERIOD_MS";
+
+    namespace detail{
+        /**
+         * \brief A histogram written by one thread and read by any
+         */
+
+        struct AtomicHistogram{
+            std::array<std::atomic<uint64_t>, CallProfiler::Histogram::NUM_BUCKETS> buckets;
+            std::atomic<uint64_t> count;
+            std::atomic<uint64_t> sum;
+            std::atomic<uint64_t> max;
+
+            static void add(std::atomic<uint64_t>& counter, uint64_t value)noexcept{ //only the owning thread writes, so no read-modify-write is needed
+                counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+            }
+
+            void record(uint64_t nanoseconds)noexcept{
+                add(buckets[CallProfiler::Histogram::bucketOf(nanoseconds)], 1);
+                add(count, 1);
+                add(sum, nanoseconds);
+                if(nanoseconds > max.load(std::memory_order_relaxed)){
+                    max.store(nanoseconds, std::memory_order_relaxed);
+                }
+            }
+
+            void mergeInto(CallProfiler::Histogram& histogram)const noexcept{
+                for(unsigned i = 0; i < buckets.size(); i++){
+                    histogram.buckets[i] += buckets[i].load(std::memory_order_relaxed);
+                }
+                histogram.count += count.load(std::memory_order_relaxed);
+                histogram.sum += sum.load(std::memory_order_relaxed);
+                histogram.max = std::max(histogram.max, max.load(std::memory_order_relaxed));
+            }
+
+            AtomicHistogram()noexcept:count(0), sum(0), max(0){
+                for(std::atomic<uint64_t>& bucket: buckets){
+                    bucket.store(0, std::memory_order_relaxed);
+                }
+            }
+        };
+
+        struct SiteCounters{
+            AtomicHistogram latency;
+            AtomicHistogram lock_wait;
+        };
+
+        /**
+         * \brief One thread's counters, allocated per entry point on its first call from the thread
+         */
+
+        struct ThreadCounters{
+            std::array<std::atomic<SiteCounters*>, CallProfiler::MAX_SITES> sites;
+
+            SiteCounters& get(std::size_t site){
+                SiteCounters* counters = sites[site].load(std::memory_order_relaxed);
+                if(counters == nullptr){
+                    counters = new SiteCounters();
+                    sites[site].store(counters, std::memory_order_release);
+                }
+                return *counters;
+            }
+
+            ThreadCounters()noexcept{
+                for(std::atomic<SiteCounters*>& site: sites){
+                    site.store(nullptr, std::memory_order_relaxed);
+                }
+            }
+
+            ~ThreadCounters(){
+                for(std::atomic<SiteCounters*>& site: sites){
+                    delete site.load(std::memory_order_relaxed);
+                }
+            }
+        };
+
+        struct ProfilerRegistry{
+            std::mutex mutex;
+            std::mutex report_mutex;
+            std::vector<std::string> site_names;
+            std::vector<std::shared_ptr<ThreadCounters>> threads; //kept after their threads exit so their calls are still reported
+            std::size_t unattributed_site;
+
+            ProfilerRegistry():unattributed_site(0){
+                site_names.push_back(CallProfiler::UNATTRIBUTED_SITE_NAME);
+            }
+        };
+
+        ProfilerRegistry& registry(){
+            static ProfilerRegistry* instance = new ProfilerRegistry(); //never destroyed so threads still running at exit can record
+            return *instance;
+        }
+
+        ThreadCounters& threadCounters(){
+            thread_local std::shared_ptr<ThreadCounters> counters;
+            if(counters == nullptr){
+                counters = std::make_shared<ThreadCounters>();
+                std::lock_guard<std::mutex> lock(registry().mutex);
+                registry().threads.push_back(counters);
+            }
+            return *counters;
+        }
+
+        thread_local CallProfiler::ScopedCall* current_call = nullptr;
+
+        uint64_t nanosecondsSince(std::chrono::steady_clock::time_point start)noexcept{
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        void startReportWriter(){
+            const char* path = std::getenv(CallProfiler::REPORT_PATH_VARIABLE.c_str());
+            if(path == nullptr || *path == '\0'){
+                return;
+            }
+            std::chrono::milliseconds period = CallProfiler::DEFAULT_REPORT_PERIOD;
+            const char* period_value = std::getenv(CallProfiler::REPORT_PERIOD_VARIABLE.c_str());
+            if(period_value != nullptr && std::atoi(period_value) > 0){
+                period = std::chrono::milliseconds(std::atoi(period_value));
+            }
+            std::atexit([](){
+                CallProfiler::writeReportToEnvironment();
+            });
+            std::thread([period](){ //robot programs are usually killed rather than exiting, so keep the file current
+                while(true){
+                    std::this_thread::sleep_for(period);
+                    CallProfiler::writeReportToEnvironment();
+                }
+            }).detach();
+        }
+    }
+
+    unsigned CallProfiler::Histogram::bucketOf(uint64_t nanoseconds)noexcept{
+        if(nanoseconds < SUB_BUCKETS){
+            return nanoseconds;
+        }
+        const unsigned EXPONENT = 63 - __builtin_clzll(nanoseconds);
+        return (EXPONENT - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + ((nanoseconds >> (EXPONENT - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+    }
+
+    uint64_t CallProfiler::Histogram::bucketUpperBound(unsigned bucket)noexcept{
+        if(bucket < 2 * SUB_BUCKETS){
+            return bucket;
+        }
+        const unsigned SHIFT = bucket / SUB_BUCKETS - 1;
+        const uint64_t LOWER = static_cast<uint64_t>(SUB_BUCKETS + bucket % SUB_BUCKETS) << SHIFT;
+        return LOWER + ((uint64_t(1) << SHIFT) - 1);
+    }
+
+    void CallProfiler::Histogram::record(uint64_t nanoseconds)noexcept{
+        buckets[bucketOf(nanoseconds)]++;
+        count++;
+        sum += nanoseconds;
+        max = std::max(max, nanoseconds);
+    }
+
+    void CallProfiler::Histogram::merge(const Histogram& other)noexcept{
+        for(unsigned i = 0; i < NUM_BUCKETS; i++){
+            buckets[i] += other.buckets[i];
+        }
+        count += other.count;
+        sum += other.sum;
+        max = std::max(max, other.max);
+    }
+
+    uint64_t CallProfiler::Histogram::percentile(double fraction)const noexcept{
+        if(count == 0){
+            return 0;
+        }
+        const uint64_t RANK = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(std::min(std::max(fraction, 0.0), 1.0) * count)));
+        uint64_t seen = 0;
+        for(unsigned i = 0; i < NUM_BUCKETS; i++){
+            seen += buckets[i];
+            if(seen >= RANK){
+                return std::min(bucketUpperBound(i), max);
+            }
+        }
+        return max;
+    }
+
+    double CallProfiler::Histogram::mean()const noexcept{
+        return count == 0 ? 0.0 : static_cast<double>(sum) / count;
+    }
+
+    CallProfiler::Histogram::Histogram()noexcept:buckets({}), count(0), sum(0), max(0){}
+
+    CallProfiler::ScopedCall::ScopedCall(std::size_t s)noexcept:site(s), start(std::chrono::steady_clock::now()), lock_wait(0), outer(detail::current_call){
+        detail::current_call = this;
+    }
+
+    CallProfiler::ScopedCall::~ScopedCall(){
+        const uint64_t DURATION = detail::nanosecondsSince(start);
+        detail::current_call = outer;
+        if(site >= MAX_SITES){
+            return;
+        }
+        detail::SiteCounters& counters = detail::threadCounters().get(site);
+        counters.latency.record(DURATION);
+        counters.lock_wait.record(lock_wait);
+    }
+
+    CallProfiler::LockWait::LockWait()noexcept:start(std::chrono::steady_clock::now()){}
+
+    CallProfiler::LockWait::~LockWait(){
+        const uint64_t DURATION = detail::nanosecondsSince(start);
+        if(detail::current_call != nullptr){
+            detail::current_call->lock_wait += DURATION;
+            return;
+        }
+        detail::SiteCounters& counters = detail::threadCounters().get(detail::registry().unattributed_site);
+        counters.latency.record(DURATION);
+        counters.lock_wait.record(DURATION);
+    }
+
+    std::string CallProfiler::siteName(const char* signature){
+        const std::string SIGNATURE = signature;
+        std::size_t end = SIGNATURE.find('(');
+        if(end == std::string::npos){
+            end = SIGNATURE.size();
+        }
+        std::size_t begin = end;
+        unsigned template_depth = 0;
+        while(begin > 0){ //the name starts after the last space outside of template arguments
+            const char C = SIGNATURE[begin - 1];
+            if(C == '>'){
+                template_depth++;
+            } else if(C == '<' && template_depth > 0){
+                template_depth--;
+            } else if(C == ' ' && template_depth == 0){
+                break;
+            }
+            begin--;
+        }
+        std::string name = SIGNATURE.substr(begin, end - begin);
+        const std::string NAMESPACE = "hel::";
+        if(name.compare(0, NAMESPACE.size(), NAMESPACE) == 0){
+            name.erase(0, NAMESPACE.size());
+        }
+        return name;
+    }
+
+    std::size_t CallProfiler::registerSite(const char* signature){
+        static std::once_flag report_writer_flag;
+        std::call_once(report_writer_flag, detail::startReportWriter);
+
+        const std::string NAME = siteName(signature);
+        std::lock_guard<std::mutex> lock(detail::registry().mutex);
+        std::vector<std::string>& names = detail::registry().site_names;
+        if(names.size() >= MAX_SITES){
+            std::cerr<<"Synthesis warning: Call profiler is full; not recording "<<NAME<<"\n";
+            return MAX_SITES;
+        }
+        names.push_back(NAME);
+        return names.size() - 1;
+    }
+
+    std::vector<CallProfiler::CallStats> CallProfiler::snapshot(){
+        std::vector<CallStats> stats;
+        {
+            std::lock_guard<std::mutex> lock(detail::registry().mutex);
+            const std::vector<std::string>& names = detail::registry().site_names;
+            for(std::size_t site = 0; site < names.size(); site++){
+                CallStats site_stats{names[site], 0, Histogram(), Histogram()};
+                for(const std::shared_ptr<detail::ThreadCounters>& thread: detail::registry().threads){
+                    const detail::SiteCounters* counters = thread->sites[site].load(std::memory_order_acquire);
+                    if(counters != nullptr){
+                        counters->latency.mergeInto(site_stats.latency);
+                        counters->lock_wait.mergeInto(site_stats.lock_wait);
+                        site_stats.threads++;
+                    }
+                }
+                if(site_stats.latency.count > 0){
+                    stats.push_back(site_stats);
+                }
+            }
+        }
+        std::sort(stats.begin(), stats.end(), [](const CallStats& a, const CallStats& b){
+            return a.latency.sum > b.latency.sum;
+        });
+        return stats;
+    }
+
+    void CallProfiler::writeReport(std::ostream& out){
+        const std::vector<CallStats> STATS = snapshot();
+        uint64_t total_calls = 0;
+        uint64_t total_time = 0;
+        for(const CallStats& stats: STATS){
+            total_calls += stats.latency.count;
+            total_time += stats.latency.sum;
+        }
+        char line[256];
+        std::snprintf(line, sizeof(line), "%-64s %10s %7s %10s %10s %10s %10s %10s %10s %6s\n", "call", "calls", "threads", "total ms", "mean us", "p50 us", "p99 us", "max us", "lock p99", "lock %");
+        out << line;
+        for(const CallStats& stats: STATS){
+            std::snprintf(
+                line, sizeof(line), "%-64s %10llu %7u %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f %6.1f\n",
+                stats.name.c_str(),
+                static_cast<unsigned long long>(stats.latency.count),
+                stats.threads,
+                stats.latency.sum / 1E6,
+                stats.latency.mean() / 1E3,
+                stats.latency.percentile(0.5) / 1E3,
+                stats.latency.percentile(0.99) / 1E3,
+                stats.latency.max / 1E3,
+                stats.lock_wait.percentile(0.99) / 1E3,
+                stats.latency.sum == 0 ? 0.0 : 100.0 * stats.lock_wait.sum / stats.latency.sum
+            );
+            out << line;
+        }
+        std::snprintf(line, sizeof(line), "%llu calls to %zu entry points, %.3f ms total\n", static_cast<unsigned long long>(total_calls), STATS.size(), total_time / 1E6);
+        out << line;
+    }
+
+    bool CallProfiler::writeReportToEnvironment(){
+        const char* path = std::getenv(REPORT_PATH_VARIABLE.c_str());
+        if(path == nullptr || *path == '\0'){
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(detail::registry().report_mutex);
+        const std::string TEMPORARY_PATH = std::string(path) + ".tmp"; //write then rename so readers never see a partial report
+        {
+            std::ofstream file(TEMPORARY_PATH, std::ios::trunc);
+            if(!file){
+                return false;
+            }
+            writeReport(file);
+            if(!file){
+                return false;
+            }
+        }
+        return std::rename(TEMPORARY_PATH.c_str(), path) == 0;
+    }
+}
@@ -1,21 +1,56 @@
+#include "FRC_NetworkCommunication/CANSessionMux.h"
+
+#include "can_stream_manager.hpp"
+#include "diagnostics.hpp"
+#include "robot_instance.hpp"
 #include "roborio_manager.hpp"
 #include "util.hpp"
 
 using namespace nFPGA;
 using namespace nRoboRIO_FPGANamespace;
 
+namespace{
+    /**
+     * \brief The number of CAN device types, for keeping a warning site per type
+     */
+
+    constexpr unsigned NUM_CAN_DEVICE_TYPES = static_cast<unsigned>(hel::CANDevice::Type::UNKNOWN) + 1;
+
+    std::array<hel::Diagnostics::Site, hel::CANMotorControllerTable::CAPACITY * 8> unknown_command_bit_warnings;
+    std::array<hel::Diagnostics::Site, NUM_CAN_DEVICE_TYPES> unsupported_write_warnings;
+    std::array<hel::Diagnostics::Site, hel::CANMotorControllerTable::CAPACITY> missing_controller_read_warnings;
+    std::array<hel::Diagnostics::Site, hel::CANMotorControllerTable::CAPACITY> controller_read_warnings;
+    std::array<hel::Diagnostics::Site, NUM_CAN_DEVICE_TYPES> unsupported_read_warnings;
+
+    /**
+     * \brief Report a status code to the caller, if it asked for one
+     * \param status Where to write the status code, or nullptr
+     * \param value The status code
+     */
+
+    void setStatus(int32_t* status, int32_t value)noexcept{
+        if(status != nullptr){
+            *status = value;
+        }
+    }
+}
+
 extern "C"{
     //Unclear what this CAN address is attempting to communicate. This is used to silence Synthesis warnings about this CAN address not being found since user code tries to communicate to it very frequently, which causes lag with all the warnings
     static const uint32_t SILENT_UNKNOWN_DEVICE_ID = 262271;
 
-    void FRC_NetworkCommunication_CANSessionMux_sendMessage(uint32_t messageID, const uint8_t* data, uint8_t dataSize, int32_t /*periodMs*/, int32_t* /*status*/){
+    void FRC_NetworkCommunication_CANSessionMux_sendMessage(uint32_t messageID, const uint8_t* data, uint8_t dataSize, int32_t /*periodMs*/, int32_t* status){
+        HEL_PROFILE_CALL();
         if(messageID == SILENT_UNKNOWN_DEVICE_ID){
             return;
         }
-        hel::BoundsCheckedArray<uint8_t, hel::CANMotorController::MessageData::SIZE> data_array{0};
-        if(data != nullptr){
-            std::copy(data, data + dataSize, data_array.begin());
+        if(data == nullptr){
+            HEL_WARN("Dropping CAN messages sent without data, first using message ID " + std::to_string(messageID));
+            setStatus(status, ERR_CANSessionMux_InvalidBuffer);
+            return;
         }
+        hel::BoundsCheckedArray<uint8_t, hel::CANMotorController::MessageData::SIZE> data_array{0};
+        std::copy(data, data + std::min<std::size_t>(dataSize, data_array.size()), data_array.begin());
 
         hel::CANDevice::Type target_type = hel::CANDevice::pullDeviceType(messageID);
         switch(target_type){
@@ -25,39 +60,53 @@ extern "C"{
             uint8_t controller_id = hel::CANDevice::pullDeviceID(messageID);
             uint8_t command_byte = data[hel::CANMotorController::MessageData::COMMAND_BYTE];
 
-            auto instance = hel::RoboRIOManager::getInstance();
-            if(instance.first->can_motor_controllers.find(controller_id) == instance.first->can_motor_controllers.end()){ //add motor controller to map if one with controller ID is not found
-                instance.first->can_motor_controllers[controller_id] = {controller_id,target_type};
-            }
+            auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::CAN_MOTOR_CONTROLLERS);
+            hel::CANMotorController& controller = instance.first->can_motor_controllers.emplace(target_type, controller_id); //added on its first message
             if(hel::checkBitHigh(command_byte,hel::CANMotorController::SendCommandByteMask::SET_POWER_PERCENT)){
-                instance.first->can_motor_controllers[controller_id].setPercentOutputData(data_array);
+                controller.setPercentOutputData(data_array);
             }
             if(hel::checkBitHigh(command_byte,hel::CANMotorController::SendCommandByteMask::SET_INVERTED)){
-                instance.first->can_motor_controllers[controller_id].setInverted(true);
+                controller.setInverted(true);
             }
+            const hel::BoundsCheckedArray<uint8_t, hel::CANMotorController::MessageData::SIZE> OUTPUT_DATA = controller.getPercentOutputData();
             instance.second.unlock();
 
+            if(hel::CANStreamManager::hasSessions()){ //answer the command with the controller's status frame, as the hardware would
+                hel::CANStreamManager::Message status_frame{
+                    hel::CANDevice::replaceAPI(messageID, hel::CANMotorController::ReceiveCommandIDMask::GET_POWER_PERCENT),
+                    static_cast<uint32_t>(hel::Global::getCurrentTime() / 1000),
+                    {},
+                    hel::CANMotorController::MessageData::SIZE
+                };
+                std::copy(OUTPUT_DATA.begin(), OUTPUT_DATA.end(), status_frame.data.begin());
+                hel::CANStreamManager::publish(hel::RobotInstance::current().getID(), status_frame);
+            }
+
             for(unsigned i = 0; i < 8; i++){ //check for unrecognized command bits
                 if(
                     i != hel::CANMotorController::SendCommandByteMask::SET_POWER_PERCENT &&
                     i != hel::CANMotorController::SendCommandByteMask::SET_INVERTED &&
                     hel::checkBitHigh(command_byte,i)
                     ){
-                    std::cerr<<"Synthesis warning: Unsupported feature: Writing to CAN motor controller ("<<asString(target_type)<<" with ID "<<((unsigned)controller_id)<<") using unknown command data byte "<<((unsigned)command_byte)<<" (bit "<<i<<")\n";
+                    hel::Diagnostics::report(unknown_command_bit_warnings[hel::CANMotorControllerTable::slotOf(target_type, controller_id) * 8 + i], [&](){
+                        return "Unsupported feature: Writing to CAN motor controller (" + asString(target_type) + " with ID " + std::to_string(controller_id) + ") using unknown command data byte " + std::to_string(command_byte) + " (bit " + std::to_string(i) + ")";
+                    });
                 }
             }
             break;
         }
         case hel::CANDevice::Type::PCM:
         {
-            auto instance = hel::RoboRIOManager::getInstance();
+            auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::PCM);
             instance.first->pcm.setSolenoids(data_array[hel::PCM::MessageData::SOLENOIDS]);
             instance.second.unlock();
             break;
         }
         case hel::CANDevice::Type::UNKNOWN:
         case hel::CANDevice::Type::PDP:
-            std::cerr<<"Synthesis warning: Attempting to write to unsupported CAN device (" + asString(target_type) + ") using message ID "<<messageID<<"\n";
+            hel::Diagnostics::report(unsupported_write_warnings[static_cast<unsigned>(target_type)], [&](){
+                return "Attempting to write to unsupported CAN device (" + asString(target_type) + "), first using message ID " + std::to_string(messageID);
+            });
             break;
         default:
             throw hel::UnhandledEnumConstantException("hel::CANDevice::Type");
@@ -65,7 +114,8 @@ extern "C"{
     }
 
     void FRC_NetworkCommunication_CANSessionMux_receiveMessage(uint32_t* messageID, uint32_t /*messageIDMask*/, uint8_t* /*data*/, uint8_t* /*dataSize*/, uint32_t* /*timeStamp*/, int32_t* /*status*/){
-        if(messageID != nullptr && *messageID == SILENT_UNKNOWN_DEVICE_ID){
+        HEL_PROFILE_CALL();
+        if(messageID == nullptr || *messageID == SILENT_UNKNOWN_DEVICE_ID){
             return;
         }
 
@@ -76,14 +126,19 @@ extern "C"{
         case hel::CANDevice::Type::VICTOR_SPX:
         {
             uint8_t device_id = hel::CANDevice::pullDeviceID(*messageID);
-            auto instance = hel::RoboRIOManager::getInstance();
-            if(instance.first->can_motor_controllers.find(device_id) == instance.first->can_motor_controllers.end()){
-                std::cerr<<"Synthesis warning: Attempting to read from missing CAN motor controller (" + asString(target_type) + " with ID "<<((unsigned)device_id)<<") using message ID "<<*messageID<<"\n";
+            const unsigned SLOT = hel::CANMotorControllerTable::slotOf(target_type, device_id);
+            auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::CAN_MOTOR_CONTROLLERS);
+            if(instance.first->can_motor_controllers.find(target_type, device_id) == nullptr){
+                hel::Diagnostics::report(missing_controller_read_warnings[SLOT], [&](){
+                    return "Attempting to read from missing CAN motor controller (" + asString(target_type) + " with ID " + std::to_string(device_id) + "), first using message ID " + std::to_string(*messageID);
+                });
             } else{
-                std::cerr<<"Synthesis warning: Unsupported feature: Attempting to read from CAN motor controller (" + asString(target_type) + " with ID "<<((unsigned)device_id)<<") using message ID "<<*messageID<<"\n";
+                hel::Diagnostics::report(controller_read_warnings[SLOT], [&](){
+                    return "Unsupported feature: Attempting to read from CAN motor controller (" + asString(target_type) + " with ID " + std::to_string(device_id) + "), first using message ID " + std::to_string(*messageID);
+                });
                 /*
                   if(hel::compareBits(*messageID, hel::CANMotorController::ReceiveCommandIDMask::GET_POWER_PERCENT, hel::CANMotorController::ReceiveCommandIDMask::GET_POWER_PERCENT)){
-                  hel::BoundsCheckedArray<uint8_t, hel::CANMotorController::MessageData::SIZE> data_array = instance.first->can_motor_controllers[device_id].getSpeedData();
+                  hel::BoundsCheckedArray<uint8_t, hel::CANMotorController::MessageData::SIZE> data_array = instance.first->can_motor_controllers.find(target_type, device_id)->getSpeedData();
                   std::copy(data_array.begin(), data_array.end(), data);
                   *dataSize = hel::CANMotorController::MessageData::SIZE;
                   *timeStamp = hel::Global::getCurrentTime() / 1000;
@@ -96,26 +151,71 @@ extern "C"{
         case hel::CANDevice::Type::PCM:
         case hel::CANDevice::Type::UNKNOWN:
         case hel::CANDevice::Type::PDP:
-            std::cerr<<"Synthesis warning: Unsupported feature: Attempting to read from CAN device (" + asString(target_type) + ") using message ID "<<*messageID<<"\n";
+            hel::Diagnostics::report(unsupported_read_warnings[static_cast<unsigned>(target_type)], [&](){
+                return "Unsupported feature: Attempting to read from CAN device (" + asString(target_type) + "), first using message ID " + std::to_string(*messageID);
+            });
             break;
         default:
             throw hel::UnhandledEnumConstantException("hel::CANDevice::Type");
         }
     }
 
-    void FRC_NetworkCommunication_CANSessionMux_openStreamSession(uint32_t* /*sessionHandle*/, uint32_t /*messageID*/, uint32_t /*messageIDMask*/, uint32_t /*maxMessages*/, int32_t* /*status*/){
-        std::cerr<<"Synthesis warning: Unsupported feature: Function call FRC_NetworkCommunication_CANSessionMux_openStreamSession\n";
+    void FRC_NetworkCommunication_CANSessionMux_openStreamSession(uint32_t* sessionHandle, uint32_t messageID, uint32_t messageIDMask, uint32_t maxMessages, int32_t* status){
+        HEL_PROFILE_CALL();
+        if(sessionHandle == nullptr){
+            setStatus(status, ERR_CANSessionMux_InvalidBuffer);
+            return;
+        }
+        try{
+            *sessionHandle = hel::CANStreamManager::open(hel::RobotInstance::current().getID(), messageID, messageIDMask, maxMessages);
+            setStatus(status, 0);
+        } catch(const std::runtime_error& ex){
+            hel::Diagnostics::report(hel::Diagnostics::registerWarning("Failed to open CAN stream session for message ID " + std::to_string(messageID) + " (" + ex.what() + ")"));
+            setStatus(status, ERR_CANSessionMux_NotAllowed);
+        }
     }
 
-    void FRC_NetworkCommunication_CANSessionMux_closeStreamSession(uint32_t /*sessionHandle*/){
-        std::cerr<<"Synthesis warning: Unsupported feature: Function call FRC_NetworkCommunication_CANSessionMux_closeStreamSession\n";
+    void FRC_NetworkCommunication_CANSessionMux_closeStreamSession(uint32_t sessionHandle){
+        HEL_PROFILE_CALL();
+        hel::CANStreamManager::close(hel::RobotInstance::current().getID(), sessionHandle);
     }
 
-    void FRC_NetworkCommunication_CANSessionMux_readStreamSession(uint32_t /*sessionHandle*/, struct tCANStreamMessage* /*messages*/, uint32_t /*messagesToRead*/, uint32_t* /*messagesRead*/, int32_t* /*status*/){
-        std::cerr<<"Synthesis warning: Unsupported feature: Function call FRC_NetworkCommunication_CANSessionMux_readStreamSession\n";
+    void FRC_NetworkCommunication_CANSessionMux_readStreamSession(uint32_t sessionHandle, struct tCANStreamMessage* messages, uint32_t messagesToRead, uint32_t* messagesRead, int32_t* status){
+        HEL_PROFILE_CALL();
+        if(messages == nullptr || messagesRead == nullptr){
+            setStatus(status, ERR_CANSessionMux_InvalidBuffer);
+            return;
+        }
+        constexpr uint32_t BATCH_SIZE = 32;
+        std::array<hel::CANStreamManager::Message, BATCH_SIZE> batch;
+        bool overrun = false;
+        *messagesRead = 0;
+        try{
+            while(*messagesRead < messagesToRead){
+                bool batch_overrun = false;
+                const std::size_t COUNT = hel::CANStreamManager::read(hel::RobotInstance::current().getID(), sessionHandle, batch.data(), std::min(messagesToRead - *messagesRead, BATCH_SIZE), batch_overrun);
+                overrun = overrun || batch_overrun;
+                for(std::size_t i = 0; i < COUNT; i++){
+                    tCANStreamMessage& message = messages[*messagesRead + i];
+                    message.messageID = batch[i].message_id;
+                    message.timeStamp = batch[i].time_stamp;
+                    std::copy(batch[i].data.begin(), batch[i].data.end(), message.data);
+                    message.dataSize = batch[i].data_size;
+                }
+                *messagesRead += COUNT;
+                if(COUNT < BATCH_SIZE){
+                    break;
+                }
+            }
+        } catch(const std::out_of_range&){
+            setStatus(status, ERR_CANSessionMux_NotAllowed);
+            return;
+        }
+        setStatus(status, overrun ? ERR_CANSessionMux_SessionOverrun : 0);
     }
 
     void FRC_NetworkCommunication_CANSessionMux_getCANStatus(float* /*percentBusUtilization*/, uint32_t* /*busOffCount*/, uint32_t* /*txFullCount*/, uint32_t* /*receiveErrorCount*/, uint32_t* /*transmitErrorCount*/, int32_t* /*status*/){
-        std::cerr<<"Synthesis warning: Unsupported feature: Function call FRC_NetworkCommunication_CANSessionMux_getCANStatus\n";
+        HEL_PROFILE_CALL();
+        HEL_WARN("Unsupported feature: Function call FRC_NetworkCommunication_CANSessionMux_getCANStatus");
     }
 }
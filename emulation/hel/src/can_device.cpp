@@ -52,4 +52,8 @@ namespace hel{
         }
         return Type::UNKNOWN;
     }
+
+    uint32_t CANDevice::replaceAPI(uint32_t message_id, uint32_t api)noexcept{
+        return (message_id & ~IDMask::API) | (api & IDMask::API);
+    }
 }
@@ -1,4 +1,5 @@
 #include "roborio_manager.hpp"
+#include "binary_util.hpp"
 #include "json_util.hpp"
 
 #include <cmath>
@@ -18,15 +19,28 @@ namespace hel{
     }
 
     std::string CANMotorController::serialize()const {
-        std::string s = "{";
-        s += "\"type\":" + quote(asString(type)) + ", ";
-        s += "\"id\":" + std::to_string(id) + ", ";
-        s += "\"percent_output\":" + std::to_string(percent_output) + ", ";
-        s += "\"inverted\":" + std::to_string(inverted);
-        s += "}";
+        std::string s;
+        JSONWriter writer(s);
+        serialize(writer);
         return s;
     }
 
+    void CANMotorController::serialize(JSONWriter& writer)const {
+        writer.writeRaw('{');
+        writer.writeLabel("type");
+        writer.writeString(asString(type));
+        writer.writeRaw(", ");
+        writer.writeLabel("id");
+        writer.write(id);
+        writer.writeRaw(", ");
+        writer.writeLabel("percent_output");
+        writer.write(percent_output);
+        writer.writeRaw(", ");
+        writer.writeLabel("inverted");
+        writer.write(inverted);
+        writer.writeRaw('}');
+    }
+
     CANMotorController CANMotorController::deserialize(std::string input){
         CANMotorController a;
         a.type = s_to_can_device_type(unquote(pullObject("\"type\"",input)));
@@ -36,6 +50,50 @@ namespace hel{
         return a;
     }
 
+    CANMotorController CANMotorController::deserialize(JSONReader& reader){
+        CANMotorController a;
+        reader.beginObject();
+        StringView label;
+        while(reader.nextField(label)){
+            switch(hasher(label)){
+            case hasher("type"):
+                a.type = s_to_can_device_type(reader.readString().toString());
+                break;
+            case hasher("id"):
+                a.id = reader.readInteger<uint8_t>();
+                break;
+            case hasher("percent_output"):
+                a.percent_output = reader.readDouble();
+                break;
+            case hasher("inverted"):
+                a.inverted = reader.readBool();
+                break;
+            default:
+                reader.skipValue();
+            }
+        }
+        return a;
+    }
+
+    void CANMotorController::serializeBinary(BinaryWriter& writer)const{
+        writer.write(static_cast<uint8_t>(type));
+        writer.write(id);
+        writer.write(static_cast<float>(percent_output));
+        writer.write(inverted);
+    }
+
+    CANMotorController CANMotorController::deserializeBinary(BinaryReader& reader){
+        CANMotorController a;
+        a.type = static_cast<CANDevice::Type>(reader.read<uint8_t>());
+        if(a.type > CANDevice::Type::UNKNOWN){
+            throw BinaryParsingException("invalid CAN device type");
+        }
+        a.id = reader.read<uint8_t>();
+        a.percent_output = reader.readFloat();
+        a.inverted = reader.readBool();
+        return a;
+    }
+
     CANDevice::Type CANMotorController::getType()const noexcept{
         return type;
     }
@@ -54,6 +112,7 @@ namespace hel{
           divide by (256*256*4) to scale from the range -256*256*4 to 256*256*4 to the range -1.0 to 1.0
         */
         percent_output = ((double)((data[1] - data[0])*256*256 + (data[2] - data[0])*256 + (data[3] - data[0])))/(256*256*4);
+        RoboRIOManager::publishSnapshot(RoboRIO::Subsystem::CAN_MOTOR_CONTROLLERS);
         auto instance = SendDataManager::getInstance();
         instance.first->updateShallow();
         instance.second.unlock();
@@ -61,6 +120,7 @@ namespace hel{
 
     void CANMotorController::setPercentOutput(double out)noexcept{
         percent_output = out;
+        RoboRIOManager::publishSnapshot(RoboRIO::Subsystem::CAN_MOTOR_CONTROLLERS);
         auto instance = SendDataManager::getInstance();
         instance.first->updateShallow();
         instance.second.unlock();
@@ -90,8 +150,13 @@ namespace hel{
         return data;
     }
 
+    bool CANMotorController::getInverted()const noexcept{
+        return inverted;
+    }
+
     void CANMotorController::setInverted(bool i)noexcept{
         inverted = i;
+        RoboRIOManager::publishSnapshot(RoboRIO::Subsystem::CAN_MOTOR_CONTROLLERS);
         auto instance = SendDataManager::getInstance();
         instance.first->updateShallow();
         instance.second.unlock();
@@ -103,19 +168,11 @@ namespace hel{
         assert(type == CANDevice::Type::TALON_SRX || type == CANDevice::Type::VICTOR_SPX);
     }
 
-    CANMotorController::CANMotorController(const CANMotorController& source)noexcept{
-#define COPY(NAME) NAME = source.NAME
-        COPY(type);
-        COPY(id);
-        COPY(percent_output);
-        COPY(inverted);
-#undef COPY
-    }
-
     CANMotorController::CANMotorController(uint32_t message_id)noexcept:CANMotorController(){
         type = CANDevice::pullDeviceType(message_id);
         assert(type == CANDevice::Type::TALON_SRX || type == CANDevice::Type::VICTOR_SPX);
         id = CANDevice::pullDeviceID(message_id);
+        RoboRIOManager::publishSnapshot(RoboRIO::Subsystem::CAN_MOTOR_CONTROLLERS);
         auto instance = SendDataManager::getInstance();
         instance.first->updateShallow();
         instance.second.unlock();
@@ -0,0 +1,74 @@
+#include "can_motor_controller_table.hpp"
+
+#include <stdexcept>
+
+#include "binary_util.hpp"
+#include "json_util.hpp"
+#include "util.hpp"
+
+namespace hel{
+    constexpr unsigned CANMotorControllerTable::NUM_TYPES;
+    constexpr unsigned CANMotorControllerTable::IDS_PER_TYPE;
+    constexpr unsigned CANMotorControllerTable::CAPACITY;
+
+    CANMotorControllerTable::CANMotorControllerTable()noexcept:slots(), occupied(){}
+
+    CANMotorController& CANMotorControllerTable::emplace(CANDevice::Type type, uint8_t id){
+        if(!hasSlot(type, id)){
+            throw std::out_of_range("Synthesis exception: no CAN motor controller slot for " + asString(type) + " with ID " + std::to_string(id));
+        }
+        const unsigned SLOT = slotOf(type, id);
+        if(!occupied.test(SLOT)){
+            slots[SLOT] = {id, type};
+            occupied.set(SLOT);
+        }
+        return slots[SLOT];
+    }
+
+    std::string CANMotorControllerTable::toString()const{
+        return asString(*this, std::function<std::string(CANMotorController)>(&CANMotorController::toString));
+    }
+
+    void CANMotorControllerTable::serialize(JSONWriter& writer)const{
+        writer.writeRaw('[');
+        for(const_iterator i = begin(); i != end(); ++i){
+            if(i != begin()){
+                writer.writeRaw(',');
+            }
+            i->serialize(writer);
+        }
+        writer.writeRaw(']');
+    }
+
+    CANMotorControllerTable CANMotorControllerTable::deserialize(JSONReader& reader){
+        CANMotorControllerTable table;
+        reader.beginList();
+        while(reader.nextElement()){
+            const CANMotorController CAN_MOTOR_CONTROLLER = CANMotorController::deserialize(reader);
+            table.emplace(CAN_MOTOR_CONTROLLER.getType(), CAN_MOTOR_CONTROLLER.getID()) = CAN_MOTOR_CONTROLLER; //throws if there is no slot for it
+        }
+        return table;
+    }
+
+    void CANMotorControllerTable::serializeBinary(BinaryWriter& writer)const{
+        serializeBinary(writer, occupied);
+    }
+
+    void CANMotorControllerTable::serializeBinary(BinaryWriter& writer, const SlotMask& selected)const{
+        writer.write(static_cast<uint8_t>(selected.count()));
+        for(unsigned slot = selected.next(0); slot < CAPACITY; slot = selected.next(slot + 1)){
+            slots[slot].serializeBinary(writer);
+        }
+    }
+
+    void CANMotorControllerTable::deserializeBinary(BinaryReader& reader){
+        const uint8_t COUNT = reader.read<uint8_t>();
+        for(unsigned i = 0; i < COUNT; i++){
+            const CANMotorController CAN_MOTOR_CONTROLLER = CANMotorController::deserializeBinary(reader);
+            if(!hasSlot(CAN_MOTOR_CONTROLLER.getType(), CAN_MOTOR_CONTROLLER.getID())){
+                throw BinaryParsingException("CAN motor controller with no slot");
+            }
+            emplace(CAN_MOTOR_CONTROLLER.getType(), CAN_MOTOR_CONTROLLER.getID()) = CAN_MOTOR_CONTROLLER;
+        }
+    }
+}
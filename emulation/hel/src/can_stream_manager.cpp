@@ -0,0 +1,106 @@
+#include "can_stream_manager.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace hel{
+    constexpr unsigned CANStreamManager::MAX_SESSIONS;
+    constexpr uint32_t CANStreamManager::MAX_MESSAGES_PER_SESSION;
+
+    std::mutex CANStreamManager::sessions_mutex;
+    std::array<CANStreamManager::Session, CANStreamManager::MAX_SESSIONS> CANStreamManager::sessions;
+    std::atomic<unsigned> CANStreamManager::open_count(0);
+
+    CANStreamManager::Stream::Stream(unsigned robot_id, uint32_t message_id, uint32_t message_id_mask, uint32_t max_messages):ring(std::min(std::max(max_messages, 1u), MAX_MESSAGES_PER_SESSION)), robot_id(robot_id), message_id(message_id), message_id_mask(message_id_mask), overrun(false){}
+
+    CANStreamManager::Pin::Pin(Session& session)noexcept:session(session){
+        session.pins.fetch_add(1); //sequentially consistent with close unpublishing the stream, so either close sees this pin or get sees nullptr
+    }
+
+    CANStreamManager::Stream* CANStreamManager::Pin::get()const noexcept{
+        return session.stream.load();
+    }
+
+    CANStreamManager::Pin::~Pin(){
+        session.pins.fetch_sub(1, std::memory_order_release);
+    }
+
+    uint32_t CANStreamManager::open(unsigned robot_id, uint32_t message_id, uint32_t message_id_mask, uint32_t max_messages){
+        std::lock_guard<std::mutex> lock(sessions_mutex);
+        for(unsigned i = 0; i < MAX_SESSIONS; i++){
+            Session& session = sessions[i];
+            if(session.stream.load(std::memory_order_relaxed) != nullptr){
+                continue;
+            }
+            session.stream.store(new Stream(robot_id, message_id, message_id_mask, max_messages), std::memory_order_release);
+            open_count++;
+            return i + 1;
+        }
+        throw std::runtime_error("Synthesis exception: all " + std::to_string(MAX_SESSIONS) + " CAN stream sessions are open");
+    }
+
+    void CANStreamManager::close(unsigned robot_id, uint32_t handle)noexcept{
+        if(handle == 0 || handle > MAX_SESSIONS){
+            return;
+        }
+        Session& session = sessions[handle - 1];
+        Stream* stream = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(sessions_mutex);
+            stream = session.stream.load(std::memory_order_relaxed);
+            if(stream == nullptr || stream->robot_id != robot_id){
+                return;
+            }
+            session.stream.store(nullptr);
+            open_count--;
+        }
+        while(session.pins.load() != 0){ //publishers and readers which saw the stream before it was unpublished may still be using it
+            std::this_thread::yield();
+        }
+        delete stream;
+    }
+
+    std::size_t CANStreamManager::read(unsigned robot_id, uint32_t handle, Message* messages, std::size_t max_count, bool& overrun){
+        if(handle == 0 || handle > MAX_SESSIONS){
+            throw std::out_of_range("Synthesis exception: CAN stream session " + std::to_string(handle) + " is not open");
+        }
+        Pin pin(sessions[handle - 1]);
+        Stream* stream = pin.get();
+        if(stream == nullptr){
+            throw std::out_of_range("Synthesis exception: CAN stream session " + std::to_string(handle) + " is not open");
+        }
+        if(stream->robot_id != robot_id){
+            throw std::out_of_range("Synthesis exception: CAN stream session " + std::to_string(handle) + " was not opened by robot instance " + std::to_string(robot_id));
+        }
+        const std::size_t COUNT = stream->ring.pop(messages, max_count);
+        overrun = stream->overrun.exchange(false, std::memory_order_relaxed);
+        return COUNT;
+    }
+
+    void CANStreamManager::publish(unsigned robot_id, const Message& message)noexcept{
+        if(!hasSessions()){
+            return;
+        }
+        for(Session& session: sessions){
+            if(session.stream.load(std::memory_order_relaxed) == nullptr){ //skip free slots without pinning them
+                continue;
+            }
+            Pin pin(session);
+            Stream* stream = pin.get();
+            if(
+                stream != nullptr &&
+                stream->robot_id == robot_id &&
+                (message.message_id & stream->message_id_mask) == (stream->message_id & stream->message_id_mask) &&
+                !stream->ring.push(message)
+            ){
+                stream->overrun.store(true, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool CANStreamManager::hasSessions()noexcept{
+        return open_count.load(std::memory_order_relaxed) != 0;
+    }
+}
@@ -1,31 +1,36 @@
 #include "roborio_manager.hpp"
+#include "sim_clock.hpp"
 using namespace nFPGA;
 using namespace nRoboRIO_FPGANamespace;
 
 extern "C" {
     int FRC_NetworkCommunication_Reserve(void* /*instance*/){ //unnecessary for emulation
+        HEL_PROFILE_CALL();
         return 0;
     }
 
     int FRC_NetworkCommunication_sendConsoleLine(const char* /*line*/){ //unnecessary for emulation
+        HEL_PROFILE_CALL();
         return 0;
     }
 
     int FRC_NetworkCommunication_sendError(int isError, int32_t errorCode, int /*isLVCode*/, const char* details, const char* location, const char* callStack){
-        auto instance = hel::RoboRIOManager::getInstance();
+        HEL_PROFILE_CALL();
+        auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::DS_ERRORS);
         instance.first->ds_errors.push_back({(bool)isError, errorCode, details, location, callStack}); //assuming isLVCode = false (not supporting LabView
         instance.second.unlock();
         return 0;
     }
 
     int64_t FRC_NetworkCommunication_nUsageReporting_report(int32_t, int32_t, int32_t, const char *){ //unnecessary for emulation
+        HEL_PROFILE_CALL();
         return 0;
     }
 
     void setNewDataSem(pthread_cond_t*){} //unnecessary for emulation
 
     int setNewDataOccurRef(uint32_t refnum){
-        auto instance = hel::RoboRIOManager::getInstance();
+        auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::NET_COMM);
         instance.first->net_comm.ref_num = refnum;
 
         instance.second.unlock();
@@ -33,7 +38,8 @@ extern "C" {
     }
 
     int FRC_NetworkCommunication_getControlWord(struct ControlWord_t* controlWord){
-        auto instance = hel::RoboRIOManager::getInstance();
+        HEL_PROFILE_CALL();
+        auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::ROBOT_MODE);
         if (controlWord != nullptr) {
             *controlWord = instance.first->robot_mode.toControlWord();
         }
@@ -43,7 +49,8 @@ extern "C" {
     }
 
     int FRC_NetworkCommunication_getAllianceStation(enum AllianceStationID_t* allianceStation){
-        auto instance = hel::RoboRIOManager::getInstance();
+        HEL_PROFILE_CALL();
+        auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::MATCH_INFO);
         if (allianceStation != nullptr)
             *allianceStation = instance.first->match_info.getAllianceStationID();
 
@@ -52,7 +59,8 @@ extern "C" {
     }
 
     int FRC_NetworkCommunication_getMatchInfo(char* eventName, MatchType_t* matchType, uint16_t* matchNumber, uint8_t* replayNumber, uint8_t* gameSpecificMessage, uint16_t* gameSpecificMessageSize){
-        auto instance = hel::RoboRIOManager::getInstance();
+        HEL_PROFILE_CALL();
+        auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::MATCH_INFO);
         if (eventName != nullptr){ //HAL requires this to be silently handled
             instance.first->match_info.getEventName().copy(eventName,hel::MatchInfo::MAX_EVENT_NAME_SIZE);
         }
@@ -75,7 +83,8 @@ extern "C" {
     }
 
     int FRC_NetworkCommunication_getMatchTime(float* matchTime){
-        auto instance = hel::RoboRIOManager::getInstance();
+        HEL_PROFILE_CALL();
+        auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::MATCH_INFO);
         if (matchTime != nullptr)
             *matchTime = instance.first->match_info.getMatchTime();
 
@@ -84,7 +93,8 @@ extern "C" {
     }
 
     int FRC_NetworkCommunication_getJoystickAxes(uint8_t joystickNum, struct JoystickAxes_t* axes, uint8_t maxAxes){
-        auto instance = hel::RoboRIOManager::getInstance();
+        HEL_PROFILE_CALL();
+        auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::JOYSTICKS);
 
         if(joystickNum >= hel::Joystick::MAX_JOYSTICK_COUNT){
             throw std::out_of_range("Exception: unexpected joysticks index (expected 0-" + std::to_string(hel::Joystick::MAX_JOYSTICK_COUNT) + " got " + std::to_string(joystickNum) + ")");
@@ -104,7 +114,8 @@ extern "C" {
     }
 
     int FRC_NetworkCommunication_getJoystickButtons(uint8_t joystickNum, uint32_t* buttons, uint8_t* count){
-        auto instance = hel::RoboRIOManager::getInstance();
+        HEL_PROFILE_CALL();
+        auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::JOYSTICKS);
 
         if(joystickNum >= hel::Joystick::MAX_JOYSTICK_COUNT){
             throw std::out_of_range("Exception: unexpected joysticks index (expected 0-" + std::to_string(hel::Joystick::MAX_JOYSTICK_COUNT) + " got " + std::to_string(joystickNum) + ")");
@@ -120,7 +131,8 @@ extern "C" {
     }
 
     int FRC_NetworkCommunication_getJoystickPOVs(uint8_t joystickNum, struct JoystickPOV_t* povs, uint8_t maxPOVs){
-        auto instance = hel::RoboRIOManager::getInstance();
+        HEL_PROFILE_CALL();
+        auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::JOYSTICKS);
 
         if(joystickNum >= hel::Joystick::MAX_JOYSTICK_COUNT){
             throw std::out_of_range("Exception: unexpected joysticks index (expected 0-" + std::to_string(hel::Joystick::MAX_JOYSTICK_COUNT) + " got " + std::to_string(joystickNum) + ")");
@@ -140,7 +152,8 @@ extern "C" {
     }
 
     int FRC_NetworkCommunication_setJoystickOutputs(uint8_t joystickNum, uint32_t hidOutputs, uint16_t leftRumble, uint16_t rightRumble){
-        auto instance = hel::RoboRIOManager::getInstance();
+        HEL_PROFILE_CALL();
+        auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::JOYSTICKS);
 
         if(joystickNum >= hel::Joystick::MAX_JOYSTICK_COUNT){
             throw std::out_of_range("Exception: unexpected joysticks index (expected 0-" + std::to_string(hel::Joystick::MAX_JOYSTICK_COUNT) + " got " + std::to_string(joystickNum) + ")");
@@ -155,7 +168,8 @@ extern "C" {
     }
 
     int FRC_NetworkCommunication_getJoystickDesc(uint8_t joystickNum, uint8_t* isXBox, uint8_t* type, char* name, uint8_t* axisCount, uint8_t* axisTypes, uint8_t* buttonCount, uint8_t* povCount){
-        auto instance = hel::RoboRIOManager::getInstance();
+        HEL_PROFILE_CALL();
+        auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::JOYSTICKS);
 
         if(joystickNum >= hel::Joystick::MAX_JOYSTICK_COUNT){
             throw std::out_of_range("Exception: unexpected joysticks index (expected 0-" + std::to_string(hel::Joystick::MAX_JOYSTICK_COUNT) + " got " + std::to_string(joystickNum) + ")");
@@ -188,11 +202,15 @@ extern "C" {
     void FRC_NetworkCommunication_getVersionString(char* /*version*/){} //unnecessary for emulation
 
     int FRC_NetworkCommunication_observeUserProgramStarting(void){ //unnecessary for emulation
+        HEL_PROFILE_CALL();
         return 0;
     }
 
     void FRC_NetworkCommunication_observeUserProgramDisabled(void){
-        auto instance = hel::RoboRIOManager::getInstance();
+        hel::SimClock::startUserLoop(); //WPILib reports the mode once per loop iteration; waits here if a driver holds the loop
+        HEL_PROFILE_CALL();
+
+        auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::ROBOT_MODE);
 
         instance.first->robot_mode.setEnabled(false);
 
@@ -200,7 +218,10 @@ extern "C" {
     }
 
     void FRC_NetworkCommunication_observeUserProgramAutonomous(void){
-        auto instance = hel::RoboRIOManager::getInstance();
+        hel::SimClock::startUserLoop();
+        HEL_PROFILE_CALL();
+
+        auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::ROBOT_MODE);
 
         instance.first->robot_mode.setMode(hel::RobotMode::Mode::AUTONOMOUS);
         instance.first->robot_mode.setEnabled(true);
@@ -209,7 +230,10 @@ extern "C" {
     }
 
     void FRC_NetworkCommunication_observeUserProgramTeleop(void){
-        auto instance = hel::RoboRIOManager::getInstance();
+        hel::SimClock::startUserLoop();
+        HEL_PROFILE_CALL();
+
+        auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::ROBOT_MODE);
 
         instance.first->robot_mode.setMode(hel::RobotMode::Mode::TELEOPERATED);
         instance.first->robot_mode.setEnabled(true);
@@ -218,7 +242,10 @@ extern "C" {
     }
 
     void FRC_NetworkCommunication_observeUserProgramTest(void){
-        auto instance = hel::RoboRIOManager::getInstance();
+        hel::SimClock::startUserLoop();
+        HEL_PROFILE_CALL();
+
+        auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::ROBOT_MODE);
 
         instance.first->robot_mode.setMode(hel::RobotMode::Mode::TEST);
         instance.first->robot_mode.setEnabled(true);
@@ -1,4 +1,5 @@
 #include "roborio_manager.hpp"
+#include "robot_instance.hpp"
 
 using namespace nFPGA;
 using namespace nRoboRIO_FPGANamespace;
@@ -56,10 +57,22 @@ namespace hel{
 #undef COPY
     }
 
-    struct CounterManager: public tCounter{
+    struct CounterManager: public tCounter, private InstanceBound{
     private:
         uint8_t index;
 
+        /**
+         * \brief Set the counter's configuration and update the index mapping encoder ports to it
+         * The caller must hold the counters sub-system
+         * \param roborio The RoboRIO holding the counter
+         * \param config The configuration to use
+         */
+
+        void setConfig(RoboRIO& roborio, tConfig config){
+            roborio.counters[index].setConfig(config);
+            roborio.counter_sources.set(index, config.UpSource_Channel, config.UpSource_Module, config.UpSource_AnalogTrigger, config.DownSource_Channel, config.DownSource_Module, config.DownSource_AnalogTrigger);
+        }
+
     public:
         CounterManager(uint8_t i):index(0){
             assert(i < Counter::MAX_COUNTER_COUNT);
@@ -71,315 +84,408 @@ namespace hel{
         }
 
         uint8_t getSystemIndex(){
+            HEL_PROFILE_CALL();
             return index;
         }
 
         tOutput readOutput(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getCurrentOutput();
         }
 
         bool readOutput_Direction(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getCurrentOutput().Direction;
         }
 
         int32_t readOutput_Value(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getCurrentOutput().Value;
         }
 
         void writeConfig(tConfig value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
-            instance.first->counters[index].setConfig(value);
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
+            setConfig(*instance.first, value);
             instance.second.unlock();
         }
 
         void writeConfig_UpSource_Channel(uint8_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             tConfig config = instance.first->counters[index].getConfig();
             config.UpSource_Channel = value;
-            instance.first->counters[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_UpSource_Module(uint8_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             tConfig config = instance.first->counters[index].getConfig();
             config.UpSource_Module = value;
-            instance.first->counters[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_UpSource_AnalogTrigger(bool value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             tConfig config = instance.first->counters[index].getConfig();
             config.UpSource_AnalogTrigger = value;
-            instance.first->counters[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_DownSource_Channel(uint8_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             tConfig config = instance.first->counters[index].getConfig();
             config.DownSource_Channel = value;
-            instance.first->counters[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_DownSource_Module(uint8_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             tConfig config = instance.first->counters[index].getConfig();
             config.DownSource_Module = value;
-            instance.first->counters[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_DownSource_AnalogTrigger(bool value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             tConfig config = instance.first->counters[index].getConfig();
             config.DownSource_AnalogTrigger = value;
-            instance.first->counters[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_IndexSource_Channel(uint8_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             tConfig config = instance.first->counters[index].getConfig();
             config.IndexSource_Channel = value;
-            instance.first->counters[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_IndexSource_Module(uint8_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             tConfig config = instance.first->counters[index].getConfig();
             config.IndexSource_Module = value;
-            instance.first->counters[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_IndexSource_AnalogTrigger(bool value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             tConfig config = instance.first->counters[index].getConfig();
             config.IndexSource_AnalogTrigger = value;
-            instance.first->counters[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_IndexActiveHigh(bool value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             tConfig config = instance.first->counters[index].getConfig();
             config.IndexActiveHigh = value;
-            instance.first->counters[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_IndexEdgeSensitive(bool value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             tConfig config = instance.first->counters[index].getConfig();
             config.IndexEdgeSensitive = value;
-            instance.first->counters[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_UpRisingEdge(bool value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             tConfig config = instance.first->counters[index].getConfig();
             config.UpRisingEdge = value;
-            instance.first->counters[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_UpFallingEdge(bool value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             tConfig config = instance.first->counters[index].getConfig();
             config.UpFallingEdge = value;
-            instance.first->counters[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_DownRisingEdge(bool value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             tConfig config = instance.first->counters[index].getConfig();
             config.DownRisingEdge = value;
-            instance.first->counters[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_DownFallingEdge(bool value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             tConfig config = instance.first->counters[index].getConfig();
             config.DownFallingEdge = value;
-            instance.first->counters[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_Mode(uint8_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             tConfig config = instance.first->counters[index].getConfig();
             config.Mode = value;
-            instance.first->counters[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_PulseLengthThreshold(uint16_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             tConfig config = instance.first->counters[index].getConfig();
             config.PulseLengthThreshold = value;
-            instance.first->counters[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         tConfig readConfig(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getConfig();
         }
 
         uint8_t readConfig_UpSource_Channel(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getConfig().UpSource_Channel;
         }
 
         uint8_t readConfig_UpSource_Module(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getConfig().UpSource_Module;
         }
 
         bool readConfig_UpSource_AnalogTrigger(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getConfig().UpSource_AnalogTrigger;
         }
 
         uint8_t readConfig_DownSource_Channel(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getConfig().DownSource_Channel;
         }
 
         uint8_t readConfig_DownSource_Module(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getConfig().DownSource_Module;
         }
 
         bool readConfig_DownSource_AnalogTrigger(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getConfig().DownSource_AnalogTrigger;
         }
 
         uint8_t readConfig_IndexSource_Channel(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getConfig().IndexSource_Channel;
         }
 
         uint8_t readConfig_IndexSource_Module(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getConfig().IndexSource_Module;
         }
 
         bool readConfig_IndexSource_AnalogTrigger(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getConfig().IndexSource_AnalogTrigger;
         }
 
         bool readConfig_IndexActiveHigh(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getConfig().IndexActiveHigh;
         }
 
         bool readConfig_IndexEdgeSensitive(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getConfig().IndexEdgeSensitive;
         }
 
         bool readConfig_UpRisingEdge(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getConfig().UpRisingEdge;
         }
 
         bool readConfig_UpFallingEdge(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getConfig().UpFallingEdge;
         }
 
         bool readConfig_DownRisingEdge(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getConfig().DownRisingEdge;
         }
 
         bool readConfig_DownFallingEdge(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getConfig().DownFallingEdge;
         }
 
         uint8_t readConfig_Mode(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getConfig().Mode;
         }
 
         uint16_t readConfig_PulseLengthThreshold(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getConfig().PulseLengthThreshold;
         }
 
         tTimerOutput readTimerOutput(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getTimerOutput();
         }
 
         uint32_t readTimerOutput_Period(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getTimerOutput().Period;
         }
 
         int8_t readTimerOutput_Count(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getTimerOutput().Count;
         }
 
         bool readTimerOutput_Stalled(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getTimerOutput().Stalled;
         }
 
         void strobeReset(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.first->counters[index].reset();
             instance.second.unlock();
         }
 
         void writeTimerConfig(tTimerConfig value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.first->counters[index].setTimerConfig(value);
             instance.second.unlock();
         }
 
         void writeTimerConfig_StallPeriod(uint32_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             tTimerConfig timer_config = instance.first->counters[index].getTimerConfig();
             timer_config.StallPeriod = value;
             instance.first->counters[index].setTimerConfig(timer_config);
@@ -387,7 +493,9 @@ namespace hel{
         }
 
         void writeTimerConfig_AverageSize(uint8_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             tTimerConfig timer_config = instance.first->counters[index].getTimerConfig();
             timer_config.AverageSize = value;
             instance.first->counters[index].setTimerConfig(timer_config);
@@ -395,7 +503,9 @@ namespace hel{
         }
 
         void writeTimerConfig_UpdateWhenEmpty(bool value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             tTimerConfig timer_config = instance.first->counters[index].getTimerConfig();
             timer_config.UpdateWhenEmpty = value;
             instance.first->counters[index].setTimerConfig(timer_config);
@@ -403,25 +513,33 @@ namespace hel{
         }
 
         tTimerConfig readTimerConfig(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getTimerConfig();
         }
 
         uint32_t readTimerConfig_StallPeriod(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getTimerConfig().StallPeriod;
         }
 
         uint8_t readTimerConfig_AverageSize(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getTimerConfig().AverageSize;
         }
 
         bool readTimerConfig_UpdateWhenEmpty(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::COUNTERS);
             instance.second.unlock();
             return instance.first->counters[index].getTimerConfig().UpdateWhenEmpty;
         }
@@ -0,0 +1,116 @@
+#include "diagnostics.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace hel{
+    constexpr std::size_t Diagnostics::MAX_WARNINGS;
+    constexpr std::chrono::milliseconds Diagnostics::DEFAULT_FLUSH_PERIOD;
+
+    const std::string Diagnostics::FLUSH_PERIOD_VARIABLE = "HEL_DIAGNOSTICS_PERIOD_MS";
+
+    namespace detail{
+        /**
+         * \brief The number of times each warning has been reported; trivially destructible so reports during exit stay safe
+         */
+
+        std::array<std::atomic<uint64_t>, Diagnostics::MAX_WARNINGS> warning_counts;
+
+        struct WarningRegistry{
+            std::mutex mutex;
+            std::mutex flush_mutex;
+            std::unordered_map<std::string, std::size_t> ids;
+            std::array<std::string, Diagnostics::MAX_WARNINGS> messages;
+            std::atomic<std::size_t> size;
+            std::array<uint64_t, Diagnostics::MAX_WARNINGS> flushed_counts; //the counts as of the last flush, guarded by flush_mutex
+            std::chrono::steady_clock::time_point last_flush;
+
+            WarningRegistry():mutex(), flush_mutex(), ids(), messages(), size(0), flushed_counts(), last_flush(std::chrono::steady_clock::now()){}
+        };
+
+        WarningRegistry& warningRegistry(){
+            static WarningRegistry* instance = new WarningRegistry(); //never destroyed so threads still running at exit can report
+            return *instance;
+        }
+
+        void startFlusher(){
+            std::chrono::milliseconds period = Diagnostics::DEFAULT_FLUSH_PERIOD;
+            const char* period_value = std::getenv(Diagnostics::FLUSH_PERIOD_VARIABLE.c_str());
+            if(period_value != nullptr && std::atoi(period_value) > 0){
+                period = std::chrono::milliseconds(std::atoi(period_value));
+            }
+            std::atexit([](){
+                Diagnostics::flush(std::cerr);
+            });
+            std::thread([period](){
+                while(true){
+                    std::this_thread::sleep_for(period);
+                    Diagnostics::flush(std::cerr);
+                }
+            }).detach();
+        }
+    }
+
+    std::size_t Diagnostics::registerWarning(const std::string& message){
+        detail::WarningRegistry& registry = detail::warningRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto existing = registry.ids.find(message);
+        if(existing != registry.ids.end()){
+            return existing->second;
+        }
+        const std::size_t SIZE = registry.size.load(std::memory_order_relaxed);
+        if(SIZE == 0){
+            detail::startFlusher();
+        }
+        if(SIZE == MAX_WARNINGS - 1){ //keep the last slot for every warning that does not fit
+            registry.messages[SIZE] = "Further warnings (registered more than " + std::to_string(MAX_WARNINGS - 1) + " distinct warnings)";
+            registry.size.store(MAX_WARNINGS, std::memory_order_release);
+        }
+        if(SIZE >= MAX_WARNINGS - 1){
+            return MAX_WARNINGS - 1;
+        }
+        registry.messages[SIZE] = message;
+        registry.ids.emplace(message, SIZE);
+        registry.size.store(SIZE + 1, std::memory_order_release);
+        return SIZE;
+    }
+
+    void Diagnostics::report(std::size_t id)noexcept{
+        detail::warning_counts[id].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Diagnostics::flush(std::ostream& out){
+        detail::WarningRegistry& registry = detail::warningRegistry();
+        std::lock_guard<std::mutex> lock(registry.flush_mutex);
+        const auto NOW = std::chrono::steady_clock::now();
+        const double ELAPSED = std::chrono::duration_cast<std::chrono::milliseconds>(NOW - registry.last_flush).count() / 1E3;
+        registry.last_flush = NOW;
+        const std::size_t SIZE = registry.size.load(std::memory_order_acquire);
+        std::string lines;
+        for(std::size_t i = 0; i < SIZE; i++){
+            const uint64_t COUNT = detail::warning_counts[i].load(std::memory_order_relaxed);
+            const uint64_t NEW = COUNT - registry.flushed_counts[i];
+            if(NEW == 0){
+                continue;
+            }
+            lines += "Synthesis warning: " + registry.messages[i];
+            if(NEW != COUNT || NEW > 1){ //a warning seen once for the first time is printed as is
+                char summary[64];
+                std::snprintf(summary, sizeof(summary), " (%llu times in the last %.1f s)", static_cast<unsigned long long>(NEW), ELAPSED);
+                lines += summary;
+            }
+            lines += "\n";
+            registry.flushed_counts[i] = COUNT;
+        }
+        if(!lines.empty()){
+            out << lines;
+            out.flush();
+        }
+    }
+}
@@ -1,4 +1,6 @@
+#include "diagnostics.hpp"
 #include "roborio_manager.hpp"
+#include "robot_instance.hpp"
 #include "util.hpp"
 #include "error.hpp"
 
@@ -12,6 +14,10 @@ namespace hel{
 
     void DigitalSystem::setOutputs(tDIO::tDO out)noexcept{
         outputs = out;
+        RoboRIOManager::publishSnapshot(RoboRIO::Subsystem::DIGITAL_SYSTEM);
+        auto instance = SendDataManager::getInstance();
+        instance.first->updateDeep();
+        instance.second.unlock();
     }
 
     tDIO::tOutputEnable DigitalSystem::getEnabledOutputs()const noexcept{
@@ -20,8 +26,9 @@ namespace hel{
 
     void DigitalSystem::setEnabledOutputs(tDIO::tOutputEnable enabled_out)noexcept{
         enabled_outputs = enabled_out;
+        RoboRIOManager::publishSnapshot(RoboRIO::Subsystem::DIGITAL_SYSTEM);
         auto instance = SendDataManager::getInstance();
-        instance.first->updateShallow();
+        instance.first->updateDeep();
         instance.second.unlock();
     }
 
@@ -31,6 +38,10 @@ namespace hel{
 
     void DigitalSystem::setPulses(tDIO::tPulse value)noexcept{
         pulses = value;
+        RoboRIOManager::publishSnapshot(RoboRIO::Subsystem::DIGITAL_SYSTEM);
+        auto instance = SendDataManager::getInstance();
+        instance.first->updateDeep();
+        instance.second.unlock();
     }
 
     tDIO::tDI DigitalSystem::getInputs()const noexcept{
@@ -47,8 +58,9 @@ namespace hel{
 
     void DigitalSystem::setMXPSpecialFunctionsEnabled(uint16_t enabled_mxp_special_functions)noexcept{
         mxp_special_functions_enabled = enabled_mxp_special_functions;
+        RoboRIOManager::publishSnapshot(RoboRIO::Subsystem::DIGITAL_SYSTEM);
         auto instance = SendDataManager::getInstance();
-        instance.first->updateShallow();
+        instance.first->updateDeep();
         instance.second.unlock();
     }
 
@@ -139,7 +151,7 @@ namespace hel{
 
     DigitalSystem::DIOConfigurationException::DIOConfigurationException(Config config, Config expected, uint8_t index)noexcept:configuration(config), expected_configuration(expected), port(index){}
 
-    struct DIOManager: public tDIO{
+    struct DIOManager: public tDIO, private InstanceBound{
         tSystemInterface* getSystemInterface() override{
             return new SystemInterface();
         }
@@ -147,7 +159,7 @@ namespace hel{
     private:
         template<typename T, typename S> //note: this is not an Ni FPGA function
         bool allowOutput(T output,S enabled, bool requires_special_function){
-            auto instance = RoboRIOManager::getInstance();
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             for(unsigned i = 1; i < findMostSignificantBit(output); i++){
                 if(!checkBitHigh(output, i)){ //Ignore if it's not trying to output
                     continue;
@@ -170,7 +182,9 @@ namespace hel{
     public:
 
         void writeDO(tDIO::tDO value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             try{
                 if(allowOutput(value.value, instance.first->digital_system.getEnabledOutputs().value, false)){
                     instance.first->digital_system.setOutputs(value);
@@ -183,7 +197,9 @@ namespace hel{
         }
 
         void writeDO_Headers(uint16_t value, tRioStatusCode* status){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             tDIO::tDO outputs = instance.first->digital_system.getOutputs();
             outputs.Headers = value;
             writeDO(outputs, status);
@@ -191,7 +207,9 @@ namespace hel{
         }
 
         void writeDO_SPIPort(uint8_t value, tRioStatusCode* status){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             tDIO::tDO outputs = instance.first->digital_system.getOutputs();
             outputs.SPIPort = value;
             writeDO(outputs, status);
@@ -199,7 +217,9 @@ namespace hel{
         }
 
         void writeDO_Reserved(uint8_t value, tRioStatusCode* status){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             tDIO::tDO outputs = instance.first->digital_system.getOutputs();
             outputs.Reserved = value;
             writeDO(outputs, status);
@@ -207,7 +227,9 @@ namespace hel{
         }
 
         void writeDO_MXP(uint16_t value, tRioStatusCode* status){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             tDIO::tDO outputs = instance.first->digital_system.getOutputs();
             outputs.MXP = value;
             writeDO(outputs, status);
@@ -215,51 +237,65 @@ namespace hel{
         }
 
         tDO readDO(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.second.unlock();
             return instance.first->digital_system.getOutputs();
         }
 
         uint16_t readDO_Headers(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.second.unlock();
             return instance.first->digital_system.getOutputs().Headers;
         }
 
         uint8_t readDO_SPIPort(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.second.unlock();
             return instance.first->digital_system.getOutputs().SPIPort;
         }
 
         uint8_t readDO_Reserved(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.second.unlock();
             return instance.first->digital_system.getOutputs().Reserved;
         }
 
         uint16_t readDO_MXP(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.second.unlock();
             return instance.first->digital_system.getOutputs().MXP;
         }
 
         void writePWMDutyCycleA(uint8_t /*bitfield_index*/, uint8_t /*value*/, tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tDIO::writePWMDutyCycleA\n";
+            HEL_PROFILE_CALL();
+            HEL_WARN("Unsupported feature: Function call tDIO::writePWMDutyCycleA");
         }
 
         uint8_t readPWMDutyCycleA(uint8_t /*bitfield_index*/, tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tDIO::readPWMDutyCycleA\n";
+            HEL_PROFILE_CALL();
+            HEL_WARN("Unsupported feature: Function call tDIO::readPWMDutyCycleA");
             return 0;
         }
 
         void writePWMDutyCycleB(uint8_t /*bitfield_index*/, uint8_t /*value*/, tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tDIO::writePWMDutyCycleB\n";
+            HEL_PROFILE_CALL();
+            HEL_WARN("Unsupported feature: Function call tDIO::writePWMDutyCycleB");
             //no need to reimplement writePWMDutyCycleA, they do the same thing
         }
 
         uint8_t readPWMDutyCycleB(uint8_t /*bitfield_index*/, tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tDIO::readPWMDutyCycleB\n";
+            HEL_PROFILE_CALL();
+            HEL_WARN("Unsupported feature: Function call tDIO::readPWMDutyCycleB");
             //no need to reimplement readPWMDutyCycleA, they do the same thing
             return 0;
         }
@@ -268,17 +304,22 @@ namespace hel{
 
 
         uint8_t readFilterSelectHdr(uint8_t /*bitfield_index*/, tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
             return 0;//unnecessary for emulation (0 implies no active filter)
         }
 
         void writeOutputEnable(tDIO::tOutputEnable value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.first->digital_system.setEnabledOutputs(value);
             instance.second.unlock();
         }
 
         void writeOutputEnable_Headers(uint16_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             tDIO::tOutputEnable enabled_outputs = instance.first->digital_system.getEnabledOutputs();
             enabled_outputs.Headers = value;
             instance.first->digital_system.setEnabledOutputs(enabled_outputs);
@@ -286,7 +327,9 @@ namespace hel{
         }
 
         void writeOutputEnable_SPIPort(uint8_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             tDIO::tOutputEnable enabled_outputs = instance.first->digital_system.getEnabledOutputs();
             enabled_outputs.SPIPort = value;
             instance.first->digital_system.setEnabledOutputs(enabled_outputs);
@@ -294,7 +337,9 @@ namespace hel{
         }
 
         void writeOutputEnable_Reserved(uint8_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             tDIO::tOutputEnable enabled_outputs = instance.first->digital_system.getEnabledOutputs();
             enabled_outputs.Reserved = value;
             instance.first->digital_system.setEnabledOutputs(enabled_outputs);
@@ -302,7 +347,9 @@ namespace hel{
         }
 
         void writeOutputEnable_MXP(uint16_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             tDIO::tOutputEnable enabled_outputs = instance.first->digital_system.getEnabledOutputs();
             enabled_outputs.MXP = value;
             instance.first->digital_system.setEnabledOutputs(enabled_outputs);
@@ -310,38 +357,50 @@ namespace hel{
         }
 
         tOutputEnable readOutputEnable(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.second.unlock();
             return instance.first->digital_system.getEnabledOutputs();
         }
 
         uint16_t readOutputEnable_Headers(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.second.unlock();
             return instance.first->digital_system.getEnabledOutputs().Headers;
         }
 
         uint8_t readOutputEnable_SPIPort(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.second.unlock();
             return instance.first->digital_system.getEnabledOutputs().SPIPort;
         }
 
         uint8_t readOutputEnable_Reserved(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.second.unlock();
             return instance.first->digital_system.getEnabledOutputs().Reserved;
         }
 
         uint16_t readOutputEnable_MXP(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.second.unlock();
             return instance.first->digital_system.getEnabledOutputs().MXP;
         }
 
         void writePWMOutputSelect(uint8_t bitfield_index, uint8_t /*value*/, tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
             //note: bitfield_index is mxp remapped dio address corresponding to the mxp pwm output
-            auto instance = RoboRIOManager::getInstance();
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             tDIO::tOutputEnable enabled_outputs = instance.first->digital_system.getEnabledOutputs();
             enabled_outputs.MXP = setBit(enabled_outputs.MXP, true, bitfield_index);
             instance.first->digital_system.setEnabledOutputs(enabled_outputs);
@@ -349,12 +408,15 @@ namespace hel{
         }
 
         uint8_t readPWMOutputSelect(uint8_t /*bitfield_index*/, tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
             return 0;//unnecessary for emulation
         }
 
     private:
         void pulse(tPulse value){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
 
             instance.first->digital_system.setPulses(value);
             uint8_t length = instance.first->digital_system.getPulseLength();
@@ -370,9 +432,11 @@ namespace hel{
     public:
 
         void writePulse(tPulse value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             if(instance.first->digital_system.getPulses().value != (new tPulse)->value){
-                std::cerr<<"Synthesis warning: multiple digital output pulses should not be allowed at once\n";
+                HEL_WARN("multiple digital output pulses should not be allowed at once");
                 return;
             }
             try{
@@ -388,96 +452,126 @@ namespace hel{
         }
 
         void writePulse_Headers(uint16_t value, tRioStatusCode* status){
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
             tPulse pulse;
             pulse.Headers = value;
             writePulse(pulse, status);
         }
 
         void writePulse_SPIPort(uint8_t value, tRioStatusCode* status){
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
             tPulse pulse;
             pulse.SPIPort = value;
             writePulse(pulse, status);
         }
 
         void writePulse_Reserved(uint8_t value, tRioStatusCode* status){
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
             tPulse pulse;
             pulse.Reserved = value;
             writePulse(pulse, status);
         }
 
         void writePulse_MXP(uint16_t value, tRioStatusCode* status){
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
             tPulse pulse;
             pulse.MXP = value;
             writePulse(pulse, status);
         }
 
         tPulse readPulse(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.second.unlock();
             return instance.first->digital_system.getPulses();
         }
 
         uint16_t readPulse_Headers(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.second.unlock();
             return instance.first->digital_system.getPulses().Headers;
         }
 
         uint8_t readPulse_SPIPort(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.second.unlock();
             return instance.first->digital_system.getPulses().SPIPort;
         }
 
         uint8_t readPulse_Reserved(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.second.unlock();
             return instance.first->digital_system.getPulses().Reserved;
         }
 
         uint16_t readPulse_MXP(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.second.unlock();
             return instance.first->digital_system.getPulses().MXP;
         }
 
         tDI readDI(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.second.unlock();
             return instance.first->digital_system.getInputs();
         }
 
         uint16_t readDI_Headers(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.second.unlock();
             return instance.first->digital_system.getInputs().Headers;
         }
 
         uint8_t readDI_SPIPort(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.second.unlock();
             return instance.first->digital_system.getInputs().SPIPort;
         }
 
         uint8_t readDI_Reserved(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.second.unlock();
             return instance.first->digital_system.getInputs().Reserved;
         }
 
         uint16_t readDI_MXP(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.second.unlock();
             return instance.first->digital_system.getInputs().MXP;
         }
 
         void writeEnableMXPSpecialFunction(uint16_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.first->digital_system.setMXPSpecialFunctionsEnabled(value);
             for(unsigned i = 0; i < findMostSignificantBit(value); i++){
                 MXPData::Config mxp_config = DigitalSystem::toMXPConfig(instance.first->digital_system.getEnabledOutputs().MXP, instance.first->digital_system.getMXPSpecialFunctionsEnabled(), i);
                 if(mxp_config == MXPData::Config::I2C || mxp_config == MXPData::Config::SPI){
-                    std::cerr<<"Synthesis warning: Unsupported feature: Configuring digital MXP input "<<i<<" for "<<asString(mxp_config)<<"\n";
+                    Diagnostics::report(Diagnostics::registerWarning("Unsupported feature: Configuring digital MXP input " + std::to_string(i) + " for " + asString(mxp_config)));
                 }
             }
 
@@ -485,7 +579,9 @@ namespace hel{
         }
 
         uint16_t readEnableMXPSpecialFunction(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.second.unlock();
             return instance.first->digital_system.getMXPSpecialFunctionsEnabled();
         }
@@ -493,21 +589,27 @@ namespace hel{
         void writeFilterSelectMXP(uint8_t /*bitfield_index*/, uint8_t /*value*/, tRioStatusCode* /*status*/){}//unnecessary for emulation
 
         uint8_t readFilterSelectMXP(uint8_t /*bitfield_index*/, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             return 0;//unnecessary for emulation
         }
 
         void writePulseLength(uint8_t value, tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
             if(value > static_cast<uint8_t>(DigitalSystem::MAX_PULSE_LENGTH)){
                 throw "Synthesis exception: Digital pulse exceeds maximum pulse length (given " + std::to_string(value) + " microseconds when max length is " + std::to_string(DigitalSystem::MAX_PULSE_LENGTH) + " microseconds)";
             }
-            auto instance = RoboRIOManager::getInstance();
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.first->digital_system.setPulseLength(value);
             instance.second.unlock();
         }
 
         uint8_t readPulseLength(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::DIGITAL_SYSTEM);
             instance.second.unlock();
             return instance.first->digital_system.getPulseLength();
         }
@@ -516,6 +618,7 @@ namespace hel{
 
 
         uint16_t readPWMPeriodPower(tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
             return 0;//unnecessary for emulation
         }
 
@@ -523,12 +626,14 @@ namespace hel{
 
 
         uint32_t readFilterPeriodMXP(uint8_t /*reg_index*/, tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
             return 0;//unnecessary for emulation
         }
 
         void writeFilterPeriodHdr(uint8_t /*reg_index*/, uint32_t /*value*/, tRioStatusCode* /*status*/){}//unnecessary for emulation
 
         uint32_t readFilterPeriodHdr(uint8_t /*reg_index*/, tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
             return 0;//unnecessary for emulation
         }
 
@@ -1,10 +1,24 @@
 #include "roborio_manager.hpp"
 
+#include <cassert>
+
+#include "binary_util.hpp"
+#include "diagnostics.hpp"
 #include "json_util.hpp"
 
 using namespace nFPGA;
 using namespace nRoboRIO_FPGANamespace;
 
+namespace{
+    /**
+     * \brief The number of port types an encoder channel can be attached to, for keeping a warning site per port
+     */
+
+    constexpr unsigned NUM_PORT_TYPES = static_cast<unsigned>(hel::EncoderManager::PortType::AI) + 1;
+
+    std::array<hel::Diagnostics::Site, NUM_PORT_TYPES * (UINT8_MAX + 1)> missing_input_warnings;
+}
+
 namespace hel{
     std::string asString(EncoderManager::Type type){
         switch(type){
@@ -29,8 +43,8 @@ namespace hel{
         }
     }
 
-    EncoderManager::PortType s_to_encoder_port_type(std::string input){
-        switch(hasher(input.c_str())){
+    EncoderManager::PortType s_to_encoder_port_type(StringView input){
+        switch(hasher(input)){
         case hasher("DI"):
             return EncoderManager::PortType::DI;
         case hasher("AI"):
@@ -54,42 +68,57 @@ namespace hel{
         return channel;
     }
 
-    bool EncoderManager::checkDevice(uint8_t a, bool a_module, bool a_analog, uint8_t b, bool b_module, bool b_analog)const noexcept{
-        if(
-            (a_analog && a_type != PortType::AI) ||
-            (b_analog && b_type != PortType::AI)
-        ){
+    constexpr unsigned EncoderSourceIndex::MAX_DEVICES;
+    constexpr unsigned EncoderSourceIndex::CHANNELS_PER_TYPE;
+
+    unsigned EncoderSourceIndex::keyOf(uint8_t channel, EncoderManager::PortType type)noexcept{
+        if(channel >= CHANNELS_PER_TYPE){
+            return 2 * CHANNELS_PER_TYPE;
+        }
+        return (type == EncoderManager::PortType::AI ? CHANNELS_PER_TYPE : 0) + channel;
+    }
+
+    void EncoderSourceIndex::setSource(std::array<uint8_t, 2 * CHANNELS_PER_TYPE>& sources, uint8_t device, uint8_t channel, bool module, bool analog)noexcept{
+        const uint8_t DEVICE_MASK = 1u << device;
+        for(uint8_t& port: sources){
+            port &= ~DEVICE_MASK;
+        }
+        if(!analog){ //analog triggers can only match analog ports
+            const unsigned DI_KEY = keyOf(getChannel(channel, module, EncoderManager::PortType::DI), EncoderManager::PortType::DI);
+            if(DI_KEY < sources.size()){
+                sources[DI_KEY] |= DEVICE_MASK;
+            }
+        }
+        const unsigned AI_KEY = keyOf(getChannel(channel, module, EncoderManager::PortType::AI), EncoderManager::PortType::AI);
+        if(AI_KEY < sources.size()){
+            sources[AI_KEY] |= DEVICE_MASK;
+        }
+    }
+
+    void EncoderSourceIndex::set(uint8_t device, uint8_t a, bool a_module, bool a_analog, uint8_t b, bool b_module, bool b_analog)noexcept{
+        assert(device < MAX_DEVICES);
+        setSource(a_sources, device, a, a_module, a_analog);
+        setSource(b_sources, device, b, b_module, b_analog);
+    }
+
+    bool EncoderSourceIndex::find(const EncoderManager& manager, uint8_t& index)const noexcept{
+        const unsigned A_KEY = keyOf(manager.getAChannel(), manager.getAType());
+        const unsigned B_KEY = keyOf(manager.getBChannel(), manager.getBType());
+        if(A_KEY >= a_sources.size() || B_KEY >= b_sources.size()){
             return false;
         }
-        if(getChannel(a, a_module, a_type) != a_channel || getChannel(b, b_module, b_type) != b_channel){
+        const unsigned DEVICES = a_sources[A_KEY] & b_sources[B_KEY];
+        if(DEVICES == 0){
             return false;
         }
+        index = __builtin_ctz(DEVICES); //the lowest index matches first, as HAL allocates them
         return true;
     }
 
-    void EncoderManager::updateDevice(){
-        auto instance = RoboRIOManager::getInstance();
-        for(unsigned i = 0; i < instance.first->fpga_encoders.size(); i++){ //check if FPGA encoder
-            tEncoder::tConfig config = instance.first->fpga_encoders[i].getConfig();
-            if(checkDevice(config.ASource_Channel,config.ASource_Module,config.ASource_AnalogTrigger,config.BSource_Channel,config.BSource_Module,config.BSource_AnalogTrigger)){
-                type = Type::FPGA_ENCODER;
-                index = i;
-                instance.second.unlock();
-                return;
-            }
+    EncoderSourceIndex::EncoderSourceIndex()noexcept:a_sources(),b_sources(){
+        for(uint8_t i = 0; i < MAX_DEVICES; i++){
+            set(i, 0, false, false, 0, false, false);
         }
-        for(unsigned i = 0; i < instance.first->counters.size(); i++){ //check if counter
-            tCounter::tConfig config = instance.first->counters[i].getConfig();
-            if(checkDevice(config.UpSource_Channel,config.UpSource_Module,config.UpSource_AnalogTrigger,config.DownSource_Channel,config.DownSource_Module,config.DownSource_AnalogTrigger)){
-                type = Type::COUNTER;
-                index = i;
-                instance.second.unlock();
-                return;
-            }
-        }
-        type = Type::UNKNOWN;
-        index = 0;
-        instance.second.unlock();
     }
 
     EncoderManager::Type EncoderManager::getType()const noexcept{
@@ -140,12 +169,21 @@ namespace hel{
     }
 
     void EncoderManager::update(){
-        updateDevice();
-        auto instance = RoboRIOManager::getInstance();
+        auto instance = RoboRIOManager::getInstance({RoboRIO::Subsystem::COUNTERS, RoboRIO::Subsystem::FPGA_ENCODERS});
+        if(instance.first->fpga_encoder_sources.find(*this, index)){ //FPGA encoders are checked before counters
+            type = Type::FPGA_ENCODER;
+        } else if(instance.first->counter_sources.find(*this, index)){
+            type = Type::COUNTER;
+        } else {
+            type = Type::UNKNOWN;
+            index = 0;
+        }
         switch(type){
         case Type::UNKNOWN:
             instance.second.unlock();
-            std::cerr<<"Synthesis exception: No matching input found in user code for input configured in robot model (EncoderManager with a channel on "<<asString(a_type)<<" port "<<((unsigned)a_channel)<<" and b channel on "<<asString(b_type)<<" port "<<((unsigned)b_channel)<<")\n";
+            Diagnostics::report(missing_input_warnings[static_cast<unsigned>(a_type) * (UINT8_MAX + 1) + a_channel], [&](){
+                return "No matching input found in user code for input configured in robot model (EncoderManager with a channel on " + asString(a_type) + " port " + std::to_string(a_channel) + " and b channel on " + asString(b_type) + " port " + std::to_string(b_channel) + ")";
+            });
             return;
         case Type::FPGA_ENCODER:
         {
@@ -170,23 +208,82 @@ namespace hel{
     }
 
     std::string EncoderManager::serialize()const{
-        std::string s = "{";
-        s += "\"a_channel\":" + std::to_string(a_channel) + ", ";
-        s += "\"a_type\":" + quote(asString(a_type)) + ", ";
-        s += "\"b_channel\":" + std::to_string(b_channel) + ", ";
-        s += "\"b_type\":" + quote(asString(b_type)) + ", ";
-        s += "\"ticks\":" + std::to_string(ticks);
-        s += "}";
+        std::string s;
+        JSONWriter writer(s);
+        serialize(writer);
         return s;
     }
 
+    void EncoderManager::serialize(JSONWriter& writer)const{
+        writer.writeRaw('{');
+        writer.writeLabel("a_channel");
+        writer.write(a_channel);
+        writer.writeRaw(", ");
+        writer.writeLabel("a_type");
+        writer.writeString(asString(a_type));
+        writer.writeRaw(", ");
+        writer.writeLabel("b_channel");
+        writer.write(b_channel);
+        writer.writeRaw(", ");
+        writer.writeLabel("b_type");
+        writer.writeString(asString(b_type));
+        writer.writeRaw(", ");
+        writer.writeLabel("ticks");
+        writer.write(ticks);
+        writer.writeRaw('}');
+    }
+
     EncoderManager EncoderManager::deserialize(std::string input){
+        JSONReader reader(input);
+        return deserialize(reader);
+    }
+
+    EncoderManager EncoderManager::deserialize(JSONReader& reader){
+        EncoderManager a;
+        reader.beginObject();
+        StringView label;
+        while(reader.nextField(label)){
+            switch(hasher(label)){
+            case hasher("a_channel"):
+                a.a_channel = reader.readInteger<uint8_t>();
+                break;
+            case hasher("a_type"):
+                a.a_type = s_to_encoder_port_type(reader.readString());
+                break;
+            case hasher("b_channel"):
+                a.b_channel = reader.readInteger<uint8_t>();
+                break;
+            case hasher("b_type"):
+                a.b_type = s_to_encoder_port_type(reader.readString());
+                break;
+            case hasher("ticks"):
+                a.ticks = reader.readInteger<int32_t>();
+                break;
+            default:
+                reader.skipValue();
+            }
+        }
+        return a;
+    }
+
+    void EncoderManager::serializeBinary(BinaryWriter& writer)const{
+        writer.write(a_channel);
+        writer.write(static_cast<uint8_t>(a_type));
+        writer.write(b_channel);
+        writer.write(static_cast<uint8_t>(b_type));
+        writer.write(ticks);
+    }
+
+    EncoderManager EncoderManager::deserializeBinary(BinaryReader& reader){
         EncoderManager a;
-        a.a_channel = std::stoi(pullObject("\"a_channel\"",input));
-        a.b_channel = std::stoi(pullObject("\"b_channel\"",input));
-        a.a_type = s_to_encoder_port_type(unquote(pullObject("\"a_type\"",input)));
-        a.b_type = s_to_encoder_port_type(unquote(pullObject("\"b_type\"",input)));
-        a.ticks = std::stoi(pullObject("\"ticks\"",input));
+        a.a_channel = reader.read<uint8_t>();
+        a.a_type = static_cast<PortType>(reader.read<uint8_t>());
+        a.b_channel = reader.read<uint8_t>();
+        a.b_type = static_cast<PortType>(reader.read<uint8_t>());
+        if(a.a_type > PortType::AI || a.b_type > PortType::AI){
+            throw BinaryParsingException("invalid encoder port type");
+        }
+        a.ticks = reader.read<int32_t>();
         return a;
     }
 
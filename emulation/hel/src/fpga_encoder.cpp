@@ -1,4 +1,5 @@
 #include "roborio_manager.hpp"
+#include "robot_instance.hpp"
 
 using namespace nFPGA;
 using namespace nRoboRIO_FPGANamespace;
@@ -56,255 +57,340 @@ namespace hel{
 #undef COPY
     }
 
-    struct FPGAEncoderManager: public tEncoder{
+    struct FPGAEncoderManager: public tEncoder, private InstanceBound{
     private:
         uint8_t index;
 
+        /**
+         * \brief Set the encoder's configuration and update the index mapping encoder ports to it
+         * The caller must hold the FPGA encoders sub-system
+         * \param roborio The RoboRIO holding the encoder
+         * \param config The configuration to use
+         */
+
+        void setConfig(RoboRIO& roborio, tConfig config){
+            roborio.fpga_encoders[index].setConfig(config);
+            roborio.fpga_encoder_sources.set(index, config.ASource_Channel, config.ASource_Module, config.ASource_AnalogTrigger, config.BSource_Channel, config.BSource_Module, config.BSource_AnalogTrigger);
+        }
+
     public:
         tSystemInterface* getSystemInterface(){ //unnecessary for emulation
             return new SystemInterface();
         }
 
         uint8_t getSystemIndex(){
+            HEL_PROFILE_CALL();
             return index;
         }
 
         tOutput readOutput(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getCurrentOutput();
         }
 
         bool readOutput_Direction(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getCurrentOutput().Direction;
         }
 
         int32_t readOutput_Value(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getCurrentOutput().Value;
         }
 
         void writeConfig(tConfig value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
-            instance.first->fpga_encoders[index].setConfig(value);
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
+            setConfig(*instance.first, value);
             instance.second.unlock();
         }
 
         void writeConfig_ASource_Channel(uint8_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             tConfig config = instance.first->fpga_encoders[index].getConfig();
             config.ASource_Channel = value;
-            instance.first->fpga_encoders[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_ASource_Module(uint8_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             tConfig config = instance.first->fpga_encoders[index].getConfig();
             config.ASource_Module = value;
-            instance.first->fpga_encoders[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_ASource_AnalogTrigger(bool value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             tConfig config = instance.first->fpga_encoders[index].getConfig();
             config.ASource_AnalogTrigger = value;
-            instance.first->fpga_encoders[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_BSource_Channel(uint8_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             tConfig config = instance.first->fpga_encoders[index].getConfig();
             config.BSource_Channel = value;
-            instance.first->fpga_encoders[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_BSource_Module(uint8_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             tConfig config = instance.first->fpga_encoders[index].getConfig();
             config.BSource_Module = value;
-            instance.first->fpga_encoders[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_BSource_AnalogTrigger(bool value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             tConfig config = instance.first->fpga_encoders[index].getConfig();
             config.BSource_AnalogTrigger = value;
-            instance.first->fpga_encoders[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_IndexSource_Channel(uint8_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             tConfig config = instance.first->fpga_encoders[index].getConfig();
             config.IndexSource_Channel = value;
-            instance.first->fpga_encoders[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_IndexSource_Module(uint8_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             tConfig config = instance.first->fpga_encoders[index].getConfig();
             config.IndexSource_Module = value;
-            instance.first->fpga_encoders[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_IndexSource_AnalogTrigger(bool value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             tConfig config = instance.first->fpga_encoders[index].getConfig();
             config.IndexSource_AnalogTrigger = value;
-            instance.first->fpga_encoders[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_IndexActiveHigh(bool value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             tConfig config = instance.first->fpga_encoders[index].getConfig();
             config.IndexActiveHigh = value;
-            instance.first->fpga_encoders[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_IndexEdgeSensitive(bool value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             tConfig config = instance.first->fpga_encoders[index].getConfig();
             config.IndexEdgeSensitive = value;
-            instance.first->fpga_encoders[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         void writeConfig_Reverse(bool value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             tConfig config = instance.first->fpga_encoders[index].getConfig();
             config.Reverse = value;
-            instance.first->fpga_encoders[index].setConfig(config);
+            setConfig(*instance.first, config);
             instance.second.unlock();
         }
 
         tConfig readConfig(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getConfig();
         }
 
         uint8_t readConfig_ASource_Channel(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getConfig().ASource_Channel;
         }
 
         uint8_t readConfig_ASource_Module(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getConfig().ASource_Module;
         }
 
         bool readConfig_ASource_AnalogTrigger(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getConfig().ASource_AnalogTrigger;
         }
 
         uint8_t readConfig_BSource_Channel(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getConfig().BSource_Channel;
         }
 
         uint8_t readConfig_BSource_Module(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getConfig().BSource_Module;
         }
 
         bool readConfig_BSource_AnalogTrigger(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getConfig().BSource_AnalogTrigger;
         }
 
         uint8_t readConfig_IndexSource_Channel(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getConfig().IndexSource_Channel;
         }
 
         uint8_t readConfig_IndexSource_Module(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getConfig().IndexSource_Module;
         }
 
         bool readConfig_IndexSource_AnalogTrigger(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getConfig().IndexSource_AnalogTrigger;
         }
 
         bool readConfig_IndexActiveHigh(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getConfig().IndexActiveHigh;
         }
 
         bool readConfig_IndexEdgeSensitive(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getConfig().IndexEdgeSensitive;
         }
 
         bool readConfig_Reverse(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getConfig().Reverse;
         }
 
         tTimerOutput readTimerOutput(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getTimerOutput();
         }
 
         uint32_t readTimerOutput_Period(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getTimerOutput().Period;
         }
 
         int8_t readTimerOutput_Count(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getTimerOutput().Count;
         }
 
         bool readTimerOutput_Stalled(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getTimerOutput().Stalled;
         }
 
         void strobeReset(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.first->fpga_encoders[index].reset();
             instance.second.unlock();
         }
 
         void writeTimerConfig(tTimerConfig value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.first->fpga_encoders[index].setTimerConfig(value);
             instance.second.unlock();
         }
 
         void writeTimerConfig_StallPeriod(uint32_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             tTimerConfig config = instance.first->fpga_encoders[index].getTimerConfig();
             config.StallPeriod = value;
             instance.first->fpga_encoders[index].setTimerConfig(config);
@@ -312,7 +398,9 @@ namespace hel{
         }
 
         void writeTimerConfig_AverageSize(uint8_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             tTimerConfig config = instance.first->fpga_encoders[index].getTimerConfig();
             config.AverageSize = value;
             instance.first->fpga_encoders[index].setTimerConfig(config);
@@ -320,7 +408,9 @@ namespace hel{
         }
 
         void writeTimerConfig_UpdateWhenEmpty(bool value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             tTimerConfig config = instance.first->fpga_encoders[index].getTimerConfig();
             config.UpdateWhenEmpty = value;
             instance.first->fpga_encoders[index].setTimerConfig(config);
@@ -328,25 +418,33 @@ namespace hel{
         }
 
         tTimerConfig readTimerConfig(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getTimerConfig();
         }
 
         uint32_t readTimerConfig_StallPeriod(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getTimerConfig().StallPeriod;
         }
 
         uint8_t readTimerConfig_AverageSize(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getTimerConfig().AverageSize;
         }
 
         bool readTimerConfig_UpdateWhenEmpty(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::FPGA_ENCODERS);
             instance.second.unlock();
             return instance.first->fpga_encoders[index].getTimerConfig().UpdateWhenEmpty;
         }
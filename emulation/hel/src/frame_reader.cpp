@@ -0,0 +1,143 @@
+#include "frame_reader.hpp"
+
+#include <algorithm>
+#include <array>
+#include "json_util.hpp"
+
+namespace hel{
+    namespace detail{
+        constexpr char JSON_PACKET_PREAMBLE[] = "{\"roborio";
+
+        constexpr std::array<char, sizeof(BINARY_PACKET_MAGIC)> BINARY_MAGIC_BYTES{{ //BINARY_PACKET_MAGIC in wire byte order
+            static_cast<char>(BINARY_PACKET_MAGIC & 0xFF),
+            static_cast<char>((BINARY_PACKET_MAGIC >> 8) & 0xFF),
+            static_cast<char>((BINARY_PACKET_MAGIC >> 16) & 0xFF),
+            static_cast<char>((BINARY_PACKET_MAGIC >> 24) & 0xFF)
+        }};
+    }
+
+    constexpr std::size_t FrameReader::INITIAL_CAPACITY;
+    constexpr uint32_t FrameReader::MAX_BINARY_PAYLOAD_SIZE;
+
+    FrameReader::FrameReader(WireFormat f, std::size_t initial_capacity):buffer(std::max(initial_capacity, static_cast<std::size_t>(1))), read_position(0), write_position(0), scan_position(0), in_frame(false), format(f){}
+
+    std::pair<char*, std::size_t> FrameReader::prepare(std::size_t min_size){
+        if(read_position == write_position){ //nothing buffered, so restart at the front for free
+            scan_position -= read_position;
+            read_position = 0;
+            write_position = 0;
+        }
+        if(buffer.size() - write_position < min_size){
+            const std::size_t BUFFERED = write_position - read_position;
+            if(read_position > 0){
+                std::copy(buffer.begin() + read_position, buffer.begin() + write_position, buffer.begin());
+                scan_position -= read_position;
+                read_position = 0;
+                write_position = BUFFERED;
+            }
+            if(buffer.size() - write_position < min_size){
+                std::size_t new_size = buffer.size();
+                while(new_size - write_position < min_size){
+                    new_size *= 2;
+                }
+                buffer.resize(new_size);
+            }
+        }
+        return std::make_pair(buffer.data() + write_position, buffer.size() - write_position);
+    }
+
+    void FrameReader::commit(std::size_t size){
+        write_position = std::min(write_position + size, buffer.size());
+    }
+
+    bool FrameReader::findFrameStart(const char* marker, std::size_t marker_size){
+        if(in_frame){
+            return true;
+        }
+        const std::size_t SEARCH_START = std::max(read_position, scan_position >= marker_size - 1 ? scan_position - (marker_size - 1) : 0); //a marker may straddle the last scan
+        const char* begin = buffer.data() + SEARCH_START;
+        const char* end = buffer.data() + write_position;
+        const char* found = std::search(begin, end, marker, marker + marker_size);
+        if(found == end){
+            if(write_position - read_position >= marker_size){ //keep what could be the start of a split marker
+                read_position = write_position - (marker_size - 1);
+            }
+            scan_position = write_position;
+            return false;
+        }
+        read_position = found - buffer.data();
+        scan_position = read_position + marker_size;
+        in_frame = true;
+        return true;
+    }
+
+    bool FrameReader::nextJSON(StringView& frame){
+        if(!findFrameStart(detail::JSON_PACKET_PREAMBLE, sizeof(detail::JSON_PACKET_PREAMBLE) - 1)){
+            return false;
+        }
+        if(scan_position >= write_position){
+            return false;
+        }
+        const char* suffix = static_cast<const char*>(std::memchr(buffer.data() + scan_position, JSON_PACKET_SUFFIX, write_position - scan_position));
+        if(suffix == nullptr){
+            scan_position = write_position;
+            return false;
+        }
+        const std::size_t END = suffix - buffer.data();
+        frame = StringView(buffer.data() + read_position, END - read_position);
+        read_position = END + 1;
+        scan_position = read_position;
+        in_frame = false;
+        return true;
+    }
+
+    bool FrameReader::nextBinary(StringView& frame){
+        while(findFrameStart(detail::BINARY_MAGIC_BYTES.data(), detail::BINARY_MAGIC_BYTES.size())){
+            if(write_position - read_position < BINARY_HEADER_SIZE){
+                return false;
+            }
+            BinaryReader reader(buffer.data() + read_position, BINARY_HEADER_SIZE);
+            uint32_t payload_length = MAX_BINARY_PAYLOAD_SIZE + 1;
+            try{
+                payload_length = readBinaryHeader(reader).payload_length;
+            } catch(const BinaryParsingException&){}
+            if(payload_length > MAX_BINARY_PAYLOAD_SIZE){ //skip the false magic and resynchronize
+                read_position++;
+                scan_position = read_position;
+                in_frame = false;
+                continue;
+            }
+            const std::size_t PACKET_SIZE = BINARY_HEADER_SIZE + payload_length;
+            if(write_position - read_position < PACKET_SIZE){
+                scan_position = write_position; //the length is known, so nothing needs scanning
+                return false;
+            }
+            frame = StringView(buffer.data() + read_position, PACKET_SIZE);
+            read_position += PACKET_SIZE;
+            scan_position = read_position;
+            in_frame = false;
+            return true;
+        }
+        return false;
+    }
+
+    bool FrameReader::next(StringView& frame){
+        return format == WireFormat::BINARY ? nextBinary(frame) : nextJSON(frame);
+    }
+
+    void FrameReader::reset(WireFormat f){
+        format = f;
+        read_position = 0;
+        write_position = 0;
+        scan_position = 0;
+        in_frame = false;
+    }
+
+    std::size_t FrameReader::buffered()const noexcept{
+        return write_position - read_position;
+    }
+
+    std::size_t FrameReader::capacity()const noexcept{
+        return buffer.size();
+    }
+}
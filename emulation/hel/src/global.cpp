@@ -1,20 +1,20 @@
 #include "roborio_manager.hpp"
-#include <chrono>
+#include "robot_instance.hpp"
 
-#include "sync_server.hpp"
-#include "sync_client.hpp"
+#include "headless_runner.hpp"
+#include "sim_clock.hpp"
+#include "sync_thread.hpp"
 
 #include "FRC_FPGA_ChipObject/RoboRIO_FRC_ChipObject_Aliases.h"
 #include "FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tGlobal.h"
 
+#include <thread>
+
 using namespace nFPGA;
 using namespace nRoboRIO_FPGANamespace;
 
 namespace hel{
-    constexpr const float TIME_CONSTANT = 1.13; // This is the offset from local time to real world time
-    Global::Global()noexcept{
-        fpga_start_time = getCurrentTime();
-    }
+    Global::Global(uint64_t fpga_start_time)noexcept:fpga_start_time(fpga_start_time){}
 
     Global::Global(const Global& source)noexcept{
 #define COPY(NAME) NAME = source.NAME
@@ -23,14 +23,14 @@ namespace hel{
     }
 
     uint64_t Global::getCurrentTime()noexcept{
-        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()/TIME_CONSTANT).count(); //TODO system time runs fast, using a scalar for now
+        return SimClock::now();
     }
 
     uint64_t Global::getFPGAStartTime()const noexcept{
         return fpga_start_time;
     }
 
-    struct GlobalManager: public tGlobal{
+    struct GlobalManager: public tGlobal, private InstanceBound{
         tSystemInterface* getSystemInterface(){
             return new SystemInterface();
         }
@@ -44,63 +44,77 @@ namespace hel{
         void writeLEDs_RSL(bool /*value*/, tRioStatusCode* /*status*/){}//unnecessary for emulation
 
         tLEDs readLEDs(tRioStatusCode* /*status*/){//unnecessary for emulation
+            HEL_PROFILE_CALL();
             return *(new tGlobal::tLEDs);
         }
 
         uint8_t readLEDs_Comm(tRioStatusCode* /*status*/){ //unnecessary for emulation
+            HEL_PROFILE_CALL();
             return 0;
         }
 
         uint8_t readLEDs_Mode(tRioStatusCode* /*status*/){ //unnecessary for emulation
+            HEL_PROFILE_CALL();
             return 0;
         }
 
         bool readLEDs_RSL(tRioStatusCode* /*status*/){ //unnecessary for emulation
+            HEL_PROFILE_CALL();
             return false;
         }
 
         uint32_t readLocalTimeUpper(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::GLOBAL);
             instance.second.unlock();
             return (Global::getCurrentTime() - instance.first->global.getFPGAStartTime()) >> 32;
         }
 
         uint16_t readVersion(tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
             return 2018; //WPILib assumes this is the competition year
         }
 
         uint32_t readLocalTime(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::GLOBAL);
             instance.second.unlock();
             return (uint32_t)(Global::getCurrentTime() - instance.first->global.getFPGAStartTime());
         }
 
         bool readUserButton(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::USER_BUTTON);
             instance.second.unlock();
             return instance.first->user_button;
         }
 
         uint32_t readRevision(tRioStatusCode* /*status*/){ //unnecessary for emulation
+            HEL_PROFILE_CALL();
             return 0;
         }
     };
 }
 
-std::thread sync_thread_send;
-std::thread sync_thread_receive;
+namespace hel{
+    void (*engine_stand_in)() = nullptr;
+}
+
+std::thread stand_in_thread;
 
 namespace nFPGA{
     namespace nRoboRIO_FPGANamespace{
         tGlobal* tGlobal::create(tRioStatusCode* /*status*/){
-            sync_thread_send = std::thread([](){
-                                               asio::io_service service;
-                                               hel::SyncServer serv(service);
-                                           });
-            sync_thread_receive = std::thread([](){
-                                                  asio::io_service service;
-                                                  hel::SyncClient serv(service);
-                                              });
+            if(hel::engine_stand_in != nullptr){
+                if(!stand_in_thread.joinable()){
+                    stand_in_thread = std::thread(hel::engine_stand_in);
+                }
+            } else {
+                hel::SyncThread::attach(hel::RobotInstance::getCurrent());
+            }
             return new hel::GlobalManager();
         }
     }
@@ -0,0 +1,199 @@
+#include "headless_runner.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "call_profiler.hpp"
+#include "diagnostics.hpp"
+#include "json_util.hpp"
+#include "receive_data.hpp"
+#include "roborio.hpp"
+#include "roborio_manager.hpp"
+#include "send_data.hpp"
+#include "sim_clock.hpp"
+
+namespace hel{
+    constexpr std::chrono::microseconds HeadlessRunner::DEFAULT_STEP_PERIOD;
+    constexpr std::chrono::seconds HeadlessRunner::LOOP_TIMEOUT;
+
+    namespace detail{
+        constexpr std::chrono::milliseconds HAL_INITIALIZATION_POLL_INTERVAL{1};
+
+        uint64_t environmentInteger(const char* name, uint64_t default_value){
+            const char* value = std::getenv(name);
+            if(value == nullptr || *value == '\0'){
+                return default_value;
+            }
+            return std::stoull(value);
+        }
+    }
+
+    std::string HeadlessRunner::RunReport::toString()const{
+        char timing[160];
+        std::snprintf(
+            timing, sizeof(timing),
+            "simulated %.3f s in %.3f s (%.1fx real time), %llu loops, loop time mean %lld us max %lld us",
+            simulated_time / 1E6,
+            wall_time.count() / 1E6,
+            wall_time.count() > 0 ? static_cast<double>(simulated_time) / wall_time.count() : 0.0,
+            static_cast<unsigned long long>(loops),
+            static_cast<long long>(mean_loop_time.count()),
+            static_cast<long long>(max_loop_time.count())
+        );
+        return std::string(timing) + ", outputs " + outputs;
+    }
+
+    HeadlessRunner::HeadlessRunner(std::vector<Keyframe> s, unsigned r, std::chrono::microseconds step):script(s), runs(r), step_period(step.count()), sim_time(0){
+        if(script.empty()){
+            throw std::invalid_argument("Synthesis exception: headless runner script is empty");
+        }
+        if(step_period == 0){
+            throw std::invalid_argument("Synthesis exception: headless runner step period must be positive");
+        }
+        std::stable_sort(script.begin(), script.end(), [](const Keyframe& a, const Keyframe& b){
+            return a.time < b.time;
+        });
+    }
+
+    std::vector<HeadlessRunner::Keyframe> HeadlessRunner::parseScript(std::istream& input){
+        std::vector<Keyframe> keyframes;
+        std::string line;
+        unsigned line_number = 0;
+        while(std::getline(input, line)){
+            line_number++;
+            const std::size_t START = line.find_first_not_of(" \t\r");
+            if(START == std::string::npos || line[START] == '#'){
+                continue;
+            }
+            std::istringstream fields(line.substr(START));
+            double seconds;
+            std::string packet;
+            if(!(fields >> seconds) || seconds < 0 || !std::getline(fields >> std::ws, packet) || packet.empty()){
+                throw std::invalid_argument("Synthesis exception: headless runner script line " + std::to_string(line_number) + " is not a time followed by a JSON packet");
+            }
+            keyframes.push_back({static_cast<uint64_t>(seconds * 1E6 + 0.5), packet});
+        }
+        std::stable_sort(keyframes.begin(), keyframes.end(), [](const Keyframe& a, const Keyframe& b){
+            return a.time < b.time;
+        });
+        return keyframes;
+    }
+
+    std::vector<HeadlessRunner::Keyframe> HeadlessRunner::defaultScript(){
+        return {
+            {0, "{\"robot_mode\":{\"mode\":\"AUTONOMOUS\",\"enabled\":1,\"emergency_stopped\":0,\"fms_attached\":1,\"ds_attached\":1}}"},
+            {15000000, "{\"robot_mode\":{\"mode\":\"AUTONOMOUS\",\"enabled\":0,\"emergency_stopped\":0,\"fms_attached\":1,\"ds_attached\":1}}"}
+        };
+    }
+
+    void HeadlessRunner::applyInputs(const std::string& packet){
+        auto instance = ReceiveDataManager::getInstance();
+        instance.first->deserializeDeep(packet);
+        instance.first->updateDeep();
+        instance.second.unlock();
+    }
+
+    std::string HeadlessRunner::captureOutputs(){
+        auto instance = SendDataManager::getInstance();
+        instance.first->updateDeep();
+        std::string outputs = instance.first->serializeDeep();
+        instance.second.unlock();
+        if(!outputs.empty() && outputs.back() == JSON_PACKET_SUFFIX){
+            outputs.pop_back();
+        }
+        return outputs;
+    }
+
+    HeadlessRunner::RunReport HeadlessRunner::run(){
+        RunReport report{0, std::chrono::microseconds(0), 0, std::chrono::microseconds(0), std::chrono::microseconds(0), ""};
+        const uint64_t START = sim_time;
+        const uint64_t END = script.back().time; //the run ends when the last keyframe is applied
+        auto next = script.begin();
+        std::chrono::microseconds total_loop_time(0);
+
+        const auto WALL_START = std::chrono::steady_clock::now();
+        auto released = WALL_START;
+        auto waitForLoop = [&](){
+            if(!SimClock::waitForUserLoop(LOOP_TIMEOUT)){
+                throw std::runtime_error("Synthesis exception: headless runner timed out waiting for the user program's loop");
+            }
+            if(report.loops > 0){
+                const auto LOOP_TIME = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - released);
+                total_loop_time += LOOP_TIME;
+                report.max_loop_time = std::max(report.max_loop_time, LOOP_TIME);
+            }
+        };
+
+        for(uint64_t elapsed = 0; elapsed <= END; elapsed += step_period){
+            waitForLoop(); //the previous iteration has finished, so inputs and time can change
+            for(; next != script.end() && next->time <= elapsed; ++next){
+                if(next + 1 == script.end()){
+                    report.outputs = captureOutputs();
+                }
+                applyInputs(next->packet);
+            }
+            sim_time = START + elapsed;
+            SimClock::advanceTo(sim_time);
+            released = std::chrono::steady_clock::now();
+            SimClock::releaseUserLoop();
+            report.loops++;
+        }
+        waitForLoop();
+        sim_time += step_period; //the next run starts one step later
+
+        report.simulated_time = sim_time - START;
+        report.wall_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - WALL_START);
+        report.mean_loop_time = total_loop_time / report.loops;
+        return report;
+    }
+
+    void HeadlessRunner::runAll(std::ostream& out){
+        SimClock::setLoopBarrier(true);
+        SimClock::advanceTo(sim_time); //signal the driver station so the user program reaches the barrier
+        sim_time += step_period;
+        for(unsigned i = 0; i < runs; i++){
+            out << "HEL runner: run " << (i + 1) << ": " << run().toString() << "\n";
+            out.flush();
+        }
+    }
+
+    void HeadlessRunner::runFromEnvironment(){
+        int status = EXIT_SUCCESS;
+        try{
+            std::vector<Keyframe> script;
+            const char* SCRIPT_PATH = std::getenv("HEL_RUNNER_SCRIPT");
+            if(SCRIPT_PATH != nullptr && *SCRIPT_PATH != '\0'){
+                std::ifstream file(SCRIPT_PATH);
+                if(!file){
+                    throw std::runtime_error(std::string("Synthesis exception: headless runner could not open script ") + SCRIPT_PATH);
+                }
+                script = parseScript(file);
+            } else {
+                script = defaultScript();
+            }
+            HeadlessRunner runner(
+                script,
+                detail::environmentInteger("HEL_RUNNER_RUNS", 1),
+                std::chrono::microseconds(detail::environmentInteger("HEL_RUNNER_STEP_US", DEFAULT_STEP_PERIOD.count()))
+            );
+            while(!hal_is_initialized){
+                std::this_thread::sleep_for(detail::HAL_INITIALIZATION_POLL_INTERVAL);
+            }
+            runner.runAll(std::cout);
+        } catch(const std::exception& ex){
+            std::cerr << ex.what() << "\n";
+            status = EXIT_FAILURE;
+        }
+        CallProfiler::writeReportToEnvironment(); //exiting this way skips the profiler's own exit handler
+        Diagnostics::flush(std::cerr); //and the diagnostics' final flush
+        std::cout.flush();
+        std::cerr.flush();
+        std::_Exit(status); //the user program never returns from its loop, and destroying its statics while it runs is unsafe
+    }
+}
@@ -1,6 +1,4 @@
-#include "roborio_manager.hpp"
-#include "send_data.hpp"
-#include "receive_data.hpp"
+#include "robot_instance.hpp"
 #include <cstdio>
 #include <fstream>
 
@@ -10,14 +8,6 @@
 namespace hel{
     std::atomic<bool> hal_is_initialized{false};
 
-    std::shared_ptr<RoboRIO> RoboRIOManager::instance = nullptr;
-    std::shared_ptr<SendData> SendDataManager::instance = nullptr;
-    std::shared_ptr<ReceiveData> ReceiveDataManager::instance = nullptr;
-
-    std::recursive_mutex RoboRIOManager::roborio_mutex;
-    std::recursive_mutex SendDataManager::send_data_mutex;
-    std::recursive_mutex ReceiveDataManager::receive_data_mutex;
-
     void __attribute__((constructor)) printVersionInfo() {
         std::ifstream vm_info;
         vm_info.open(VIRTUAL_MACHINE_INFO_PATH);
@@ -1,31 +1,137 @@
 #include "interrupt_manager.hpp"
 
-#include "error.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "call_profiler.hpp"
+#include "robot_instance.hpp"
+
+namespace hel{
+    namespace detail{
+        /**
+         * \brief What HEL knows of a tInterruptManager, kept outside it since its layout belongs to the Ni FPGA headers
+         */
+
+        struct InterruptManagerState{
+            /**
+             * \brief The robot instance current when the manager was created
+             */
+
+            std::shared_ptr<RobotInstance> robot;
+
+            /**
+             * \brief The edges the manager watches
+             */
+
+            uint32_t mask;
+
+            /**
+             * \brief The handler called for each assertion once the manager is enabled, or nullptr if none is registered
+             */
+
+            void (*handler)(uint32_t, void*);
+
+            /**
+             * \brief The parameter passed to the handler
+             */
+
+            void* param;
+
+            /**
+             * \brief Whether the handler thread should keep running
+             */
+
+            std::atomic<bool> enabled;
+
+            /**
+             * \brief The thread calling the handler while the manager is enabled
+             */
+
+            std::thread handler_thread;
+
+            InterruptManagerState(uint32_t mask):robot(RobotInstance::getCurrent()), mask(mask), handler(nullptr), param(nullptr), enabled(false), handler_thread(){}
+        };
+
+        std::mutex interrupt_managers_mutex;
+
+        std::unordered_map<const nFPGA::tInterruptManager*, std::shared_ptr<InterruptManagerState>> interrupt_managers;
+
+        std::shared_ptr<InterruptManagerState> interruptManagerState(const nFPGA::tInterruptManager* manager){
+            std::lock_guard<std::mutex> lock(interrupt_managers_mutex);
+            return interrupt_managers.at(manager);
+        }
+
+        void stopHandlerThread(InterruptManagerState& state){
+            if(!state.enabled.exchange(false)){
+                return;
+            }
+            state.robot->getInterruptSystem().release(state.mask);
+            if(state.handler_thread.get_id() == std::this_thread::get_id()){ //disabled from within the handler
+                state.handler_thread.detach();
+            } else if(state.handler_thread.joinable()){
+                state.handler_thread.join();
+            }
+        }
+    }
+}
 
 namespace nFPGA{
-    tInterruptManager::tInterruptManager(uint32_t /*interruptMask*/, bool /*watcher*/, tRioStatusCode* status) : tSystem(status){}
+    tInterruptManager::tInterruptManager(uint32_t interruptMask, bool /*watcher*/, tRioStatusCode* status) : tSystem(status){
+        std::lock_guard<std::mutex> lock(hel::detail::interrupt_managers_mutex);
+        hel::detail::interrupt_managers[this] = std::make_shared<hel::detail::InterruptManagerState>(interruptMask);
+    }
 
-    tInterruptManager::~tInterruptManager(){}
+    tInterruptManager::~tInterruptManager(){
+        std::shared_ptr<hel::detail::InterruptManagerState> state;
+        {
+            std::lock_guard<std::mutex> lock(hel::detail::interrupt_managers_mutex);
+            auto entry = hel::detail::interrupt_managers.find(this);
+            state = entry->second;
+            hel::detail::interrupt_managers.erase(entry);
+        }
+        hel::detail::stopHandlerThread(*state);
+    }
 
-    void tInterruptManager::registerHandler(tInterruptHandler /*handler*/, void* /*param*/, tRioStatusCode* /*status*/){
-        std::cerr<<"Synthesis warning: Unsupported feature: Function call tInterruptManager::registerHandler\n";
+    void tInterruptManager::registerHandler(tInterruptHandler handler, void* param, tRioStatusCode* /*status*/){
+        HEL_PROFILE_CALL();
+        std::shared_ptr<hel::detail::InterruptManagerState> state = hel::detail::interruptManagerState(this);
+        state->handler = handler;
+        state->param = param;
     }
 
-    uint32_t tInterruptManager::watch(int32_t /*timeoutInMs*/, bool /*ignorePrevious*/, tRioStatusCode* /*status*/){
-        std::cerr<<"Synthesis warning: Unsupported feature: Function call tInterruptManager::watch\n";
-        return 0;
+    uint32_t tInterruptManager::watch(int32_t timeoutInMs, bool ignorePrevious, tRioStatusCode* /*status*/){
+        HEL_PROFILE_CALL();
+        std::shared_ptr<hel::detail::InterruptManagerState> state = hel::detail::interruptManagerState(this);
+        return state->robot->getInterruptSystem().wait(state->mask, std::chrono::milliseconds(timeoutInMs), ignorePrevious); //a timeout returns no edges, which HAL reports as a timeout
     }
 
     void tInterruptManager::enable(tRioStatusCode* /*status*/){
-        std::cerr<<"Synthesis warning: Unsupported feature: Function call tInterruptManager::enable\n";
+        HEL_PROFILE_CALL();
+        std::shared_ptr<hel::detail::InterruptManagerState> state = hel::detail::interruptManagerState(this);
+        if(state->handler == nullptr || state->enabled.exchange(true)){
+            return;
+        }
+        state->handler_thread = std::thread([state](){
+            hel::RobotInstance::Binding binding(*state->robot);
+            while(state->enabled){
+                const uint32_t ASSERTED = state->robot->getInterruptSystem().wait(state->mask, std::chrono::microseconds(-1), false, &state->enabled);
+                if(ASSERTED != 0 && state->enabled){
+                    state->handler(ASSERTED, state->param);
+                }
+            }
+        });
     }
 
     void tInterruptManager::disable(tRioStatusCode* /*status*/){
-        std::cerr<<"Synthesis warning: Unsupported feature: Function call tInterruptManager::disable\n";
+        HEL_PROFILE_CALL();
+        hel::detail::stopHandlerThread(*hel::detail::interruptManagerState(this));
     }
 
     bool tInterruptManager::isEnabled(tRioStatusCode* /*status*/){
-        std::cerr<<"Synthesis warning: Unsupported feature: Function call tInterruptManager::isEnabled\n";
-        return false;
+        HEL_PROFILE_CALL();
+        return hel::detail::interruptManagerState(this)->enabled;
     }
 }
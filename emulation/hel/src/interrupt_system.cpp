@@ -0,0 +1,268 @@
+#include "interrupt_system.hpp"
+
+#include <cassert>
+#include <stdexcept>
+#include <string>
+
+#include "call_profiler.hpp"
+#include "digital_system.hpp"
+#include "robot_instance.hpp"
+#include "system_interface.hpp"
+#include "util.hpp"
+
+using namespace nFPGA;
+using namespace nRoboRIO_FPGANamespace;
+
+namespace hel{
+    constexpr uint8_t InterruptSystem::MAX_INTERRUPT_COUNT;
+    constexpr unsigned InterruptSystem::FALLING_EDGE_SHIFT;
+    constexpr unsigned InterruptSystem::ALARM_IRQ;
+    constexpr uint8_t InterruptSystem::ALARM_SLOT;
+
+    InterruptSystem::Slot::Slot()noexcept:mutex(), changed(), config(), rising_time_stamp(0), falling_time_stamp(0), asserted(0), releases(0){}
+
+    InterruptSystem::InterruptSystem()noexcept:slots(){}
+
+    uint32_t InterruptSystem::maskOf(uint8_t index)noexcept{
+        return (1u << index) | (1u << (index + FALLING_EDGE_SHIFT));
+    }
+
+    uint32_t InterruptSystem::edgesOf(uint8_t slot)noexcept{
+        return slot == ALARM_SLOT ? 1u << ALARM_IRQ : maskOf(slot);
+    }
+
+    uint8_t InterruptSystem::indexOf(uint32_t mask){
+        if(checkBitHigh(mask, ALARM_IRQ)){
+            return ALARM_SLOT;
+        }
+        const uint32_t EDGES = (mask | (mask >> FALLING_EDGE_SHIFT)) & ((1u << MAX_INTERRUPT_COUNT) - 1);
+        if(EDGES == 0){
+            throw std::out_of_range("Synthesis exception: interrupt mask " + std::to_string(mask) + " selects no interrupt");
+        }
+        return __builtin_ctz(EDGES);
+    }
+
+    tInterrupt::tConfig InterruptSystem::getConfig(uint8_t index){
+        std::lock_guard<std::mutex> lock(slots[index].mutex);
+        return slots[index].config;
+    }
+
+    void InterruptSystem::setConfig(uint8_t index, tInterrupt::tConfig config){
+        std::lock_guard<std::mutex> lock(slots[index].mutex);
+        slots[index].config = config;
+    }
+
+    uint32_t InterruptSystem::getRisingTimeStamp(uint8_t index){
+        std::lock_guard<std::mutex> lock(slots[index].mutex);
+        return slots[index].rising_time_stamp;
+    }
+
+    uint32_t InterruptSystem::getFallingTimeStamp(uint8_t index){
+        std::lock_guard<std::mutex> lock(slots[index].mutex);
+        return slots[index].falling_time_stamp;
+    }
+
+    void InterruptSystem::updateHeaders(uint16_t previous, uint16_t current, uint32_t time_stamp){
+        updateDigitalSource(0, DigitalSystem::NUM_DIGITAL_HEADERS, previous, current, time_stamp);
+    }
+
+    void InterruptSystem::updateMXP(uint16_t previous, uint16_t current, uint32_t time_stamp){
+        updateDigitalSource(1, DigitalSystem::NUM_DIGITAL_MXP_CHANNELS, previous, current, time_stamp); //HAL routes MXP digital channels through source module 1
+    }
+
+    void InterruptSystem::updateDigitalSource(uint8_t module, uint8_t channels, uint16_t previous, uint16_t current, uint32_t time_stamp){
+        const uint16_t CHANGED = previous ^ current;
+        if(CHANGED == 0){
+            return;
+        }
+        for(uint8_t i = 0; i < MAX_INTERRUPT_COUNT; i++){
+            Slot& slot = slots[i];
+            bool asserted = false;
+            {
+                std::lock_guard<std::mutex> lock(slot.mutex);
+                const tInterrupt::tConfig CONFIG = slot.config;
+                if(CONFIG.Source_Module != module || CONFIG.Source_AnalogTrigger || CONFIG.Source_Channel >= channels || checkBitLow(CHANGED, CONFIG.Source_Channel)){
+                    continue;
+                }
+                if(checkBitHigh(current, CONFIG.Source_Channel)){
+                    if(CONFIG.RisingEdge){
+                        slot.rising_time_stamp = time_stamp;
+                        slot.asserted |= 1u << i;
+                        asserted = true;
+                    }
+                } else if(CONFIG.FallingEdge){
+                    slot.falling_time_stamp = time_stamp;
+                    slot.asserted |= 1u << (i + FALLING_EDGE_SHIFT);
+                    asserted = true;
+                }
+            }
+            if(asserted){
+                slot.changed.notify_all();
+            }
+        }
+    }
+
+    void InterruptSystem::assertAlarm(){
+        Slot& slot = slots[ALARM_SLOT];
+        {
+            std::lock_guard<std::mutex> lock(slot.mutex);
+            slot.asserted |= 1u << ALARM_IRQ;
+        }
+        slot.changed.notify_all();
+    }
+
+    uint32_t InterruptSystem::wait(uint32_t mask, std::chrono::microseconds timeout, bool ignore_previous, const std::atomic<bool>* active){
+        const uint8_t INDEX = indexOf(mask);
+        const uint32_t EDGES = mask & edgesOf(INDEX);
+        Slot& slot = slots[INDEX];
+        std::unique_lock<std::mutex> lock(slot.mutex);
+        if(ignore_previous){
+            slot.asserted &= ~EDGES;
+        }
+        const uint64_t RELEASES = slot.releases;
+        auto ready = [&](){
+            return (slot.asserted & EDGES) != 0 || slot.releases != RELEASES || (active != nullptr && !*active);
+        };
+        if(timeout.count() < 0){
+            slot.changed.wait(lock, ready);
+        } else {
+            slot.changed.wait_for(lock, timeout, ready);
+        }
+        const uint32_t ASSERTED = slot.asserted & EDGES;
+        slot.asserted &= ~ASSERTED;
+        return ASSERTED;
+    }
+
+    void InterruptSystem::release(uint32_t mask){
+        Slot& slot = slots[indexOf(mask)];
+        {
+            std::lock_guard<std::mutex> lock(slot.mutex);
+            slot.releases++;
+        }
+        slot.changed.notify_all();
+    }
+
+    struct InterruptManager: public tInterrupt, private InstanceBound{
+    private:
+        uint8_t index;
+
+        InterruptSystem& interrupts()const noexcept{
+            return robot->getInterruptSystem();
+        }
+
+    public:
+        InterruptManager(uint8_t i):index(0){
+            assert(i < InterruptSystem::MAX_INTERRUPT_COUNT);
+            index = i;
+        }
+
+        tSystemInterface* getSystemInterface(){
+            return new SystemInterface();
+        }
+
+        uint8_t getSystemIndex(){
+            HEL_PROFILE_CALL();
+            return index;
+        }
+
+        uint32_t readFallingTimeStamp(tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
+            return interrupts().getFallingTimeStamp(index);
+        }
+
+        uint32_t readRisingTimeStamp(tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
+            return interrupts().getRisingTimeStamp(index);
+        }
+
+        void writeConfig(tConfig value, tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
+            interrupts().setConfig(index, value);
+        }
+
+        void writeConfig_Source_Channel(uint8_t value, tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
+            tConfig config = interrupts().getConfig(index);
+            config.Source_Channel = value;
+            interrupts().setConfig(index, config);
+        }
+
+        void writeConfig_Source_Module(uint8_t value, tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
+            tConfig config = interrupts().getConfig(index);
+            config.Source_Module = value;
+            interrupts().setConfig(index, config);
+        }
+
+        void writeConfig_Source_AnalogTrigger(bool value, tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
+            tConfig config = interrupts().getConfig(index);
+            config.Source_AnalogTrigger = value;
+            interrupts().setConfig(index, config);
+        }
+
+        void writeConfig_RisingEdge(bool value, tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
+            tConfig config = interrupts().getConfig(index);
+            config.RisingEdge = value;
+            interrupts().setConfig(index, config);
+        }
+
+        void writeConfig_FallingEdge(bool value, tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
+            tConfig config = interrupts().getConfig(index);
+            config.FallingEdge = value;
+            interrupts().setConfig(index, config);
+        }
+
+        void writeConfig_WaitForAck(bool value, tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
+            tConfig config = interrupts().getConfig(index);
+            config.WaitForAck = value;
+            interrupts().setConfig(index, config);
+        }
+
+        tConfig readConfig(tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
+            return interrupts().getConfig(index);
+        }
+
+        uint8_t readConfig_Source_Channel(tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
+            return interrupts().getConfig(index).Source_Channel;
+        }
+
+        uint8_t readConfig_Source_Module(tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
+            return interrupts().getConfig(index).Source_Module;
+        }
+
+        bool readConfig_Source_AnalogTrigger(tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
+            return interrupts().getConfig(index).Source_AnalogTrigger;
+        }
+
+        bool readConfig_RisingEdge(tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
+            return interrupts().getConfig(index).RisingEdge;
+        }
+
+        bool readConfig_FallingEdge(tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
+            return interrupts().getConfig(index).FallingEdge;
+        }
+
+        bool readConfig_WaitForAck(tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
+            return interrupts().getConfig(index).WaitForAck;
+        }
+    };
+}
+
+namespace nFPGA{
+    namespace nRoboRIO_FPGANamespace{
+        tInterrupt* tInterrupt::create(uint8_t sys_index, tRioStatusCode* /*status*/){
+            return new hel::InterruptManager(sys_index);
+        }
+    }
+}
@@ -0,0 +1,149 @@
+#include "io_recorder.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+#include "sim_clock.hpp"
+
+namespace hel{
+    const std::string IORecorder::LOG_MAGIC = "HELR";
+    constexpr uint8_t IORecorder::LOG_VERSION;
+    const std::string IORecorder::LOG_PATH_VARIABLE = "HEL_RECORD_LOG";
+    constexpr std::size_t IORecorder::RECORD_HEADER_SIZE;
+
+    IORecorder* IORecorder::active(){
+        static IORecorder* const RECORDER = [](){
+            const char* path = std::getenv(LOG_PATH_VARIABLE.c_str());
+            if(path == nullptr || *path == '\0'){
+                return static_cast<IORecorder*>(nullptr);
+            }
+            try{
+                IORecorder* recorder = new IORecorder(path); //never destroyed, since detached threads may record during exit
+                std::atexit([](){
+                    active()->flush();
+                });
+                return recorder;
+            } catch(const std::exception& ex){
+                std::cerr << "Synthesis warning: " << ex.what() << ". Engine I/O will not be recorded.\n";
+                return static_cast<IORecorder*>(nullptr);
+            }
+        }();
+        return RECORDER;
+    }
+
+    void IORecorder::record(Direction direction, WireFormat format, unsigned robot_id, StringView packet){
+        IORecorder* recorder = active();
+        if(recorder != nullptr){
+            recorder->append(direction, format, robot_id, packet);
+        }
+    }
+
+    void IORecorder::appendRecord(std::string& log, Direction direction, WireFormat format, unsigned robot_id, uint64_t time, StringView packet){
+        BinaryWriter writer(log);
+        writer.write(direction);
+        writer.write(static_cast<uint8_t>(format));
+        writer.write(static_cast<uint16_t>(robot_id));
+        writer.write(time);
+        writer.write(static_cast<uint32_t>(packet.size()));
+        log.append(packet.data(), packet.size());
+    }
+
+    std::vector<IORecorder::Record> IORecorder::readLog(std::istream& input){
+        const std::string LOG((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+        if(LOG.compare(0, LOG_MAGIC.size(), LOG_MAGIC) != 0 || LOG.size() < LOG_MAGIC.size() + 1){
+            throw std::invalid_argument("Synthesis exception: not an I/O log");
+        }
+        const uint8_t VERSION = static_cast<uint8_t>(LOG[LOG_MAGIC.size()]);
+        if(VERSION != LOG_VERSION){
+            throw std::invalid_argument("Synthesis exception: unsupported I/O log version " + std::to_string(VERSION));
+        }
+
+        std::vector<Record> records;
+        std::size_t position = LOG_MAGIC.size() + 1;
+        while(position < LOG.size()){
+            BinaryReader reader(LOG.data() + position, LOG.size() - position);
+            if(reader.remaining() < RECORD_HEADER_SIZE){
+                std::cerr << "Synthesis warning: Dropping truncated record at the end of the I/O log.\n";
+                break;
+            }
+            Record record;
+            record.direction = reader.read<Direction>();
+            const uint8_t FORMAT = reader.read<uint8_t>();
+            record.robot_id = reader.read<uint16_t>();
+            record.time = reader.read<uint64_t>();
+            const uint32_t LENGTH = reader.read<uint32_t>();
+            if(record.direction > Direction::OUTPUT || FORMAT > static_cast<uint8_t>(WireFormat::BINARY)){
+                throw std::invalid_argument("Synthesis exception: malformed I/O log record at byte " + std::to_string(position));
+            }
+            if(reader.remaining() < LENGTH){
+                std::cerr << "Synthesis warning: Dropping truncated record at the end of the I/O log.\n";
+                break;
+            }
+            record.format = static_cast<WireFormat>(FORMAT);
+            record.packet = LOG.substr(position + RECORD_HEADER_SIZE, LENGTH);
+            records.push_back(std::move(record));
+            position += RECORD_HEADER_SIZE + LENGTH;
+        }
+        return records;
+    }
+
+    IORecorder::IORecorder(const std::string& path):file(path, std::ios::binary | std::ios::trunc), buffer_mutex(), buffer_changed(), pending(LOG_MAGIC), appended(0), written(0), stopping(false), writer(){
+        if(!file){
+            throw std::runtime_error("Synthesis exception: could not create I/O log " + path);
+        }
+        pending.push_back(static_cast<char>(LOG_VERSION));
+        appended = pending.size();
+        writer = std::thread(&IORecorder::writeLoop, this);
+    }
+
+    IORecorder::~IORecorder(){
+        {
+            std::lock_guard<std::mutex> lock(buffer_mutex);
+            stopping = true;
+        }
+        buffer_changed.notify_all();
+        writer.join();
+    }
+
+    void IORecorder::append(Direction direction, WireFormat format, unsigned robot_id, StringView packet){
+        const uint64_t TIME = SimClock::now();
+        {
+            std::lock_guard<std::mutex> lock(buffer_mutex);
+            const std::size_t START = pending.size();
+            appendRecord(pending, direction, format, robot_id, TIME, packet);
+            appended += pending.size() - START;
+        }
+        buffer_changed.notify_all();
+    }
+
+    void IORecorder::flush(){
+        std::unique_lock<std::mutex> lock(buffer_mutex);
+        const uint64_t TARGET = appended;
+        buffer_changed.wait(lock, [&](){
+            return written >= TARGET;
+        });
+    }
+
+    void IORecorder::writeLoop(){
+        std::string writing;
+        std::unique_lock<std::mutex> lock(buffer_mutex);
+        while(true){
+            buffer_changed.wait(lock, [&](){
+                return stopping || !pending.empty();
+            });
+            if(pending.empty()){ //stopping, and everything is written
+                return;
+            }
+            writing.clear();
+            std::swap(writing, pending); //the buffers trade places, so steady state recording does not allocate
+            lock.unlock();
+            file.write(writing.data(), writing.size());
+            file.flush(); //robot programs are usually killed rather than exiting, so keep the file current
+            lock.lock();
+            written += writing.size();
+            buffer_changed.notify_all();
+        }
+    }
+}
@@ -0,0 +1,188 @@
+#include "io_replayer.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+
+#include "call_profiler.hpp"
+#include "diagnostics.hpp"
+#include "headless_runner.hpp"
+#include "receive_data.hpp"
+#include "roborio.hpp"
+#include "sim_clock.hpp"
+
+namespace hel{
+    constexpr std::size_t IOReplayer::MAX_REPORTED_MISMATCHES;
+    constexpr const char* IOReplayer::LOG_PATH_VARIABLE;
+    constexpr const char* IOReplayer::ROBOT_VARIABLE;
+
+    std::string IOReplayer::ReplayReport::toString()const{
+        char summary[160];
+        std::snprintf(
+            summary, sizeof(summary),
+            "%llu inputs in %.3f s, %llu loops, %llu checks, %llu mismatches",
+            static_cast<unsigned long long>(inputs),
+            wall_time.count() / 1E6,
+            static_cast<unsigned long long>(loops),
+            static_cast<unsigned long long>(checks),
+            static_cast<unsigned long long>(mismatches.size())
+        );
+        std::string s = summary;
+        for(std::size_t i = 0; i < std::min(mismatches.size(), MAX_REPORTED_MISMATCHES); i++){
+            char time[32];
+            std::snprintf(time, sizeof(time), "%.6f", mismatches[i].time / 1E6);
+            s += std::string("\n  at ") + time + " s expected " + mismatches[i].expected + "\n  but got " + mismatches[i].actual;
+        }
+        return s;
+    }
+
+    IOReplayer::IOReplayer(const std::vector<IORecorder::Record>& log, unsigned robot_id):records(), expected(), expected_format(){
+        std::copy_if(log.begin(), log.end(), std::back_inserter(records), [&](const IORecorder::Record& record){
+            return record.robot_id == robot_id;
+        });
+        if(std::none_of(records.begin(), records.end(), [](const IORecorder::Record& record){
+            return record.direction == IORecorder::Direction::INPUT;
+        })){
+            throw std::invalid_argument("Synthesis exception: I/O log holds no inputs for robot " + std::to_string(robot_id));
+        }
+    }
+
+    void IOReplayer::applyOutputs(const IORecorder::Record& record){
+        if(record.format == WireFormat::BINARY){
+            expected.deserializeBinary(record.packet);
+        } else {
+            expected.deserializeJSON(record.packet);
+        }
+        expected_format = Maybe<WireFormat>(record.format);
+    }
+
+    void IOReplayer::applyInputs(const IORecorder::Record& record){
+        auto instance = ReceiveDataManager::getInstance();
+        if(record.format == WireFormat::BINARY){
+            instance.first->deserializeBinary(record.packet);
+        } else {
+            instance.first->deserializeShallow(record.packet);
+        }
+        instance.first->updateDeep(); //as the sync threads do, so MXP inputs from deep packets are applied
+        instance.second.unlock();
+    }
+
+    void IOReplayer::check(uint64_t time, ReplayReport& report){
+        if(!expected_format){ //nothing was sent before this input
+            return;
+        }
+        SendData actual;
+        {
+            auto instance = SendDataManager::getInstance();
+            instance.first->updateDeep();
+            if(expected_format.get() == WireFormat::BINARY){ //decoded from the same format, so both sides are rounded alike
+                actual.deserializeBinary(instance.first->serializeDeepBinary());
+            } else {
+                actual.deserializeJSON(instance.first->serializeDeep());
+            }
+            instance.second.unlock();
+        }
+        const std::string EXPECTED_OUTPUTS = expected.toString();
+        const std::string ACTUAL_OUTPUTS = actual.toString();
+        report.checks++;
+        if(EXPECTED_OUTPUTS != ACTUAL_OUTPUTS){
+            report.mismatches.push_back({time, EXPECTED_OUTPUTS, ACTUAL_OUTPUTS});
+        }
+    }
+
+    IOReplayer::ReplayReport IOReplayer::run(){
+        ReplayReport report{0, 0, 0, std::chrono::microseconds(0), {}};
+        const uint64_t START = std::find_if(records.begin(), records.end(), [](const IORecorder::Record& record){
+            return record.direction == IORecorder::Direction::INPUT;
+        })->time;
+        auto waitForLoop = [](){
+            if(!SimClock::waitForUserLoop(HeadlessRunner::LOOP_TIMEOUT)){
+                throw std::runtime_error("Synthesis exception: replay timed out waiting for the user program's loop");
+            }
+        };
+
+        const auto WALL_START = std::chrono::steady_clock::now();
+        SimClock::setLoopBarrier(true);
+        SimClock::advanceTo(START); //signal the driver station so the user program reaches the barrier
+        bool released = false;
+        uint64_t last_input_time = START;
+        for(const IORecorder::Record& record: records){
+            if(record.direction == IORecorder::Direction::OUTPUT){
+                try{
+                    applyOutputs(record);
+                } catch(const std::exception& ex){
+                    std::cerr << "Synthesis warning: Skipping malformed recorded output (" << ex.what() << ").\n";
+                }
+                continue;
+            }
+            waitForLoop(); //the previous iteration has finished, so its outputs can be checked and inputs can change
+            if(released){
+                check(last_input_time - START, report);
+                released = false;
+            }
+            const uint64_t STEP = SimClock::getStep();
+            try{
+                applyInputs(record);
+            } catch(const std::exception& ex){
+                std::cerr << "Synthesis warning: Skipping malformed recorded input (" << ex.what() << ").\n";
+            }
+            if(SimClock::getStep() == STEP){ //the engine did not send a simulation time, so follow the recorded time instead
+                SimClock::advanceTo(record.time);
+            }
+            if(SimClock::getStep() != STEP){ //inputs recorded at the same time are applied in the same iteration
+                SimClock::releaseUserLoop();
+                released = true;
+                report.loops++;
+            }
+            last_input_time = record.time;
+            report.inputs++;
+        }
+        waitForLoop();
+        if(released){
+            check(last_input_time - START, report);
+        }
+        report.wall_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - WALL_START);
+        return report;
+    }
+
+    void IOReplayer::runFromEnvironment(){
+        int status = EXIT_SUCCESS;
+        try{
+            const char* LOG_PATH = std::getenv(LOG_PATH_VARIABLE);
+            if(LOG_PATH == nullptr || *LOG_PATH == '\0'){
+                throw std::runtime_error(std::string("Synthesis exception: ") + LOG_PATH_VARIABLE + " must name the I/O log to replay");
+            }
+            std::ifstream file(LOG_PATH, std::ios::binary);
+            if(!file){
+                throw std::runtime_error(std::string("Synthesis exception: replay could not open I/O log ") + LOG_PATH);
+            }
+            const std::vector<IORecorder::Record> LOG = IORecorder::readLog(file);
+            if(LOG.empty()){
+                throw std::runtime_error(std::string("Synthesis exception: I/O log ") + LOG_PATH + " is empty");
+            }
+            const char* ROBOT = std::getenv(ROBOT_VARIABLE);
+            IOReplayer replayer(LOG, ROBOT != nullptr && *ROBOT != '\0' ? std::stoul(ROBOT) : LOG.front().robot_id);
+            while(!hal_is_initialized){
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            const ReplayReport REPORT = replayer.run();
+            std::cout << "HEL replay: " << REPORT.toString() << "\n";
+            if(!REPORT.mismatches.empty()){
+                status = EXIT_FAILURE;
+            }
+        } catch(const std::exception& ex){
+            std::cerr << ex.what() << "\n";
+            status = EXIT_FAILURE;
+        }
+        CallProfiler::writeReportToEnvironment(); //exiting this way skips the profiler's own exit handler
+        Diagnostics::flush(std::cerr); //and the diagnostics' final flush
+        std::cout.flush();
+        std::cerr.flush();
+        std::_Exit(status); //the user program never returns from its loop, and destroying its statics while it runs is unsafe
+    }
+}
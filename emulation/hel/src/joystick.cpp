@@ -1,4 +1,5 @@
 #include "joystick.hpp"
+#include "binary_util.hpp"
 #include "send_data.hpp"
 #include "util.hpp"
 #include "json_util.hpp"
@@ -127,55 +128,155 @@ namespace hel{
         return s;
     }
     std::string Joystick::serialize()const{
-        std::string s = "{";
-        s += "\"is_xbox\":" + asString(is_xbox) + ", ";
-        s += "\"type\":" + std::to_string(type) + ", ";
-        s += "\"name\":" + quote(name) + ", ";
-        s += "\"buttons\":" + std::to_string(buttons) + ", ";
-        s += "\"button_count\":" + std::to_string((int)button_count) + ", ";
-        s += serializeList("\"axes\"", axes, std::function<std::string(int8_t)>(static_cast<std::string(*)(int)>(std::to_string))) + ", ";
-        s += "\"axis_count\":" + std::to_string(axis_count) + ", ";
-        s += serializeList("\"axis_types\"", axis_types, std::function<std::string(uint8_t)>(static_cast<std::string(*)(int)>(std::to_string))) + ", ";
-        s += serializeList("\"povs\"", povs, std::function<std::string(int16_t)>(static_cast<std::string(*)(int)>(std::to_string))) + ", ";
-        s += "\"pov_count\":" + std::to_string(pov_count) +", ";
-        s += "\"outputs\":" + std::to_string(outputs) + ", ";
-        s += "\"left_rumble\":" + std::to_string(left_rumble) + ", ";
-        s += "\"right_rumble\":" + std::to_string(right_rumble);
-        s += "}";
+        std::string s;
+        JSONWriter writer(s);
+        serialize(writer);
         return s;
     }
 
+    void Joystick::serialize(JSONWriter& writer)const{
+        writer.writeRaw('{');
+        writer.writeLabel("is_xbox");
+        writer.write(is_xbox);
+        writer.writeRaw(", ");
+        writer.writeLabel("type");
+        writer.write(type);
+        writer.writeRaw(", ");
+        writer.writeLabel("name");
+        writer.writeString(name);
+        writer.writeRaw(", ");
+        writer.writeLabel("buttons");
+        writer.write(buttons);
+        writer.writeRaw(", ");
+        writer.writeLabel("button_count");
+        writer.write(button_count);
+        writer.writeRaw(", ");
+        serializeList(writer, "axes", axes, [](JSONWriter& w, int8_t axis){ w.write(axis); });
+        writer.writeRaw(", ");
+        writer.writeLabel("axis_count");
+        writer.write(axis_count);
+        writer.writeRaw(", ");
+        serializeList(writer, "axis_types", axis_types, [](JSONWriter& w, uint8_t axis_type){ w.write(axis_type); });
+        writer.writeRaw(", ");
+        serializeList(writer, "povs", povs, [](JSONWriter& w, int16_t pov){ w.write(pov); });
+        writer.writeRaw(", ");
+        writer.writeLabel("pov_count");
+        writer.write(pov_count);
+        writer.writeRaw(", ");
+        writer.writeLabel("outputs");
+        writer.write(outputs);
+        writer.writeRaw(", ");
+        writer.writeLabel("left_rumble");
+        writer.write(left_rumble);
+        writer.writeRaw(", ");
+        writer.writeLabel("right_rumble");
+        writer.write(right_rumble);
+        writer.writeRaw('}');
+    }
+
     Joystick Joystick::deserialize(std::string input){
+        JSONReader reader(input);
+        return deserialize(reader);
+    }
+
+    Joystick Joystick::deserialize(JSONReader& reader){
         Joystick joy;
-        joy.is_xbox = stob(pullObject("\"is_xbox\"", input));
-        joy.type = std::stoi(pullObject("\"type\"",input));
-        joy.name = unquote(pullObject("\"name\"", input));
-        joy.buttons = std::stoi(pullObject("\"buttons\"", input));
-        joy.button_count = std::stoi(pullObject("\"button_count\"", input));
-        std::vector<int8_t> axes_deserialized = deserializeList(pullObject("\"axes\"",input), std::function<int8_t(std::string)>([&](std::string input){ return std::stoi(input);}), true);
-        if(axes_deserialized.size() == joy.axes.size()){
-            joy.axes = axes_deserialized;
-        } else {
-            throw std::out_of_range("Exception: deserialization resulted in array of " + std::to_string(axes_deserialized.size()) + " axes, expected " + std::to_string(joy.axes.size()));
+        reader.beginObject();
+        StringView label;
+        while(reader.nextField(label)){
+            switch(hasher(label)){
+            case hasher("is_xbox"):
+                joy.is_xbox = reader.readBool();
+                break;
+            case hasher("type"):
+                joy.type = reader.readInteger<uint8_t>();
+                break;
+            case hasher("name"):
+            {
+                StringView name = reader.readString();
+                joy.name.assign(name.data(), name.size());
+                break;
+            }
+            case hasher("buttons"):
+                joy.buttons = reader.readInteger<uint32_t>();
+                break;
+            case hasher("button_count"):
+                joy.button_count = reader.readInteger<uint8_t>();
+                break;
+            case hasher("axes"):
+                deserializeList(reader, joy.axes, [](JSONReader& r){ return r.readInteger<int8_t>(); });
+                break;
+            case hasher("axis_count"):
+                joy.axis_count = reader.readInteger<uint8_t>();
+                break;
+            case hasher("axis_types"):
+                deserializeList(reader, joy.axis_types, [](JSONReader& r){ return r.readInteger<uint8_t>(); });
+                break;
+            case hasher("povs"):
+                deserializeList(reader, joy.povs, [](JSONReader& r){ return r.readInteger<int16_t>(); });
+                break;
+            case hasher("pov_count"):
+                joy.pov_count = reader.readInteger<uint8_t>();
+                break;
+            case hasher("outputs"):
+                joy.outputs = reader.readInteger<uint32_t>();
+                break;
+            case hasher("left_rumble"):
+                joy.left_rumble = reader.readInteger<uint16_t>();
+                break;
+            case hasher("right_rumble"):
+                joy.right_rumble = reader.readInteger<uint16_t>();
+                break;
+            default:
+                reader.skipValue();
+            }
         }
-        joy.axis_count = std::stoi(pullObject("\"axis_count\"", input));
-        std::vector<uint8_t> axis_types_deserialized = deserializeList(pullObject("\"axis_types\"",input), std::function<uint8_t(std::string)>([&](std::string input){ return std::stoi(input);}), true);
-        if(axis_types_deserialized.size() == joy.axis_types.size()){
-            joy.axis_types = axis_types_deserialized;
-        } else {
-            throw std::out_of_range("Exception: deserialization resulted in array of " + std::to_string(axis_types_deserialized.size()) + " axis types, expected " + std::to_string(joy.axis_types.size()));
+        return joy;
+    }
+
+    void Joystick::serializeBinary(BinaryWriter& writer)const{
+        writer.write(is_xbox);
+        writer.write(type);
+        writer.write(name);
+        writer.write(buttons);
+        writer.write(button_count);
+        for(int8_t axis: axes){
+            writer.write(axis);
         }
-        std::vector<int16_t> povs_deserialized = deserializeList(pullObject("\"povs\"",input), std::function<int16_t(std::string)>([&](std::string input){ return std::stoi(input);}), true);
-        if(povs_deserialized.size() == joy.povs.size()){
-            joy.povs = povs_deserialized;
-        } else {
-            throw std::out_of_range("Exception: deserialization resulted in array of " + std::to_string(povs_deserialized.size()) + " povs, expected " + std::to_string(joy.povs.size()));
+        writer.write(axis_count);
+        for(uint8_t axis_type: axis_types){
+            writer.write(axis_type);
         }
-        joy.pov_count = std::stoi(pullObject("\"pov_count\"", input));
-        joy.outputs = std::stoi(pullObject("\"outputs\"", input));
-        joy.left_rumble = std::stoi(pullObject("\"left_rumble\"", input));
-        joy.right_rumble = std::stoi(pullObject("\"right_rumble\"", input));
+        for(int16_t pov: povs){
+            writer.write(pov);
+        }
+        writer.write(pov_count);
+        writer.write(outputs);
+        writer.write(left_rumble);
+        writer.write(right_rumble);
+    }
 
+    Joystick Joystick::deserializeBinary(BinaryReader& reader){
+        Joystick joy;
+        joy.is_xbox = reader.readBool();
+        joy.type = reader.read<uint8_t>();
+        joy.name = reader.readString();
+        joy.buttons = reader.read<uint32_t>();
+        joy.button_count = reader.read<uint8_t>();
+        for(int8_t& axis: joy.axes){
+            axis = reader.read<int8_t>();
+        }
+        joy.axis_count = reader.read<uint8_t>();
+        for(uint8_t& axis_type: joy.axis_types){
+            axis_type = reader.read<uint8_t>();
+        }
+        for(int16_t& pov: joy.povs){
+            pov = reader.read<int16_t>();
+        }
+        joy.pov_count = reader.read<uint8_t>();
+        joy.outputs = reader.read<uint32_t>();
+        joy.left_rumble = reader.read<uint16_t>();
+        joy.right_rumble = reader.read<uint16_t>();
         return joy;
     }
 
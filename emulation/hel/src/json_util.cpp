@@ -1,12 +1,261 @@
 #include "json_util.hpp"
 #include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
 
 namespace hel{
-    JSONParsingException::JSONParsingException(std::string det):details(det){}
+    JSONParsingException::JSONParsingException(std::string det):message("Synthesis exception: JSON parsing failed due to malformed data in " + det){}
 
     const char* JSONParsingException::what()const throw(){
-        std::string s = "Synthesis exception: JSON parsing failed due to malformed data in " + details;
-        return s.c_str();
+        return message.c_str();
+    }
+
+    JSONReader::JSONReader(StringView input)noexcept:position(input.begin()), end(input.end()){}
+
+    void JSONReader::skipWhitespace()noexcept{
+        while(position != end && (*position == ' ' || *position == '\t' || *position == '\n' || *position == '\r')){
+            position++;
+        }
+    }
+
+    void JSONReader::expect(char c){
+        skipWhitespace();
+        if(position == end || *position != c){
+            throw JSONParsingException(std::string("hel::JSONReader (expected '") + c + "')");
+        }
+        position++;
+    }
+
+    void JSONReader::beginObject(){
+        expect('{');
+    }
+
+    bool JSONReader::nextField(StringView& label){
+        skipWhitespace();
+        if(position != end && *position == '}'){
+            position++;
+            return false;
+        }
+        if(position != end && *position == ','){
+            position++;
+        }
+        label = readString();
+        expect(':');
+        return true;
+    }
+
+    void JSONReader::beginList(){
+        expect('[');
+    }
+
+    bool JSONReader::nextElement(){
+        skipWhitespace();
+        if(position != end && *position == ']'){
+            position++;
+            return false;
+        }
+        if(position != end && *position == ','){
+            position++;
+        }
+        return true;
+    }
+
+    bool JSONReader::readNull(){
+        skipWhitespace();
+        if(end - position >= 4 && std::memcmp(position, "null", 4) == 0){
+            position += 4;
+            return true;
+        }
+        return false;
+    }
+
+    StringView JSONReader::readString(){
+        expect('\"');
+        const char* start = position;
+        while(position != end && *position != '\"'){
+            if(*position == '\\' && (position + 1) != end){ //skip the escaped character so an escaped quote doesn't end the string
+                position++;
+            }
+            position++;
+        }
+        if(position == end){
+            throw JSONParsingException("hel::JSONReader (unterminated string)");
+        }
+        StringView value(start, position - start);
+        position++;
+        return value;
+    }
+
+    int64_t JSONReader::readSigned(){
+        skipWhitespace();
+        bool negative = false;
+        if(position != end && (*position == '-' || *position == '+')){
+            negative = *position == '-';
+            position++;
+        }
+        if(position == end || *position < '0' || *position > '9'){
+            throw JSONParsingException("hel::JSONReader (expected integer)");
+        }
+        int64_t value = 0;
+        while(position != end && *position >= '0' && *position <= '9'){
+            value = value * 10 + (*position - '0');
+            position++;
+        }
+        return negative ? -value : value;
+    }
+
+    double JSONReader::readDouble(){
+        constexpr std::size_t MAX_NUMBER_LENGTH = 64;
+
+        skipWhitespace();
+        const char* start = position;
+        while(position != end && ((*position >= '0' && *position <= '9') || *position == '-' || *position == '+' || *position == '.' || *position == 'e' || *position == 'E')){
+            position++;
+        }
+        const std::size_t LENGTH = position - start;
+        if(LENGTH == 0 || LENGTH >= MAX_NUMBER_LENGTH){
+            throw JSONParsingException("hel::JSONReader (expected number)");
+        }
+        char number[MAX_NUMBER_LENGTH]; //strtod needs a terminated string, which the buffer may not provide
+        std::memcpy(number, start, LENGTH);
+        number[LENGTH] = '\0';
+        char* number_end = nullptr;
+        double value = std::strtod(number, &number_end);
+        if(number_end != number + LENGTH){
+            throw JSONParsingException("hel::JSONReader (malformed number)");
+        }
+        return value;
+    }
+
+    bool JSONReader::readBool(){
+        skipWhitespace();
+        if(end - position >= 4 && std::memcmp(position, "true", 4) == 0){
+            position += 4;
+            return true;
+        }
+        if(end - position >= 5 && std::memcmp(position, "false", 5) == 0){
+            position += 5;
+            return false;
+        }
+        return readSigned() != 0;
+    }
+
+    StringView JSONReader::skipValue(){
+        skipWhitespace();
+        if(position == end){
+            throw JSONParsingException("hel::JSONReader (expected value)");
+        }
+        const char* start = position;
+        if(*position == '\"'){
+            readString();
+            return StringView(start, position - start);
+        }
+        if(*position != '{' && *position != '['){ //numbers and literals end at the next delimiter
+            while(position != end && *position != ',' && *position != '}' && *position != ']'){
+                position++;
+            }
+            return StringView(start, position - start);
+        }
+        unsigned depth = 0;
+        while(position != end){
+            const char c = *position;
+            if(c == '\"'){
+                readString();
+                continue;
+            }
+            position++;
+            if(c == '{' || c == '['){
+                depth++;
+            } else if(c == '}' || c == ']'){
+                depth--;
+                if(depth == 0){
+                    return StringView(start, position - start);
+                }
+            }
+        }
+        throw JSONParsingException("hel::JSONReader (unterminated value)");
+    }
+
+    JSONWriter::JSONWriter(std::string& out)noexcept:output(out){}
+
+    void JSONWriter::writeDigits(uint64_t value){
+        char digits[20]; //enough for any uint64_t
+        unsigned count = 0;
+        do{
+            digits[count++] = '0' + (value % 10);
+            value /= 10;
+        } while(value != 0);
+        while(count > 0){
+            output.push_back(digits[--count]);
+        }
+    }
+
+    void JSONWriter::writeRaw(StringView value){
+        output.append(value.data(), value.size());
+    }
+
+    void JSONWriter::writeRaw(const char* value){
+        output.append(value);
+    }
+
+    void JSONWriter::writeRaw(char value){
+        output.push_back(value);
+    }
+
+    void JSONWriter::writeLabel(const char* label){
+        output.push_back('\"');
+        output.append(label);
+        output.append("\":", 2);
+    }
+
+    void JSONWriter::writeString(StringView value){
+        output.push_back('\"');
+        output.append(value.data(), value.size());
+        output.push_back('\"');
+    }
+
+    void JSONWriter::write(bool value){
+        output.push_back(value ? '1' : '0');
+    }
+
+    void JSONWriter::write(double value){
+        constexpr double SCALE = 1e6; //10^DECIMAL_PLACES
+        constexpr double MAX_SCALED = 9007199254740992.0; //2^53, above which scaled values are no longer exact integers
+        static_assert(DECIMAL_PLACES == 6, "JSONWriter::write(double) SCALE must match DECIMAL_PLACES");
+
+        const double MAGNITUDE = std::fabs(value);
+        const double SCALED = MAGNITUDE * SCALE;
+        if(!(SCALED < MAX_SCALED)){ //fall back for huge values, infinities, and NaN
+            char buffer[512];
+            const int LENGTH = std::snprintf(buffer, sizeof(buffer), "%.6f", value);
+            output.append(buffer, LENGTH);
+            return;
+        }
+        double whole = std::floor(SCALED);
+        double fraction = SCALED - whole;
+        const double ERROR = std::fma(MAGNITUDE, SCALE, -SCALED); //the multiplication's rounding error, which decides values printf sees on the other side of a tie
+        if(fraction == 0 && ERROR < 0){ //the exact product is just below a whole number
+            whole -= 1;
+            fraction = 1;
+        }
+        uint64_t rounded = static_cast<uint64_t>(whole);
+        const double ABOVE_HALF = fraction - 0.5; //compared against the error rather than summed with it, which would round the error away
+        if(ABOVE_HALF > -ERROR || (ABOVE_HALF == -ERROR && (rounded & 1))){
+            rounded++;
+        }
+
+        if(std::signbit(value)){
+            output.push_back('-');
+        }
+        constexpr uint64_t INTEGER_SCALE = 1000000;
+        writeDigits(rounded / INTEGER_SCALE);
+        output.push_back('.');
+        uint64_t decimals = rounded % INTEGER_SCALE;
+        for(uint64_t place = INTEGER_SCALE / 10; place > 0; place /= 10){
+            output.push_back('0' + (decimals / place));
+            decimals %= place;
+        }
     }
 
     std::string quote(const std::string& s){
@@ -1,5 +1,6 @@
 #include "match_info.hpp"
 
+#include "binary_util.hpp"
 #include "error.hpp"
 #include "json_util.hpp"
 #include "util.hpp"
@@ -76,8 +77,8 @@ namespace hel{
         }
     }
 
-    MatchType_t s_to_match_type(std::string s){
-        switch(hasher(s.c_str())){
+    MatchType_t s_to_match_type(StringView s){
+        switch(hasher(s)){
         case hasher("NONE"):
             return MatchType_t::kMatchType_none;
         case hasher("PRACTICE"):
@@ -110,8 +111,8 @@ namespace hel{
         }
     }
 
-    AllianceStationID_t s_to_alliance_station_id(std::string s){
-        switch(hasher(s.c_str())){
+    AllianceStationID_t s_to_alliance_station_id(StringView s){
+        switch(hasher(s)){
         case hasher("BLUE1"):
             return AllianceStationID_t::kAllianceStationID_blue1;
         case hasher("BLUE2"):
@@ -130,38 +131,118 @@ namespace hel{
     }
 
     MatchInfo MatchInfo::deserialize(std::string input){
+        JSONReader reader(input);
+        return deserialize(reader);
+    }
+
+    MatchInfo MatchInfo::deserialize(JSONReader& reader){
         MatchInfo a;
-        a.event_name = unquote(pullObject("\"event_name\"",input));
-        a.game_specific_message = unquote(pullObject("\"game_specific_message\"",input));
-        a.match_type = s_to_match_type(unquote(pullObject("\"match_type\"",input)));
-        a.match_number = std::stoi(pullObject("\"match_number\"",input));
-        a.replay_number = std::stoi(pullObject("\"replay_number\"",input));
-        a.alliance_station_id = s_to_alliance_station_id(unquote(pullObject("\"alliance_station_id\"",input)));
-        a.match_time = std::stod(pullObject("\"match_time\"",input));
+        reader.beginObject();
+        StringView label;
+        while(reader.nextField(label)){
+            switch(hasher(label)){
+            case hasher("event_name"):
+            {
+                StringView event_name = reader.readString();
+                a.event_name.assign(event_name.data(), event_name.size());
+                break;
+            }
+            case hasher("game_specific_message"):
+            {
+                StringView message = reader.readString();
+                a.game_specific_message.assign(message.data(), message.size());
+                break;
+            }
+            case hasher("match_type"):
+                a.match_type = s_to_match_type(reader.readString());
+                break;
+            case hasher("match_number"):
+                a.match_number = reader.readInteger<uint16_t>();
+                break;
+            case hasher("replay_number"):
+                a.replay_number = reader.readInteger<uint8_t>();
+                break;
+            case hasher("alliance_station_id"):
+                a.alliance_station_id = s_to_alliance_station_id(reader.readString());
+                break;
+            case hasher("match_time"):
+                a.match_time = reader.readDouble();
+                break;
+            default:
+                reader.skipValue();
+            }
+        }
         return a;
     }
 
+    MatchInfo MatchInfo::deserializeBinary(BinaryReader& reader){
+        MatchInfo a;
+        a.event_name = reader.readString();
+        a.game_specific_message = reader.readString();
+        a.match_type = static_cast<MatchType_t>(reader.read<uint8_t>());
+        if(a.match_type > MatchType_t::kMatchType_elimination){
+            throw BinaryParsingException("invalid match_type");
+        }
+        a.match_number = reader.read<uint16_t>();
+        a.replay_number = reader.read<uint8_t>();
+        a.alliance_station_id = static_cast<AllianceStationID_t>(reader.read<uint8_t>());
+        if(a.alliance_station_id > AllianceStationID_t::kAllianceStationID_blue3){
+            throw BinaryParsingException("invalid alliance_station_id");
+        }
+        a.match_time = reader.readDouble();
+        return a;
+    }
+
+    void MatchInfo::serializeBinary(BinaryWriter& writer)const{
+        writer.write(event_name);
+        writer.write(game_specific_message);
+        writer.write(static_cast<uint8_t>(match_type));
+        writer.write(match_number);
+        writer.write(replay_number);
+        writer.write(static_cast<uint8_t>(alliance_station_id));
+        writer.write(match_time);
+    }
+
     std::string MatchInfo::serialize()const{
-        std::string s = "{";
-        s += "\"event_name\":" + quote(event_name) + ", ";
-        s += "\"game_specific_message\":" + quote(game_specific_message) + ", ";
-        s += "\"match_type\":" + quote(asString(match_type)) + ", ";
-        s += "\"match_number\":" + std::to_string(match_number) + ", ";
-        s += "\"replay_number\":" + std::to_string(replay_number) + ", ";
-        s += "\"alliance_station_id\":" + quote(asString(alliance_station_id)) + ", ";
-        s += "\"match_time\":" + std::to_string(match_time);
-        s += "}";
+        std::string s;
+        JSONWriter writer(s);
+        serialize(writer);
         return s;
     }
 
+    void MatchInfo::serialize(JSONWriter& writer)const{
+        writer.writeRaw('{');
+        writer.writeLabel("event_name");
+        writer.writeString(event_name);
+        writer.writeRaw(", ");
+        writer.writeLabel("game_specific_message");
+        writer.writeString(game_specific_message);
+        writer.writeRaw(", ");
+        writer.writeLabel("match_type");
+        writer.writeString(to_string(match_type));
+        writer.writeRaw(", ");
+        writer.writeLabel("match_number");
+        writer.write(match_number);
+        writer.writeRaw(", ");
+        writer.writeLabel("replay_number");
+        writer.write(replay_number);
+        writer.writeRaw(", ");
+        writer.writeLabel("alliance_station_id");
+        writer.writeString(to_string(alliance_station_id));
+        writer.writeRaw(", ");
+        writer.writeLabel("match_time");
+        writer.write(match_time);
+        writer.writeRaw('}');
+    }
+
     std::string MatchInfo::toString()const{
         std::string s = "{";
         s += "event_name:" + event_name + ", ";
         s += "game_specific_message:" + game_specific_message + ", ";
-        s += "match_type:" + asString(match_type) + ", ";
+        s += "match_type:" + to_string(match_type) + ", ";
         s += "match_number:" + std::to_string(match_number) + ", ";
         s += "replay_number:" + std::to_string(replay_number) + ", ";
-        s += "alliance_station_id:" + asString(alliance_station_id) + ", ";
+        s += "alliance_station_id:" + to_string(alliance_station_id) + ", ";
         s += "match_time:" + std::to_string(match_time);
         s += "}";
         return s;
@@ -0,0 +1,256 @@
+#include "multiplexed_sync.hpp"
+#include "diagnostics.hpp"
+#include "io_recorder.hpp"
+#include "sim_clock.hpp"
+#include "sync_util.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+namespace hel{
+    constexpr std::chrono::milliseconds MultiplexedSync::SEND_IDLE_TIMEOUT;
+
+    std::vector<MultiplexedSync::BatchEntry> MultiplexedSync::parseBatch(StringView batch){
+        BinaryReader header_reader(batch.data(), batch.size());
+        const BinaryHeader HEADER = readBinaryHeader(header_reader);
+        if(HEADER.type != BinaryPacketType::BATCH){
+            throw BinaryParsingException("expected a batch packet");
+        }
+        if(BINARY_HEADER_SIZE + HEADER.payload_length > batch.size()){
+            throw BinaryParsingException("truncated batch");
+        }
+        std::vector<BatchEntry> entries;
+        std::size_t position = BINARY_HEADER_SIZE;
+        const std::size_t END = BINARY_HEADER_SIZE + HEADER.payload_length;
+        while(position < END){
+            BinaryReader reader(batch.data() + position, END - position);
+            BatchEntry entry;
+            entry.robot_id = reader.read<uint16_t>();
+            const BinaryHeader PACKET_HEADER = readBinaryHeader(reader);
+            if(reader.remaining() < PACKET_HEADER.payload_length){
+                throw BinaryParsingException("truncated batch entry for robot " + std::to_string(entry.robot_id));
+            }
+            position += sizeof(uint16_t);
+            const std::size_t PACKET_SIZE = BINARY_HEADER_SIZE + PACKET_HEADER.payload_length;
+            entry.packet = StringView(batch.data() + position, PACKET_SIZE);
+            position += PACKET_SIZE;
+            entries.push_back(entry);
+        }
+        return entries;
+    }
+
+    void MultiplexedSync::appendBatchEntry(std::string& batch, uint16_t robot_id, const std::string& packet){
+        BinaryWriter writer(batch);
+        writer.write(robot_id);
+        batch.append(packet);
+    }
+
+    MultiplexedSync::MultiplexedSync(asio::io_context& io_context, uint16_t port, std::vector<std::shared_ptr<RobotInstance>> robots):
+        io(io_context),
+        robots(robots),
+        dirty(new std::atomic<bool>[robots.size()]),
+        acceptor(io_context, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port)),
+        socket(io_context),
+        negotiation_timer(io_context),
+        idle_timer(io_context),
+        frames(WireFormat::BINARY),
+        connected(false),
+        write_in_progress(false),
+        send_pending(false),
+        notify_posted(false),
+        outgoing("")
+    {
+        for(std::size_t i = 0; i < robots.size(); i++){
+            dirty[i] = true;
+            RobotInstance::Binding binding(*robots[i]);
+            SendDataManager::setNewDataListener([this, i](){
+                dirty[i] = true;
+                if(!notify_posted.exchange(true)){ //changes from every robot until the io_context gets to it are sent in one batch
+                    asio::post(io, [this](){
+                        notify_posted = false;
+                        sendLatest();
+                    });
+                }
+            });
+        }
+        startAccept();
+    }
+
+    MultiplexedSync::~MultiplexedSync(){
+        for(const std::shared_ptr<RobotInstance>& robot: robots){
+            RobotInstance::Binding binding(*robot);
+            SendDataManager::setNewDataListener(nullptr);
+        }
+    }
+
+    void MultiplexedSync::startAccept(){
+        acceptor.async_accept(socket, [this](const auto& ec){
+            if(ec){
+                std::cerr << "Synthesis warning: Multiplexed session failed to accept a connection (" << ec.message() << ").\n";
+                startAccept();
+                return;
+            }
+            asyncNegotiateWireFormat(socket, negotiation_timer, [](const std::string& /*name*/){
+                return false; //one socket already carries every robot, so a ring would save little
+            }, [this](WireFormat format, Transport /*transport*/){
+                if(format != WireFormat::BINARY){
+                    std::cerr << "Synthesis warning: Multiplexed session requires the binary wire format. Closing the connection.\n";
+                    disconnect();
+                    return;
+                }
+                connected = true;
+                write_in_progress = false;
+                send_pending = false;
+                for(const std::shared_ptr<RobotInstance>& robot: robots){
+                    RobotInstance::Binding binding(*robot);
+                    auto instance = SendDataManager::getInstance();
+                    instance.first->requestKeyframe(); //the engine has not seen any previous packets
+                    instance.second.unlock();
+                }
+                markAllDirty();
+                frames.reset(WireFormat::BINARY);
+                startRead();
+                sendLatest();
+            });
+        });
+    }
+
+    void MultiplexedSync::startRead(){
+        std::pair<char*, std::size_t> space = frames.prepare(ETHERNET_MTU);
+        socket.async_read_some(asio::buffer(space.first, space.second), [this](const auto& ec, std::size_t bytes_received){
+            if(ec){
+                if(ec != asio::error::operation_aborted){
+                    disconnect();
+                }
+                return;
+            }
+            frames.commit(bytes_received);
+            StringView frame;
+            while(frames.next(frame)){ //unlike a single robot's packets, each batch may carry different robots, so none are skipped
+                applyBatch(frame);
+            }
+            startRead();
+        });
+    }
+
+    void MultiplexedSync::applyBatch(StringView batch){
+        std::vector<BatchEntry> entries;
+        try{
+            entries = parseBatch(batch);
+        } catch(const std::exception& ex){
+            static Diagnostics::Site malformed_batch_warning;
+            Diagnostics::report(malformed_batch_warning, [&](){
+                return std::string("Dropping malformed batches, first because of: ") + ex.what();
+            });
+            return;
+        }
+        for(const BatchEntry& entry: entries){
+            auto robot = std::find_if(robots.begin(), robots.end(), [&](const std::shared_ptr<RobotInstance>& r){
+                return r->getID() == entry.robot_id;
+            });
+            if(robot == robots.end()){
+                static Diagnostics::Site unknown_robot_warning;
+                Diagnostics::report(unknown_robot_warning, [&](){
+                    return "Dropping packets for robots which are not in this multiplexed session, first for robot " + std::to_string(entry.robot_id);
+                });
+                continue;
+            }
+            RobotInstance::Binding binding(**robot);
+            auto instance = ReceiveDataManager::getInstance();
+            try{
+                instance.first->deserializeBinary(entry.packet);
+                IORecorder::record(IORecorder::Direction::INPUT, WireFormat::BINARY, entry.robot_id, entry.packet);
+            } catch(const std::exception& ex){
+                static Diagnostics::Site malformed_packet_warning;
+                Diagnostics::report(malformed_packet_warning, [&](){
+                    return "Dropping malformed packets, first for robot " + std::to_string(entry.robot_id) + " because of: " + ex.what();
+                });
+            }
+            instance.first->updateDeep(); //binary packets may be deep, and MXP inputs keep their last deep values otherwise
+            instance.second.unlock();
+        }
+    }
+
+    void MultiplexedSync::sendLatest(){
+        if(!connected){
+            return;
+        }
+        if(write_in_progress){
+            send_pending = true;
+            return;
+        }
+        send_pending = false;
+        outgoing.clear();
+        BinaryWriter writer(outgoing);
+        const std::size_t HEADER_POSITION = writer.beginPacket(BinaryPacketType::BATCH);
+        for(std::size_t i = 0; i < robots.size(); i++){
+            if(!dirty[i].exchange(false)){
+                continue;
+            }
+            RobotInstance::Binding binding(*robots[i]);
+            auto instance = SendDataManager::getInstance();
+            const std::string& packet = instance.first->serializeNext(WireFormat::BINARY);
+            IORecorder::record(IORecorder::Direction::OUTPUT, WireFormat::BINARY, robots[i]->getID(), packet);
+            appendBatchEntry(outgoing, robots[i]->getID(), packet);
+            instance.second.unlock();
+        }
+        if(outgoing.size() == BINARY_HEADER_SIZE){ //another notification already sent these changes
+            return;
+        }
+        writer.endPacket(HEADER_POSITION);
+        write_in_progress = true;
+        idle_timer.cancel();
+        asio::async_write(socket, asio::buffer(outgoing), [this](const auto& ec, std::size_t /*bytes_transferred*/){
+            write_in_progress = false;
+            if(ec){
+                if(ec != asio::error::operation_aborted){
+                    std::cerr << "Synthesis warning: Multiplexed session disconnected. User code will continue to run.\n";
+                    disconnect();
+                }
+                return;
+            }
+            if(send_pending){
+                sendLatest();
+            } else {
+                restartIdleTimer();
+            }
+        });
+    }
+
+    void MultiplexedSync::markAllDirty()noexcept{
+        for(std::size_t i = 0; i < robots.size(); i++){
+            dirty[i] = true;
+        }
+    }
+
+    void MultiplexedSync::restartIdleTimer(){
+        idle_timer.expires_after(SEND_IDLE_TIMEOUT);
+        idle_timer.async_wait([this](const auto& ec){
+            if(!ec){
+                markAllDirty(); //resend so a dropped connection is noticed
+                sendLatest();
+            }
+        });
+    }
+
+    void MultiplexedSync::disconnect(){
+        if(!socket.is_open()){
+            return;
+        }
+        connected = false;
+        idle_timer.cancel();
+        for(const std::shared_ptr<RobotInstance>& robot: robots){
+            RobotInstance::Binding binding(*robot);
+            SimClock::release(); //without the engine, time must keep running for the user programs
+            auto instance = ReceiveDataManager::getInstance();
+            instance.first->deserializeDeep(ReceiveData::defaultPacket());
+            instance.first->updateDeep();
+            instance.second.unlock();
+        }
+        try{
+            socket.close();
+        } catch(const std::exception&){}
+        startAccept();
+    }
+}
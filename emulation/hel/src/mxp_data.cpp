@@ -1,4 +1,5 @@
 #include "mxp_data.hpp"
+#include "binary_util.hpp"
 #include "util.hpp"
 #include "json_util.hpp"
 #include "error.hpp"
@@ -21,8 +22,8 @@ namespace hel{
         }
     }
 
-    MXPData::Config s_to_mxp_config(std::string input){
-        switch(hasher(input.c_str())){
+    MXPData::Config s_to_mxp_config(StringView input){
+        switch(hasher(input)){
         case hasher("DI"):
             return MXPData::Config::DI;
         case hasher("DO"):
@@ -55,17 +56,58 @@ namespace hel{
     }
 
     std::string MXPData::serialize()const{
-        std::string s = "{";
-        s += "\"config\":" + quote(asString(config)) + ", ";
-        s += "\"value\":" + std::to_string(value);
-        s += "}";
+        std::string s;
+        JSONWriter writer(s);
+        serialize(writer);
         return s;
     }
 
+    void MXPData::serialize(JSONWriter& writer)const{
+        writer.writeRaw('{');
+        writer.writeLabel("config");
+        writer.writeString(asString(config));
+        writer.writeRaw(", ");
+        writer.writeLabel("value");
+        writer.write(value);
+        writer.writeRaw('}');
+    }
+
     MXPData MXPData::deserialize(std::string s){
+        JSONReader reader(s);
+        return deserialize(reader);
+    }
+
+    MXPData MXPData::deserialize(JSONReader& reader){
+        MXPData m;
+        reader.beginObject();
+        StringView label;
+        while(reader.nextField(label)){
+            switch(hasher(label)){
+            case hasher("config"):
+                m.config = s_to_mxp_config(reader.readString());
+                break;
+            case hasher("value"):
+                m.value = reader.readDouble();
+                break;
+            default:
+                reader.skipValue();
+            }
+        }
+        return m;
+    }
+
+    void MXPData::serializeBinary(BinaryWriter& writer)const{
+        writer.write(static_cast<uint8_t>(config));
+        writer.write(static_cast<float>(value));
+    }
+
+    MXPData MXPData::deserializeBinary(BinaryReader& reader){
         MXPData m;
-        m.config = s_to_mxp_config(unquote(pullObject("\"config\"",s)));
-        m.value = std::stod(pullObject("\"value\"",s));
+        m.config = static_cast<Config>(reader.read<uint8_t>());
+        if(m.config > Config::I2C){
+            throw BinaryParsingException("invalid MXP config");
+        }
+        m.value = reader.readFloat();
         return m;
     }
 }
@@ -1,9 +1,8 @@
 #include "roborio_manager.hpp"
+#include "robot_instance.hpp"
+#include "sim_clock.hpp"
 #include <thread>
 #include <cstdio>
-#include <unistd.h>
-
-std::thread ds_spoofer;
 
 namespace hel{
     NetComm::NetComm()noexcept:ref_num(),occurFunction(){}
@@ -17,19 +16,23 @@ namespace hel{
 
 extern "C" {
     void NetCommRPCProxy_SetOccurFuncPointer(void (*Occur)(uint32_t)){
-        auto instance = hel::RoboRIOManager::getInstance();
+        auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::NET_COMM);
         auto newData = [Occur](uint32_t x) {
-            usleep(10000);
             Occur(x);
         };
         instance.first->net_comm.occurFunction = newData;
-        ds_spoofer = std::thread( //call Occur repeatably in the background to signal HAL that the Driver Station has new data for it; this way it won't block and will actually receive HEL DS data
-            [newData](){
+        std::thread( //call Occur repeatably in the background to signal HAL that the Driver Station has new data for it; this way it won't block and will actually receive HEL DS data
+            [newData](std::shared_ptr<hel::RobotInstance> robot){
+                hel::RobotInstance::Binding binding(*robot);
+                uint64_t step = hel::SimClock::getStep();
                 while(1){
-                    newData(42); //TODO use NetComm ref_num instead of 42
+                    if(hel::SimClock::waitForStep(step, hel::SimClock::REAL_TIME_STEP_PERIOD)){ //in lockstep mode, the user loop runs once per engine step
+                        newData(42); //TODO use NetComm ref_num instead of 42
+                    }
                 }
-            }
-        );
+            },
+            hel::RobotInstance::getCurrent()
+        ).detach();
         hel::hal_is_initialized.store(true);
         instance.second.unlock();
     }
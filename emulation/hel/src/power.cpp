@@ -1,4 +1,5 @@
 #include "roborio_manager.hpp"
+#include "robot_instance.hpp"
 
 using namespace nFPGA;
 using namespace nRoboRIO_FPGANamespace;
@@ -37,127 +38,163 @@ namespace hel{
 #undef COPY
     }
 
-    struct PowerManager: public tPower{
+    struct PowerManager: public tPower, private InstanceBound{
         tSystemInterface* getSystemInterface(){ //unnecessary for emulation
             return new SystemInterface();
         }
 
         uint16_t readUserVoltage3V3(tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
             return (3.3 + 0.01) * 4.096 / 0.004902; //reverse HAL math to return expected value
         }
 
         tStatus readStatus(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::POWER);
             instance.second.unlock();
             return instance.first->power.getStatus();
         }
 
         uint8_t readStatus_User3V3(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::POWER);
             instance.second.unlock();
             return instance.first->power.getStatus().User3V3;
         }
 
         uint8_t readStatus_User5V(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::POWER);
             instance.second.unlock();
             return instance.first->power.getStatus().User5V;
         }
 
         uint8_t readStatus_User6V(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::POWER);
             instance.second.unlock();
             return instance.first->power.getStatus().User6V;
         }
 
         uint16_t readUserVoltage6V(tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
             return (6.0 + 0.014) * 4.096 / 0.007019; //reverse HAL math to return expected value
         }
 
         uint16_t readOnChipTemperature(tRioStatusCode* /*status*/){ //unnecessary for emulation
+            HEL_PROFILE_CALL();
             return 0; 
         }
 
         uint16_t readUserVoltage5V(tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
             return (5.0 + 0.013) * 4.096 / 0.005962; //reverse HAL math to return expected value
         }
 
         void strobeResetFaultCounts(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::POWER);
             instance.first->power.setFaultCounts(*(new tFaultCounts));
             instance.second.unlock();
         }
 
         uint16_t readIntegratedIO(tRioStatusCode* /*status*/){ //unnecessary for emulation
+            HEL_PROFILE_CALL();
             return 0;
         }
 
         uint16_t readMXP_DIOVoltage(tRioStatusCode* /*status*/){ //unnecessary for emulation
+            HEL_PROFILE_CALL();
             return 0;
         }
 
         uint16_t readUserCurrent3V3(tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
             return 0;
         }
 
         uint16_t readVinVoltage(tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
             return 0;
         }
 
         uint16_t readUserCurrent6V(tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
             return 0;
         }
 
         uint16_t readUserCurrent5V(tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
             return 0;
         }
 
         uint16_t readAOVoltage(tRioStatusCode* /*status*/){ //unnecessary for emulation
+            HEL_PROFILE_CALL();
             return 0;
         }
 
         tFaultCounts readFaultCounts(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::POWER);
             instance.second.unlock();
             return instance.first->power.getFaultCounts();
         }
 
         uint8_t readFaultCounts_OverCurrentFaultCount3V3(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::POWER);
             instance.second.unlock();
             return instance.first->power.getFaultCounts().OverCurrentFaultCount3V3;
         }
 
         uint8_t readFaultCounts_OverCurrentFaultCount5V(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::POWER);
             instance.second.unlock();
             return instance.first->power.getFaultCounts().OverCurrentFaultCount5V;
         }
 
         uint8_t readFaultCounts_OverCurrentFaultCount6V(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::POWER);
             instance.second.unlock();
             return instance.first->power.getFaultCounts().OverCurrentFaultCount6V;
         }
 
         uint8_t readFaultCounts_UnderVoltageFaultCount5V(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::POWER);
             instance.second.unlock();
             return instance.first->power.getFaultCounts().UnderVoltageFaultCount5V;
         }
 
         uint16_t readVinCurrent(tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
             return 0;
         }
 
         void writeDisable(tDisable value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::POWER);
             instance.first->power.setDisabled(value);
             instance.second.unlock();
         }
 
         void writeDisable_User3V3(bool value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::POWER);
             tDisable disabled = instance.first->power.getDisabled();
             disabled.User3V3 = value;
             instance.first->power.setDisabled(disabled);
@@ -165,7 +202,9 @@ namespace hel{
         }
 
         void writeDisable_User5V(bool value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::POWER);
             tDisable disabled = instance.first->power.getDisabled();
             disabled.User5V = value;
             instance.first->power.setDisabled(disabled);
@@ -173,7 +212,9 @@ namespace hel{
         }
 
         void writeDisable_User6V(bool value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::POWER);
             tDisable disabled = instance.first->power.getDisabled();
             disabled.User6V = value;
             instance.first->power.setDisabled(disabled);
@@ -181,25 +222,33 @@ namespace hel{
         }
 
         tDisable readDisable(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::POWER);
             instance.second.unlock();
             return instance.first->power.getDisabled();
         }
 
         bool readDisable_User3V3(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::POWER);
             instance.second.unlock();
             return instance.first->power.getDisabled().User3V3;
         }
 
         bool readDisable_User5V(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::POWER);
             instance.second.unlock();
             return instance.first->power.getDisabled().User5V;
         }
 
         bool readDisable_User6V(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::POWER);
             instance.second.unlock();
             return instance.first->power.getDisabled().User6V;
         }
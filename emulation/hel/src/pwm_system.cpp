@@ -1,4 +1,5 @@
 #include "roborio_manager.hpp"
+#include "robot_instance.hpp"
 #include "util.hpp"
 
 using namespace nFPGA;
@@ -35,6 +36,7 @@ namespace hel{
 
     void PWMSystem::setHdrPulseWidth(uint8_t index, uint32_t value){
         hdr[index].pulse_width = value;
+        RoboRIOManager::publishSnapshot(RoboRIO::Subsystem::PWM_SYSTEM);
         auto instance = SendDataManager::getInstance();
         instance.first->updateShallow();
         instance.second.unlock();
@@ -46,8 +48,9 @@ namespace hel{
 
     void PWMSystem::setMXPPulseWidth(uint8_t index, uint32_t value){
         mxp[index].pulse_width = value;
+        RoboRIOManager::publishSnapshot(RoboRIO::Subsystem::PWM_SYSTEM);
         auto instance = SendDataManager::getInstance();
-        instance.first->updateShallow();
+        instance.first->updateDeep();
         instance.second.unlock();
     }
 
@@ -83,23 +86,28 @@ namespace hel{
 #undef COPY
     }
 
-    struct PWMManager: public tPWM{
+    struct PWMManager: public tPWM, private InstanceBound{
         tSystemInterface* getSystemInterface(){
             return new SystemInterface();
         }
 
         uint32_t readCycleStartTime(tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
             return 0;//unnecessary for emulation
         }
 
         void writeConfig(tPWM::tConfig value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::PWM_SYSTEM);
             instance.first->pwm_system.setConfig(value);
             instance.second.unlock();
         }
 
         void writeConfig_Period(uint16_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::PWM_SYSTEM);
             tPWM::tConfig config = instance.first->pwm_system.getConfig();
             config.Period = value;
             instance.first->pwm_system.setConfig(config);
@@ -107,7 +115,9 @@ namespace hel{
         }
 
         void writeConfig_MinHigh(uint16_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::PWM_SYSTEM);
             tPWM::tConfig config = instance.first->pwm_system.getConfig();
             config.MinHigh = value;
             instance.first->pwm_system.setConfig(config);
@@ -115,53 +125,70 @@ namespace hel{
         }
 
         tPWM::tConfig readConfig(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::PWM_SYSTEM);
             instance.second.unlock();
             return instance.first->pwm_system.getConfig();
         }
 
         uint16_t readConfig_Period(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::PWM_SYSTEM);
             instance.second.unlock();
             return instance.first->pwm_system.getConfig().Period;
         }
 
         uint16_t readConfig_MinHigh(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::PWM_SYSTEM);
             instance.second.unlock();
             return instance.first->pwm_system.getConfig().MinHigh;
         }
 
         uint32_t readCycleStartTimeUpper(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::PWM_SYSTEM);
             instance.second.unlock();
             return 0;//unnecessary for emulation
         }
 
         uint16_t readLoopTiming(tRioStatusCode* /*status*/){
+            HEL_PROFILE_CALL();
             return PWMSystem::EXPECTED_LOOP_TIMING;
         }
 
         void writePeriodScaleMXP(uint8_t bitfield_index, uint8_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::PWM_SYSTEM);
             instance.first->pwm_system.setMXPPeriodScale(bitfield_index, value);
             instance.second.unlock();
         }
 
         uint8_t readPeriodScaleMXP(uint8_t bitfield_index, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::PWM_SYSTEM);
             instance.second.unlock();
             return instance.first->pwm_system.getMXPPeriodScale(bitfield_index);
         }
 
         void writePeriodScaleHdr(uint8_t bitfield_index, uint8_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::PWM_SYSTEM);
             instance.first->pwm_system.setHdrPeriodScale(bitfield_index, value);
             instance.second.unlock();
         }
 
         uint8_t readPeriodScaleHdr(uint8_t bitfield_index, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::PWM_SYSTEM);
             instance.second.unlock();
             return instance.first->pwm_system.getHdrPeriodScale(bitfield_index);
         }
@@ -169,23 +196,30 @@ namespace hel{
         void writeZeroLatch(uint8_t /*bitfield_index*/, bool /*value*/, tRioStatusCode* /*status*/){} //unnecessary for emulation
 
         bool readZeroLatch(uint8_t /*bitfield_index*/, tRioStatusCode* /*status*/){ //unnecessary for emulation
+            HEL_PROFILE_CALL();
             return false;
         }
 
         void writeHdr(uint8_t reg_index, uint16_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::PWM_SYSTEM);
             instance.first->pwm_system.setHdrPulseWidth(reg_index, value);
             instance.second.unlock();
         }
 
         uint16_t readHdr(uint8_t reg_index, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::PWM_SYSTEM);
             instance.second.unlock();
             return instance.first->pwm_system.getHdrPulseWidth(reg_index);
         }
 
         void writeMXP(uint8_t reg_index, uint16_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance({RoboRIO::Subsystem::DIGITAL_SYSTEM, RoboRIO::Subsystem::PWM_SYSTEM});
 
             if(value == 0){ //allow disabling PWM even when output isn't configured for PWM
                 instance.first->pwm_system.setMXPPulseWidth(reg_index, value);
@@ -205,7 +239,9 @@ namespace hel{
         }
 
         uint16_t readMXP(uint8_t reg_index, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::PWM_SYSTEM);
             instance.second.unlock();
             return instance.first->pwm_system.getMXPPulseWidth(reg_index);
         }
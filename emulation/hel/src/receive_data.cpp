@@ -1,6 +1,9 @@
 #include "receive_data.hpp"
 
+#include "binary_util.hpp"
 #include "roborio_manager.hpp"
+#include "robot_instance.hpp"
+#include "sim_clock.hpp"
 #include "util.hpp"
 #include "json_util.hpp"
 
@@ -8,17 +11,65 @@ using namespace nFPGA;
 using namespace nRoboRIO_FPGANamespace;
 
 namespace hel{
-    namespace detail {
-        const auto liftedDeserialize = hel::Maybe<std::string>::lift<hel::EncoderManager>(hel::EncoderManager::deserialize);
-    }
+    ReceiveData::ReceiveData():last_received_data(""),digital_hdrs(false), digital_mxp({}), joysticks({}), match_info({}), robot_mode({}), encoder_managers({}), sim_time(){}
 
-    ReceiveData::ReceiveData():last_received_data(""),digital_hdrs(false), digital_mxp({}), joysticks({}), match_info({}), robot_mode({}), encoder_managers({}){}
+    void ReceiveData::update(bool deep)const{
+        if(hal_is_initialized){
+            updateDigitalInputs(deep);
+            updateInputs();
+        }
+        if(sim_time){
+            SimClock::advanceTo(sim_time.get()); //after the inputs are applied, so the step they belong to sees them
+        }
+    }
 
     void ReceiveData::updateShallow()const{
-        if(!hal_is_initialized){
+        update(false);
+    }
+
+    void ReceiveData::updateDeep()const{
+        update(true);
+    }
+
+    void ReceiveData::updateDigitalInputs(bool deep)const{
+        auto instance = RoboRIOManager::getInstance({RoboRIO::Subsystem::DIGITAL_SYSTEM, RoboRIO::Subsystem::GLOBAL});
+        const tDIO::tDI PREVIOUS = instance.first->digital_system.getInputs();
+        tDIO::tDI di = PREVIOUS;
+        tDIO::tOutputEnable output_mode = instance.first->digital_system.getEnabledOutputs();
+        for(unsigned i = 0; i < digital_hdrs.size(); i++){
+            if(checkBitLow(output_mode.Headers,i)){ //if set for input, then read in the inputs
+                di.Headers = setBit(di.Headers, digital_hdrs[i], i);
+            }
+        }
+        if(deep){
+            const uint16_t SPECIAL_FUNCTIONS = instance.first->digital_system.getMXPSpecialFunctionsEnabled();
+            for(unsigned i = 0; i < digital_mxp.size(); i++){
+                if(DigitalSystem::toMXPConfig(output_mode.MXP, SPECIAL_FUNCTIONS, i) == MXPData::Config::DI){
+                    di.MXP = setBit(di.MXP, digital_mxp[i].value != 0, i);
+                }
+            }
+        }
+        if(di.Headers == PREVIOUS.Headers && di.MXP == PREVIOUS.MXP){
+            instance.second.unlock();
             return;
         }
-        auto instance = RoboRIOManager::getInstance();
+        instance.first->digital_system.setInputs(di);
+        const uint32_t FPGA_TIME = Global::getCurrentTime() - instance.first->global.getFPGAStartTime();
+        instance.second.unlock();
+        InterruptSystem& interrupts = RobotInstance::current().getInterruptSystem(); //after unlocking, since woken handlers may read the RoboRIO
+        interrupts.updateHeaders(PREVIOUS.Headers, di.Headers, FPGA_TIME);
+        interrupts.updateMXP(PREVIOUS.MXP, di.MXP, FPGA_TIME);
+    }
+
+    void ReceiveData::updateInputs()const{
+        auto instance = RoboRIOManager::getInstance({ //encoder managers update the counters and FPGA encoders, so lock those too
+            RoboRIO::Subsystem::COUNTERS,
+            RoboRIO::Subsystem::MATCH_INFO,
+            RoboRIO::Subsystem::ENCODER_MANAGERS,
+            RoboRIO::Subsystem::FPGA_ENCODERS,
+            RoboRIO::Subsystem::JOYSTICKS,
+            RoboRIO::Subsystem::ROBOT_MODE
+        });
 
         instance.first->joysticks = joysticks;
         instance.first->match_info = match_info;
@@ -32,32 +83,11 @@ namespace hel{
         instance.second.unlock();
     }
 
-    void ReceiveData::updateDeep()const{
-        if(!hal_is_initialized){
-            return;
-        }
-        auto instance = RoboRIOManager::getInstance();
-
-        updateShallow();
-        {
-            tDIO::tDI di = instance.first->digital_system.getInputs();
-            tDIO::tOutputEnable output_mode = instance.first->digital_system.getEnabledOutputs();
-            for(unsigned i = 0; i < digital_hdrs.size(); i++){
-                if(checkBitLow(output_mode.Headers,i)){ //if set for input, then read in the inputs
-                    di.Headers = setBit(di.Headers, digital_hdrs[i], i);
-                }
-            }
-            //TODO add MXP digital inputs
-            instance.first->digital_system.setInputs(di);
-        }
-        instance.second.unlock();
-    }
-
     std::string ReceiveData::toString()const{
         std::string s = "(";
         s += "digital_hdrs:" + asString(digital_hdrs, std::function<std::string(bool)>(static_cast<std::string(*)(bool)>(asString))) + ", ";
         s += "joysticks:" + asString(joysticks, std::function<std::string(Joystick)>(&Joystick::toString)) + ", ";
-        s += "digital_mxp:" + asString(digital_mxp, std::function<std::string(MXPData)>(&MXPData::serialize)) + ", ";
+        s += "digital_mxp:" + asString(digital_mxp, std::function<std::string(MXPData)>(static_cast<std::string(MXPData::*)()const>(&MXPData::serialize))) + ", ";
         s += "match_info:" + match_info.toString() + ", ";
         s += "robot_mode:" + robot_mode.toString() + ", ";
         s += "encoder_managers:" + asString(encoder_managers, std::function<std::string(Maybe<EncoderManager>)>([&](Maybe<EncoderManager> a){
@@ -66,111 +96,114 @@ namespace hel{
                                                                                                                      }
                                                                                                                      return std::string("null");
                                                                                                                  }));
+        s += ", sim_time:" + (sim_time ? std::to_string(sim_time.get()) : std::string("null"));
         s += ")";
         return s;
     }
 
-    void ReceiveData::deserializeDigitalHdrs(std::string& input){
-        if(input.find(quote("digital_hdrs")) != std::string::npos){
-            try{
-                digital_hdrs = deserializeList(
-                    pullObject("\"digital_hdrs\"", input),
-                    std::function<bool(std::string)>(stob),
-                    true);
-            } catch(const std::exception& ex){
-                throw JSONParsingException("digital_hdrs");
+    template<SchemaDepth DEPTH>
+    void ReceiveData::deserializeFields(JSONReader& reader){
+        reader.beginObject();
+        StringView label;
+        while(reader.nextField(label)){
+            if(label == StringView("roborio", 7)){ //the inputs are wrapped in a single outer object
+                deserializeFields<DEPTH>(reader);
+            } else if(!JSONSchema::deserialize<DEPTH>(reader, label, *this)){
+                reader.skipValue();
             }
         }
     }
 
-    void ReceiveData::deserializeJoysticks(std::string& input){
-        if(input.find(quote("joysticks")) != std::string::npos){
-            try{
-                joysticks = deserializeList(
-                    pullObject("\"joysticks\"", input),
-                    std::function<Joystick(std::string)>(Joystick::deserialize),
-                    true);
-            } catch(const std::exception& ex){
-                throw JSONParsingException("joysticks");
-            }
+    template<SchemaDepth DEPTH>
+    void ReceiveData::deserializeJSON(StringView input){
+        if(input == StringView(last_received_data)){
+            return;
         }
-    }
 
-    void ReceiveData::deserializeDigitalMXP(std::string& input){
-        if(input.find(quote("digital_mxp")) != std::string::npos){
-            try{
-                digital_mxp = deserializeList(
-                    pullObject("\"digital_mxp\"", input),
-                    std::function<MXPData(std::string)>(MXPData::deserialize),
-                    true);
-            } catch(const std::exception& ex){
-                throw JSONParsingException("digital_mxp");
-            }
-        }
+        JSONReader reader(input);
+        deserializeFields<DEPTH>(reader);
+
+        last_received_data.assign(input.data(), input.size());
     }
 
-    void ReceiveData::deserializeMatchInfo(std::string& input){
-        if(input.find(quote("match_info")) != std::string::npos){
-            try{
-                match_info = MatchInfo::deserialize(pullObject("\"match_info\"", input));
-            } catch(const std::exception& ex){
-                throw JSONParsingException("match_info");
-            }
-        }
+    void ReceiveData::deserializeShallow(StringView input){
+        deserializeJSON<SchemaDepth::SHALLOW>(input);
     }
 
-    void ReceiveData::deserializeRobotMode(std::string& input){
-        if(input.find(quote("robot_mode")) != std::string::npos){
-            try{
-                robot_mode = RobotMode::deserialize(pullObject("\"robot_mode\"", input));
-            } catch(const std::exception& ex){
-                throw JSONParsingException("robot_mode");
-            }
-        }
+    void ReceiveData::deserializeDeep(StringView input){
+        deserializeJSON<SchemaDepth::DEEP>(input);
     }
 
-    void ReceiveData::deserializeEncoders(std::string& input){
-        if(input.find(quote("encoders")) != std::string::npos){
-            try{
-                encoder_managers = deserializeList(
-                    pullObject("\"encoders\"", input),
-                    std::function<Maybe<EncoderManager>(std::string)>([&](std::string str){
-                                                                          if(trim(str) == "null"){
-                                                                              return Maybe<EncoderManager>();
-                                                                          }
-                                                                          Maybe<std::string> a = Maybe<std::string>(str);
-                                                                          return a.fmap(detail::liftedDeserialize);
-                                                                      }),
-                    true);
-            } catch(const std::exception& ex){
-                throw JSONParsingException("encoders");
-            }
-        }
+    const std::string& ReceiveData::defaultPacket(){
+        static const std::string DEFAULT_PACKET = [](){
+            ReceiveData defaults;
+            defaults.robot_mode.setEnabled(false); //without an engine there is no driver station, so the robot must not run
+            defaults.robot_mode.setDSAttached(false);
+
+            std::string packet;
+            JSONWriter writer(packet);
+            writer.writeRaw("{\"roborio\":{");
+            JSONSchema::serialize<SchemaDepth::DEEP>(writer, defaults);
+            writer.writeRaw("}}");
+            return packet;
+        }();
+        return DEFAULT_PACKET;
     }
 
-    void ReceiveData::deserializeShallow(std::string input){
-        if(input == last_received_data){
+    void ReceiveData::deserializeBinary(StringView packet){
+        if(packet == StringView(last_received_data)){
             return;
         }
-        last_received_data = input;
 
-        deserializeJoysticks(input);
-        deserializeMatchInfo(input);
-        deserializeRobotMode(input);
-        deserializeEncoders(input);
-    }
+        BinaryReader reader(packet.data(), packet.size());
+        BinaryHeader header = readBinaryHeader(reader);
+        if(header.version != BINARY_SCHEMA_VERSION){
+            throw BinaryParsingException("unsupported schema version " + std::to_string(header.version));
+        }
+        if(header.payload_length != reader.remaining()){
+            throw BinaryParsingException("payload length mismatch");
+        }
+        if(header.type != BinaryPacketType::SHALLOW && header.type != BinaryPacketType::DEEP){
+            throw BinaryParsingException("unexpected packet type " + std::to_string(static_cast<unsigned>(header.type)));
+        }
+        const bool DEEP = header.type == BinaryPacketType::DEEP;
 
-    void ReceiveData::deserializeDeep(std::string input){
-        if(input == last_received_data){
-            return;
+        uint16_t digital_hdrs_mask = reader.read<uint16_t>();
+        for(unsigned i = 0; i < digital_hdrs.size(); i++){
+            digital_hdrs[i] = checkBitHigh(digital_hdrs_mask, i);
+        }
+        for(Joystick& joystick: joysticks){
+            joystick = Joystick::deserializeBinary(reader);
+        }
+        if(DEEP){
+            for(MXPData& mxp: digital_mxp){
+                mxp = MXPData::deserializeBinary(reader);
+            }
         }
-        last_received_data = input;
+        match_info = MatchInfo::deserializeBinary(reader);
+        robot_mode = RobotMode::deserializeBinary(reader);
+        for(Maybe<EncoderManager>& encoder_manager: encoder_managers){
+            if(reader.readBool()){
+                encoder_manager = Maybe<EncoderManager>(EncoderManager::deserializeBinary(reader));
+            } else {
+                encoder_manager = Maybe<EncoderManager>();
+            }
+        }
+        if(reader.readBool()){
+            sim_time = Maybe<uint64_t>(reader.read<uint64_t>());
+        } else {
+            sim_time = Maybe<uint64_t>();
+        }
+
+        last_received_data = packet.toString();
+    }
+
+    ReceiveDataManager::State::State():instance(std::make_shared<ReceiveData>()), receive_data_mutex(){}
 
-        deserializeDigitalHdrs(input);
-        deserializeJoysticks(input);
-        deserializeDigitalMXP(input);
-        deserializeMatchInfo(input);
-        deserializeRobotMode(input);
-        deserializeEncoders(input);
+    std::pair<std::shared_ptr<ReceiveData>, std::unique_lock<std::recursive_mutex>> ReceiveDataManager::getInstance(){
+        State& state = RobotInstance::current().receive_data;
+        HEL_PROFILE_LOCK_WAIT();
+        std::unique_lock<std::recursive_mutex> lock(state.receive_data_mutex);
+        return std::make_pair(state.instance, std::move(lock));
     }
 }
@@ -1,4 +1,5 @@
 #include "roborio_manager.hpp"
+#include "robot_instance.hpp"
 
 using namespace nFPGA;
 using namespace nRoboRIO_FPGANamespace;
@@ -11,6 +12,10 @@ namespace hel{
 
     void RelaySystem::setValue(tRelay::tValue v)noexcept{
         value = v;
+        RoboRIOManager::publishSnapshot(RoboRIO::Subsystem::RELAY_SYSTEM);
+        auto instance = SendDataManager::getInstance();
+        instance.first->updateDeep();
+        instance.second.unlock();
     }
 
     RelaySystem::RelaySystem()noexcept:value(){}
@@ -20,7 +25,7 @@ namespace hel{
 #undef COPY
     }
 
-    RelaySystem::State RelaySystem::getState(uint8_t index)noexcept{
+    RelaySystem::State RelaySystem::getState(uint8_t index)const noexcept{
         bool forward = checkBitHigh(value.Forward, index);
         bool reverse  = checkBitHigh(value.Reverse, index);
         if(forward){
@@ -50,20 +55,39 @@ namespace hel{
         }
     }
 
+    RelaySystem::State s_to_relay_state(StringView input){
+        switch(hasher(input)){
+        case hasher("OFF"):
+            return RelaySystem::State::OFF;
+        case hasher("REVERSE"):
+            return RelaySystem::State::REVERSE;
+        case hasher("FORWARD"):
+            return RelaySystem::State::FORWARD;
+        case hasher("ERROR"):
+            return RelaySystem::State::ERROR;
+        default:
+            throw UnhandledCase();
+        }
+    }
+
 
-    struct RelayManager: public tRelay{
+    struct RelayManager: public tRelay, private InstanceBound{
         tSystemInterface* getSystemInterface(){
             return new SystemInterface();
         }
 
         void writeValue(tValue value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::RELAY_SYSTEM);
             instance.first->relay_system.setValue(value);
             instance.second.unlock();
         }
 
         void writeValue_Forward(uint8_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::RELAY_SYSTEM);
             tRelay::tValue v = instance.first->relay_system.getValue();
             v.Forward = value;
             instance.first->relay_system.setValue(v);
@@ -71,7 +95,9 @@ namespace hel{
         }
 
         void writeValue_Reverse(uint8_t value, tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::RELAY_SYSTEM);
             tRelay::tValue v = instance.first->relay_system.getValue();
             v.Reverse = value;
             instance.first->relay_system.setValue(v);
@@ -79,19 +105,25 @@ namespace hel{
         }
 
         tValue readValue(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::RELAY_SYSTEM);
             instance.second.unlock();
             return instance.first->relay_system.getValue();
         }
 
         uint8_t readValue_Forward(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::RELAY_SYSTEM);
             instance.second.unlock();
             return instance.first->relay_system.getValue().Forward;
         }
 
         uint8_t readValue_Reverse(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::RELAY_SYSTEM);
             instance.second.unlock();
             return instance.first->relay_system.getValue().Reverse;
         }
@@ -1,9 +1,11 @@
 #include "roborio.hpp"
 
 namespace hel{
-    RoboRIO::RoboRIO()noexcept:user_button(false), accelerometer(), accumulators(Accumulator()), alarm(), analog_inputs(), analog_outputs(), can_motor_controllers(), counters(Counter()), digital_system(), ds_errors(), match_info(), encoder_managers(Maybe<EncoderManager>()), fpga_encoders(FPGAEncoder()), global(), joysticks(Joystick()), net_comm(), power(), pwm_system(), relay_system(), robot_mode(), pcm(), pdp(), spi_system(), watchdog(){}
+    static_assert(FPGAEncoder::NUM_ENCODERS <= EncoderSourceIndex::MAX_DEVICES && Counter::MAX_COUNTER_COUNT <= EncoderSourceIndex::MAX_DEVICES, "Encoder source indexes must hold every FPGA encoder and counter");
 
-    RoboRIO::RoboRIO(const RoboRIO& source)noexcept:RoboRIO(){
+    RoboRIO::RoboRIO(uint64_t fpga_start_time)noexcept:user_button(false), accelerometer(), accumulators(Accumulator()), alarm(), analog_inputs(), analog_outputs(), can_motor_controllers(), counters(Counter()), counter_sources(), digital_system(), ds_errors(), match_info(), encoder_managers(Maybe<EncoderManager>()), fpga_encoders(FPGAEncoder()), fpga_encoder_sources(), global(fpga_start_time), joysticks(Joystick()), net_comm(), power(), pwm_system(), relay_system(), robot_mode(), pcm(), pdp(), spi_system(), watchdog(){}
+
+    RoboRIO::RoboRIO(const RoboRIO& source)noexcept:RoboRIO(source.global.getFPGAStartTime()){
 #define COPY(NAME) NAME = source.NAME
         COPY(user_button);
         COPY(accelerometer);
@@ -13,11 +15,13 @@ namespace hel{
         COPY(analog_outputs);
         COPY(can_motor_controllers);
         COPY(counters);
+        COPY(counter_sources);
         COPY(digital_system);
         COPY(ds_errors);
         COPY(match_info);
         COPY(encoder_managers);
         COPY(fpga_encoders);
+        COPY(fpga_encoder_sources);
         COPY(global);
         COPY(joysticks);
         COPY(net_comm);
@@ -42,11 +46,13 @@ namespace hel{
             COPY(analog_outputs);
             COPY(can_motor_controllers);
             COPY(counters);
+            COPY(counter_sources);
             COPY(digital_system);
             COPY(ds_errors);
             COPY(match_info);
             COPY(encoder_managers);
             COPY(fpga_encoders);
+            COPY(fpga_encoder_sources);
             COPY(global);
             COPY(joysticks);
             COPY(net_comm);
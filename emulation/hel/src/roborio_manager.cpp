@@ -1,13 +1,113 @@
 #include "roborio_manager.hpp"
 #include "roborio.hpp"
+#include "robot_instance.hpp"
+#include "util.hpp"
 
 namespace hel{
-    std::pair<std::shared_ptr<RoboRIO>, std::unique_lock<std::recursive_mutex>> RoboRIOManager::getInstance() {
-        std::unique_lock<std::recursive_mutex> lock(roborio_mutex);
-        if (instance == nullptr) {
-            instance = std::make_shared<RoboRIO>();
+    namespace detail{
+        constexpr uint32_t subsystemMask(RoboRIO::Subsystem subsystem){
+            return 1u << static_cast<unsigned>(subsystem);
+        }
+
+        constexpr uint32_t ALL_SUBSYSTEMS = (1u << RoboRIO::NUM_SUBSYSTEMS) - 1;
+
+        constexpr uint32_t OUTPUT_SUBSYSTEMS =
+            subsystemMask(RoboRIO::Subsystem::ANALOG_OUTPUTS) |
+            subsystemMask(RoboRIO::Subsystem::CAN_MOTOR_CONTROLLERS) |
+            subsystemMask(RoboRIO::Subsystem::DIGITAL_SYSTEM) |
+            subsystemMask(RoboRIO::Subsystem::PWM_SYSTEM) |
+            subsystemMask(RoboRIO::Subsystem::RELAY_SYSTEM);
+
+        template<typename T>
+        void publish(TripleBuffer<T>& buffers, const T& value){
+            buffers.getBack() = value;
+            buffers.publish();
+        }
+
+        void publish(RoboRIOManager::State& state, const RoboRIO& roborio, RoboRIO::Subsystem subsystem){
+            switch(subsystem){
+            case RoboRIO::Subsystem::PWM_SYSTEM:
+                publish(state.pwm_snapshots, roborio.pwm_system);
+                break;
+            case RoboRIO::Subsystem::DIGITAL_SYSTEM:
+                publish(state.digital_snapshots, roborio.digital_system);
+                break;
+            case RoboRIO::Subsystem::RELAY_SYSTEM:
+                publish(state.relay_snapshots, roborio.relay_system);
+                break;
+            case RoboRIO::Subsystem::ANALOG_OUTPUTS:
+                publish(state.analog_output_snapshots, roborio.analog_outputs);
+                break;
+            case RoboRIO::Subsystem::CAN_MOTOR_CONTROLLERS:
+                publish(state.can_motor_controller_snapshots, roborio.can_motor_controllers);
+                break;
+            default:
+                return; //not transmitted to the engine
+            }
+            state.snapshot_version.fetch_add(1, std::memory_order_release);
         }
-        return std::make_pair(instance, std::move(lock));
+    }
+
+    bool RoboRIOManager::Lock::ownsLock()const noexcept{
+        return held;
+    }
+
+    void RoboRIOManager::Lock::lock(){
+        if(held){
+            return;
+        }
+        HEL_PROFILE_LOCK_WAIT();
+        for(unsigned i = 0; i < RoboRIO::NUM_SUBSYSTEMS; i++){ //always lock in declaration order to prevent deadlocks between sub-systems
+            if(checkBitHigh(subsystems, i)){
+                (*mutexes)[i].lock();
+            }
+        }
+        held = true;
+    }
+
+    void RoboRIOManager::Lock::unlock()noexcept{
+        if(!held){
+            return;
+        }
+        for(unsigned i = RoboRIO::NUM_SUBSYSTEMS; i-- > 0;){
+            if(checkBitHigh(subsystems, i)){
+                (*mutexes)[i].unlock();
+            }
+        }
+        held = false;
+    }
+
+    RoboRIOManager::Lock::Lock(std::array<std::recursive_mutex, RoboRIO::NUM_SUBSYSTEMS>& mutexes, uint32_t mask):mutexes(&mutexes), subsystems(mask), held(false){
+        lock();
+    }
+
+    RoboRIOManager::Lock::Lock(Lock&& source)noexcept:mutexes(source.mutexes), subsystems(source.subsystems), held(source.held){
+        source.held = false;
+    }
+
+    RoboRIOManager::Lock::~Lock(){
+        unlock();
+    }
+
+    std::pair<std::shared_ptr<RoboRIO>, RoboRIOManager::Lock> RoboRIOManager::getInstance(uint32_t mask){
+        State& state = RobotInstance::current().roborio;
+        return std::make_pair(state.instance, Lock(state.subsystem_mutexes, mask));
+    }
+
+    std::pair<std::shared_ptr<RoboRIO>, RoboRIOManager::Lock> RoboRIOManager::getInstance(){
+        return getInstance(detail::ALL_SUBSYSTEMS);
+    }
+
+    std::pair<std::shared_ptr<RoboRIO>, RoboRIOManager::Lock> RoboRIOManager::getInstance(RoboRIO::Subsystem subsystem){
+        return getInstance(detail::subsystemMask(subsystem));
+    }
+
+    std::pair<std::shared_ptr<RoboRIO>, RoboRIOManager::Lock> RoboRIOManager::getInstance(std::initializer_list<RoboRIO::Subsystem> subsystems){
+        uint32_t mask = 0;
+        for(RoboRIO::Subsystem subsystem: subsystems){
+            mask |= detail::subsystemMask(subsystem);
+        }
+        return getInstance(mask);
     }
 
     RoboRIO RoboRIOManager::getCopy() {
@@ -16,4 +116,39 @@ namespace hel{
         instance.second.unlock();
         return roborio_copy;
     }
+
+    void RoboRIOManager::publishSnapshot(){
+        State& state = RobotInstance::current().roborio;
+        auto instance = RoboRIOManager::getInstance(detail::OUTPUT_SUBSYSTEMS);
+        for(unsigned i = 0; i < RoboRIO::NUM_SUBSYSTEMS; i++){
+            if(checkBitHigh(detail::OUTPUT_SUBSYSTEMS, i)){
+                detail::publish(state, *instance.first, static_cast<RoboRIO::Subsystem>(i));
+            }
+        }
+    }
+
+    void RoboRIOManager::publishSnapshot(RoboRIO::Subsystem subsystem){
+        State& state = RobotInstance::current().roborio;
+        auto instance = RoboRIOManager::getInstance(subsystem);
+        detail::publish(state, *instance.first, subsystem);
+    }
+
+    RoboRIOSnapshot RoboRIOManager::getSnapshot(){
+        State& state = RobotInstance::current().roborio;
+        const uint64_t VERSION = state.snapshot_version.load(std::memory_order_acquire); //read before the buffers, so a concurrent publish is seen again by the next update
+        return RoboRIOSnapshot{
+            VERSION,
+            state.pwm_snapshots.read(),
+            state.digital_snapshots.read(),
+            state.relay_snapshots.read(),
+            state.analog_output_snapshots.read(),
+            state.can_motor_controller_snapshots.read()
+        };
+    }
+
+    uint64_t RoboRIOManager::getSnapshotVersion()noexcept{
+        return RobotInstance::current().roborio.snapshot_version.load(std::memory_order_acquire);
+    }
+
+    RoboRIOManager::State::State(uint64_t fpga_start_time):instance(std::make_shared<RoboRIO>(fpga_start_time)), subsystem_mutexes(), pwm_snapshots(), digital_snapshots(), relay_snapshots(), analog_output_snapshots(), can_motor_controller_snapshots(), snapshot_version(0){}
 }
@@ -0,0 +1,98 @@
+#include "robot_instance.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace hel{
+    constexpr unsigned RobotInstance::DEFAULT_ID;
+    constexpr uint16_t RobotInstance::DEFAULT_RECEIVE_PORT;
+    constexpr uint16_t RobotInstance::DEFAULT_SEND_PORT;
+
+    std::mutex RobotInstance::registry_mutex;
+    std::vector<uint16_t> RobotInstance::used_ports;
+    std::atomic<unsigned> RobotInstance::next_id{DEFAULT_ID + 1};
+    thread_local RobotInstance* RobotInstance::bound = nullptr;
+
+    RobotInstance::Binding::Binding(RobotInstance& robot)noexcept:previous(bound){
+        bound = &robot;
+    }
+
+    RobotInstance::Binding::~Binding(){
+        bound = previous;
+    }
+
+    void RobotInstance::reservePort(uint16_t port){
+        if(std::find(used_ports.begin(), used_ports.end(), port) != used_ports.end()){
+            throw std::invalid_argument("Synthesis exception: port " + std::to_string(port) + " is already used by another robot instance");
+        }
+        used_ports.push_back(port);
+    }
+
+    std::shared_ptr<RobotInstance> RobotInstance::create(uint16_t receive_port, uint16_t send_port){
+        return create(next_id++, receive_port, send_port);
+    }
+
+    std::shared_ptr<RobotInstance> RobotInstance::create(unsigned id, uint16_t receive_port, uint16_t send_port){
+        if(receive_port == send_port){
+            throw std::invalid_argument("Synthesis exception: robot instance cannot send and receive on the same port " + std::to_string(receive_port));
+        }
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        reservePort(receive_port);
+        try{
+            reservePort(send_port);
+        } catch(const std::exception&){
+            used_ports.pop_back();
+            throw;
+        }
+        return std::shared_ptr<RobotInstance>(new RobotInstance(id, receive_port, send_port));
+    }
+
+    std::shared_ptr<RobotInstance> RobotInstance::getDefault(){
+        static const std::shared_ptr<RobotInstance>* default_instance = new std::shared_ptr<RobotInstance>(create(DEFAULT_ID, DEFAULT_RECEIVE_PORT, DEFAULT_SEND_PORT)); //never destroyed, since detached threads may use it during exit
+        return *default_instance;
+    }
+
+    std::shared_ptr<RobotInstance> RobotInstance::getCurrent(){
+        return bound != nullptr ? bound->shared_from_this() : getDefault();
+    }
+
+    RobotInstance& RobotInstance::current()noexcept{
+        if(bound != nullptr){
+            return *bound;
+        }
+        static RobotInstance& default_instance = *getDefault();
+        return default_instance;
+    }
+
+    unsigned RobotInstance::getID()const noexcept{
+        return id;
+    }
+
+    uint16_t RobotInstance::getReceivePort()const noexcept{
+        return receive_port;
+    }
+
+    uint16_t RobotInstance::getSendPort()const noexcept{
+        return send_port;
+    }
+
+    InterruptSystem& RobotInstance::getInterruptSystem()noexcept{
+        return interrupt_system;
+    }
+
+    AlarmScheduler& RobotInstance::getAlarmScheduler()noexcept{
+        return alarm_scheduler;
+    }
+
+    RobotInstance::RobotInstance(unsigned id, uint16_t receive_port, uint16_t send_port):id(id), receive_port(receive_port), send_port(send_port), sim_clock(), roborio(SimClock::now(sim_clock)), send_data(), receive_data(), interrupt_system(), alarm_scheduler(*this){}
+
+    RobotInstance::~RobotInstance(){
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        for(uint16_t port: {receive_port, send_port}){
+            used_ports.erase(std::find(used_ports.begin(), used_ports.end(), port));
+        }
+    }
+
+    InstanceBound::InstanceBound():robot(RobotInstance::getCurrent()){}
+}
@@ -1,5 +1,6 @@
 #include "robot_mode.hpp"
 
+#include "binary_util.hpp"
 #include "error.hpp"
 #include "json_util.hpp"
 #include "send_data.hpp"
@@ -75,8 +76,8 @@ namespace hel{
         }
     }
 
-    RobotMode::Mode s_to_robot_mode(std::string s){
-        switch(hasher(s.c_str())){
+    RobotMode::Mode s_to_robot_mode(StringView s){
+        switch(hasher(s)){
         case hasher("AUTONOMOUS"):
             return RobotMode::Mode::AUTONOMOUS;
         case hasher("TELEOPERATED"):
@@ -89,26 +90,85 @@ namespace hel{
     }
 
     RobotMode RobotMode::deserialize(std::string input){
+        JSONReader reader(input);
+        return deserialize(reader);
+    }
+
+    RobotMode RobotMode::deserialize(JSONReader& reader){
+        RobotMode a;
+        reader.beginObject();
+        StringView label;
+        while(reader.nextField(label)){
+            switch(hasher(label)){
+            case hasher("mode"):
+                a.mode = s_to_robot_mode(reader.readString());
+                break;
+            case hasher("enabled"):
+                a.enabled = reader.readBool();
+                break;
+            case hasher("emergency_stopped"):
+                a.emergency_stopped = reader.readBool();
+                break;
+            case hasher("fms_attached"):
+                a.fms_attached = reader.readBool();
+                break;
+            case hasher("ds_attached"):
+                a.ds_attached = reader.readBool();
+                break;
+            default:
+                reader.skipValue();
+            }
+        }
+        return a;
+    }
+
+    RobotMode RobotMode::deserializeBinary(BinaryReader& reader){
         RobotMode a;
-        a.mode = s_to_robot_mode(unquote(pullObject("\"mode\"",input)));
-        a.enabled = stob(pullObject("\"enabled\"",input));
-        a.emergency_stopped = stob(pullObject("\"emergency_stopped\"",input));
-        a.fms_attached = stob(pullObject("\"fms_attached\"",input));
-        a.ds_attached = stob(pullObject("\"ds_attached\"",input));
+        a.mode = static_cast<RobotMode::Mode>(reader.read<uint8_t>());
+        if(a.mode > RobotMode::Mode::TEST){
+            throw BinaryParsingException("invalid robot mode");
+        }
+        a.enabled = reader.readBool();
+        a.emergency_stopped = reader.readBool();
+        a.fms_attached = reader.readBool();
+        a.ds_attached = reader.readBool();
         return a;
     }
 
+    void RobotMode::serializeBinary(BinaryWriter& writer)const{
+        writer.write(static_cast<uint8_t>(mode));
+        writer.write(enabled);
+        writer.write(emergency_stopped);
+        writer.write(fms_attached);
+        writer.write(ds_attached);
+    }
+
     std::string RobotMode::serialize()const{
-        std::string s = "{";
-        s += "\"mode\":" + quote(asString(mode)) + ", ";
-        s += "\"enabled\":" + asString(enabled) + ", ";
-        s += "\"emergency_stopped\":" + asString(emergency_stopped) + ", ";
-        s += "\"fms_attached\":" + asString(fms_attached) + ", ";
-        s += "\"ds_attached\":" + asString(ds_attached);
-        s += "}";
+        std::string s;
+        JSONWriter writer(s);
+        serialize(writer);
         return s;
     }
 
+    void RobotMode::serialize(JSONWriter& writer)const{
+        writer.writeRaw('{');
+        writer.writeLabel("mode");
+        writer.writeString(asString(mode));
+        writer.writeRaw(", ");
+        writer.writeLabel("enabled");
+        writer.write(enabled);
+        writer.writeRaw(", ");
+        writer.writeLabel("emergency_stopped");
+        writer.write(emergency_stopped);
+        writer.writeRaw(", ");
+        writer.writeLabel("fms_attached");
+        writer.write(fms_attached);
+        writer.writeRaw(", ");
+        writer.writeLabel("ds_attached");
+        writer.write(ds_attached);
+        writer.writeRaw('}');
+    }
+
     std::string RobotMode::toString()const{
         std::string s = "(";
         s += "mode:" + asString(mode) + ", ";
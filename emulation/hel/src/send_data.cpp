@@ -1,4 +1,5 @@
 #include "roborio_manager.hpp"
+#include "robot_instance.hpp"
 #include "util.hpp"
 #include "json_util.hpp"
 
@@ -6,9 +7,11 @@ using namespace nFPGA;
 using namespace nRoboRIO_FPGANamespace;
 
 namespace hel{
-    constexpr char ZEROED_SERIALIZATION_DATA[] = "{\"roborio\":{\"pwm_hdrs\":[0.000000,0.000000,0.000000,0.000000,0.000000,0.000000,0.000000,0.000000,0.000000,0.000000],\"relays\":[\"OFF\",\"OFF\",\"OFF\",\"OFF\"],\"analog_outputs\":[0.000000,0.000000],\"digital_mxp\":[{\"config\":\"DI\", \"value\":0.000000},{\"config\":\"DI\", \"value\":0.000000},{\"config\":\"DI\", \"value\":0.000000},{\"config\":\"DI\", \"value\":0.000000},{\"config\":\"DI\", \"value\":0.000000},{\"config\":\"DI\", \"value\":0.000000},{\"config\":\"DI\", \"value\":0.000000},{\"config\":\"DI\", \"value\":0.000000},{\"config\":\"DI\", \"value\":0.000000},{\"config\":\"DI\", \"value\":0.000000},{\"config\":\"DI\", \"value\":0.000000},{\"config\":\"DI\", \"value\":0.000000},{\"config\":\"DI\", \"value\":0.000000},{\"config\":\"DI\", \"value\":0.000000},{\"config\":\"DI\", \"value\":0.000000},{\"config\":\"DI\", \"value\":0.000000}],\"digital_hdrs\":[0,0,0,0,0,0,0,0,0,0],\"can_motor_controllers\":[]}}\x1B"; //TODO replace with shallow and deep versions
+    constexpr std::size_t INITIAL_SERIALIZED_CAPACITY = 4096; //enough for a deep packet with a full drivetrain of CAN motor controllers, so the buffer rarely grows
 
-    SendData::SendData():serialized_data(""),new_data(true),enabled(false),pwm_hdrs(0.0), relays(RelaySystem::State::OFF), analog_outputs(0.0), digital_mxp({}), digital_hdrs(false), can_motor_controllers({}){}
+    SendData::SendData():serialized_data(""),serialized_format(WireFormat::JSON),new_data(true),enabled(false),pwm_hdrs(0.0), relays(RelaySystem::State::OFF), analog_outputs(0.0), digital_mxp({}), digital_hdrs(false), can_motor_controllers(), dirty_pwm_hdrs(0), dirty_relays(0), dirty_analog_outputs(0), dirty_digital_mxp(0), dirty_digital_hdrs(false), dirty_can_motor_controllers(), sequence(0), deltas_since_keyframe(0), keyframe_requested(true), snapshot_version(0){
+        serialized_data.reserve(INITIAL_SERIALIZED_CAPACITY);
+    }
 
 
     bool SendData::hasNewData()const{
@@ -20,18 +23,74 @@ namespace hel{
             return;
         }
 
-        RoboRIO roborio = RoboRIOManager::getCopy();
+        const RoboRIOSnapshot& roborio = RoboRIOManager::getSnapshot();
+
+        if(roborio.version == snapshot_version){ //nothing has been published since the last update
+            return;
+        }
+        snapshot_version = roborio.version;
 
         for(unsigned i = 0; i < pwm_hdrs.size(); i++){
-            pwm_hdrs[i] = PWMSystem::getPercentOutput(roborio.pwm_system.getHdrPulseWidth(i));
+            double pwm_hdr = PWMSystem::getPercentOutput(roborio.pwm_system.getHdrPulseWidth(i));
+            if(pwm_hdr != pwm_hdrs[i]){
+                pwm_hdrs[i] = pwm_hdr;
+                dirty_pwm_hdrs = setBit(dirty_pwm_hdrs, true, i);
+            }
+        }
+
+        updateCANMotorControllers(roborio.can_motor_controllers);
+        if(dirty_pwm_hdrs != 0 || !dirty_can_motor_controllers.empty()){
+            new_data = true;
+            SendDataManager::notifyNewData();
+        }
+    }
+
+    void SendData::updateCANMotorControllers(const CANMotorControllerTable& source){
+        const CANMotorControllerTable::SlotMask& OCCUPIED = source.occupancy();
+        for(unsigned slot = OCCUPIED.next(0); slot < CANMotorControllerTable::CAPACITY; slot = OCCUPIED.next(slot + 1)){
+            const CANMotorController& a = source.at(slot);
+            const CANMotorController* existing = can_motor_controllers.find(a.getType(), a.getID());
+            if(
+                existing == nullptr ||
+                existing->getPercentOutput() != a.getPercentOutput() ||
+                existing->getInverted() != a.getInverted()
+            ){
+                can_motor_controllers.emplace(a.getType(), a.getID()) = a; //only changed slots are copied
+                dirty_can_motor_controllers.set(slot);
+            }
+        }
+    }
+
+    void SendData::updateDeep(){
+        if(!hal_is_initialized){
+            return;
         }
 
+        updateShallow();
+
+        const RoboRIOSnapshot& roborio = RoboRIOManager::getSnapshot();
+
+        for(unsigned i = 0; i < relays.size(); i++){
+            RelaySystem::State relay = roborio.relay_system.getState(i);
+            if(relay != relays[i]){
+                relays[i] = relay;
+                dirty_relays = setBit(dirty_relays, true, i);
+            }
+        }
+        for(unsigned i = 0; i < analog_outputs.size(); i++){
+            double analog_output = (roborio.analog_outputs.getMXPOutput(i)) * 5.0 / 0x1000;
+            if(analog_output != analog_outputs[i]){
+                analog_outputs[i] = analog_output;
+                dirty_analog_outputs = setBit(dirty_analog_outputs, true, i);
+            }
+        }
         for(unsigned i = 0; i < digital_mxp.size(); i++){
-            digital_mxp[i].config = DigitalSystem::toMXPConfig(roborio.digital_system.getEnabledOutputs().MXP, roborio.digital_system.getMXPSpecialFunctionsEnabled(), i);
+            MXPData mxp = digital_mxp[i];
+            mxp.config = DigitalSystem::toMXPConfig(roborio.digital_system.getEnabledOutputs().MXP, roborio.digital_system.getMXPSpecialFunctionsEnabled(), i);
 
-            switch(digital_mxp[i].config){
+            switch(mxp.config){
             case MXPData::Config::DO:
-                digital_mxp[i].value = (checkBitHigh(roborio.digital_system.getOutputs().MXP, i) | checkBitHigh(roborio.digital_system.getPulses().MXP, i));
+                mxp.value = (checkBitHigh(roborio.digital_system.getOutputs().MXP, i) | checkBitHigh(roborio.digital_system.getPulses().MXP, i));
                 break;
             case MXPData::Config::PWM:
             {
@@ -39,7 +98,7 @@ namespace hel{
                 if(remapped_i >= 4){ //digital ports 0-3 line up with mxp pwm ports 0-3, the rest are offset by 4
                     remapped_i -= 4;
                 }
-                digital_mxp[i].value = PWMSystem::getPercentOutput(roborio.pwm_system.getMXPPulseWidth(remapped_i));
+                mxp.value = PWMSystem::getPercentOutput(roborio.pwm_system.getMXPPulseWidth(remapped_i));
                 break;
             }
             case MXPData::Config::SPI:
@@ -47,25 +106,10 @@ namespace hel{
             default:
                 break; //do nothing
             }
-        }
-        can_motor_controllers = roborio.can_motor_controllers;
-        new_data = true;
-    }
-
-    void SendData::updateDeep(){
-        if(!hal_is_initialized){
-            return;
-        }
-
-        updateShallow();
-
-        RoboRIO roborio = RoboRIOManager::getCopy();
-
-        for(unsigned i = 0; i < relays.size(); i++){
-            relays[i] = roborio.relay_system.getState(i);
-        }
-        for(unsigned i = 0; i < analog_outputs.size(); i++){
-            analog_outputs[i] = (roborio.analog_outputs.getMXPOutput(i)) * 5.0 / 0x1000;
+            if(mxp.config != digital_mxp[i].config || mxp.value != digital_mxp[i].value){
+                digital_mxp[i] = mxp;
+                dirty_digital_mxp = setBit(dirty_digital_mxp, true, i);
+            }
         }
         {
             tDIO::tOutputEnable output_mode = roborio.digital_system.getEnabledOutputs();
@@ -73,12 +117,19 @@ namespace hel{
             auto pulses = roborio.digital_system.getPulses().Headers;
             for(unsigned i = 0; i < digital_hdrs.size(); i++){
                 if(checkBitHigh(output_mode.Headers, i)){ //if digital port is set for output, then set digital output
-                    digital_hdrs[i] = (checkBitHigh(values, i) | checkBitHigh(pulses, i));
+                    bool digital_hdr = (checkBitHigh(values, i) | checkBitHigh(pulses, i));
+                    if(digital_hdr != digital_hdrs[i]){
+                        digital_hdrs[i] = digital_hdr;
+                        dirty_digital_hdrs = true;
+                    }
                 }
             }
         }
-        can_motor_controllers = roborio.can_motor_controllers;
-        new_data = true;
+        updateCANMotorControllers(roborio.can_motor_controllers);
+        if(dirty_relays != 0 || dirty_analog_outputs != 0 || dirty_digital_mxp != 0 || dirty_digital_hdrs || !dirty_can_motor_controllers.empty()){
+            new_data = true;
+            SendDataManager::notifyNewData();
+        }
     }
 
     std::string SendData::toString()const{
@@ -88,106 +139,371 @@ namespace hel{
         s += "analog_outputs:" + asString(analog_outputs, std::function<std::string(double)>(static_cast<std::string(*)(double)>(std::to_string))) + ", ";
         s += "digital_mxp:" + asString(digital_mxp, std::function<std::string(MXPData)>(&MXPData::toString)) + ", ";
         s += "digital_hdrs:" + asString(digital_hdrs, std::function<std::string(bool)>(static_cast<std::string(*)(bool)>(asString))) + ", ";
-        s += "can_motor_controllers:" + asString(can_motor_controllers, std::function<std::string(std::pair<uint32_t,CANMotorController>)>([&](std::pair<uint32_t, CANMotorController> a){ return "[" + std::to_string(a.first) + ", " + a.second.toString() + "]";}));
+        s += "can_motor_controllers:" + can_motor_controllers.toString();
         s += ")";
         return s;
     }
 
-    void SendData::serializePWMHdrs(){
-        serialized_data += serializeList("\"pwm_hdrs\"", pwm_hdrs, std::function<std::string(double)>(static_cast<std::string(*)(double)>(std::to_string)));
+    template<SchemaDepth DEPTH>
+    void SendData::serializeJSON(JSONWriter& writer)const{
+        writer.writeRaw("{\"roborio\":{");
+        JSONSchema::serialize<DEPTH>(writer, *this);
+        writer.writeRaw("}}");
+        writer.writeRaw(JSON_PACKET_SUFFIX);
     }
 
-    void SendData::serializeRelays(){
-        serialized_data += serializeList(
-            "\"relays\"",
-            relays,
-            std::function<std::string(RelaySystem::State)>([&](RelaySystem::State r){
-                                                               return quote(asString(r));
-                                                           })
-            );
-    }
+    template<SchemaDepth DEPTH>
+    const std::string& SendData::serializeJSON(){
+        if(!new_data && serialized_format == WireFormat::JSON){
+            return serialized_data;
+        }
+        new_data = false;
+        serialized_format = WireFormat::JSON;
+        serialized_data.clear(); //keeps the buffer's capacity, so steady state serialization does not allocate
 
-    void SendData::serializeAnalogOutputs(){
-        serialized_data += serializeList("\"analog_outputs\"", analog_outputs, std::function<std::string(double)>(static_cast<std::string(*)(double)>(std::to_string)));
+        JSONWriter writer(serialized_data);
+        if(!enabled){
+            static const SendData ZEROED_SEND_DATA;
+            ZEROED_SEND_DATA.serializeJSON<DEPTH>(writer);
+            return serialized_data;
+        }
+        serializeJSON<DEPTH>(writer);
+        return serialized_data;
     }
 
-    void SendData::serializeDigitalMXP(){
-        serialized_data += serializeList(
-            "\"digital_mxp\"",
-            digital_mxp,
-            std::function<std::string(MXPData)>(&MXPData::serialize)
-            );
+    const std::string& SendData::serializeShallow(){
+        return serializeJSON<SchemaDepth::SHALLOW>();
     }
 
-    void SendData::serializeDigitalHdrs(){
-        serialized_data += serializeList(
-            "\"digital_hdrs\"",
-            digital_hdrs,
-            std::function<std::string(bool)>(static_cast<std::string(*)(bool)>(asString))
-            );
+    const std::string& SendData::serializeDeep(){
+        return serializeJSON<SchemaDepth::DEEP>();
     }
 
-    void SendData::serializeCANMotorControllers(){
-        serialized_data += serializeList(
-            "\"can_motor_controllers\"",
-            can_motor_controllers,
-            std::function<std::string(std::pair<uint32_t,CANMotorController>)>([&](std::pair<uint32_t, CANMotorController> a){
-                                                                                   return a.second.serialize();
-                                                                               })
-            );
+    void SendData::serializeBinary(BinaryWriter& writer, BinaryPacketType type)const{
+        std::size_t header_position = writer.beginPacket(type);
+        for(double pwm_hdr: pwm_hdrs){
+            writer.write(static_cast<float>(pwm_hdr));
+        }
+        if(type == BinaryPacketType::DEEP){
+            for(RelaySystem::State relay: relays){
+                writer.write(static_cast<uint8_t>(relay));
+            }
+            for(double analog_output: analog_outputs){
+                writer.write(static_cast<float>(analog_output));
+            }
+            for(const MXPData& mxp: digital_mxp){
+                mxp.serializeBinary(writer);
+            }
+            uint16_t digital_hdrs_mask = 0;
+            for(unsigned i = 0; i < digital_hdrs.size(); i++){
+                digital_hdrs_mask = setBit(digital_hdrs_mask, digital_hdrs[i], i);
+            }
+            writer.write(digital_hdrs_mask);
+        }
+        can_motor_controllers.serializeBinary(writer);
+        writer.endPacket(header_position);
     }
 
-    std::string SendData::serializeShallow(){
-        if(!new_data){
+    const std::string& SendData::serializeBinary(BinaryPacketType type){
+        if(!new_data && serialized_format == WireFormat::BINARY){
             return serialized_data;
         }
         new_data = false;
+        serialized_format = WireFormat::BINARY;
+        serialized_data.clear();
+
+        BinaryWriter writer(serialized_data);
         if(!enabled){
-            serialized_data = std::string(ZEROED_SERIALIZATION_DATA);
+            static const SendData ZEROED_SEND_DATA;
+            ZEROED_SEND_DATA.serializeBinary(writer, type);
             return serialized_data;
         }
-
-        serialized_data = "{\"roborio\":{";
-        serializePWMHdrs();
-        serialized_data += ",";
-        serializeCANMotorControllers();
-        serialized_data += "}}";
-        serialized_data += JSON_PACKET_SUFFIX;
+        serializeBinary(writer, type);
         return serialized_data;
     }
 
-    std::string SendData::serializeDeep(){
-        if(!new_data){
-            return serialized_data;
+    const std::string& SendData::serializeShallowBinary(){
+        return serializeBinary(BinaryPacketType::SHALLOW);
+    }
+
+    const std::string& SendData::serializeDeepBinary(){
+        return serializeBinary(BinaryPacketType::DEEP);
+    }
+
+    void SendData::serializeDelta(BinaryWriter& writer, uint32_t seq, bool deep, bool keyframe)const{
+        uint8_t sections = 0;
+        if(keyframe){
+            sections = KEYFRAME | PWM_HDRS | CAN_MOTOR_CONTROLLERS;
+            if(deep){
+                sections |= RELAYS | ANALOG_OUTPUTS | DIGITAL_MXP | DIGITAL_HDRS;
+            }
+        } else {
+            sections |= dirty_pwm_hdrs != 0 ? PWM_HDRS : 0;
+            sections |= !dirty_can_motor_controllers.empty() ? CAN_MOTOR_CONTROLLERS : 0;
+            if(deep){
+                sections |= dirty_relays != 0 ? RELAYS : 0;
+                sections |= dirty_analog_outputs != 0 ? ANALOG_OUTPUTS : 0;
+                sections |= dirty_digital_mxp != 0 ? DIGITAL_MXP : 0;
+                sections |= dirty_digital_hdrs ? DIGITAL_HDRS : 0;
+            }
         }
-        new_data = false;
-        if(!enabled){
-            serialized_data = std::string(ZEROED_SERIALIZATION_DATA);
+
+        std::size_t header_position = writer.beginPacket(BinaryPacketType::DELTA);
+        writer.write(seq);
+        writer.write(sections);
+        if(sections & PWM_HDRS){
+            const uint16_t MASK = keyframe ? (1u << pwm_hdrs.size()) - 1 : dirty_pwm_hdrs;
+            writer.write(MASK);
+            for(unsigned i = 0; i < pwm_hdrs.size(); i++){
+                if(checkBitHigh(MASK, i)){
+                    writer.write(static_cast<float>(pwm_hdrs[i]));
+                }
+            }
+        }
+        if(sections & RELAYS){
+            const uint8_t MASK = keyframe ? (1u << relays.size()) - 1 : dirty_relays;
+            writer.write(MASK);
+            for(unsigned i = 0; i < relays.size(); i++){
+                if(checkBitHigh(MASK, i)){
+                    writer.write(static_cast<uint8_t>(relays[i]));
+                }
+            }
+        }
+        if(sections & ANALOG_OUTPUTS){
+            const uint8_t MASK = keyframe ? (1u << analog_outputs.size()) - 1 : dirty_analog_outputs;
+            writer.write(MASK);
+            for(unsigned i = 0; i < analog_outputs.size(); i++){
+                if(checkBitHigh(MASK, i)){
+                    writer.write(static_cast<float>(analog_outputs[i]));
+                }
+            }
+        }
+        if(sections & DIGITAL_MXP){
+            const uint16_t MASK = keyframe ? (1u << digital_mxp.size()) - 1 : dirty_digital_mxp;
+            writer.write(MASK);
+            for(unsigned i = 0; i < digital_mxp.size(); i++){
+                if(checkBitHigh(MASK, i)){
+                    digital_mxp[i].serializeBinary(writer);
+                }
+            }
+        }
+        if(sections & DIGITAL_HDRS){
+            uint16_t digital_hdrs_mask = 0;
+            for(unsigned i = 0; i < digital_hdrs.size(); i++){
+                digital_hdrs_mask = setBit(digital_hdrs_mask, digital_hdrs[i], i);
+            }
+            writer.write(digital_hdrs_mask);
+        }
+        if(sections & CAN_MOTOR_CONTROLLERS){
+            can_motor_controllers.serializeBinary(writer, keyframe ? can_motor_controllers.occupancy() : dirty_can_motor_controllers);
+        }
+        writer.endPacket(header_position);
+    }
+
+    const std::string& SendData::serializeDelta(bool deep){
+        if(!new_data && serialized_format == WireFormat::BINARY){
             return serialized_data;
         }
+        new_data = false;
+        serialized_format = WireFormat::BINARY;
+        serialized_data.clear();
 
-        serialized_data = "{\"roborio\":{";
-        serializePWMHdrs();
-        serialized_data += ",";
-        serializeRelays();
-        serialized_data += ",";
-        serializeAnalogOutputs();
-        serialized_data += ",";
-        serializeDigitalMXP();
-        serialized_data += ",";
-        serializeDigitalHdrs();
-        serialized_data += ",";
-        serializeCANMotorControllers();
-        serialized_data += "}}";
-        serialized_data += JSON_PACKET_SUFFIX;
+        const bool KEYFRAME = isKeyframeDue();
+        BinaryWriter writer(serialized_data);
+        if(enabled){
+            serializeDelta(writer, sequence, deep, KEYFRAME);
+        } else {
+            static const SendData ZEROED_SEND_DATA;
+            ZEROED_SEND_DATA.serializeDelta(writer, sequence, deep, true);
+        }
+        sequence++;
+        deltas_since_keyframe = KEYFRAME ? 0 : deltas_since_keyframe + 1;
+        keyframe_requested = false;
+        clearDirty(deep);
         return serialized_data;
     }
 
+    bool SendData::isKeyframeDue()const noexcept{
+        return keyframe_requested || deltas_since_keyframe + 1 >= KEYFRAME_INTERVAL || !enabled;
+    }
+
+    bool SendData::hasDeepChanges()const noexcept{
+        return dirty_relays != 0 || dirty_analog_outputs != 0 || dirty_digital_mxp != 0 || dirty_digital_hdrs;
+    }
+
+    void SendData::clearDirty(bool deep)noexcept{
+        dirty_pwm_hdrs = 0;
+        dirty_can_motor_controllers.clear();
+        if(deep){ //a shallow packet does not carry these, so they stay dirty until a deep packet sends them
+            dirty_relays = 0;
+            dirty_analog_outputs = 0;
+            dirty_digital_mxp = 0;
+            dirty_digital_hdrs = false;
+        }
+    }
+
+    const std::string& SendData::serializeShallowDelta(){
+        return serializeDelta(false);
+    }
+
+    const std::string& SendData::serializeDeepDelta(){
+        return serializeDelta(true);
+    }
+
+    const std::string& SendData::serializeNext(WireFormat format){
+        if(format == WireFormat::BINARY){
+            return serializeDelta(isKeyframeDue() || hasDeepChanges());
+        }
+        const bool DEEP = keyframe_requested || hasDeepChanges(); //JSON packets hold every output they carry, so only a new peer needs a deep one to catch up
+        keyframe_requested = false;
+        clearDirty(DEEP);
+        return DEEP ? serializeDeep() : serializeShallow();
+    }
+
+    void SendData::deserializeBinary(StringView packet){
+        BinaryReader reader(packet.data(), packet.size());
+        const BinaryHeader HEADER = readBinaryHeader(reader);
+        if(HEADER.version != BINARY_SCHEMA_VERSION){
+            throw BinaryParsingException("unsupported schema version " + std::to_string(HEADER.version));
+        }
+        if(HEADER.payload_length != reader.remaining()){
+            throw BinaryParsingException("payload length mismatch");
+        }
+        if(HEADER.type == BinaryPacketType::SHALLOW || HEADER.type == BinaryPacketType::DEEP){
+            for(double& pwm_hdr: pwm_hdrs){
+                pwm_hdr = reader.readFloat();
+            }
+            if(HEADER.type == BinaryPacketType::DEEP){
+                for(RelaySystem::State& relay: relays){
+                    relay = static_cast<RelaySystem::State>(reader.read<uint8_t>());
+                }
+                for(double& analog_output: analog_outputs){
+                    analog_output = reader.readFloat();
+                }
+                for(MXPData& mxp: digital_mxp){
+                    mxp = MXPData::deserializeBinary(reader);
+                }
+                const uint16_t DIGITAL_HDRS_MASK = reader.read<uint16_t>();
+                for(unsigned i = 0; i < digital_hdrs.size(); i++){
+                    digital_hdrs[i] = checkBitHigh(DIGITAL_HDRS_MASK, i);
+                }
+            }
+            can_motor_controllers.clear();
+            can_motor_controllers.deserializeBinary(reader);
+        } else if(HEADER.type == BinaryPacketType::DELTA){
+            reader.read<uint32_t>(); //the sequence number only matters to a peer watching for gaps
+            const uint8_t SECTIONS = reader.read<uint8_t>();
+            if(SECTIONS & PWM_HDRS){
+                const uint16_t MASK = reader.read<uint16_t>();
+                for(unsigned i = 0; i < pwm_hdrs.size(); i++){
+                    if(checkBitHigh(MASK, i)){
+                        pwm_hdrs[i] = reader.readFloat();
+                    }
+                }
+            }
+            if(SECTIONS & RELAYS){
+                const uint8_t MASK = reader.read<uint8_t>();
+                for(unsigned i = 0; i < relays.size(); i++){
+                    if(checkBitHigh(MASK, i)){
+                        relays[i] = static_cast<RelaySystem::State>(reader.read<uint8_t>());
+                    }
+                }
+            }
+            if(SECTIONS & ANALOG_OUTPUTS){
+                const uint8_t MASK = reader.read<uint8_t>();
+                for(unsigned i = 0; i < analog_outputs.size(); i++){
+                    if(checkBitHigh(MASK, i)){
+                        analog_outputs[i] = reader.readFloat();
+                    }
+                }
+            }
+            if(SECTIONS & DIGITAL_MXP){
+                const uint16_t MASK = reader.read<uint16_t>();
+                for(unsigned i = 0; i < digital_mxp.size(); i++){
+                    if(checkBitHigh(MASK, i)){
+                        digital_mxp[i] = MXPData::deserializeBinary(reader);
+                    }
+                }
+            }
+            if(SECTIONS & DIGITAL_HDRS){
+                const uint16_t DIGITAL_HDRS_MASK = reader.read<uint16_t>();
+                for(unsigned i = 0; i < digital_hdrs.size(); i++){
+                    digital_hdrs[i] = checkBitHigh(DIGITAL_HDRS_MASK, i);
+                }
+            }
+            if(SECTIONS & CAN_MOTOR_CONTROLLERS){
+                if(SECTIONS & KEYFRAME){ //a keyframe holds every controller, so any missing were removed
+                    can_motor_controllers.clear();
+                }
+                can_motor_controllers.deserializeBinary(reader);
+            }
+        } else {
+            throw BinaryParsingException("unexpected packet type " + std::to_string(static_cast<unsigned>(HEADER.type)));
+        }
+        if(reader.remaining() != 0){
+            throw BinaryParsingException("trailing bytes after outputs");
+        }
+        new_data = true;
+    }
+
+    void SendData::deserializeFields(JSONReader& reader){
+        reader.beginObject();
+        StringView label;
+        while(reader.nextField(label)){
+            if(label == StringView("roborio", 7)){ //the outputs are wrapped in a single outer object
+                deserializeFields(reader);
+            } else if(!JSONSchema::deserialize<SchemaDepth::DEEP>(reader, label, *this)){ //deep packets hold every field, so this reads both
+                reader.skipValue();
+            }
+        }
+    }
+
+    void SendData::deserializeJSON(StringView packet){
+        JSONReader reader(packet);
+        deserializeFields(reader);
+        new_data = true;
+    }
+
+    void SendData::requestKeyframe(){
+        keyframe_requested = true;
+        new_data = true;
+        SendDataManager::notifyNewData();
+    }
+
     void SendData::enable(bool e){
         if(e != enabled){
             new_data = true;
+            SendDataManager::notifyNewData();
+            keyframe_requested = true;
             enabled = e;
         }
     }
-}
 
+    SendDataManager::State::State():instance(std::make_shared<SendData>()), send_data_mutex(), new_data_condition(), new_data_listener(){}
+
+    std::pair<std::shared_ptr<SendData>, std::unique_lock<std::recursive_mutex>> SendDataManager::getInstance(){
+        State& state = RobotInstance::current().send_data;
+        HEL_PROFILE_LOCK_WAIT();
+        std::unique_lock<std::recursive_mutex> lock(state.send_data_mutex);
+        return std::make_pair(state.instance, std::move(lock));
+    }
+
+    void SendDataManager::notifyNewData(){
+        State& state = RobotInstance::current().send_data;
+        state.new_data_condition.notify_all();
+        if(state.new_data_listener){
+            state.new_data_listener();
+        }
+    }
+
+    void SendDataManager::setNewDataListener(std::function<void()> listener){
+        State& state = RobotInstance::current().send_data;
+        std::lock_guard<std::recursive_mutex> lock(state.send_data_mutex);
+        state.new_data_listener = listener;
+    }
+
+    bool SendDataManager::waitForNewData(std::unique_lock<std::recursive_mutex>& lock, std::chrono::milliseconds timeout){
+        State& state = RobotInstance::current().send_data;
+        return state.new_data_condition.wait_for(lock, timeout, [&state](){ return state.instance->hasNewData(); });
+    }
+}
@@ -0,0 +1,69 @@
+#include "shm_engine_peer.hpp"
+
+#include <array>
+#include <atomic>
+#include <unistd.h>
+
+#include "sync_client.hpp"
+#include "sync_server.hpp"
+
+namespace hel{
+    namespace detail{
+        std::string uniqueRingName(const std::string& purpose){
+            static std::atomic<unsigned> count{0};
+            return "/hel_" + purpose + "_" + std::to_string(getpid()) + "_" + std::to_string(count++);
+        }
+    }
+
+    ShmEnginePeer::ShmEnginePeer(const std::string& host, uint32_t capacity):
+        io(),
+        inputs(ShmRing::create(detail::uniqueRingName("inputs"), capacity)),
+        outputs(ShmRing::create(detail::uniqueRingName("outputs"), capacity)),
+        input_socket(io),
+        output_socket(io),
+        format(WireFormat::JSON)
+    {
+        format = connect(input_socket, host, RECEIVE_PORT, inputs);
+        if(connect(output_socket, host, SEND_PORT, outputs) != format){
+            throw ShmException("negotiate the same wire format for inputs and outputs");
+        }
+    }
+
+    WireFormat ShmEnginePeer::connect(asio::ip::tcp::socket& socket, const std::string& host, unsigned short port, const ShmRing& ring){
+        socket.connect(asio::ip::tcp::endpoint(asio::ip::make_address(host), port));
+        socket.set_option(asio::ip::tcp::no_delay(true));
+
+        std::string request;
+        BinaryWriter writer(request);
+        std::size_t header_position = writer.beginPacket(BinaryPacketType::HANDSHAKE);
+        writer.write(BINARY_SCHEMA_VERSION);
+        writer.write(ring.getName());
+        writer.endPacket(header_position);
+        asio::write(socket, asio::buffer(request));
+
+        std::array<char, BINARY_HEADER_SIZE + sizeof(uint16_t) + sizeof(bool)> reply;
+        asio::read(socket, asio::buffer(reply));
+        BinaryReader reader(reply.data(), reply.size());
+        BinaryHeader header = readBinaryHeader(reader);
+        if(header.type != BinaryPacketType::HANDSHAKE || header.payload_length != sizeof(uint16_t) + sizeof(bool)){
+            throw BinaryParsingException("malformed handshake reply");
+        }
+        const uint16_t VERSION = reader.read<uint16_t>();
+        if(!reader.readBool()){
+            throw ShmException("attach HEL to " + ring.getName());
+        }
+        return VERSION == BINARY_SCHEMA_VERSION ? WireFormat::BINARY : WireFormat::JSON;
+    }
+
+    WireFormat ShmEnginePeer::getWireFormat()const noexcept{
+        return format;
+    }
+
+    bool ShmEnginePeer::sendInputs(StringView packet){
+        return inputs.tryWrite(packet);
+    }
+
+    bool ShmEnginePeer::receiveOutputs(std::string& packet, std::chrono::microseconds timeout){
+        return outputs.waitForData(timeout) && outputs.readLatest(packet);
+    }
+}
@@ -0,0 +1,244 @@
+#include "shm_transport.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace hel{
+    namespace detail{
+        static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && ATOMIC_INT_LOCK_FREE == 2, "Shared memory rings require lock-free 32-bit atomics usable as futex words");
+
+        constexpr uint32_t MIN_SHM_RING_CAPACITY = 64;
+
+        uint32_t roundUpToPowerOfTwo(uint32_t value)noexcept{
+            uint32_t result = MIN_SHM_RING_CAPACITY;
+            while(result < value){
+                result <<= 1;
+            }
+            return result;
+        }
+
+        uint32_t* futexWord(std::atomic<uint32_t>& word)noexcept{
+            return reinterpret_cast<uint32_t*>(&word);
+        }
+
+        void futexWait(std::atomic<uint32_t>& word, uint32_t expected, std::chrono::nanoseconds timeout)noexcept{
+            timespec relative;
+            relative.tv_sec = std::chrono::duration_cast<std::chrono::seconds>(timeout).count();
+            relative.tv_nsec = (timeout - std::chrono::seconds(relative.tv_sec)).count();
+            syscall(SYS_futex, futexWord(word), FUTEX_WAIT, expected, &relative, nullptr, 0); //not FUTEX_PRIVATE since the word is shared between processes
+        }
+
+        void futexWakeAll(std::atomic<uint32_t>& word)noexcept{
+            syscall(SYS_futex, futexWord(word), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+        }
+
+        std::string errnoMessage(const std::string& action, const std::string& name){
+            return action + " " + name + " (" + std::strerror(errno) + ")";
+        }
+    }
+
+    constexpr uint32_t ShmRing::LENGTH_PREFIX_SIZE;
+
+    ShmException::ShmException(std::string det):message("Synthesis exception: shared memory transport failed to " + det){}
+
+    const char* ShmException::what()const throw(){
+        return message.c_str();
+    }
+
+    ShmRing::ShmRing(std::string n, ShmRingHeader* h, std::size_t size, bool o)noexcept:name(n), header(h), data(reinterpret_cast<char*>(h) + sizeof(ShmRingHeader)), mapped_size(size), owner(o){}
+
+    ShmRing::ShmRing(ShmRing&& source)noexcept:name(std::move(source.name)), header(source.header), data(source.data), mapped_size(source.mapped_size), owner(source.owner){
+        source.header = nullptr;
+        source.data = nullptr;
+        source.mapped_size = 0;
+        source.owner = false;
+    }
+
+    ShmRing& ShmRing::operator=(ShmRing&& source)noexcept{
+        std::swap(name, source.name);
+        std::swap(header, source.header);
+        std::swap(data, source.data);
+        std::swap(mapped_size, source.mapped_size);
+        std::swap(owner, source.owner);
+        return *this;
+    }
+
+    ShmRing::~ShmRing(){
+        if(header != nullptr){
+            munmap(header, mapped_size);
+        }
+        if(owner){
+            shm_unlink(name.c_str());
+        }
+    }
+
+    ShmRing ShmRing::create(const std::string& name, uint32_t requested_capacity){
+        const uint32_t CAPACITY = detail::roundUpToPowerOfTwo(requested_capacity);
+        const std::size_t SIZE = sizeof(ShmRingHeader) + CAPACITY;
+
+        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if(fd < 0){
+            throw ShmException(detail::errnoMessage("create", name));
+        }
+        if(ftruncate(fd, SIZE) != 0){
+            ShmException ex(detail::errnoMessage("size", name));
+            close(fd);
+            shm_unlink(name.c_str());
+            throw ex;
+        }
+        void* region = mmap(nullptr, SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if(region == MAP_FAILED){
+            ShmException ex(detail::errnoMessage("map", name));
+            shm_unlink(name.c_str());
+            throw ex;
+        }
+
+        ShmRingHeader* header = new(region) ShmRingHeader();
+        header->capacity = CAPACITY;
+        header->head.store(0);
+        header->consumer_waiting.store(0);
+        header->tail.store(0);
+        header->magic = SHM_RING_MAGIC;
+        return ShmRing(name, header, SIZE, true);
+    }
+
+    ShmRing ShmRing::open(const std::string& name){
+        int fd = shm_open(name.c_str(), O_RDWR, 0);
+        if(fd < 0){
+            throw ShmException(detail::errnoMessage("open", name));
+        }
+        struct stat info;
+        if(fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(ShmRingHeader)){
+            close(fd);
+            throw ShmException("open " + name + " (too small to hold a ring)");
+        }
+        const std::size_t SIZE = info.st_size;
+        void* region = mmap(nullptr, SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if(region == MAP_FAILED){
+            throw ShmException(detail::errnoMessage("map", name));
+        }
+
+        ShmRingHeader* header = reinterpret_cast<ShmRingHeader*>(region);
+        const uint32_t CAPACITY = header->capacity;
+        if(header->magic != SHM_RING_MAGIC || CAPACITY == 0 || (CAPACITY & (CAPACITY - 1)) != 0 || sizeof(ShmRingHeader) + CAPACITY > SIZE){
+            munmap(region, SIZE);
+            throw ShmException("open " + name + " (not a ring)");
+        }
+        return ShmRing(name, header, SIZE, false);
+    }
+
+    const std::string& ShmRing::getName()const noexcept{
+        return name;
+    }
+
+    uint32_t ShmRing::capacity()const noexcept{
+        return header->capacity;
+    }
+
+    void ShmRing::copyIn(uint32_t position, const char* source, uint32_t size)noexcept{
+        const uint32_t OFFSET = position & (header->capacity - 1);
+        const uint32_t FIRST = std::min(size, header->capacity - OFFSET);
+        std::memcpy(data + OFFSET, source, FIRST);
+        std::memcpy(data, source + FIRST, size - FIRST);
+    }
+
+    void ShmRing::copyOut(uint32_t position, char* destination, uint32_t size)const noexcept{
+        const uint32_t OFFSET = position & (header->capacity - 1);
+        const uint32_t FIRST = std::min(size, header->capacity - OFFSET);
+        std::memcpy(destination, data + OFFSET, FIRST);
+        std::memcpy(destination + FIRST, data, size - FIRST);
+    }
+
+    bool ShmRing::tryWrite(StringView packet){
+        if(packet.size() > header->capacity - LENGTH_PREFIX_SIZE){
+            return false;
+        }
+        const uint32_t SIZE = packet.size();
+        const uint32_t HEAD = header->head.load(std::memory_order_relaxed);
+        const uint32_t TAIL = header->tail.load(std::memory_order_acquire);
+        if(LENGTH_PREFIX_SIZE + SIZE > header->capacity - (HEAD - TAIL)){
+            return false;
+        }
+        copyIn(HEAD, reinterpret_cast<const char*>(&SIZE), LENGTH_PREFIX_SIZE);
+        copyIn(HEAD + LENGTH_PREFIX_SIZE, packet.data(), SIZE);
+        header->head.store(HEAD + LENGTH_PREFIX_SIZE + SIZE, std::memory_order_seq_cst); //ordered before checking for a sleeping consumer
+
+        if(header->consumer_waiting.load(std::memory_order_seq_cst)){ //skip the system call when nobody is asleep
+            detail::futexWakeAll(header->head);
+        }
+        return true;
+    }
+
+    bool ShmRing::tryRead(std::string& packet){
+        const uint32_t TAIL = header->tail.load(std::memory_order_relaxed);
+        const uint32_t HEAD = header->head.load(std::memory_order_acquire);
+        if(HEAD == TAIL){
+            return false;
+        }
+        uint32_t size;
+        copyOut(TAIL, reinterpret_cast<char*>(&size), LENGTH_PREFIX_SIZE);
+        if(size > HEAD - TAIL - LENGTH_PREFIX_SIZE){
+            throw ShmException("read " + name + " (corrupt packet length)");
+        }
+        packet.resize(size);
+        copyOut(TAIL + LENGTH_PREFIX_SIZE, &packet[0], size);
+        header->tail.store(TAIL + LENGTH_PREFIX_SIZE + size, std::memory_order_release);
+        return true;
+    }
+
+    bool ShmRing::readLatest(std::string& packet){
+        uint32_t tail = header->tail.load(std::memory_order_relaxed);
+        const uint32_t HEAD = header->head.load(std::memory_order_acquire);
+        if(HEAD == tail){
+            return false;
+        }
+        while(true){
+            uint32_t size;
+            copyOut(tail, reinterpret_cast<char*>(&size), LENGTH_PREFIX_SIZE);
+            if(size > HEAD - tail - LENGTH_PREFIX_SIZE){
+                throw ShmException("read " + name + " (corrupt packet length)");
+            }
+            const uint32_t NEXT = tail + LENGTH_PREFIX_SIZE + size;
+            if(NEXT == HEAD){
+                packet.resize(size);
+                copyOut(tail + LENGTH_PREFIX_SIZE, &packet[0], size);
+                header->tail.store(NEXT, std::memory_order_release);
+                return true;
+            }
+            tail = NEXT;
+        }
+    }
+
+    bool ShmRing::empty()const noexcept{
+        return header->head.load(std::memory_order_acquire) == header->tail.load(std::memory_order_acquire);
+    }
+
+    bool ShmRing::waitForData(std::chrono::microseconds timeout){
+        const auto DEADLINE = std::chrono::steady_clock::now() + timeout;
+        const uint32_t TAIL = header->tail.load(std::memory_order_relaxed);
+        while(true){
+            header->consumer_waiting.store(1, std::memory_order_seq_cst);
+            const uint32_t HEAD = header->head.load(std::memory_order_seq_cst); //rechecked after announcing the wait so a write cannot be missed
+            if(HEAD != TAIL){
+                header->consumer_waiting.store(0, std::memory_order_relaxed);
+                return true;
+            }
+            const auto NOW = std::chrono::steady_clock::now();
+            if(NOW >= DEADLINE){
+                header->consumer_waiting.store(0, std::memory_order_relaxed);
+                return false;
+            }
+            detail::futexWait(header->head, HEAD, DEADLINE - NOW); //returns immediately if head has already changed
+        }
+    }
+}
@@ -0,0 +1,178 @@
+#include "sim_clock.hpp"
+
+#include <thread>
+
+#include "robot_instance.hpp"
+
+namespace hel{
+    constexpr const float TIME_CONSTANT = 1.13; // This is the offset from local time to real world time
+
+    constexpr std::chrono::microseconds SimClock::REAL_TIME_STEP_PERIOD;
+
+    SimClock::State::State():clock_mutex(), step_taken(), lockstep(false), base_time(0), base_host_time(0), base_sim_time(0), sim_time(0), step(0), loop_changed(), loop_barrier(false), loops_started(0), loops_released(0){}
+
+    SimClock::State& SimClock::current()noexcept{
+        return RobotInstance::current().sim_clock;
+    }
+
+    uint64_t SimClock::hostTime()noexcept{
+        const uint64_t HOST_TIME = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+        return (uint64_t)(HOST_TIME / (double)TIME_CONSTANT); //TODO system time runs fast, using a scalar for now; scaled as a double since a float cannot resolve microseconds since the epoch
+    }
+
+    uint64_t SimClock::nowLocked(const State& state)noexcept{
+        if(state.lockstep){
+            return state.base_time + (state.sim_time - state.base_sim_time);
+        }
+        return state.base_time + (hostTime() - state.base_host_time);
+    }
+
+    uint64_t SimClock::now()noexcept{
+        return now(current());
+    }
+
+    uint64_t SimClock::now(State& state)noexcept{
+        std::lock_guard<std::mutex> lock(state.clock_mutex);
+        return nowLocked(state);
+    }
+
+    bool SimClock::isLockstep()noexcept{
+        State& state = current();
+        std::lock_guard<std::mutex> lock(state.clock_mutex);
+        return state.lockstep;
+    }
+
+    void SimClock::advanceTo(uint64_t time){
+        State& state = current();
+        {
+            std::lock_guard<std::mutex> lock(state.clock_mutex);
+            if(state.lockstep && time == state.sim_time){
+                return;
+            }
+            if(!state.lockstep || time < state.sim_time){ //rebase so time continues from where it was
+                state.base_time = nowLocked(state);
+                state.base_sim_time = time;
+                state.lockstep = true;
+            }
+            state.sim_time = time;
+            state.step++;
+        }
+        state.step_taken.notify_all();
+    }
+
+    void SimClock::release(){
+        State& state = current();
+        {
+            std::lock_guard<std::mutex> lock(state.clock_mutex);
+            if(!state.lockstep){
+                return;
+            }
+            state.base_time = nowLocked(state);
+            state.base_host_time = hostTime();
+            state.lockstep = false;
+        }
+        state.step_taken.notify_all(); //waiters fall back to the real-time period
+    }
+
+    uint64_t SimClock::getStep()noexcept{
+        State& state = current();
+        std::lock_guard<std::mutex> lock(state.clock_mutex);
+        return state.step;
+    }
+
+    bool SimClock::waitForStep(uint64_t& last_step, std::chrono::microseconds timeout){
+        State& state = current();
+        std::unique_lock<std::mutex> lock(state.clock_mutex);
+        if(state.lockstep){
+            const bool STEPPED = state.step_taken.wait_for(lock, timeout, [&](){
+                return state.step != last_step || !state.lockstep;
+            });
+            if(STEPPED && state.lockstep){
+                last_step = state.step;
+                return true;
+            }
+            if(!STEPPED){
+                return false;
+            }
+        }
+        lock.unlock(); //in real-time mode, or the engine just disconnected
+        std::this_thread::sleep_for(REAL_TIME_STEP_PERIOD);
+        lock.lock();
+        last_step = state.step;
+        return true;
+    }
+
+    bool SimClock::waitUntil(uint64_t time, const std::function<bool()>& cancelled){
+        State& state = current();
+        std::unique_lock<std::mutex> lock(state.clock_mutex);
+        while(!cancelled()){
+            const uint64_t NOW = nowLocked(state);
+            if(NOW >= time){
+                return true;
+            }
+            if(state.lockstep){
+                state.step_taken.wait(lock);
+            } else { //time runs slower than the host clock by TIME_CONSTANT
+                state.step_taken.wait_for(lock, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double, std::micro>((time - NOW) * (double)TIME_CONSTANT)));
+            }
+        }
+        return false;
+    }
+
+    void SimClock::wake(){
+        State& state = current();
+        {
+            std::lock_guard<std::mutex> lock(state.clock_mutex); //so a waiter cannot miss the change between checking it and waiting
+        }
+        state.step_taken.notify_all();
+    }
+
+    void SimClock::setLoopBarrier(bool enabled){
+        State& state = current();
+        {
+            std::lock_guard<std::mutex> lock(state.clock_mutex);
+            state.loop_barrier = enabled;
+            if(!enabled){
+                state.loops_released = state.loops_started;
+            }
+        }
+        state.loop_changed.notify_all();
+    }
+
+    void SimClock::startUserLoop(){
+        State& state = current();
+        std::unique_lock<std::mutex> lock(state.clock_mutex);
+        state.loops_started++;
+        if(!state.loop_barrier){
+            state.loops_released = state.loops_started;
+            return;
+        }
+        state.loop_changed.notify_all();
+        state.loop_changed.wait(lock, [&](){
+            return state.loops_released >= state.loops_started;
+        });
+    }
+
+    bool SimClock::waitForUserLoop(std::chrono::microseconds timeout){
+        State& state = current();
+        std::unique_lock<std::mutex> lock(state.clock_mutex);
+        return state.loop_changed.wait_for(lock, timeout, [&](){
+            return state.loops_started > state.loops_released;
+        });
+    }
+
+    void SimClock::releaseUserLoop(){
+        State& state = current();
+        {
+            std::lock_guard<std::mutex> lock(state.clock_mutex);
+            state.loops_released = state.loops_started;
+        }
+        state.loop_changed.notify_all();
+    }
+
+    uint64_t SimClock::getUserLoopCount()noexcept{
+        State& state = current();
+        std::lock_guard<std::mutex> lock(state.clock_mutex);
+        return state.loops_started;
+    }
+}
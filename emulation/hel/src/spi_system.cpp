@@ -1,4 +1,6 @@
+#include "diagnostics.hpp"
 #include "roborio_manager.hpp"
+#include "robot_instance.hpp"
 
 using namespace nFPGA;
 using namespace nRoboRIO_FPGANamespace;
@@ -73,31 +75,37 @@ namespace hel{
 #undef COPY
     }
 
-    struct SPIManager: public tSPI{
+    struct SPIManager: public tSPI, private InstanceBound{
         tSystemInterface* getSystemInterface(){
             return new SystemInterface();
         }
 
         uint32_t readDebugIntStatReadCount(tRioStatusCode* /*status*/){ //unnecessary for emulation
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readDebugIntStatReadCount\n";
+            HEL_PROFILE_CALL();
+            HEL_WARN("Unsupported feature: Function call tSPI::readDebugIntStatReadCount");
             return 0;
         }
 
         uint16_t readDebugState(tRioStatusCode* /*status*/){ //unnecessary for emulation
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readDebugState\n";
+            HEL_PROFILE_CALL();
+            HEL_WARN("Unsupported feature: Function call tSPI::readDebugState");
             return 0;
         }
 
         void writeAutoTriggerConfig(tAutoTriggerConfig value, tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::writeAutoTriggerConfig\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::writeAutoTriggerConfig");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.first->spi_system.setAutoTriggerConfig(value);
             instance.second.unlock();
         }
 
         void writeAutoTriggerConfig_ExternalClockSource_Channel(uint8_t value, tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::writeAutoTriggerConfig_ExternalClockSource_Channel\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::writeAutoTriggerConfig_ExternalClockSource_Channel");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             tAutoTriggerConfig config = instance.first->spi_system.getAutoTriggerConfig();
             config.ExternalClockSource_Channel = value;
             instance.first->spi_system.setAutoTriggerConfig(config);
@@ -105,8 +113,10 @@ namespace hel{
         }
 
         void writeAutoTriggerConfig_ExternalClockSource_Module(uint8_t value, tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::writeAutoTriggerConfig_ExternalClockSource_Module\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::writeAutoTriggerConfig_ExternalClockSource_Module");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             tAutoTriggerConfig config = instance.first->spi_system.getAutoTriggerConfig();
             config.ExternalClockSource_Module = value;
             instance.first->spi_system.setAutoTriggerConfig(config);
@@ -114,8 +124,10 @@ namespace hel{
         }
 
         void writeAutoTriggerConfig_ExternalClockSource_AnalogTrigger(bool value, tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::writeAutoTriggerConfig_ExternalClockSource_AnalogTrigger\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::writeAutoTriggerConfig_ExternalClockSource_AnalogTrigger");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             tAutoTriggerConfig config = instance.first->spi_system.getAutoTriggerConfig();
             config.ExternalClockSource_AnalogTrigger = value;
             instance.first->spi_system.setAutoTriggerConfig(config);
@@ -123,8 +135,10 @@ namespace hel{
         }
 
         void writeAutoTriggerConfig_RisingEdge(bool value, tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::writeAutoTriggerConfig_RisingEdge\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::writeAutoTriggerConfig_RisingEdge");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             tAutoTriggerConfig config = instance.first->spi_system.getAutoTriggerConfig();
             config.RisingEdge = value;
             instance.first->spi_system.setAutoTriggerConfig(config);
@@ -132,8 +146,10 @@ namespace hel{
         }
 
         void writeAutoTriggerConfig_FallingEdge(bool value, tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::writeAutoTriggerConfig_FallingEdge\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::writeAutoTriggerConfig_FallingEdge");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             tAutoTriggerConfig config = instance.first->spi_system.getAutoTriggerConfig();
             config.FallingEdge = value;
             instance.first->spi_system.setAutoTriggerConfig(config);
@@ -141,8 +157,10 @@ namespace hel{
         }
 
         void writeAutoTriggerConfig_ExternalClock(bool value, tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::writeAutoTriggerConfig_ExternalClock\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::writeAutoTriggerConfig_ExternalClock");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             tAutoTriggerConfig config = instance.first->spi_system.getAutoTriggerConfig();
             config.ExternalClock = value;
             instance.first->spi_system.setAutoTriggerConfig(config);
@@ -150,88 +168,112 @@ namespace hel{
         }
 
         tAutoTriggerConfig readAutoTriggerConfig(tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readAutoTriggerConfig\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::readAutoTriggerConfig");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.second.unlock();
             return instance.first->spi_system.getAutoTriggerConfig();
         }
 
         uint8_t readAutoTriggerConfig_ExternalClockSource_Channel(tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readAutoTriggerConfig_ExternalClockSource_Channel\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::readAutoTriggerConfig_ExternalClockSource_Channel");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.second.unlock();
             return instance.first->spi_system.getAutoTriggerConfig().ExternalClockSource_Channel;
         }
 
         uint8_t readAutoTriggerConfig_ExternalClockSource_Module(tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readAutoTriggerConfig_ExternalClockSource_Module\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::readAutoTriggerConfig_ExternalClockSource_Module");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.second.unlock();
             return instance.first->spi_system.getAutoTriggerConfig().ExternalClockSource_Module;
         }
 
         bool readAutoTriggerConfig_ExternalClockSource_AnalogTrigger(tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readAutoTriggerConfig_ExternalClockSource_AnalogTrigger\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::readAutoTriggerConfig_ExternalClockSource_AnalogTrigger");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.second.unlock();
             return instance.first->spi_system.getAutoTriggerConfig().ExternalClockSource_AnalogTrigger;
         }
 
         bool readAutoTriggerConfig_RisingEdge(tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readAutoTriggerConfig_RisingEdge\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::readAutoTriggerConfig_RisingEdge");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.second.unlock();
             return instance.first->spi_system.getAutoTriggerConfig().RisingEdge;
         }
 
         bool readAutoTriggerConfig_FallingEdge(tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readAutoTriggerConfig_FallingEdge\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::readAutoTriggerConfig_FallingEdge");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.second.unlock();
             return instance.first->spi_system.getAutoTriggerConfig().FallingEdge;
         }
 
         bool readAutoTriggerConfig_ExternalClock(tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readAutoTriggerConfig_ExternalClock\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::readAutoTriggerConfig_ExternalClock");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.second.unlock();
             return instance.first->spi_system.getAutoTriggerConfig().ExternalClock;
         }
 
         void writeAutoChipSelect(uint8_t value, tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::writeAutoChipSelect\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::writeAutoChipSelect");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.first->spi_system.setAutoChipSelect(value);
             instance.second.unlock();
         }
 
         uint8_t readAutoChipSelect(tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readAutoChipSelect\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::readAutoChipSelect");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.second.unlock();
             return instance.first->spi_system.getAutoChipSelect();
         }
 
         uint32_t readDebugRevision(tRioStatusCode* /*status*/){ //unnecessary for emulation
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readDebugRevision\n";
+            HEL_PROFILE_CALL();
+            HEL_WARN("Unsupported feature: Function call tSPI::readDebugRevision");
             return 0;
         }
 
         uint32_t readTransferSkippedFullCount(tRioStatusCode* /*status*/){ //unnecessary for emulation
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readTransferSkippedFullCount\n";
+            HEL_PROFILE_CALL();
+            HEL_WARN("Unsupported feature: Function call tSPI::readTransferSkippedFullCount");
             return 0;
         }
 
         void writeAutoByteCount(tAutoByteCount value, tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::writeAutoByteCount\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::writeAutoByteCount");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.first->spi_system.setAutoByteCount(value);
             instance.second.unlock();
         }
 
         void writeAutoByteCount_TxByteCount(uint8_t value, tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::writeAutoByteCount_TxByteCount\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::writeAutoByteCount_TxByteCount");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             tAutoByteCount count = instance.first->spi_system.getAutoByteCount();
             count.TxByteCount = value;
             instance.first->spi_system.setAutoByteCount(count);
@@ -239,8 +281,10 @@ namespace hel{
         }
 
         void writeAutoByteCount_ZeroByteCount(uint8_t value, tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::writeAutoByteCount_ZeroByteCount\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::writeAutoByteCount_ZeroByteCount");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             tAutoByteCount count = instance.first->spi_system.getAutoByteCount();
             count.ZeroByteCount = value;
             instance.first->spi_system.setAutoByteCount(count);
@@ -248,93 +292,118 @@ namespace hel{
         }
 
         tAutoByteCount readAutoByteCount(tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readAutoByteCount\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::readAutoByteCount");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.second.unlock();
             return instance.first->spi_system.getAutoByteCount();
         }
 
         uint8_t readAutoByteCount_TxByteCount(tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readAutoByteCount_TxByteCount\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::readAutoByteCount_TxByteCount");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.second.unlock();
             return instance.first->spi_system.getAutoByteCount().TxByteCount;
         }
 
         uint8_t readAutoByteCount_ZeroByteCount(tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readAutoByteCount_ZeroByteCount\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::readAutoByteCount_ZeroByteCount");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.second.unlock();
             return instance.first->spi_system.getAutoByteCount().ZeroByteCount;
         }
 
         uint32_t readDebugIntStat(tRioStatusCode* /*status*/){ //unnecessary for emulation
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readDebugIntStat\n";
+            HEL_PROFILE_CALL();
+            HEL_WARN("Unsupported feature: Function call tSPI::readDebugIntStat");
             return 0;
         }
 
         uint32_t readDebugEnabled(tRioStatusCode* /*status*/){ //unnecessary for emulation
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readDebugEnabled\n";
+            HEL_PROFILE_CALL();
+            HEL_WARN("Unsupported feature: Function call tSPI::readDebugEnabled");
             return 0;
         }
 
         void writeAutoSPI1Select(bool value, tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::writeAutoSPI1Select\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::writeAutoSPI1Select");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.first->spi_system.setAutoSPI1Select(value);
             instance.second.unlock();
         }
 
         bool readAutoSPI1Select(tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readAutoSPI1Select\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::readAutoSPI1Select");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.second.unlock();
             return instance.first->spi_system.getAutoSPI1Select();
         }
 
         uint8_t readDebugSubstate(tRioStatusCode* /*status*/){ //unnecessary for emulation
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readDebugSubstate\n";
+            HEL_PROFILE_CALL();
+            HEL_WARN("Unsupported feature: Function call tSPI::readDebugSubstate");
             return 0;
         }
 
         void writeAutoRate(uint32_t value, tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::writeAutoRate\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::writeAutoRate");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.first->spi_system.setAutoRate(value);
             instance.second.unlock();
         }
 
         uint32_t readAutoRate(tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readAutoRate\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::readAutoRate");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.second.unlock();
             return instance.first->spi_system.getAutoRate();
         }
 
         void writeEnableDIO(uint8_t value, tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::writeEnableDIO\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::writeEnableDIO");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.first->spi_system.setEnabledDIO(value);
             instance.second.unlock();
         }
 
         uint8_t readEnableDIO(tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readEnableDIO\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::readEnableDIO");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.second.unlock();
             return instance.first->spi_system.getEnabledDIO();
         }
 
         void writeChipSelectActiveHigh(tChipSelectActiveHigh value, tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::writeChipSelectActiveHigh\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::writeChipSelectActiveHigh");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.first->spi_system.setChipSelectActiveHigh(value);
             instance.second.unlock();
         }
 
         void writeChipSelectActiveHigh_Hdr(uint8_t value, tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::writeChipSelectActiveHigh_Hdr\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::writeChipSelectActiveHigh_Hdr");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             tChipSelectActiveHigh select = instance.first->spi_system.getChipSelectActiveHigh();
             select.Hdr = value;
             instance.first->spi_system.setChipSelectActiveHigh(select);
@@ -342,8 +411,10 @@ namespace hel{
         }
 
         void writeChipSelectActiveHigh_MXP(uint8_t value, tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::writeChipSelectActiveHigh_MXP\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::writeChipSelectActiveHigh_MXP");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             tChipSelectActiveHigh select = instance.first->spi_system.getChipSelectActiveHigh();
             select.MXP = value;
             instance.first->spi_system.setChipSelectActiveHigh(select);
@@ -351,38 +422,47 @@ namespace hel{
         }
 
         tChipSelectActiveHigh readChipSelectActiveHigh(tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readChipSelectActiveHigh\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::readChipSelectActiveHigh");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.second.unlock();
             return instance.first->spi_system.getChipSelectActiveHigh();
         }
 
         uint8_t readChipSelectActiveHigh_Hdr(tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readChipSelectActiveHigh_Hdr\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::readChipSelectActiveHigh_Hdr");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.second.unlock();
             return instance.first->spi_system.getChipSelectActiveHigh().Hdr;
         }
 
         uint8_t readChipSelectActiveHigh_MXP(tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readChipSelectActiveHigh_MXP\n";
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            HEL_WARN("Unsupported feature: Function call tSPI::readChipSelectActiveHigh_MXP");
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::SPI_SYSTEM);
             instance.second.unlock();
             return instance.first->spi_system.getChipSelectActiveHigh().MXP;
         }
 
         void strobeAutoForceOne(tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::strobeAutoForceOne\n";
+            HEL_PROFILE_CALL();
+            HEL_WARN("Unsupported feature: Function call tSPI::strobeAutoForceOne");
             //TODO
         }
 
         void writeAutoTx(uint8_t /*reg_index*/, uint8_t /*bitfield_index*/, uint8_t /*value*/, tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::writeAutoTx\n";
+            HEL_PROFILE_CALL();
+            HEL_WARN("Unsupported feature: Function call tSPI::writeAutoTx");
              //TODO
         }
 
         uint8_t readAutoTx(uint8_t /*reg_index*/, uint8_t /*bitfield_index*/, tRioStatusCode* /*status*/){
-            std::cerr<<"Synthesis warning: Unsupported feature: Function call tSPI::readAutoTx\n";
+            HEL_PROFILE_CALL();
+            HEL_WARN("Unsupported feature: Function call tSPI::readAutoTx");
             //TODO
             return 0;
         }
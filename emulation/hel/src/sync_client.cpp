@@ -1,71 +1,160 @@
 #include "sync_client.hpp"
+#include "io_recorder.hpp"
 #include "receive_data.hpp"
+#include "sim_clock.hpp"
+#include "sync_util.hpp"
 
-#include <unistd.h>
 #include <iostream>
-#include "util.hpp"
-#include "global.hpp"
 #include "json_util.hpp"
 
-#define ETHERNET_MTU 1516
+namespace hel {
+    constexpr std::chrono::milliseconds SyncClient::RING_WAIT_TIMEOUT;
 
-constexpr char DEFAULT_DESERIALIZATION_DATA[] = "{\"roborio\":{\"digital_hdrs\":[0,0,0,0,0,0,0,0,0,0],\"joysticks\":[{\"is_xbox\":0,\"type\":0,\"name\":\"\",\"buttons\":0,\"button_count\":0,\"axes\":[0,0,0,0,0,0,0,0,0,0,0,0],\"axis_count\":0,\"axis_types\":[0,0,0,0,0,0,0,0,0,0,0,0],\"povs\":[0,0,0,0,0,0,0,0,0,0,0,0],\"pov_count\":0,\"outputs\":0,\"left_rumble\":0,\"right_rumble\":0},{\"is_xbox\":0,\"type\":0,\"name\":\"\",\"buttons\":0,\"button_count\":0,\"axes\":[0,0,0,0,0,0,0,0,0,0,0,0],\"axis_count\":0,\"axis_types\":[0,0,0,0,0,0,0,0,0,0,0,0],\"povs\":[0,0,0,0,0,0,0,0,0,0,0,0],\"pov_count\":0,\"outputs\":0,\"left_rumble\":0,\"right_rumble\":0},{\"is_xbox\":0,\"type\":0,\"name\":\"\",\"buttons\":0,\"button_count\":0,\"axes\":[0,0,0,0,0,0,0,0,0,0,0,0],\"axis_count\":0,\"axis_types\":[0,0,0,0,0,0,0,0,0,0,0,0],\"povs\":[0,0,0,0,0,0,0,0,0,0,0,0],\"pov_count\":0,\"outputs\":0,\"left_rumble\":0,\"right_rumble\":0},{\"is_xbox\":0,\"type\":0,\"name\":\"\",\"buttons\":0,\"button_count\":0,\"axes\":[0,0,0,0,0,0,0,0,0,0,0,0],\"axis_count\":0,\"axis_types\":[0,0,0,0,0,0,0,0,0,0,0,0],\"povs\":[0,0,0,0,0,0,0,0,0,0,0,0],\"pov_count\":0,\"outputs\":0,\"left_rumble\":0,\"right_rumble\":0},{\"is_xbox\":0,\"type\":0,\"name\":\"\",\"buttons\":0,\"button_count\":0,\"axes\":[0,0,0,0,0,0,0,0,0,0,0,0],\"axis_count\":0,\"axis_types\":[0,0,0,0,0,0,0,0,0,0,0,0],\"povs\":[0,0,0,0,0,0,0,0,0,0,0,0],\"pov_count\":0,\"outputs\":0,\"left_rumble\":0,\"right_rumble\":0},{\"is_xbox\":0,\"type\":0,\"name\":\"\",\"buttons\":0,\"button_count\":0,\"axes\":[0,0,0,0,0,0,0,0,0,0,0,0],\"axis_count\":0,\"axis_types\":[0,0,0,0,0,0,0,0,0,0,0,0],\"povs\":[0,0,0,0,0,0,0,0,0,0,0,0],\"pov_count\":0,\"outputs\":0,\"left_rumble\":0,\"right_rumble\":0}],\"digital_mxp\":[{\"config\":\"DI\",\"value\":0.0},{\"config\":\"DI\",\"value\":0.0},{\"config\":\"DI\",\"value\":0.0},{\"config\":\"DI\",\"value\":0.0},{\"config\":\"DI\",\"value\":0.0},{\"config\":\"DI\",\"value\":0.0},{\"config\":\"DI\",\"value\":0.0},{\"config\":\"DI\",\"value\":0.0},{\"config\":\"DI\",\"value\":0.0},{\"config\":\"DI\",\"value\":0.0},{\"config\":\"DI\",\"value\":0.0},{\"config\":\"DI\",\"value\":0.0},{\"config\":\"DI\",\"value\":0.0},{\"config\":\"DI\",\"value\":0.0},{\"config\":\"DI\",\"value\":0.0},{\"config\":\"DI\",\"value\":0.0}],\"match_info\":{\"event_name\":\"\",\"game_specific_message\":\"\",\"match_type\":\"NONE\",\"match_number\":0,\"replay_number\":0,\"alliance_station_id\":\"RED1\",\"match_time\":0.0},\"robot_mode\":{\"mode\":\"TELEOPERATED\",\"enabled\":0,\"emergency_stopped\":0,\"fms_attached\":0,\"ds_attached\":0},\"encoders\":[null,null,null,null,null,null,null,null]}}"; //TODO replace with shallow and deep versions
+    SyncClient::SyncClient(asio::io_context& io):SyncClient(io, RobotInstance::getCurrent()){}
 
-namespace hel {
+    SyncClient::SyncClient(asio::io_context& io, std::shared_ptr<RobotInstance> robot):
+        robot(robot),
+        acceptor(io, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), robot->getReceivePort())),
+        socket(io),
+        negotiation_timer(io),
+        format(WireFormat::JSON),
+        frames(),
+        ring(nullptr),
+        ring_reader(),
+        ring_reader_running(false),
+        discarded()
+    {
+        startSync();
+    }
 
-    SyncClient::SyncClient(asio::io_service& io)   {
-        endpoint = asio::ip::tcp::endpoint(asio::ip::tcp::v4(), RECEIVE_PORT);
-        startSync(io);
+    SyncClient::~SyncClient(){
+        stopRingReader();
     }
 
-    std::string readJSONPacket(asio::ip::tcp::socket& socket, std::string& rest){
-        std::array<char, ETHERNET_MTU + 1> data;
-        std::fill(data.begin(), data.end(), '\0');
-        int bytes_received = socket.receive(asio::buffer(data));
-        std::string received_data = rest;
-        received_data += std::string(data.begin(), data.begin()+bytes_received);
-        rest = "";
-        const std::string PREAMBLE = "{\"roborio";
-        if(received_data.substr(0, PREAMBLE.length()) != PREAMBLE) {
-            if (received_data.find(JSON_PACKET_SUFFIX) == std::string::npos) {
-                rest = received_data;
-            } else {
-                rest = received_data.substr(received_data.find(JSON_PACKET_SUFFIX) + 1);
+    void SyncClient::startSync() {
+        startAccept();
+    }
+
+    void SyncClient::startAccept() {
+        acceptor.async_accept(socket, [this](const auto& ec){
+            if(ec){
+                std::cerr << "Synthesis warning: Receiver failed to accept a connection (" << ec.message() << ").\n";
+                startAccept();
+                return;
             }
-            return readJSONPacket(socket,rest);
-        }
-        std::size_t i = received_data.find(JSON_PACKET_SUFFIX);
-        if(i == std::string::npos) {
-            rest = received_data;
-            return readJSONPacket(socket,rest);
+            asyncNegotiateWireFormat(socket, negotiation_timer, [this](const std::string& name){
+                return attachRing(name);
+            }, [this](WireFormat f, Transport transport){
+                format = f;
+                if(transport == Transport::SHARED_MEMORY){
+                    startRingReader();
+                    startWatch();
+                    return;
+                }
+                ring = nullptr; //negotiation failed after attaching
+                frames.reset(f);
+                startRead();
+            });
+        });
+    }
+
+    void SyncClient::startRead() {
+        std::pair<char*, std::size_t> space = frames.prepare(ETHERNET_MTU);
+        socket.async_read_some(asio::buffer(space.first, space.second), [this](const auto& ec, std::size_t bytes_received){
+            if(ec){
+                disconnect();
+                return;
+            }
+            frames.commit(bytes_received);
+            StringView frame;
+            StringView latest;
+            bool received = false;
+            while(frames.next(frame)){
+                latest = frame;
+                received = true;
+            }
+            if(received){
+                applyPacket(latest);
+            }
+            startRead();
+        });
+    }
+
+    bool SyncClient::attachRing(const std::string& name) {
+        try {
+            ring = std::make_unique<ShmRing>(ShmRing::open(name));
+            return true;
+        } catch(const std::exception& ex){
+            std::cerr << "Synthesis warning: Receiver could not attach to shared memory (" << ex.what() << "). Falling back to the socket.\n";
+            return false;
         }
-        rest = received_data.substr(i + 1);
-        return received_data.substr(0, i);
     }
 
-    void SyncClient::startSync(asio::io_service& io) {
-        while(1) {
-            asio::ip::tcp::socket socket(io);
-            asio::ip::tcp::acceptor acceptor(io, endpoint);
-            acceptor.accept(socket);
-            std::string rest = "";
-            std::string json_string = "";
-            try {
-                while(1) {
-                    json_string = readJSONPacket(socket,rest);
-                    auto instance = ReceiveDataManager::getInstance();
-                    instance.first->deserializeShallow(json_string);
-                    instance.first->updateShallow();
-                    instance.second.unlock();
-                    usleep(30000);
+    void SyncClient::startRingReader() {
+        ring_reader_running = true;
+        ring_reader = std::thread([this](){
+            std::string packet;
+            while(ring_reader_running){
+                try {
+                    if(ring->waitForData(RING_WAIT_TIMEOUT) && ring->readLatest(packet)){
+                        applyPacket(packet);
+                    }
+                } catch(const std::exception& ex){
+                    std::cerr << "Synthesis warning: Dropping shared memory packets (" << ex.what() << ").\n";
                 }
-            } catch(std::system_error) {
-                std::cerr << "Synthesis warning: Receiver socket disconnected. User code will continue to run, but inputs will be set to default.\n";
-                auto instance = ReceiveDataManager::getInstance();
-                instance.first->deserializeDeep(std::string(DEFAULT_DESERIALIZATION_DATA));
-                instance.first->updateDeep();
-                instance.second.unlock();
             }
+        });
+    }
+
+    void SyncClient::stopRingReader() {
+        ring_reader_running = false;
+        if(ring_reader.joinable()){
+            ring_reader.join();
+        }
+        ring = nullptr;
+    }
+
+    void SyncClient::startWatch() {
+        socket.async_read_some(asio::buffer(discarded), [this](const auto& ec, std::size_t /*bytes_received*/){
+            if(ec){
+                disconnect();
+                return;
+            }
+            startWatch();
+        });
+    }
+
+    void SyncClient::applyPacket(StringView packet) {
+        RobotInstance::Binding binding(*robot);
+        auto instance = ReceiveDataManager::getInstance();
+        try {
+            if(format == WireFormat::BINARY){
+                instance.first->deserializeBinary(packet);
+            } else {
+                instance.first->deserializeShallow(packet);
+            }
+            IORecorder::record(IORecorder::Direction::INPUT, format, robot->getID(), packet);
+        } catch(const std::exception& ex){
+            std::cerr << "Synthesis warning: Dropping malformed packet (" << ex.what() << ").\n";
+        }
+        instance.first->updateDeep(); //binary packets may be deep, and MXP inputs keep their last deep values otherwise
+        instance.second.unlock();
+    }
+
+    void SyncClient::disconnect() {
+        std::cerr << "Synthesis warning: Receiver socket disconnected. User code will continue to run, but inputs will be set to default.\n";
+        stopRingReader();
+        {
+            RobotInstance::Binding binding(*robot);
+            SimClock::release(); //without the engine, time must keep running for the user program
+            auto instance = ReceiveDataManager::getInstance();
+            instance.first->deserializeDeep(ReceiveData::defaultPacket());
+            instance.first->updateDeep();
+            instance.second.unlock();
         }
+        try {
+            socket.close();
+        } catch(const std::exception&){}
+        startAccept();
     }
 }
@@ -1,40 +1,205 @@
 #include "sync_server.hpp"
+#include "io_recorder.hpp"
 #include "roborio_manager.hpp"
 #include "send_data.hpp"
+#include "sync_util.hpp"
 
-#include <unistd.h>
 #include <iostream>
 
 namespace hel {
+    constexpr std::chrono::milliseconds SyncServer::SEND_IDLE_TIMEOUT;
 
-    SyncServer::SyncServer(asio::io_service& io)   {
-        endpoint = asio::ip::tcp::endpoint(asio::ip::tcp::v4(), SEND_PORT);
-        startSync(io);
+    SyncServer::SyncServer(asio::io_context& io_context, unsigned max_send_rate):SyncServer(io_context, RobotInstance::getCurrent(), max_send_rate){}
+
+    SyncServer::SyncServer(asio::io_context& io_context, std::shared_ptr<RobotInstance> robot, unsigned max_send_rate):
+        io(io_context),
+        robot(robot),
+        acceptor(io_context, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), robot->getSendPort())),
+        socket(io_context),
+        negotiation_timer(io_context),
+        idle_timer(io_context),
+        rate_timer(io_context),
+        ring_retry_timer(io_context),
+        format(WireFormat::JSON),
+        connected(false),
+        write_in_progress(false),
+        send_pending(false),
+        rate_limited(false),
+        notify_posted(false),
+        outgoing(""),
+        min_send_interval(max_send_rate > 0 ? 1000000 / max_send_rate : 0),
+        ring(nullptr),
+        discarded()
+    {
+        RobotInstance::Binding binding(*robot);
+        SendDataManager::setNewDataListener([this](){
+            if(!notify_posted.exchange(true)){ //one pending notification is enough since sendLatest always serializes the latest outputs
+                asio::post(io, [this](){
+                    notify_posted = false;
+                    sendLatest();
+                });
+            }
+        });
+        startSync();
     }
 
-    void SyncServer::startSync(asio::io_service& io) {
-        while(1) {
-            asio::ip::tcp::socket socket(io);
-            asio::ip::tcp::acceptor acceptor(io, endpoint);
-            acceptor.accept(socket);
-            std::string data = "";
-            while(1) {
-                auto instance = SendDataManager::getInstance();
+    SyncServer::~SyncServer(){
+        RobotInstance::Binding binding(*robot);
+        SendDataManager::setNewDataListener(nullptr);
+    }
 
-                if(instance.first->hasNewData()){
-                    data = instance.first->serializeShallow();
-                    instance.second.unlock();
-                    try {
-                        asio::write(socket, asio::buffer(data), asio::transfer_all());
-                    } catch(std::system_error){
-                        std::cerr << "Synthesis warning: Sender socket disconnected. User code will continue to run.\n";
-                        break;
-                    }
+    void SyncServer::startSync() {
+        startAccept();
+    }
+
+    void SyncServer::startAccept() {
+        acceptor.async_accept(socket, [this](const auto& ec){
+            if(ec){
+                std::cerr << "Synthesis warning: Sender failed to accept a connection (" << ec.message() << ").\n";
+                startAccept();
+                return;
+            }
+            asyncNegotiateWireFormat(socket, negotiation_timer, [this](const std::string& name){
+                return attachRing(name);
+            }, [this](WireFormat f, Transport transport){
+                format = f;
+                if(transport == Transport::SHARED_MEMORY){
+                    startWatch();
                 } else {
+                    ring = nullptr; //negotiation failed after attaching
+                }
+                connected = true;
+                write_in_progress = false;
+                send_pending = false;
+                rate_limited = false;
+                {
+                    RobotInstance::Binding binding(*robot);
+                    auto instance = SendDataManager::getInstance();
+                    instance.first->requestKeyframe(); //the engine has not seen any previous packets
                     instance.second.unlock();
                 }
-                usleep(30000);
+                sendLatest();
+            });
+        });
+    }
+
+    void SyncServer::sendLatest() {
+        if(!connected){
+            return;
+        }
+        if(write_in_progress || rate_limited){
+            send_pending = true;
+            return;
+        }
+        send_pending = false;
+        {
+            RobotInstance::Binding binding(*robot);
+            auto instance = SendDataManager::getInstance();
+            outgoing = instance.first->serializeNext(format);
+            instance.second.unlock();
+        }
+        IORecorder::record(IORecorder::Direction::OUTPUT, format, robot->getID(), outgoing);
+        write_in_progress = true;
+        idle_timer.cancel();
+        if(ring){
+            writeToRing();
+            return;
+        }
+        asio::async_write(socket, asio::buffer(outgoing), [this](const auto& ec, std::size_t /*bytes_transferred*/){
+            write_in_progress = false;
+            if(ec){
+                std::cerr << "Synthesis warning: Sender socket disconnected. User code will continue to run.\n";
+                disconnect();
+                return;
+            }
+            finishWrite();
+        });
+    }
+
+    bool SyncServer::attachRing(const std::string& name) {
+        try {
+            ring = std::make_unique<ShmRing>(ShmRing::open(name));
+            return true;
+        } catch(const std::exception& ex){
+            std::cerr << "Synthesis warning: Sender could not attach to shared memory (" << ex.what() << "). Falling back to the socket.\n";
+            return false;
+        }
+    }
+
+    void SyncServer::writeToRing() {
+        if(outgoing.size() + ShmRing::LENGTH_PREFIX_SIZE > ring->capacity()){
+            std::cerr << "Synthesis warning: Sender packet is larger than the shared memory ring. User code will continue to run.\n";
+            write_in_progress = false;
+            disconnect();
+            return;
+        }
+        if(!ring->tryWrite(outgoing)){ //the engine is behind; a delta cannot be dropped, so the same packet is retried
+            ring_retry_timer.expires_after(SHM_FULL_RETRY_INTERVAL);
+            ring_retry_timer.async_wait([this](const auto& ec){
+                if(!ec){
+                    writeToRing();
+                }
+            });
+            return;
+        }
+        write_in_progress = false;
+        finishWrite();
+    }
+
+    void SyncServer::startWatch() {
+        socket.async_read_some(asio::buffer(discarded), [this](const auto& ec, std::size_t /*bytes_received*/){
+            if(ec == asio::error::operation_aborted){ //the connection was already closed
+                return;
             }
+            if(ec){
+                std::cerr << "Synthesis warning: Sender socket disconnected. User code will continue to run.\n";
+                disconnect();
+                return;
+            }
+            startWatch();
+        });
+    }
+
+    void SyncServer::finishWrite() {
+        if(min_send_interval.count() > 0){
+            rate_limited = true;
+            rate_timer.expires_after(min_send_interval);
+            rate_timer.async_wait([this](const auto& ec){
+                if(ec){
+                    return;
+                }
+                rate_limited = false;
+                if(send_pending){ //changes made during the interval are coalesced into one packet
+                    sendLatest();
+                } else {
+                    restartIdleTimer();
+                }
+            });
+        } else if(send_pending){
+            sendLatest();
+        } else {
+            restartIdleTimer();
         }
     }
+
+    void SyncServer::restartIdleTimer() {
+        idle_timer.expires_after(SEND_IDLE_TIMEOUT);
+        idle_timer.async_wait([this](const auto& ec){
+            if(!ec){
+                sendLatest(); //resend the cached packet so a dropped connection is noticed
+            }
+        });
+    }
+
+    void SyncServer::disconnect() {
+        connected = false;
+        idle_timer.cancel();
+        rate_timer.cancel();
+        ring_retry_timer.cancel();
+        ring = nullptr;
+        try {
+            socket.close();
+        } catch(const std::exception&){}
+        startAccept();
+    }
 }
@@ -0,0 +1,41 @@
+#include "sync_thread.hpp"
+#include "multiplexed_sync.hpp"
+#include "sync_client.hpp"
+#include "sync_server.hpp"
+
+#include <iostream>
+
+namespace hel{
+    SyncThread& SyncThread::getInstance(){
+        static SyncThread* sync_thread = new SyncThread();
+        return *sync_thread;
+    }
+
+    void SyncThread::attach(std::shared_ptr<RobotInstance> robot){
+        SyncThread& sync_thread = getInstance();
+        asio::post(sync_thread.io, [&sync_thread, robot](){
+            if(!sync_thread.attached.insert(robot->getID()).second){ //already multiplexed, or HAL created tGlobal more than once for this instance
+                return;
+            }
+            sync_thread.servers.emplace_back(new SyncServer(sync_thread.io, robot));
+            sync_thread.clients.emplace_back(new SyncClient(sync_thread.io, robot));
+        });
+    }
+
+    void SyncThread::multiplex(uint16_t port, std::vector<std::shared_ptr<RobotInstance>> robots){
+        SyncThread& sync_thread = getInstance();
+        asio::post(sync_thread.io, [&sync_thread, port, robots](){
+            std::vector<std::shared_ptr<RobotInstance>> unattached;
+            for(const std::shared_ptr<RobotInstance>& robot: robots){
+                if(sync_thread.attached.insert(robot->getID()).second){
+                    unattached.push_back(robot);
+                } else {
+                    std::cerr << "Synthesis warning: Robot " << robot->getID() << " already has an engine connection, so it will not be multiplexed on port " << port << ".\n";
+                }
+            }
+            sync_thread.sessions.emplace_back(new MultiplexedSync(sync_thread.io, port, unattached));
+        });
+    }
+
+    SyncThread::SyncThread():io(), work(asio::make_work_guard(io)), servers(), clients(), sessions(), attached(), thread([this](){ io.run(); }){}
+}
@@ -0,0 +1,161 @@
+#include "sync_util.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include "error.hpp"
+
+namespace hel{
+    namespace detail{
+        std::string binaryPacketMagic(){
+            std::string magic;
+            BinaryWriter writer(magic);
+            writer.write(BINARY_PACKET_MAGIC);
+            return magic;
+        }
+
+        constexpr unsigned NEGOTIATION_POLL_INTERVAL_MS = 1; //how often to check for the rest of a partially received handshake
+
+        /**
+         * \brief The state of one wire format negotiation, kept alive by its pending handlers
+         */
+
+        struct WireFormatNegotiation: public std::enable_shared_from_this<WireFormatNegotiation>{
+            asio::ip::tcp::socket& socket;
+            asio::steady_timer& timeout;
+            asio::steady_timer poll;
+            std::function<bool(const std::string&)> attach;
+            std::function<void(WireFormat, Transport)> handler;
+            std::array<char, BINARY_HEADER_SIZE + MAX_HANDSHAKE_PAYLOAD_SIZE> handshake; //header followed by the engine's schema version and optional ring name
+            bool done;
+
+            void start(){
+                auto self = shared_from_this();
+                timeout.expires_after(std::chrono::milliseconds(WIRE_FORMAT_NEGOTIATION_TIMEOUT_MS));
+                timeout.async_wait([self](const auto& ec){
+                    if(!ec){
+                        self->finish(WireFormat::JSON, Transport::SOCKET); //the engine never asked for the binary format
+                    }
+                });
+                waitForData();
+            }
+
+            void waitForData(){
+                auto self = shared_from_this();
+                socket.async_wait(asio::ip::tcp::socket::wait_read, [self](const auto& ec){
+                    if(ec){
+                        self->finish(WireFormat::JSON, Transport::SOCKET);
+                        return;
+                    }
+                    self->inspect();
+                });
+            }
+
+            void inspect(){
+                if(done){
+                    return;
+                }
+                try{
+                    const std::size_t AVAILABLE = socket.available();
+                    if(AVAILABLE == 0){ //the engine disconnected; the first read will notice
+                        finish(WireFormat::JSON, Transport::SOCKET);
+                        return;
+                    }
+                    const std::string MAGIC = binaryPacketMagic();
+                    const std::size_t PEEKED = socket.receive(asio::buffer(handshake, std::min(AVAILABLE, handshake.size())), asio::socket_base::message_peek);
+                    if(MAGIC.compare(0, std::min(PEEKED, MAGIC.size()), handshake.data(), std::min(PEEKED, MAGIC.size())) != 0){
+                        finish(WireFormat::JSON, Transport::SOCKET); //the engine started sending JSON
+                        return;
+                    }
+                    if(PEEKED < BINARY_HEADER_SIZE){
+                        waitForRest();
+                        return;
+                    }
+                    BinaryReader reader(handshake.data(), PEEKED);
+                    BinaryHeader header = readBinaryHeader(reader);
+                    if(header.type != BinaryPacketType::HANDSHAKE){
+                        finish(WireFormat::BINARY, Transport::SOCKET); //the engine skipped the handshake, but it is sending binary packets
+                        return;
+                    }
+                    if(header.payload_length < sizeof(uint16_t) || header.payload_length > MAX_HANDSHAKE_PAYLOAD_SIZE){
+                        throw BinaryParsingException("malformed handshake");
+                    }
+                    const std::size_t HANDSHAKE_SIZE = BINARY_HEADER_SIZE + header.payload_length;
+                    if(PEEKED < HANDSHAKE_SIZE){
+                        waitForRest();
+                        return;
+                    }
+                    asio::read(socket, asio::buffer(handshake, HANDSHAKE_SIZE));
+                    reader = BinaryReader(handshake.data() + BINARY_HEADER_SIZE, header.payload_length);
+
+                    const uint16_t VERSION = std::min(reader.read<uint16_t>(), BINARY_SCHEMA_VERSION);
+                    const bool RING_OFFERED = reader.remaining() > 0;
+                    bool attached = false;
+                    if(RING_OFFERED){
+                        const std::string RING_NAME = reader.readString();
+                        if(reader.remaining() != 0){
+                            throw BinaryParsingException("malformed handshake");
+                        }
+                        attached = attach(RING_NAME);
+                    }
+                    std::string reply;
+                    BinaryWriter writer(reply);
+                    std::size_t header_position = writer.beginPacket(BinaryPacketType::HANDSHAKE);
+                    writer.write(VERSION);
+                    if(RING_OFFERED){ //engines which did not offer a ring expect only the version
+                        writer.write(attached);
+                    }
+                    writer.endPacket(header_position);
+                    asio::write(socket, asio::buffer(reply), asio::transfer_all()); //small enough to never block on a fresh connection
+
+                    finish(VERSION == BINARY_SCHEMA_VERSION ? WireFormat::BINARY : WireFormat::JSON, attached ? Transport::SHARED_MEMORY : Transport::SOCKET);
+                } catch(const std::exception& ex){
+                    std::cerr << "Synthesis warning: Wire format negotiation failed (" << ex.what() << "). Falling back to JSON.\n";
+                    finish(WireFormat::JSON, Transport::SOCKET);
+                }
+            }
+
+            void waitForRest(){
+                auto self = shared_from_this();
+                poll.expires_after(std::chrono::milliseconds(NEGOTIATION_POLL_INTERVAL_MS));
+                poll.async_wait([self](const auto& ec){
+                    if(!ec){
+                        self->inspect();
+                    }
+                });
+            }
+
+            void finish(WireFormat format, Transport transport){
+                if(done){
+                    return;
+                }
+                done = true;
+                timeout.cancel();
+                poll.cancel();
+                try{
+                    socket.cancel(); //abandon the wait for data
+                } catch(const std::exception&){}
+                handler(format, transport);
+            }
+
+            WireFormatNegotiation(asio::ip::tcp::socket& s, asio::steady_timer& t, std::function<bool(const std::string&)> a, std::function<void(WireFormat, Transport)> h):socket(s), timeout(t), poll(t.get_executor()), attach(a), handler(h), handshake(), done(false){}
+        };
+    }
+
+    std::string asString(Transport transport){
+        switch(transport){
+        case Transport::SOCKET:
+            return "SOCKET";
+        case Transport::SHARED_MEMORY:
+            return "SHARED_MEMORY";
+        default:
+            throw UnhandledEnumConstantException("hel::Transport");
+        }
+    }
+
+    void asyncNegotiateWireFormat(asio::ip::tcp::socket& socket, asio::steady_timer& timer, std::function<bool(const std::string&)> attach, std::function<void(WireFormat, Transport)> handler){
+        std::make_shared<detail::WireFormatNegotiation>(socket, timer, attach, handler)->start();
+    }
+}
@@ -1,4 +1,5 @@
 #include "roborio_manager.hpp"
+#include "robot_instance.hpp"
 
 using namespace nFPGA;
 using namespace nRoboRIO_FPGANamespace;
@@ -19,37 +20,47 @@ namespace hel{
 #undef COPY
     }
 
-    struct SysWatchdogManager: public tSysWatchdog{
+    struct SysWatchdogManager: public tSysWatchdog, private InstanceBound{
         tSystemInterface* getSystemInterface(){ //unnecessary for emulation
             return new SystemInterface();
         }
 
         tStatus readStatus(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::WATCHDOG);
             instance.second.unlock();
             return instance.first->watchdog.getStatus();
         }
 
         bool readStatus_SystemActive(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::WATCHDOG);
             instance.second.unlock();
             return instance.first->watchdog.getStatus().SystemActive;
         }
 
         bool readStatus_PowerAlive(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::WATCHDOG);
             instance.second.unlock();
             return instance.first->watchdog.getStatus().PowerAlive;
         }
 
         uint16_t readStatus_SysDisableCount(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::WATCHDOG);
             instance.second.unlock();
             return instance.first->watchdog.getStatus().SysDisableCount;
         }
 
         uint16_t readStatus_PowerDisableCount(tRioStatusCode* /*status*/){
-            auto instance = RoboRIOManager::getInstance();
+            HEL_PROFILE_CALL();
+            RobotInstance::Binding binding(*robot);
+            auto instance = RoboRIOManager::getInstance(RoboRIO::Subsystem::WATCHDOG);
             instance.second.unlock();
             return instance.first->watchdog.getStatus().PowerDisableCount;
         }
@@ -57,24 +68,29 @@ namespace hel{
         void writeCommand(uint16_t /*value*/, tRioStatusCode* /*status*/){} //unnecessary for emulation
 
         uint16_t readCommand(tRioStatusCode* /*status*/){ //unnecessary for emulation
+            HEL_PROFILE_CALL();
             return 0;
         }
 
         uint8_t readChallenge(tRioStatusCode* /*status*/){ //unnecessary for emulation
+            HEL_PROFILE_CALL();
             return 0;
         }
 
         void writeActive(bool /*value*/, tRioStatusCode* /*status*/){} //unnecessary for emulation
 
         bool readActive(tRioStatusCode* /*status*/){ //unnecessary for emulation
+            HEL_PROFILE_CALL();
             return 0;
         }
 
         uint32_t readTimer(tRioStatusCode* /*status*/){ //unnecessary for emulation
+            HEL_PROFILE_CALL();
             return 0;
         }
 
         uint16_t readForcedKills(tRioStatusCode* /*status*/){ //unnecessary for emulation
+            HEL_PROFILE_CALL();
             return 0;
         }
     };
@@ -1,45 +1,46 @@
 #include "system_interface.hpp"
+#include "diagnostics.hpp"
 #include "error.hpp"
 
 using namespace nFPGA;
 
 namespace hel{
     const uint16_t SystemInterface::getExpectedFPGAVersion(){
-        std::cerr<<"Synthesis warning: Unsupported feature: Function call tSystem::getExpectedFPGAVersion\n";
+        HEL_WARN("Unsupported feature: Function call tSystem::getExpectedFPGAVersion");
         return 0;
     }
 
     const uint32_t SystemInterface::getExpectedFPGARevision(){
-        std::cerr<<"Synthesis warning: Unsupported feature: Function call tSystem::getExpectedFPGARevision\n";
+        HEL_WARN("Unsupported feature: Function call tSystem::getExpectedFPGARevision");
         return 0;
     }
 
     const uint32_t* const SystemInterface::getExpectedFPGASignature(){
-        std::cerr<<"Synthesis warning: Unsupported feature: Function call tSystem::getExpectedFPGASignature\n";
+        HEL_WARN("Unsupported feature: Function call tSystem::getExpectedFPGASignature");
         static const uint32_t i = 0;
         return &i;
     }
 
     void SystemInterface::getHardwareFpgaSignature(uint32_t* /*guid_ptr*/, tRioStatusCode* /*status*/){
-        std::cerr<<"Synthesis warning: Unsupported feature: Function call tSystem::getHardwareFpgaSignature\n";
+        HEL_WARN("Unsupported feature: Function call tSystem::getHardwareFpgaSignature");
     }
 
     uint32_t SystemInterface::getLVHandle(tRioStatusCode* /*status*/){
-        std::cerr<<"Synthesis warning: Unsupported feature: Function call tSystem::getLVHandle\n";
+        HEL_WARN("Unsupported feature: Function call tSystem::getLVHandle");
         return 0;
     }
 
     uint32_t SystemInterface::getHandle(){
-        std::cerr<<"Synthesis warning: Unsupported feature: Function call tSystem::getHandle\n";
+        HEL_WARN("Unsupported feature: Function call tSystem::getHandle");
         return 0;
     }
 
     void SystemInterface::reset(tRioStatusCode* /*status*/){
-        std::cerr<<"Synthesis warning: Unsupported feature: Function call tSystem::reset\n";
+        HEL_WARN("Unsupported feature: Function call tSystem::reset");
     }
 
     void SystemInterface::getDmaDescriptor(int /*dmaChannelDescriptorIndex*/, tDMAChannelDescriptor* /*desc*/){
-        std::cerr<<"Synthesis warning: Unsupported feature: Function call tSystem::getDmaDescriptor\n";
+        HEL_WARN("Unsupported feature: Function call tSystem::getDmaDescriptor");
     }
 }
 
@@ -0,0 +1,47 @@
+#include "gtest/gtest.h"
+#include "roborio_manager.hpp"
+#include "robot_instance.hpp"
+#include "sim_clock.hpp"
+
+#include <memory>
+
+using namespace nFPGA;
+using namespace nRoboRIO_FPGANamespace;
+
+TEST(AlarmTest, Deadline){
+    hel::Alarm alarm;
+    alarm.setTriggerTime(1500);
+    EXPECT_EQ(10000u + 1501u, alarm.getDeadline(10000, 11000)); //due once FPGA time passes 1500
+    EXPECT_EQ(12000u, alarm.getDeadline(10000, 12000)); //already passed
+    alarm.setTriggerTime(100);
+    EXPECT_EQ(10000u + (1ull << 32) + 101u, alarm.getDeadline(10000, 10000 + (1ull << 32) - 50)); //FPGA time wraps before the trigger time
+}
+
+TEST(AlarmTest, Trigger){
+    tRioStatusCode status = 0;
+    std::unique_ptr<tAlarm> alarm(tAlarm::create(&status));
+    hel::InterruptSystem& interrupts = hel::RobotInstance::current().getInterruptSystem();
+    const uint32_t MASK = 1u << hel::InterruptSystem::ALARM_IRQ;
+
+    hel::SimClock::advanceTo(0);
+    auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::GLOBAL);
+    const uint32_t FPGA_TIME = hel::Global::getCurrentTime() - instance.first->global.getFPGAStartTime();
+    instance.second.unlock();
+
+    alarm->writeTriggerTime(FPGA_TIME + 20000, &status);
+    alarm->writeEnable(true, &status);
+    hel::SimClock::advanceTo(20000);
+    EXPECT_EQ(0u, interrupts.wait(MASK, std::chrono::milliseconds(20), false)); //not yet past the trigger time
+    EXPECT_TRUE(alarm->readEnable(&status));
+
+    hel::SimClock::advanceTo(20001);
+    EXPECT_EQ(MASK, interrupts.wait(MASK, std::chrono::seconds(1), false));
+    EXPECT_FALSE(alarm->readEnable(&status)); //the alarm disables itself once it triggers
+
+    alarm->writeTriggerTime(FPGA_TIME + 30000, &status);
+    alarm->writeEnable(true, &status);
+    alarm->writeEnable(false, &status);
+    hel::SimClock::advanceTo(40000);
+    EXPECT_EQ(0u, interrupts.wait(MASK, std::chrono::milliseconds(20), false));
+    hel::SimClock::release();
+}
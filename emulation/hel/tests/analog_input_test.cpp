@@ -11,3 +11,29 @@ TEST(AnalogInputTest, ReadWriteConfig) {
     EXPECT_EQ(65536u, instance.first->analog_inputs.getConfig().ConvertRate);
     instance.second.unlock();
 }
+
+TEST(AnalogInputTest, AveragedRead){
+    hel::AnalogInputs analog_inputs;
+    EXPECT_EQ(0, analog_inputs.getAveragedValue(0));
+    analog_inputs.setAverageBits(0, 2);
+    analog_inputs.setOversampleBits(0, 1);
+    for(int32_t i = 1; i <= 4; i++){
+        analog_inputs.pushValue(0, i);
+    }
+    EXPECT_EQ(4, analog_inputs.getLatestValue(0));
+    EXPECT_EQ(2, analog_inputs.getAveragedValue(0)); //fewer samples than the window of 8
+    for(int32_t i = 5; i <= 1000; i++){
+        analog_inputs.pushValue(0, i);
+    }
+    EXPECT_EQ((993 + 1000) / 2, analog_inputs.getAveragedValue(0)); //the newest 8 samples, long after the history wrapped
+
+    analog_inputs.setAverageBits(0, 15); //clamped to the largest window kept
+    const int32_t WINDOW = 1 << hel::AnalogInputs::MAX_SAMPLE_BITS;
+    EXPECT_EQ((1000 - WINDOW + 1 + 1000) / 2, analog_inputs.getAveragedValue(0));
+
+    analog_inputs.setValues(1, {-3, -5, 7});
+    EXPECT_EQ(std::vector<int32_t>({-3, -5, 7}), analog_inputs.getValues(1));
+    EXPECT_EQ(7, analog_inputs.getAveragedValue(1)); //only the newest sample without any averaging bits
+    analog_inputs.setAverageBits(1, 2);
+    EXPECT_EQ(0, analog_inputs.getAveragedValue(1)); //-1/3 truncated towards zero
+}
@@ -0,0 +1,71 @@
+#include "gtest/gtest.h"
+#include "binary_util.hpp"
+#include "joystick.hpp"
+#include "send_data.hpp"
+#include <iostream>
+
+TEST(BinaryUtilTest, PrimitiveRoundTrip){
+    std::string packet;
+    hel::BinaryWriter writer(packet);
+    std::size_t header_position = writer.beginPacket(hel::BinaryPacketType::DEEP);
+    writer.write(static_cast<int8_t>(-118));
+    writer.write(static_cast<uint16_t>(0xBEEF));
+    writer.write(static_cast<int32_t>(-50));
+    writer.write(true);
+    writer.write(0.25f);
+    writer.write(-135.5);
+    writer.write(std::string("LLL"));
+    writer.endPacket(header_position);
+
+    EXPECT_TRUE(hel::isBinaryPacket(packet.data(), packet.size()));
+    EXPECT_FALSE(hel::isBinaryPacket("{\"roborio\":{}}", 14));
+
+    hel::BinaryReader reader(packet.data(), packet.size());
+    hel::BinaryHeader header = hel::readBinaryHeader(reader);
+    EXPECT_EQ(hel::BINARY_SCHEMA_VERSION, header.version);
+    EXPECT_EQ(hel::BinaryPacketType::DEEP, header.type);
+    EXPECT_EQ(packet.size() - hel::BINARY_HEADER_SIZE, header.payload_length);
+
+    EXPECT_EQ(-118, reader.read<int8_t>());
+    EXPECT_EQ(0xBEEF, reader.read<uint16_t>());
+    EXPECT_EQ(-50, reader.read<int32_t>());
+    EXPECT_TRUE(reader.readBool());
+    EXPECT_EQ(0.25f, reader.readFloat());
+    EXPECT_EQ(-135.5, reader.readDouble());
+    EXPECT_EQ("LLL", reader.readString());
+    EXPECT_EQ(0u, reader.remaining());
+    EXPECT_THROW(reader.read<uint8_t>(), hel::BinaryParsingException);
+}
+
+TEST(BinaryUtilTest, JoystickRoundTrip){
+    hel::Joystick joystick;
+    joystick.setName("Test Gamepad");
+    joystick.setButtons(0x2A5);
+    joystick.setButtonCount(10);
+    joystick.setAxes(std::array<int8_t, hel::Joystick::MAX_AXIS_COUNT>{{27,16,4,92,26,57,-25,-97,85,-92,45,-118}});
+    joystick.setAxisCount(12);
+    joystick.setPOVCount(1);
+    joystick.setRightRumble(0xFFFF);
+
+    std::string data;
+    hel::BinaryWriter writer(data);
+    joystick.serializeBinary(writer);
+
+    hel::BinaryReader reader(data.data(), data.size());
+    hel::Joystick deserialized = hel::Joystick::deserializeBinary(reader);
+    std::cout<<"Joystick: "<<deserialized.toString()<<"\n";
+
+    EXPECT_EQ(joystick.serialize(), deserialized.serialize());
+    EXPECT_EQ(0u, reader.remaining());
+}
+
+TEST(BinaryUtilTest, SerializeShallowBinary){
+    hel::SendData sender;
+    std::string packet = sender.serializeShallowBinary();
+
+    hel::BinaryReader reader(packet.data(), packet.size());
+    hel::BinaryHeader header = hel::readBinaryHeader(reader);
+    EXPECT_EQ(hel::BinaryPacketType::SHALLOW, header.type);
+    EXPECT_EQ(hel::PWMSystem::NUM_HDRS * sizeof(float) + 1, header.payload_length); //zeroed PWM outputs and no CAN motor controllers
+    EXPECT_LT(packet.size(), sender.serializeShallow().size() / 2);
+}
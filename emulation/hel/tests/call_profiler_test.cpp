@@ -0,0 +1,121 @@
+#define HEL_PROFILING //exercise the instrumentation macros regardless of how HEL was built
+
+#include "gtest/gtest.h"
+#include "call_profiler.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <thread>
+
+namespace{
+    const hel::CallProfiler::CallStats* findStats(const std::vector<hel::CallProfiler::CallStats>& stats, const std::string& name){
+        auto it = std::find_if(stats.begin(), stats.end(), [&](const hel::CallProfiler::CallStats& s){
+            return s.name == name;
+        });
+        return it == stats.end() ? nullptr : &*it;
+    }
+
+    struct ProfiledManager{
+        unsigned readValue(){
+            HEL_PROFILE_CALL();
+            HEL_PROFILE_LOCK_WAIT();
+            return 1;
+        }
+    };
+}
+
+TEST(CallProfilerTest, HistogramBuckets){
+    using Histogram = hel::CallProfiler::Histogram;
+    for(uint64_t value = 0; value < 100000; value++){ //buckets are contiguous and each value lies within its own
+        const unsigned BUCKET = Histogram::bucketOf(value);
+        EXPECT_LE(value, Histogram::bucketUpperBound(BUCKET));
+        if(BUCKET > 0){
+            EXPECT_GT(value, Histogram::bucketUpperBound(BUCKET - 1));
+        }
+    }
+    EXPECT_EQ(Histogram::NUM_BUCKETS - 1, Histogram::bucketOf(UINT64_MAX));
+    EXPECT_EQ(UINT64_MAX, Histogram::bucketUpperBound(Histogram::NUM_BUCKETS - 1));
+}
+
+TEST(CallProfilerTest, HistogramPercentiles){
+    hel::CallProfiler::Histogram histogram;
+    EXPECT_EQ(0u, histogram.percentile(0.5));
+    for(uint64_t value = 1; value <= 1000; value++){
+        histogram.record(value * 1000);
+    }
+    EXPECT_EQ(1000u, histogram.count);
+    EXPECT_DOUBLE_EQ(500500.0, histogram.mean());
+    EXPECT_EQ(1000000u, histogram.percentile(1.0));
+    for(double fraction: {0.5, 0.9, 0.99}){
+        const double EXACT = fraction * 1000000;
+        EXPECT_GE(histogram.percentile(fraction), EXACT);
+        EXPECT_LE(histogram.percentile(fraction), EXACT * (1.0 + 1.0 / hel::CallProfiler::Histogram::SUB_BUCKETS));
+    }
+
+    hel::CallProfiler::Histogram other;
+    other.record(5000000);
+    histogram.merge(other);
+    EXPECT_EQ(1001u, histogram.count);
+    EXPECT_EQ(5000000u, histogram.max);
+}
+
+TEST(CallProfilerTest, SiteName){
+    EXPECT_EQ("PWMManager::writeHdr", hel::CallProfiler::siteName("virtual void hel::PWMManager::writeHdr(uint8_t, uint16_t, tRioStatusCode*)"));
+    EXPECT_EQ("FRC_NetworkCommunication_getJoystickAxes", hel::CallProfiler::siteName("int FRC_NetworkCommunication_getJoystickAxes(uint8_t, JoystickAxes_t*, uint8_t)"));
+    EXPECT_EQ("DIOManager::readDI", hel::CallProfiler::siteName("std::pair<int, std::vector<int> > hel::DIOManager::readDI(tRioStatusCode*)"));
+}
+
+TEST(CallProfilerTest, LockWaitAttribution){
+    const std::size_t OUTER = hel::CallProfiler::registerSite("void hel::ProfilerTestManager::outer()");
+    const std::size_t INNER = hel::CallProfiler::registerSite("void hel::ProfilerTestManager::inner()");
+    constexpr unsigned THREADS = 4;
+    std::vector<std::thread> threads;
+    for(unsigned t = 0; t < THREADS; t++){
+        threads.emplace_back([&](){
+            hel::CallProfiler::ScopedCall outer(OUTER);
+            {
+                hel::CallProfiler::LockWait wait;
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+            hel::CallProfiler::ScopedCall inner(INNER); //waits in nested calls belong to the nested call only
+            hel::CallProfiler::LockWait wait;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        });
+    }
+    for(std::thread& thread: threads){
+        thread.join();
+    }
+    {
+        hel::CallProfiler::LockWait wait;
+    }
+
+    const std::vector<hel::CallProfiler::CallStats> STATS = hel::CallProfiler::snapshot();
+    const hel::CallProfiler::CallStats* outer = findStats(STATS, "ProfilerTestManager::outer");
+    const hel::CallProfiler::CallStats* inner = findStats(STATS, "ProfilerTestManager::inner");
+    ASSERT_NE(nullptr, outer);
+    ASSERT_NE(nullptr, inner);
+    EXPECT_EQ(THREADS, outer->threads);
+    EXPECT_EQ(THREADS, outer->latency.count);
+    EXPECT_GE(outer->lock_wait.percentile(0.0), 2000000u);
+    EXPECT_LE(outer->lock_wait.sum + THREADS * 1000000u, outer->latency.sum); //the inner call's wait is not charged again
+    EXPECT_GE(outer->latency.percentile(0.0), 3000000u);
+    EXPECT_GE(inner->lock_wait.percentile(0.0), 1000000u);
+    EXPECT_NE(nullptr, findStats(STATS, hel::CallProfiler::UNATTRIBUTED_SITE_NAME));
+    EXPECT_GE(STATS.front().latency.sum, STATS.back().latency.sum);
+
+    std::ostringstream report;
+    hel::CallProfiler::writeReport(report);
+    EXPECT_NE(std::string::npos, report.str().find("ProfilerTestManager::outer"));
+}
+
+TEST(CallProfilerTest, Macros){
+    ProfiledManager manager;
+    for(unsigned i = 0; i < 10; i++){
+        manager.readValue();
+    }
+    const std::vector<hel::CallProfiler::CallStats> STATS = hel::CallProfiler::snapshot();
+    const hel::CallProfiler::CallStats* stats = findStats(STATS, "{anonymous}::ProfiledManager::readValue");
+    ASSERT_NE(nullptr, stats);
+    EXPECT_EQ(10u, stats->latency.count);
+    EXPECT_EQ(10u, stats->lock_wait.count);
+}
@@ -0,0 +1,61 @@
+#include "gtest/gtest.h"
+#include "binary_util.hpp"
+#include "can_motor_controller_table.hpp"
+
+TEST(CANMotorControllerTableTest, Slots){
+    hel::CANMotorControllerTable table;
+    EXPECT_TRUE(table.empty());
+    EXPECT_EQ(nullptr, table.find(hel::CANDevice::Type::TALON_SRX, 4));
+
+    table.emplace(hel::CANDevice::Type::TALON_SRX, 4).setPercentOutput(0.5);
+    table.emplace(hel::CANDevice::Type::VICTOR_SPX, 4).setPercentOutput(-0.25); //the same ID on another type is another device
+    table.emplace(hel::CANDevice::Type::TALON_SRX, 62);
+    EXPECT_EQ(3u, table.size());
+    ASSERT_NE(nullptr, table.find(hel::CANDevice::Type::TALON_SRX, 4));
+    EXPECT_DOUBLE_EQ(0.5, table.find(hel::CANDevice::Type::TALON_SRX, 4)->getPercentOutput());
+    EXPECT_DOUBLE_EQ(0.5, table.emplace(hel::CANDevice::Type::TALON_SRX, 4).getPercentOutput()); //emplacing an existing device keeps its outputs
+    EXPECT_EQ(nullptr, table.find(hel::CANDevice::Type::PCM, 4));
+    EXPECT_THROW(table.emplace(hel::CANDevice::Type::PDP, 0), std::out_of_range);
+
+    std::vector<std::pair<hel::CANDevice::Type, unsigned>> visited;
+    for(const hel::CANMotorController& controller: table){
+        visited.emplace_back(controller.getType(), controller.getID());
+    }
+    const std::vector<std::pair<hel::CANDevice::Type, unsigned>> EXPECTED = {
+        {hel::CANDevice::Type::VICTOR_SPX, 4},
+        {hel::CANDevice::Type::TALON_SRX, 4},
+        {hel::CANDevice::Type::TALON_SRX, 62}
+    };
+    EXPECT_EQ(EXPECTED, visited);
+
+    hel::CANMotorControllerTable copy = table;
+    table.clear();
+    EXPECT_TRUE(table.empty());
+    EXPECT_EQ(3u, copy.size());
+}
+
+TEST(CANMotorControllerTableTest, BinaryRoundTrip){
+    hel::CANMotorControllerTable table;
+    table.emplace(hel::CANDevice::Type::TALON_SRX, 1).setPercentOutput(0.75);
+    table.emplace(hel::CANDevice::Type::VICTOR_SPX, 2).setInverted(true);
+    table.emplace(hel::CANDevice::Type::TALON_SRX, 3);
+
+    hel::CANMotorControllerTable::SlotMask selected;
+    selected.set(hel::CANMotorControllerTable::slotOf(hel::CANDevice::Type::TALON_SRX, 1));
+
+    std::string packet;
+    hel::BinaryWriter writer(packet);
+    table.serializeBinary(writer);
+    table.serializeBinary(writer, selected);
+
+    hel::BinaryReader reader(packet.data(), packet.size());
+    hel::CANMotorControllerTable all;
+    all.deserializeBinary(reader);
+    EXPECT_EQ(table.occupancy(), all.occupancy());
+    EXPECT_EQ(table.toString(), all.toString());
+
+    hel::CANMotorControllerTable some;
+    some.deserializeBinary(reader);
+    EXPECT_EQ(selected, some.occupancy());
+    EXPECT_EQ(0u, reader.remaining());
+}
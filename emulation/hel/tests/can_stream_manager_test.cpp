@@ -0,0 +1,141 @@
+#include "gtest/gtest.h"
+#include "can_device.hpp"
+#include "can_stream_manager.hpp"
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+static hel::CANStreamManager::Message makeFrame(uint32_t message_id, uint8_t value){
+    return {message_id, 0, {value}, 1};
+}
+
+TEST(CANStreamManagerTest, RingOrder){
+    hel::MPMCRing<uint32_t> ring(100);
+    EXPECT_EQ(100u, ring.getCapacity());
+    constexpr uint32_t PRODUCERS = 4;
+    constexpr uint32_t COUNT = 20000;
+    std::vector<std::thread> producers;
+    for(uint32_t p = 0; p < PRODUCERS; p++){
+        producers.emplace_back([&ring, p](){
+            for(uint32_t i = 0; i < COUNT; i++){
+                while(!ring.push(p * COUNT + i)){
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    std::array<uint32_t, PRODUCERS> next = {};
+    std::array<uint32_t, 16> batch;
+    for(uint32_t received = 0; received < PRODUCERS * COUNT;){
+        const std::size_t READ = ring.pop(batch.data(), batch.size());
+        if(READ == 0){
+            std::this_thread::yield();
+        }
+        for(std::size_t i = 0; i < READ; i++){
+            const uint32_t PRODUCER = batch[i] / COUNT;
+            ASSERT_EQ(next[PRODUCER], batch[i] % COUNT); //each producer's values arrive in the order it pushed them
+            next[PRODUCER]++;
+        }
+        received += READ;
+    }
+    for(std::thread& producer: producers){
+        producer.join();
+    }
+    EXPECT_EQ(0u, ring.size());
+}
+
+TEST(CANStreamManagerTest, Sessions){
+    const uint32_t TALON_1 = 0x02041401;
+    const uint32_t TALON_2 = 0x02041402;
+    const uint32_t session_all = hel::CANStreamManager::open(0, TALON_1, 0xFFFFFFC0, 3); //status frames of every Talon
+    const uint32_t session_one = hel::CANStreamManager::open(0, TALON_2, 0xFFFFFFFF, 8);
+    const uint32_t session_other_robot = hel::CANStreamManager::open(1, TALON_1, 0xFFFFFFFF, 8);
+    EXPECT_NE(0u, session_all);
+    EXPECT_TRUE(hel::CANStreamManager::hasSessions());
+
+    hel::CANStreamManager::publish(0, makeFrame(TALON_1, 1));
+    hel::CANStreamManager::publish(0, makeFrame(TALON_2, 2));
+    hel::CANStreamManager::publish(0, makeFrame(0x09041401, 3)); //a PCM frame matches no session
+
+    std::array<hel::CANStreamManager::Message, 8> messages;
+    bool overrun = true;
+    ASSERT_EQ(2u, hel::CANStreamManager::read(0, session_all, messages.data(), messages.size(), overrun));
+    EXPECT_FALSE(overrun);
+    EXPECT_EQ(TALON_1, messages[0].message_id);
+    EXPECT_EQ(2, messages[1].data[0]);
+    ASSERT_EQ(1u, hel::CANStreamManager::read(0, session_one, messages.data(), messages.size(), overrun));
+    EXPECT_EQ(TALON_2, messages[0].message_id);
+    EXPECT_EQ(0u, hel::CANStreamManager::read(1, session_other_robot, messages.data(), messages.size(), overrun));
+
+    for(uint8_t i = 0; i < 5; i++){
+        hel::CANStreamManager::publish(0, makeFrame(TALON_1, i));
+    }
+    ASSERT_EQ(3u, hel::CANStreamManager::read(0, session_all, messages.data(), messages.size(), overrun)); //the newest frames are dropped once the session is full
+    EXPECT_TRUE(overrun);
+    EXPECT_EQ(0, messages[0].data[0]);
+    EXPECT_EQ(2, messages[2].data[0]);
+    EXPECT_EQ(0u, hel::CANStreamManager::read(0, session_all, messages.data(), messages.size(), overrun));
+    EXPECT_FALSE(overrun);
+    EXPECT_THROW(hel::CANStreamManager::read(1, session_all, messages.data(), messages.size(), overrun), std::out_of_range); //another robot's session
+
+    hel::CANStreamManager::close(1, session_all); //another robot cannot close it either
+    EXPECT_EQ(0u, hel::CANStreamManager::read(0, session_all, messages.data(), messages.size(), overrun));
+    hel::CANStreamManager::close(0, session_all);
+    hel::CANStreamManager::close(0, session_one);
+    hel::CANStreamManager::close(1, session_other_robot);
+    EXPECT_FALSE(hel::CANStreamManager::hasSessions());
+    EXPECT_THROW(hel::CANStreamManager::read(0, session_all, messages.data(), messages.size(), overrun), std::out_of_range);
+    hel::CANStreamManager::close(0, session_all); //closing twice is harmless
+}
+
+TEST(CANStreamManagerTest, CloseWhileReading){
+    const uint32_t TALON_1 = 0x02041401;
+    const uint32_t session = hel::CANStreamManager::open(0, TALON_1, 0xFFFFFFFF, 64);
+    std::atomic<bool> closed(false);
+    std::thread reader([&](){
+        std::array<hel::CANStreamManager::Message, 8> messages;
+        bool overrun = false;
+        try{
+            while(true){
+                hel::CANStreamManager::read(0, session, messages.data(), messages.size(), overrun);
+            }
+        } catch(const std::out_of_range&){
+            closed = true; //the reader sees the session closed instead of a freed ring
+        }
+    });
+    for(uint8_t i = 0; i < 100; i++){
+        hel::CANStreamManager::publish(0, makeFrame(TALON_1, i));
+    }
+    hel::CANStreamManager::close(0, session);
+    reader.join();
+    EXPECT_TRUE(closed);
+    EXPECT_FALSE(hel::CANStreamManager::hasSessions());
+}
+
+TEST(CANStreamManagerTest, CloseWhilePublishing){
+    const uint32_t TALON_1 = 0x02041401;
+    const uint32_t session = hel::CANStreamManager::open(0, TALON_1, 0xFFFFFFFF, 16);
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> publishers;
+    for(unsigned i = 0; i < 4; i++){
+        publishers.emplace_back([&](){
+            while(!stop){
+                hel::CANStreamManager::publish(0, makeFrame(TALON_1, 0));
+            }
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    hel::CANStreamManager::close(0, session); //must not free the ring under a publisher
+    stop = true;
+    for(std::thread& publisher: publishers){
+        publisher.join();
+    }
+    EXPECT_FALSE(hel::CANStreamManager::hasSessions());
+}
+
+TEST(CANStreamManagerTest, StatusFrameID){
+    EXPECT_EQ(0x02041401u, hel::CANDevice::replaceAPI(0x02040081, 0b1010000000000));
+    EXPECT_EQ(hel::CANDevice::Type::TALON_SRX, hel::CANDevice::pullDeviceType(hel::CANDevice::replaceAPI(0x02040081, 0b1010000000000)));
+}
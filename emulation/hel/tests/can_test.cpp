@@ -12,7 +12,7 @@ TEST(CANTest, IDs){
     auto instance = hel::RoboRIOManager::getInstance();
     //ctre::phoenix::motorcontrol::can::WPI_TalonSRX talon = {1};
     auto can_motor_controllers = instance.first->can_motor_controllers;
-    std::cout<<"can_motor_controllers:" + hel::asString(can_motor_controllers, std::function<std::string(std::pair<uint32_t,hel::CANMotorController>)>([&](std::pair<uint32_t, hel::CANMotorController> a){ return "[" + std::to_string(a.first) + ", " + a.second.toString() + "]";}))<<"\n";
+    std::cout<<"can_motor_controllers:" + can_motor_controllers.toString()<<"\n";
     EXPECT_EQ(1, 1); //TODO
     instance.second.unlock();
 }
@@ -0,0 +1,37 @@
+#include "gtest/gtest.h"
+#include "diagnostics.hpp"
+
+#include <cstdlib>
+#include <sstream>
+
+static void raiseWarning(){
+    HEL_WARN("diagnostics test warning");
+}
+
+TEST(DiagnosticsTest, Summaries){
+    setenv(hel::Diagnostics::FLUSH_PERIOD_VARIABLE.c_str(), "3600000", 1); //keep the background flusher from taking the reports first
+
+    const std::size_t ID = hel::Diagnostics::registerWarning("diagnostics test registered warning");
+    EXPECT_EQ(ID, hel::Diagnostics::registerWarning("diagnostics test registered warning"));
+    EXPECT_NE(ID, hel::Diagnostics::registerWarning("diagnostics test other warning"));
+
+    raiseWarning();
+    hel::Diagnostics::report(ID);
+    hel::Diagnostics::report(ID);
+    std::ostringstream first;
+    hel::Diagnostics::flush(first);
+    EXPECT_NE(std::string::npos, first.str().find("Synthesis warning: diagnostics test warning\n")); //reported once, so printed as is
+    EXPECT_NE(std::string::npos, first.str().find("Synthesis warning: diagnostics test registered warning (2 times in the last"));
+    EXPECT_EQ(std::string::npos, first.str().find("other warning")); //never reported
+
+    std::ostringstream quiet;
+    hel::Diagnostics::flush(quiet);
+    EXPECT_EQ("", quiet.str());
+
+    for(unsigned i = 0; i < 1000; i++){
+        raiseWarning();
+    }
+    std::ostringstream repeated;
+    hel::Diagnostics::flush(repeated);
+    EXPECT_NE(std::string::npos, repeated.str().find("Synthesis warning: diagnostics test warning (1000 times in the last"));
+}
@@ -0,0 +1,27 @@
+#include "gtest/gtest.h"
+#include "roborio_manager.hpp"
+
+TEST(EncoderSourceIndexTest, Find){
+    using PortType = hel::EncoderManager::PortType;
+    hel::EncoderSourceIndex index;
+    uint8_t device = 0xFF;
+    EXPECT_TRUE(index.find(hel::EncoderManager{0, PortType::DI, 0, PortType::DI}, device)); //unconfigured devices default to channel 0
+    EXPECT_EQ(0u, device);
+
+    index.set(0, 2, false, false, 3, false, false);
+    index.set(3, 2, true, false, 3, true, false); //on the MXP
+    index.set(5, 1, false, true, 2, false, true); //analog triggers
+    EXPECT_TRUE(index.find(hel::EncoderManager{2, PortType::DI, 3, PortType::DI}, device));
+    EXPECT_EQ(0u, device);
+    EXPECT_TRUE(index.find(hel::EncoderManager{12, PortType::DI, 13, PortType::DI}, device));
+    EXPECT_EQ(3u, device);
+    EXPECT_FALSE(index.find(hel::EncoderManager{1, PortType::DI, 2, PortType::DI}, device));
+    EXPECT_TRUE(index.find(hel::EncoderManager{1, PortType::AI, 2, PortType::AI}, device));
+    EXPECT_EQ(5u, device);
+    EXPECT_FALSE(index.find(hel::EncoderManager{200, PortType::DI, 3, PortType::DI}, device));
+
+    index.set(0, 4, false, false, 5, false, false); //reconfiguring a device moves it
+    EXPECT_TRUE(index.find(hel::EncoderManager{4, PortType::DI, 5, PortType::DI}, device));
+    EXPECT_EQ(0u, device);
+    EXPECT_FALSE(index.find(hel::EncoderManager{2, PortType::DI, 3, PortType::DI}, device));
+}
@@ -0,0 +1,47 @@
+#include "gtest/gtest.h"
+#include "frame_reader.hpp"
+#include "json_util.hpp"
+#include "send_data.hpp"
+
+namespace{
+    void feed(hel::FrameReader& reader, const std::string& data){
+        std::pair<char*, std::size_t> space = reader.prepare(data.size());
+        std::copy(data.begin(), data.end(), space.first);
+        reader.commit(data.size());
+    }
+}
+
+TEST(FrameReaderTest, FragmentedJSON){
+    const std::string PACKET = "{\"roborio\":{\"digital_hdrs\":[0,1,0,0,1,0,0,1,0,0]}}";
+    const std::string STREAM = "junk{\"rob" + PACKET + hel::JSON_PACKET_SUFFIX + PACKET + hel::JSON_PACKET_SUFFIX;
+
+    hel::FrameReader reader(hel::WireFormat::JSON, 16);
+    hel::StringView frame;
+    std::vector<std::string> frames;
+    for(char c: STREAM){ //one byte at a time, the worst possible fragmentation
+        feed(reader, std::string(1, c));
+        while(reader.next(frame)){
+            frames.push_back(frame.toString());
+        }
+    }
+    ASSERT_EQ(2u, frames.size());
+    EXPECT_EQ(PACKET, frames[0]);
+    EXPECT_EQ(PACKET, frames[1]);
+    EXPECT_EQ(0u, reader.buffered());
+}
+
+TEST(FrameReaderTest, BinaryResynchronize){
+    hel::SendData sender;
+    const std::string PACKET = sender.serializeShallowBinary();
+    std::string corrupt = PACKET.substr(0, hel::BINARY_HEADER_SIZE);
+    corrupt[hel::BINARY_HEADER_SIZE - 1] = '\x7F'; //an impossible payload length
+
+    hel::FrameReader reader(hel::WireFormat::BINARY);
+    feed(reader, corrupt + PACKET.substr(0, 7));
+    hel::StringView frame;
+    EXPECT_FALSE(reader.next(frame));
+    feed(reader, PACKET.substr(7) + "\x01\x02");
+    ASSERT_TRUE(reader.next(frame));
+    EXPECT_EQ(PACKET, frame.toString());
+    EXPECT_FALSE(reader.next(frame));
+}
@@ -0,0 +1,61 @@
+#include "gtest/gtest.h"
+#include "interrupt_system.hpp"
+
+#include <thread>
+
+using namespace nFPGA;
+using namespace nRoboRIO_FPGANamespace;
+
+static tInterrupt::tConfig makeConfig(uint8_t channel, bool rising, bool falling){
+    tInterrupt::tConfig config = {};
+    config.Source_Channel = channel;
+    config.RisingEdge = rising;
+    config.FallingEdge = falling;
+    return config;
+}
+
+TEST(InterruptTest, Edges){
+    hel::InterruptSystem interrupts;
+    interrupts.setConfig(2, makeConfig(3, true, true));
+    const uint32_t MASK = hel::InterruptSystem::maskOf(2);
+
+    EXPECT_EQ(0u, interrupts.wait(MASK, std::chrono::microseconds(0), false));
+    interrupts.updateHeaders(0b0000, 0b1000, 1500);
+    interrupts.updateHeaders(0b1000, 0b1001, 1600); //other channels do not trigger it
+    EXPECT_EQ(1u << 2, interrupts.wait(MASK, std::chrono::microseconds(0), false));
+    EXPECT_EQ(1500u, interrupts.getRisingTimeStamp(2));
+
+    interrupts.updateHeaders(0b1001, 0b0001, 2500);
+    EXPECT_EQ(1u << (2 + hel::InterruptSystem::FALLING_EDGE_SHIFT), interrupts.wait(MASK, std::chrono::microseconds(0), false));
+    EXPECT_EQ(2500u, interrupts.getFallingTimeStamp(2));
+    EXPECT_EQ(0u, interrupts.wait(MASK, std::chrono::microseconds(0), false)); //waiting acknowledges the edge
+
+    interrupts.updateHeaders(0b0001, 0b1001, 3500);
+    EXPECT_EQ(0u, interrupts.wait(MASK, std::chrono::microseconds(0), true)); //ignoring edges from before the wait
+}
+
+TEST(InterruptTest, BlockingWait){
+    hel::InterruptSystem interrupts;
+    interrupts.setConfig(0, makeConfig(0, true, false));
+    const uint32_t MASK = hel::InterruptSystem::maskOf(0);
+
+    std::chrono::steady_clock::time_point edge_time;
+    std::thread engine([&](){
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        edge_time = std::chrono::steady_clock::now();
+        interrupts.updateHeaders(0, 1, 20000);
+    });
+    EXPECT_EQ(1u, interrupts.wait(MASK, std::chrono::microseconds(-1), false));
+    const auto WAKE_LATENCY = std::chrono::steady_clock::now() - edge_time;
+    engine.join();
+    EXPECT_LT(WAKE_LATENCY, std::chrono::milliseconds(5));
+
+    std::atomic<bool> active(true);
+    std::thread disabler([&](){
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        active = false;
+        interrupts.release(MASK);
+    });
+    EXPECT_EQ(0u, interrupts.wait(MASK, std::chrono::microseconds(-1), false, &active)); //released without an edge
+    disabler.join();
+}
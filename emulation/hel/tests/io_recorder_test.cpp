@@ -0,0 +1,127 @@
+#include "gtest/gtest.h"
+#include "io_recorder.hpp"
+#include "io_replayer.hpp"
+#include "roborio_manager.hpp"
+#include "send_data.hpp"
+#include "sim_clock.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace nFPGA;
+using namespace nRoboRIO_FPGANamespace;
+
+TEST(IORecorderTest, LogRoundTrip){
+    std::string log = hel::IORecorder::LOG_MAGIC;
+    log.push_back(static_cast<char>(hel::IORecorder::LOG_VERSION));
+    hel::IORecorder::appendRecord(log, hel::IORecorder::Direction::INPUT, hel::WireFormat::JSON, 0, 20000, std::string("{\"roborio\":{}}"));
+    hel::IORecorder::appendRecord(log, hel::IORecorder::Direction::OUTPUT, hel::WireFormat::BINARY, 3, 40000, std::string("\x01\x02\x00", 3));
+
+    std::istringstream input(log);
+    std::vector<hel::IORecorder::Record> records = hel::IORecorder::readLog(input);
+    ASSERT_EQ(2u, records.size());
+    EXPECT_EQ(hel::IORecorder::Direction::INPUT, records[0].direction);
+    EXPECT_EQ(hel::WireFormat::JSON, records[0].format);
+    EXPECT_EQ(0u, records[0].robot_id);
+    EXPECT_EQ(20000u, records[0].time);
+    EXPECT_EQ("{\"roborio\":{}}", records[0].packet);
+    EXPECT_EQ(hel::IORecorder::Direction::OUTPUT, records[1].direction);
+    EXPECT_EQ(hel::WireFormat::BINARY, records[1].format);
+    EXPECT_EQ(3u, records[1].robot_id);
+    EXPECT_EQ(40000u, records[1].time);
+    EXPECT_EQ(std::string("\x01\x02\x00", 3), records[1].packet);
+
+    std::istringstream truncated(log.substr(0, log.size() - 1)); //as if the program was killed mid-write
+    EXPECT_EQ(1u, hel::IORecorder::readLog(truncated).size());
+
+    std::istringstream not_a_log("{\"roborio\":{}}");
+    EXPECT_THROW(hel::IORecorder::readLog(not_a_log), std::invalid_argument);
+}
+
+TEST(IORecorderTest, BackgroundWrite){
+    const std::string PATH = "io_recorder_test.helr";
+    {
+        hel::IORecorder recorder(PATH);
+        for(unsigned i = 0; i < 1000; i++){
+            recorder.append(i % 2 == 0 ? hel::IORecorder::Direction::INPUT : hel::IORecorder::Direction::OUTPUT, hel::WireFormat::BINARY, 0, std::to_string(i));
+        }
+        recorder.flush();
+
+        std::ifstream file(PATH, std::ios::binary);
+        std::vector<hel::IORecorder::Record> records = hel::IORecorder::readLog(file);
+        ASSERT_EQ(1000u, records.size());
+        for(unsigned i = 0; i < records.size(); i++){
+            EXPECT_EQ(std::to_string(i), records[i].packet);
+        }
+    }
+    std::remove(PATH.c_str());
+}
+
+TEST(IORecorderTest, DecodeOutputs){
+    hel::hal_is_initialized.store(true);
+    hel::SendData a = {};
+    a.enable(true);
+    a.updateDeep();
+    hel::SendData seen = {};
+    seen.deserializeBinary(a.serializeShallowDelta());
+
+    {
+        auto instance = hel::RoboRIOManager::getInstance();
+        instance.first->pwm_system.setHdrPulseWidth(5, 2000);
+        instance.second.unlock();
+    }
+    a.updateShallow();
+    seen.deserializeBinary(a.serializeShallowDelta());
+    EXPECT_NE(hel::SendData().toString(), seen.toString());
+
+    a.requestKeyframe();
+    hel::SendData expected = {};
+    expected.deserializeBinary(a.serializeShallowDelta());
+    EXPECT_EQ(expected.toString(), seen.toString()); //applying each delta in turn gives the same outputs as a keyframe
+}
+
+TEST(IORecorderTest, Replay){
+    hel::hal_is_initialized.store(true);
+    tRelay* relay = tRelay::create(nullptr);
+    relay->writeValue_Forward(1u << 2, nullptr);
+    tDIO* dio = tDIO::create(nullptr);
+    dio->writeOutputEnable_Headers(1u << 3, nullptr);
+    dio->writeDO_Headers(1u << 3, nullptr);
+    {
+        auto instance = hel::SendDataManager::getInstance();
+        instance.first->enable(true);
+        instance.second.unlock();
+    }
+
+    std::atomic<bool> done(false);
+    std::thread user_program([&](){
+        while(!done){
+            hel::SimClock::startUserLoop(); //the outputs above stay set, as a program setting them every loop would leave them
+        }
+    });
+
+    uint64_t time = 0;
+    for(hel::WireFormat format: {hel::WireFormat::BINARY, hel::WireFormat::JSON}){
+        hel::SendData recorded = {}; //the outputs an identical run sent to the engine
+        recorded.enable(true);
+        recorded.updateDeep();
+        std::vector<hel::IORecorder::Record> log;
+        for(unsigned i = 0; i < 3; i++){
+            time += 20000;
+            log.push_back({hel::IORecorder::Direction::INPUT, hel::WireFormat::JSON, 0, time, "{\"roborio\":{}}"});
+            log.push_back({hel::IORecorder::Direction::OUTPUT, format, 0, time, recorded.serializeNext(format)});
+        }
+
+        hel::IOReplayer::ReplayReport report = hel::IOReplayer(log, 0).run();
+        EXPECT_LT(0u, report.checks);
+        EXPECT_TRUE(report.mismatches.empty()) << report.toString();
+    }
+
+    done = true;
+    hel::SimClock::setLoopBarrier(false);
+    user_program.join();
+    hel::SimClock::release();
+}
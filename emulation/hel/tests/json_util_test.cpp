@@ -1,5 +1,7 @@
 #include "gtest/gtest.h"
 #include "json_util.hpp"
+#include "json_schema.hpp"
+#include <cmath>
 #include <iostream>
 
 struct Joystick{
@@ -73,3 +75,154 @@ TEST(JSONUtilTest, FormatJSONTest){
     std::cout<<"Formated JSON:\n"<<hel::formatJSON(INPUT)<<"\n";
     
 }
+
+TEST(JSONUtilTest, JSONReaderTest){
+    const std::string INPUT = "{\"can\":\"no\", \"dio\":[0, 1,true,1,  false],\"skipped\":{\"a\":[1,{\"b\":\"}\"}]},\"pwm\":-0.500,\"joystick\":{\"is_xbox\":1,\"name\":\"Maxwell\"},\"encoder\":null}";
+    hel::JSONReader reader(INPUT);
+    hel::BoundsCheckedArray<bool, 5> dio(false);
+    hel::StringView label;
+
+    reader.beginObject();
+    ASSERT_TRUE(reader.nextField(label));
+    EXPECT_EQ(label, hel::StringView("can", 3));
+    EXPECT_EQ(reader.readString(), hel::StringView("no", 2));
+
+    ASSERT_TRUE(reader.nextField(label));
+    EXPECT_EQ(label, hel::StringView("dio", 3));
+    hel::deserializeList(reader, dio, [](hel::JSONReader& r){ return r.readBool(); });
+    EXPECT_FALSE(dio[0]);
+    EXPECT_TRUE(dio[1]);
+    EXPECT_TRUE(dio[2]);
+    EXPECT_TRUE(dio[3]);
+    EXPECT_FALSE(dio[4]);
+
+    ASSERT_TRUE(reader.nextField(label));
+    EXPECT_EQ(label, hel::StringView("skipped", 7));
+    reader.skipValue();
+
+    ASSERT_TRUE(reader.nextField(label));
+    EXPECT_EQ(label, hel::StringView("pwm", 3));
+    EXPECT_EQ(reader.readDouble(), -0.5);
+
+    ASSERT_TRUE(reader.nextField(label));
+    EXPECT_EQ(label, hel::StringView("joystick", 8));
+    reader.beginObject();
+    ASSERT_TRUE(reader.nextField(label));
+    EXPECT_TRUE(reader.readBool());
+    ASSERT_TRUE(reader.nextField(label));
+    EXPECT_EQ(reader.readString(), hel::StringView("Maxwell", 7));
+    EXPECT_FALSE(reader.nextField(label));
+
+    ASSERT_TRUE(reader.nextField(label));
+    EXPECT_TRUE(reader.readNull());
+    EXPECT_FALSE(reader.nextField(label));
+
+    const std::string SHORT_LIST = "[0,1]";
+    hel::JSONReader short_list(SHORT_LIST);
+    EXPECT_THROW(hel::deserializeList(short_list, dio, [](hel::JSONReader& r){ return r.readBool(); }), std::out_of_range);
+
+    const std::string MALFORMED = "{\"a\" 1}";
+    hel::JSONReader malformed(MALFORMED);
+    malformed.beginObject();
+    EXPECT_THROW(malformed.nextField(label), hel::JSONParsingException);
+
+    const hel::JSONParsingException EXCEPTION("pwm_hdrs");
+    EXPECT_STREQ("Synthesis exception: JSON parsing failed due to malformed data in pwm_hdrs", EXCEPTION.what());
+}
+
+TEST(JSONUtilTest, JSONWriterTest){
+    std::string out;
+    hel::JSONWriter writer(out);
+    for(double value: {0.0, -0.0, 0.5, -0.5, 1.0 / 3.0, -2.0 / 3.0, 0.0000004, 0.0000005, 123456.789, 1e20}){
+        out.clear();
+        writer.write(value);
+        EXPECT_EQ(out, std::to_string(value));
+    }
+    for(double value: {7.75e-05, -7.75e-05, 2.5e-06, 1.0000005, 0.1234565, 8.4999995, 4503599627.3704995}){ //just off a tie after scaling
+        out.clear();
+        writer.write(value);
+        EXPECT_EQ(out, std::to_string(value));
+    }
+    for(unsigned i = 0; i < 100000; i++){
+        const double TIE = (i + 0.5) * 1e-6;
+        for(double value: {TIE, std::nextafter(TIE, 0.0), std::nextafter(TIE, 1.0)}){
+            out.clear();
+            writer.write(value);
+            ASSERT_EQ(out, std::to_string(value));
+        }
+    }
+
+    out.clear();
+    writer.write(static_cast<int8_t>(-128));
+    writer.writeRaw(',');
+    writer.write(static_cast<uint8_t>(255));
+    writer.writeRaw(',');
+    writer.write(true);
+    EXPECT_EQ(out, "-128,255,1");
+
+    out.clear();
+    const std::vector<double> LIST = {0.25, -1.0};
+    hel::serializeList(writer, "pwm", LIST, [](hel::JSONWriter& w, double d){ w.write(d); });
+    EXPECT_EQ(out, "\"pwm\":[0.250000,-1.000000]");
+}
+
+struct SchemaTestData{
+    hel::BoundsCheckedArray<double, 2> outputs;
+    bool enabled;
+    hel::BoundsCheckedArray<hel::Maybe<bool>, 2> sensors;
+    hel::Maybe<uint64_t> time;
+
+    HEL_SCHEMA_FIELD(OutputsField, SchemaTestData, outputs, "outputs", hel::SchemaDepth::SHALLOW);
+    HEL_SCHEMA_FIELD(EnabledField, SchemaTestData, enabled, "enabled", hel::SchemaDepth::DEEP);
+    HEL_SCHEMA_FIELD(SensorsField, SchemaTestData, sensors, "sensors", hel::SchemaDepth::SHALLOW);
+    HEL_SCHEMA_FIELD(TimeField, SchemaTestData, time, "time", hel::SchemaDepth::SHALLOW);
+
+    using JSONSchema = hel::Schema<OutputsField, EnabledField, SensorsField, TimeField>;
+
+    SchemaTestData():outputs(0.0), enabled(false), sensors(hel::Maybe<bool>()), time(){}
+};
+
+TEST(JSONUtilTest, JSONSchemaTest){
+    SchemaTestData data;
+    data.outputs[1] = 0.5;
+    data.enabled = true;
+    data.sensors[0] = hel::Maybe<bool>(true);
+    data.time = hel::Maybe<uint64_t>(15000000);
+
+    std::string out;
+    hel::JSONWriter writer(out);
+    SchemaTestData::JSONSchema::serialize<hel::SchemaDepth::SHALLOW>(writer, data);
+    EXPECT_EQ(out, "\"outputs\":[0.000000,0.500000],\"sensors\":[1,null],\"time\":15000000");
+
+    out.clear();
+    SchemaTestData::JSONSchema::serialize<hel::SchemaDepth::DEEP>(writer, data);
+    EXPECT_EQ(out, "\"outputs\":[0.000000,0.500000],\"enabled\":1,\"sensors\":[1,null],\"time\":15000000");
+
+    const std::string INPUT = "{" + out + ",\"unknown\":[1]}";
+    for(hel::SchemaDepth depth: {hel::SchemaDepth::SHALLOW, hel::SchemaDepth::DEEP}){
+        SchemaTestData parsed;
+        hel::JSONReader reader(INPUT);
+        hel::StringView label;
+        reader.beginObject();
+        while(reader.nextField(label)){
+            const bool FOUND = depth == hel::SchemaDepth::DEEP ? SchemaTestData::JSONSchema::deserialize<hel::SchemaDepth::DEEP>(reader, label, parsed) : SchemaTestData::JSONSchema::deserialize<hel::SchemaDepth::SHALLOW>(reader, label, parsed);
+            if(!FOUND){
+                reader.skipValue();
+            }
+        }
+        EXPECT_EQ(parsed.outputs[1], 0.5);
+        EXPECT_EQ(parsed.enabled, depth == hel::SchemaDepth::DEEP); //shallow parsing skips deep fields
+        EXPECT_TRUE(parsed.sensors[0]);
+        EXPECT_FALSE(parsed.sensors[1]);
+        ASSERT_TRUE(parsed.time);
+        EXPECT_EQ(15000000u, parsed.time.get());
+    }
+
+    const std::string MALFORMED = "{\"outputs\":[0.5]}";
+    SchemaTestData parsed;
+    hel::JSONReader reader(MALFORMED);
+    hel::StringView label;
+    reader.beginObject();
+    reader.nextField(label);
+    EXPECT_THROW(SchemaTestData::JSONSchema::deserialize<hel::SchemaDepth::SHALLOW>(reader, label, parsed), hel::JSONParsingException);
+}
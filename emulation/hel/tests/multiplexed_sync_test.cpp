@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+#include "multiplexed_sync.hpp"
+
+#include <thread>
+
+namespace{
+    std::string packetOf(hel::BinaryPacketType type, const std::string& payload){
+        std::string packet;
+        hel::BinaryWriter writer(packet);
+        std::size_t header_position = writer.beginPacket(type);
+        packet.append(payload);
+        writer.endPacket(header_position);
+        return packet;
+    }
+
+    std::string readPacket(asio::ip::tcp::socket& socket){
+        std::string packet(hel::BINARY_HEADER_SIZE, '\0');
+        asio::read(socket, asio::buffer(&packet[0], packet.size()));
+        hel::BinaryReader reader(packet.data(), packet.size());
+        const uint32_t PAYLOAD_LENGTH = hel::readBinaryHeader(reader).payload_length;
+        packet.resize(hel::BINARY_HEADER_SIZE + PAYLOAD_LENGTH);
+        asio::read(socket, asio::buffer(&packet[hel::BINARY_HEADER_SIZE], PAYLOAD_LENGTH));
+        return packet;
+    }
+}
+
+TEST(MultiplexedSyncTest, BatchRoundTrip){
+    const std::string FIRST = packetOf(hel::BinaryPacketType::SHALLOW, "first");
+    const std::string SECOND = packetOf(hel::BinaryPacketType::DELTA, "");
+    std::string batch;
+    hel::BinaryWriter writer(batch);
+    std::size_t header_position = writer.beginPacket(hel::BinaryPacketType::BATCH);
+    hel::MultiplexedSync::appendBatchEntry(batch, 3, FIRST);
+    hel::MultiplexedSync::appendBatchEntry(batch, 7, SECOND);
+    writer.endPacket(header_position);
+
+    const std::vector<hel::MultiplexedSync::BatchEntry> ENTRIES = hel::MultiplexedSync::parseBatch(hel::StringView(batch.data(), batch.size()));
+    ASSERT_EQ(2u, ENTRIES.size());
+    EXPECT_EQ(3u, ENTRIES[0].robot_id);
+    EXPECT_EQ(FIRST, ENTRIES[0].packet.toString());
+    EXPECT_EQ(7u, ENTRIES[1].robot_id);
+    EXPECT_EQ(SECOND, ENTRIES[1].packet.toString());
+}
+
+TEST(MultiplexedSyncTest, MalformedBatch){
+    const std::string NOT_BATCH = packetOf(hel::BinaryPacketType::SHALLOW, "");
+    EXPECT_THROW(hel::MultiplexedSync::parseBatch(hel::StringView(NOT_BATCH.data(), NOT_BATCH.size())), hel::BinaryParsingException);
+
+    std::string entry;
+    hel::MultiplexedSync::appendBatchEntry(entry, 1, packetOf(hel::BinaryPacketType::SHALLOW, "payload"));
+    const std::string TRUNCATED = packetOf(hel::BinaryPacketType::BATCH, entry.substr(0, entry.size() - 1));
+    EXPECT_THROW(hel::MultiplexedSync::parseBatch(hel::StringView(TRUNCATED.data(), TRUNCATED.size())), hel::BinaryParsingException);
+}
+
+TEST(MultiplexedSyncTest, Session){
+    constexpr uint16_t PORT = 12100;
+    hel::hal_is_initialized.store(true);
+    auto first = hel::RobotInstance::create(12101, 12102);
+    auto second = hel::RobotInstance::create(12103, 12104);
+    asio::io_context io;
+    hel::MultiplexedSync session(io, PORT, {first, second});
+    std::thread sync_thread([&](){
+        io.run();
+    });
+
+    asio::io_context engine_io;
+    asio::ip::tcp::socket socket(engine_io);
+    socket.connect(asio::ip::tcp::endpoint(asio::ip::make_address("127.0.0.1"), PORT));
+    std::string handshake;
+    hel::BinaryWriter writer(handshake);
+    std::size_t header_position = writer.beginPacket(hel::BinaryPacketType::HANDSHAKE);
+    writer.write(hel::BINARY_SCHEMA_VERSION);
+    writer.endPacket(header_position);
+    asio::write(socket, asio::buffer(handshake));
+    readPacket(socket); //the handshake reply
+
+    const std::string KEYFRAMES = readPacket(socket); //one batch with every robot
+    std::vector<hel::MultiplexedSync::BatchEntry> entries = hel::MultiplexedSync::parseBatch(hel::StringView(KEYFRAMES.data(), KEYFRAMES.size()));
+    ASSERT_EQ(2u, entries.size());
+    EXPECT_EQ(first->getID(), entries[0].robot_id);
+    EXPECT_EQ(second->getID(), entries[1].robot_id);
+
+    {
+        hel::RobotInstance::Binding binding(*second);
+        auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::PWM_SYSTEM);
+        instance.first->pwm_system.setHdrPulseWidth(0, 2000); //outside the deadband, so the output changes
+        instance.second.unlock();
+    }
+    const std::string CHANGES = readPacket(socket); //only the robot whose outputs changed
+    entries = hel::MultiplexedSync::parseBatch(hel::StringView(CHANGES.data(), CHANGES.size()));
+    ASSERT_EQ(1u, entries.size());
+    EXPECT_EQ(second->getID(), entries[0].robot_id);
+
+    socket.close();
+    io.stop();
+    sync_thread.join();
+}
@@ -1,5 +1,8 @@
 #include "gtest/gtest.h"
+#include "binary_util.hpp"
+#include "interrupt_system.hpp"
 #include "receive_data.hpp"
+#include "robot_instance.hpp"
 #include <iostream>
 
 TEST(ReceiveDataTest, Deserialize){
@@ -13,3 +16,81 @@ TEST(ReceiveDataTest, Deserialize){
 
     EXPECT_EQ(0, 0); //TODO
 }
+
+TEST(ReceiveDataTest, DefaultPacket){ //applied whenever the engine disconnects
+    hel::ReceiveData receiver;
+    EXPECT_NO_THROW(receiver.deserializeDeep(hel::ReceiveData::defaultPacket()));
+}
+
+static std::string makeHeaderPacket(uint16_t digital_hdrs_mask, hel::BinaryPacketType type = hel::BinaryPacketType::SHALLOW, uint16_t digital_mxp_mask = 0){
+    std::string packet;
+    hel::BinaryWriter writer(packet);
+    std::size_t header_position = writer.beginPacket(type);
+    writer.write(digital_hdrs_mask);
+    for(unsigned i = 0; i < hel::Joystick::MAX_JOYSTICK_COUNT; i++){
+        hel::Joystick().serializeBinary(writer);
+    }
+    if(type == hel::BinaryPacketType::DEEP){
+        for(unsigned i = 0; i < hel::DigitalSystem::NUM_DIGITAL_MXP_CHANNELS; i++){
+            hel::MXPData mxp;
+            mxp.value = hel::checkBitHigh(digital_mxp_mask, i);
+            mxp.serializeBinary(writer);
+        }
+    }
+    hel::MatchInfo().serializeBinary(writer);
+    hel::RobotMode().serializeBinary(writer);
+    for(unsigned i = 0; i < hel::FPGAEncoder::NUM_ENCODERS; i++){
+        writer.write(false); //no encoder
+    }
+    writer.write(false); //no simulation time
+    writer.endPacket(header_position);
+    return packet;
+}
+
+TEST(ReceiveDataTest, ShallowHeaderEdge){
+    nFPGA::nRoboRIO_FPGANamespace::tInterrupt::tConfig config = {};
+    config.Source_Channel = 0;
+    config.RisingEdge = true;
+    hel::InterruptSystem& interrupts = hel::RobotInstance::current().getInterruptSystem();
+    interrupts.setConfig(0, config);
+    const uint32_t MASK = hel::InterruptSystem::maskOf(0);
+    hel::hal_is_initialized = true;
+
+    hel::ReceiveData receiver;
+    receiver.deserializeBinary(makeHeaderPacket(0));
+    receiver.updateShallow();
+    EXPECT_EQ(0u, interrupts.wait(MASK, std::chrono::microseconds(0), false));
+
+    receiver.deserializeBinary(makeHeaderPacket(1));
+    receiver.updateShallow();
+    EXPECT_EQ(1u, interrupts.wait(MASK, std::chrono::microseconds(0), false));
+
+    hel::hal_is_initialized = false;
+}
+
+TEST(ReceiveDataTest, DeepMXPEdge){
+    nFPGA::nRoboRIO_FPGANamespace::tInterrupt::tConfig config = {};
+    config.Source_Module = 1; //MXP
+    config.Source_Channel = 2;
+    config.RisingEdge = true;
+    hel::InterruptSystem& interrupts = hel::RobotInstance::current().getInterruptSystem();
+    interrupts.setConfig(1, config);
+    const uint32_t MASK = hel::InterruptSystem::maskOf(1);
+    hel::hal_is_initialized = true;
+
+    hel::ReceiveData receiver;
+    receiver.deserializeBinary(makeHeaderPacket(0, hel::BinaryPacketType::DEEP, 0));
+    receiver.updateDeep();
+    EXPECT_EQ(0u, interrupts.wait(MASK, std::chrono::microseconds(0), false));
+
+    receiver.deserializeBinary(makeHeaderPacket(0, hel::BinaryPacketType::DEEP, 1u << 2));
+    receiver.updateDeep();
+    EXPECT_EQ(1u << 1, interrupts.wait(MASK, std::chrono::microseconds(0), false));
+    EXPECT_TRUE(hel::checkBitHigh(hel::RoboRIOManager::getCopy().digital_system.getInputs().MXP, 2));
+
+    receiver.deserializeBinary(makeHeaderPacket(1)); //shallow packets leave the MXP inputs as the last deep packet set them
+    receiver.updateDeep();
+    EXPECT_TRUE(hel::checkBitHigh(hel::RoboRIOManager::getCopy().digital_system.getInputs().MXP, 2));
+
+    hel::hal_is_initialized = false;
+}
@@ -0,0 +1,78 @@
+#include "gtest/gtest.h"
+#include "robot_instance.hpp"
+#include "sim_clock.hpp"
+
+#include <thread>
+
+TEST(RobotInstanceTest, Default){ //first, so nothing else has created the default instance yet
+    auto robot = hel::RobotInstance::getDefault();
+    EXPECT_EQ(hel::RobotInstance::DEFAULT_ID, robot->getID());
+    EXPECT_EQ(robot, hel::RobotInstance::getCurrent());
+    EXPECT_LE(hel::RoboRIOManager::getCopy().global.getFPGAStartTime(), hel::SimClock::now());
+}
+
+TEST(RobotInstanceTest, Isolation){
+    auto first = hel::RobotInstance::create(12000, 12001);
+    auto second = hel::RobotInstance::create(12010, 12011);
+    EXPECT_NE(first->getID(), second->getID());
+    {
+        hel::RobotInstance::Binding binding(*first);
+        auto instance = hel::RoboRIOManager::getInstance(hel::RoboRIO::Subsystem::PWM_SYSTEM);
+        instance.first->pwm_system.setHdrPulseWidth(0, 1000); //also publishes the snapshot of the bound instance
+        instance.second.unlock();
+        {
+            hel::RobotInstance::Binding nested(*second);
+            EXPECT_EQ(0u, hel::RoboRIOManager::getCopy().pwm_system.getHdrPulseWidth(0));
+            EXPECT_EQ(0u, hel::RoboRIOManager::getSnapshotVersion());
+        }
+        EXPECT_EQ(first, hel::RobotInstance::getCurrent());
+        EXPECT_LT(0u, hel::RoboRIOManager::getSnapshotVersion());
+        EXPECT_EQ(1000u, hel::RoboRIOManager::getSnapshot().pwm_system.getHdrPulseWidth(0));
+    }
+    EXPECT_EQ(hel::RobotInstance::DEFAULT_ID, hel::RobotInstance::getCurrent()->getID());
+    std::thread([](){ //bindings belong to the thread that made them
+        EXPECT_EQ(hel::RobotInstance::getDefault(), hel::RobotInstance::getCurrent());
+    }).join();
+}
+
+TEST(RobotInstanceTest, Ports){
+    auto robot = hel::RobotInstance::create(12020, 12021);
+    EXPECT_EQ(12020, robot->getReceivePort());
+    EXPECT_EQ(12021, robot->getSendPort());
+    EXPECT_THROW(hel::RobotInstance::create(12021, 12022), std::invalid_argument);
+    EXPECT_THROW(hel::RobotInstance::create(12030, 12030), std::invalid_argument);
+    EXPECT_THROW(hel::RobotInstance::create(hel::RobotInstance::getDefault()->getReceivePort(), 12031), std::invalid_argument);
+    robot.reset(); //ports are released with the instance
+    EXPECT_NO_THROW(hel::RobotInstance::create(12021, 12022));
+}
+
+TEST(RobotInstanceTest, Clocks){
+    auto first = hel::RobotInstance::create(12040, 12041);
+    auto second = hel::RobotInstance::create(12050, 12051);
+    hel::RobotInstance::Binding binding(*first);
+    hel::SimClock::advanceTo(1000000);
+    const uint64_t FIRST_TIME = hel::SimClock::now();
+    {
+        hel::RobotInstance::Binding nested(*second);
+        EXPECT_FALSE(hel::SimClock::isLockstep());
+        hel::SimClock::advanceTo(0);
+        hel::SimClock::advanceTo(50000000); //another robot's engine time does not move this one
+        hel::SimClock::release(); //nor does its disconnect
+    }
+    EXPECT_TRUE(hel::SimClock::isLockstep());
+    EXPECT_EQ(FIRST_TIME, hel::SimClock::now());
+    hel::SimClock::release();
+}
+
+TEST(RobotInstanceTest, FPGAStartTime){
+    auto first = hel::RobotInstance::create(12060, 12061);
+    hel::RobotInstance::Binding binding(*first);
+    hel::SimClock::advanceTo(0);
+    hel::SimClock::advanceTo(3600000000); //an hour ahead of the host clock
+    auto second = hel::RobotInstance::create(12070, 12071); //created while another instance is bound
+    {
+        hel::RobotInstance::Binding nested(*second);
+        EXPECT_LE(hel::RoboRIOManager::getCopy().global.getFPGAStartTime(), hel::SimClock::now()); //read from its own clock
+    }
+    hel::SimClock::release();
+}
@@ -31,3 +31,135 @@ TEST(SendDataTest, Update){
     EXPECT_EQ(true, true); //TODO
 }
 
+
+TEST(SendDataTest, DeltaPacket){
+    hel::hal_is_initialized.store(true);
+    hel::SendData a = {};
+    a.enable(true);
+    a.updateDeep();
+
+    std::string keyframe = a.serializeShallowDelta();
+    {
+        hel::BinaryReader reader(keyframe.data(), keyframe.size());
+        EXPECT_EQ(hel::BinaryPacketType::DELTA, hel::readBinaryHeader(reader).type);
+        EXPECT_EQ(0u, reader.read<uint32_t>());
+        EXPECT_EQ(hel::SendData::KEYFRAME | hel::SendData::PWM_HDRS | hel::SendData::CAN_MOTOR_CONTROLLERS, reader.read<uint8_t>());
+    }
+
+    {
+        auto instance = hel::RoboRIOManager::getInstance();
+        instance.first->pwm_system.setHdrPulseWidth(3, 2000);
+        instance.second.unlock();
+    }
+    a.updateShallow();
+    EXPECT_TRUE(a.hasNewData());
+
+    std::string delta = a.serializeShallowDelta();
+    std::cout<<"Keyframe size: "<<keyframe.size()<<" bytes, delta size: "<<delta.size()<<" bytes\n";
+    hel::BinaryReader reader(delta.data(), delta.size());
+    hel::readBinaryHeader(reader);
+    EXPECT_EQ(1u, reader.read<uint32_t>());
+    EXPECT_EQ(hel::SendData::PWM_HDRS, reader.read<uint8_t>());
+    EXPECT_EQ(1u << 3, reader.read<uint16_t>());
+    EXPECT_FLOAT_EQ(hel::PWMSystem::getPercentOutput(2000), reader.readFloat());
+    EXPECT_EQ(0u, reader.remaining());
+
+    a.updateShallow();
+    EXPECT_FALSE(a.hasNewData());
+}
+
+TEST(SendDataTest, DeepDeltaAfterShallowKeyframe){
+    hel::hal_is_initialized.store(true);
+    hel::SendData a = {};
+    a.enable(true);
+    {
+        auto instance = hel::RoboRIOManager::getInstance();
+        tRelay::tValue value = instance.first->relay_system.getValue();
+        value.Forward = 1u << 2;
+        instance.first->relay_system.setValue(value);
+        instance.second.unlock();
+    }
+    hel::RoboRIOManager::publishSnapshot();
+    a.updateDeep();
+
+    std::string keyframe = a.serializeShallowDelta();
+    {
+        hel::BinaryReader reader(keyframe.data(), keyframe.size());
+        hel::readBinaryHeader(reader);
+        reader.read<uint32_t>();
+        EXPECT_EQ(0u, reader.read<uint8_t>() & hel::SendData::RELAYS);
+    }
+
+    {
+        auto instance = hel::RoboRIOManager::getInstance();
+        instance.first->pwm_system.setHdrPulseWidth(1, 2000);
+        instance.second.unlock();
+    }
+    a.updateDeep();
+
+    std::string delta = a.serializeDeepDelta();
+    hel::BinaryReader reader(delta.data(), delta.size());
+    hel::readBinaryHeader(reader);
+    EXPECT_EQ(1u, reader.read<uint32_t>());
+    const uint8_t SECTIONS = reader.read<uint8_t>();
+    EXPECT_EQ(0u, SECTIONS & hel::SendData::KEYFRAME);
+    ASSERT_NE(0u, SECTIONS & hel::SendData::RELAYS);
+
+    hel::SendData b = {};
+    b.deserializeBinary(keyframe);
+    b.deserializeBinary(delta);
+    EXPECT_NE(std::string::npos, b.toString().find("relays:[OFF,OFF,FORWARD,OFF]"));
+}
+
+TEST(SendDataTest, OutputSettersPublish){
+    hel::hal_is_initialized.store(true);
+    const uint64_t VERSION = hel::RoboRIOManager::getSnapshotVersion();
+
+    tRelay* relay = tRelay::create(nullptr);
+    relay->writeValue_Forward(1u << 0, nullptr);
+    tAO* ao = tAO::create(nullptr);
+    ao->writeMXP(1, 0x800, nullptr);
+
+    EXPECT_LE(VERSION + 2, hel::RoboRIOManager::getSnapshotVersion());
+    const hel::RoboRIOSnapshot& roborio = hel::RoboRIOManager::getSnapshot();
+    EXPECT_EQ(hel::RelaySystem::State::FORWARD, roborio.relay_system.getState(0));
+    EXPECT_EQ(0x800, roborio.analog_outputs.getMXPOutput(1));
+
+    auto instance = hel::SendDataManager::getInstance();
+    EXPECT_TRUE(instance.first->hasNewData());
+    EXPECT_NE(std::string::npos, instance.first->toString().find("relays:[FORWARD,"));
+    instance.second.unlock();
+}
+
+TEST(SendDataTest, SerializeNext){
+    hel::hal_is_initialized.store(true);
+    hel::SendData a = {};
+    a.enable(true);
+    a.updateDeep();
+
+    auto sections = [](const std::string& packet){
+        hel::BinaryReader reader(packet.data(), packet.size());
+        hel::readBinaryHeader(reader);
+        reader.read<uint32_t>();
+        return reader.read<uint8_t>();
+    };
+    const uint8_t KEYFRAME_SECTIONS = sections(a.serializeNext(hel::WireFormat::BINARY)); //a new peer gets a deep keyframe
+    EXPECT_NE(0u, KEYFRAME_SECTIONS & hel::SendData::KEYFRAME);
+    EXPECT_NE(0u, KEYFRAME_SECTIONS & hel::SendData::RELAYS);
+
+    tPWM* pwm = tPWM::create(nullptr);
+    pwm->writeHdr(4, 2000, nullptr);
+    a.updateDeep();
+    EXPECT_EQ(hel::SendData::PWM_HDRS, sections(a.serializeNext(hel::WireFormat::BINARY)));
+
+    tRelay* relay = tRelay::create(nullptr);
+    relay->writeValue_Reverse(1u << 3, nullptr);
+    a.updateDeep();
+    EXPECT_EQ(hel::SendData::RELAYS, sections(a.serializeNext(hel::WireFormat::BINARY)));
+
+    a.requestKeyframe();
+    EXPECT_NE(std::string::npos, a.serializeNext(hel::WireFormat::JSON).find("\"relays\""));
+    pwm->writeHdr(4, 1000, nullptr);
+    a.updateDeep();
+    EXPECT_EQ(std::string::npos, a.serializeNext(hel::WireFormat::JSON).find("\"relays\""));
+}
@@ -0,0 +1,89 @@
+#include "gtest/gtest.h"
+#include "shm_engine_peer.hpp"
+#include "shm_transport.hpp"
+#include "sync_client.hpp"
+#include "sync_server.hpp"
+
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+namespace{
+    std::string ringName(const std::string& test){
+        return "/hel_test_" + test + "_" + std::to_string(getpid());
+    }
+}
+
+TEST(ShmTransportTest, WrapAround){
+    hel::ShmRing producer = hel::ShmRing::create(ringName("wrap"), 64);
+    hel::ShmRing consumer = hel::ShmRing::open(producer.getName());
+    EXPECT_EQ(64u, consumer.capacity());
+
+    std::string packet;
+    for(unsigned i = 0; i < 20; i++){ //packets of 4 + 25 bytes straddle the end of the storage
+        const std::string SENT = std::string(24, 'a' + i % 26) + std::to_string(i % 10);
+        ASSERT_TRUE(producer.tryWrite(SENT));
+        ASSERT_TRUE(consumer.tryRead(packet));
+        EXPECT_EQ(SENT, packet);
+    }
+    EXPECT_TRUE(consumer.empty());
+    EXPECT_FALSE(consumer.tryRead(packet));
+}
+
+TEST(ShmTransportTest, FullAndLatest){
+    hel::ShmRing producer = hel::ShmRing::create(ringName("full"), 64);
+    hel::ShmRing consumer = hel::ShmRing::open(producer.getName());
+
+    EXPECT_FALSE(producer.tryWrite(std::string(64, 'x'))); //the length prefix can never fit
+    EXPECT_TRUE(producer.tryWrite(std::string(20, '1')));
+    EXPECT_TRUE(producer.tryWrite(std::string(20, '2')));
+    EXPECT_FALSE(producer.tryWrite(std::string(20, '3')));
+
+    std::string packet;
+    ASSERT_TRUE(consumer.readLatest(packet));
+    EXPECT_EQ(std::string(20, '2'), packet);
+    EXPECT_TRUE(producer.tryWrite(std::string(20, '3')));
+}
+
+TEST(ShmTransportTest, Wakeup){
+    hel::ShmRing producer = hel::ShmRing::create(ringName("wakeup"));
+    hel::ShmRing consumer = hel::ShmRing::open(producer.getName());
+
+    EXPECT_FALSE(consumer.waitForData(std::chrono::microseconds(1000)));
+
+    constexpr unsigned ROUND_TRIPS = 1000;
+    std::thread writer([&](){
+        for(unsigned i = 0; i < ROUND_TRIPS; i++){
+            while(!producer.tryWrite(std::to_string(i))){}
+        }
+    });
+    std::string packet;
+    for(unsigned i = 0; i < ROUND_TRIPS; i++){
+        ASSERT_TRUE(consumer.waitForData(std::chrono::seconds(1)));
+        ASSERT_TRUE(consumer.tryRead(packet));
+        EXPECT_EQ(std::to_string(i), packet);
+    }
+    writer.join();
+}
+
+TEST(ShmTransportTest, OpenMissing){
+    EXPECT_THROW(hel::ShmRing::open(ringName("missing")), hel::ShmException);
+}
+
+TEST(ShmTransportTest, EnginePeer){
+    asio::io_context io;
+    hel::SyncServer server(io);
+    hel::SyncClient client(io);
+    std::thread sync_thread([&](){
+        io.run();
+    });
+    {
+        hel::ShmEnginePeer peer;
+        EXPECT_EQ(hel::WireFormat::BINARY, peer.getWireFormat());
+        std::string packet;
+        EXPECT_TRUE(peer.receiveOutputs(packet, std::chrono::seconds(1))); //the keyframe sent on connection
+        EXPECT_TRUE(hel::isBinaryPacket(packet.data(), packet.size()));
+    }
+    io.stop();
+    sync_thread.join();
+}
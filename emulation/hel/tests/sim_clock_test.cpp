@@ -0,0 +1,108 @@
+#include "gtest/gtest.h"
+#include "sim_clock.hpp"
+
+#include <atomic>
+#include <thread>
+
+TEST(SimClockTest, Lockstep){
+    const uint64_t START = hel::SimClock::now();
+    hel::SimClock::advanceTo(1000000);
+    EXPECT_TRUE(hel::SimClock::isLockstep());
+    const uint64_t ENTERED = hel::SimClock::now();
+    EXPECT_GE(ENTERED, START); //entering lockstep never moves time backwards
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_EQ(ENTERED, hel::SimClock::now()); //host time no longer matters
+
+    hel::SimClock::advanceTo(1020000);
+    EXPECT_EQ(ENTERED + 20000, hel::SimClock::now());
+
+    hel::SimClock::advanceTo(0); //the engine restarted its simulation
+    EXPECT_EQ(ENTERED + 20000, hel::SimClock::now());
+    hel::SimClock::advanceTo(15000000); //15 s of autonomous in one step
+    EXPECT_EQ(ENTERED + 15020000, hel::SimClock::now());
+
+    hel::SimClock::release();
+    EXPECT_FALSE(hel::SimClock::isLockstep());
+    EXPECT_GE(hel::SimClock::now(), ENTERED + 15020000);
+}
+
+TEST(SimClockTest, WaitForStep){
+    hel::SimClock::advanceTo(0);
+    const uint64_t START = hel::SimClock::now();
+    uint64_t step = hel::SimClock::getStep();
+    EXPECT_FALSE(hel::SimClock::waitForStep(step, std::chrono::milliseconds(1))); //the engine has not stepped
+
+    std::thread engine([](){
+        for(uint64_t time = 20000; time <= 100000; time += 20000){
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            hel::SimClock::advanceTo(time);
+        }
+    });
+    unsigned wakeups = 0;
+    while(hel::SimClock::now() - START < 100000){ //steps taken while the waiter is busy are coalesced
+        if(hel::SimClock::waitForStep(step, std::chrono::seconds(1))){
+            wakeups++;
+        }
+    }
+    engine.join();
+    EXPECT_GE(wakeups, 1u);
+    EXPECT_EQ(hel::SimClock::getStep(), step);
+    hel::SimClock::release();
+}
+
+TEST(SimClockTest, LoopBarrier){
+    hel::SimClock::setLoopBarrier(true);
+    const uint64_t START = hel::SimClock::getUserLoopCount();
+    constexpr unsigned ITERATIONS = 100;
+    std::atomic<unsigned> completed{0};
+    std::thread user_program([&](){
+        for(unsigned i = 0; i < ITERATIONS; i++){
+            hel::SimClock::startUserLoop();
+            completed++;
+        }
+        hel::SimClock::startUserLoop(); //held until the barrier is disabled
+    });
+    for(unsigned i = 0; i < ITERATIONS; i++){
+        if(!hel::SimClock::waitForUserLoop(std::chrono::seconds(1))){
+            ADD_FAILURE() << "the user program did not reach the barrier";
+            break;
+        }
+        EXPECT_EQ(i, completed); //the previous iteration has finished and the next has not begun
+        hel::SimClock::releaseUserLoop();
+    }
+    EXPECT_TRUE(hel::SimClock::waitForUserLoop(std::chrono::seconds(1)));
+    EXPECT_EQ(ITERATIONS, completed);
+    hel::SimClock::setLoopBarrier(false);
+    user_program.join();
+    EXPECT_EQ(START + ITERATIONS + 1, hel::SimClock::getUserLoopCount());
+    EXPECT_FALSE(hel::SimClock::waitForUserLoop(std::chrono::milliseconds(1)));
+}
+
+TEST(SimClockTest, WaitUntil){
+    const uint64_t DEADLINE = hel::SimClock::now() + 5000;
+    EXPECT_TRUE(hel::SimClock::waitUntil(DEADLINE, [](){ return false; }));
+    EXPECT_GE(hel::SimClock::now(), DEADLINE);
+
+    std::atomic<bool> cancelled{false};
+    std::thread canceller([&](){
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        cancelled = true;
+        hel::SimClock::wake();
+    });
+    EXPECT_FALSE(hel::SimClock::waitUntil(hel::SimClock::now() + 60000000, [&](){ return cancelled.load(); }));
+    canceller.join();
+
+    hel::SimClock::advanceTo(0);
+    const uint64_t STEP_DEADLINE = hel::SimClock::now() + 30000;
+    std::thread engine([](){
+        for(uint64_t time = 10000; time <= 30000; time += 10000){
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            hel::SimClock::advanceTo(time);
+        }
+    });
+    EXPECT_TRUE(hel::SimClock::waitUntil(STEP_DEADLINE, [](){ return false; })); //only the engine's time counts in lockstep mode
+    EXPECT_EQ(STEP_DEADLINE, hel::SimClock::now());
+    engine.join();
+    hel::SimClock::release();
+}